@@ -35,7 +35,7 @@
 #include "BitmapAnnotation.h"
 #include "Commands.h"
 
-BitmapAnnotation::BitmapAnnotation(QString classFileName, QString annotation, GraphicsView *pGraphicsView)
+BitmapAnnotation::BitmapAnnotation(QString classFileName, const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   mpComponent = 0;
@@ -76,24 +76,34 @@ BitmapAnnotation::BitmapAnnotation(ShapeAnnotation *pShapeAnnotation, GraphicsVi
 
 void BitmapAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Bitmap.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief BitmapAnnotation::parseShapeAnnotation
+ * Parses the Bitmap annotation values.
+ * \param list - the arguments of the Bitmap(..) call.
+ */
+void BitmapAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
   if (list.size() < 5) {
     return;
   }
   // 4th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2)
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  OMCValue extents = list.at(3);
+  for (int i = 0 ; i < qMin(extents.size(), 2) ; i++) {
+    OMCValue extentPoint = extents.at(i);
+    if (extentPoint.size() >= 2)
+      mExtents.replace(i, QPointF(extentPoint.at(0).toReal(), extentPoint.at(1).toReal()));
   }
   // 5th item is the fileName
-  setFileName(StringHandler::removeFirstLastQuotes(list.at(4)), mpComponent);
+  setFileName(list.at(4).getText().toString(), mpComponent);
   // 6th item is the imageSource
   if (list.size() >= 6) {
-    mImageSource = StringHandler::removeFirstLastQuotes(list.at(5));
+    mImageSource = list.at(5).getText().toString();
   }
   if (!mImageSource.isEmpty()) {
     mImage.loadFromData(QByteArray::fromBase64(mImageSource.toLatin1()));
@@ -199,7 +209,7 @@ void BitmapAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
  */
 void BitmapAnnotation::duplicate()
 {
-  BitmapAnnotation *pBitmapAnnotation = new BitmapAnnotation(mClassFileName, "", mpGraphicsView);
+  BitmapAnnotation *pBitmapAnnotation = new BitmapAnnotation(mClassFileName, OMCValue(), mpGraphicsView);
   pBitmapAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
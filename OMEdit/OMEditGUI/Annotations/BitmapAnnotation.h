@@ -45,12 +45,13 @@ class BitmapAnnotation : public ShapeAnnotation
   Q_OBJECT
 public:
   // Used for icon/diagram shape
-  BitmapAnnotation(QString classFileName, QString annotation, GraphicsView *pGraphicsView);
+  BitmapAnnotation(QString classFileName, const OMCValue &annotation, GraphicsView *pGraphicsView);
   // Used for shape inside a component
   BitmapAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent);
   // Used for icon/diagram inherited shape
   BitmapAnnotation(ShapeAnnotation *pShapeAnnotation, GraphicsView *pGraphicsView);
   void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValue &list);
   QRectF boundingRect() const;
   QPainterPath shape() const;
   void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
@@ -35,7 +35,7 @@
 #include "EllipseAnnotation.h"
 #include "Commands.h"
 
-EllipseAnnotation::EllipseAnnotation(QString annotation, GraphicsView *pGraphicsView)
+EllipseAnnotation::EllipseAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   // set the default values
@@ -74,25 +74,35 @@ EllipseAnnotation::EllipseAnnotation(ShapeAnnotation *pShapeAnnotation, Graphics
 
 void EllipseAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Ellipse.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief EllipseAnnotation::parseShapeAnnotation
+ * Parses the Ellipse annotation values.
+ * \param list - the arguments of the Ellipse(..) call.
+ */
+void EllipseAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  OMCValue extents = list.at(8);
+  for (int i = 0 ; i < qMin(extents.size(), 2) ; i++) {
+    OMCValue extentPoint = extents.at(i);
+    if (extentPoint.size() >= 2) {
+      mExtents.replace(i, QPointF(extentPoint.at(0).toReal(), extentPoint.at(1).toReal()));
     }
   }
   // 10th item of the list contains the start angle.
-  mStartAngle = list.at(9).toFloat();
+  mStartAngle = list.at(9).toReal();
   // 11th item of the list contains the end angle.
-  mEndAngle = list.at(10).toFloat();
+  mEndAngle = list.at(10).toReal();
 }
 
 QRectF EllipseAnnotation::boundingRect() const
@@ -222,7 +232,7 @@ void EllipseAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
  */
 void EllipseAnnotation::duplicate()
 {
-  EllipseAnnotation *pEllipseAnnotation = new EllipseAnnotation("", mpGraphicsView);
+  EllipseAnnotation *pEllipseAnnotation = new EllipseAnnotation(OMCValue(), mpGraphicsView);
   pEllipseAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
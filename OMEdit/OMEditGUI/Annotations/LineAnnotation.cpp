@@ -35,7 +35,7 @@
 #include "LineAnnotation.h"
 #include "Commands.h"
 
-LineAnnotation::LineAnnotation(QString annotation, GraphicsView *pGraphicsView)
+LineAnnotation::LineAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   setLineType(LineAnnotation::ShapeType);
@@ -110,7 +110,7 @@ LineAnnotation::LineAnnotation(Component *pStartComponent, GraphicsView *pGraphi
   setAlpha("0.2");
 }
 
-LineAnnotation::LineAnnotation(QString annotation, Component *pStartComponent, Component *pEndComponent, GraphicsView *pGraphicsView)
+LineAnnotation::LineAnnotation(const OMCValue &annotation, Component *pStartComponent, Component *pEndComponent, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   setFlag(QGraphicsItem::ItemIsSelectable);
@@ -200,44 +200,50 @@ LineAnnotation::LineAnnotation(GraphicsView *pGraphicsView)
 
 void LineAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Line.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief LineAnnotation::parseShapeAnnotation
+ * Parses the Line annotation values.
+ * \param list - the arguments of the Line(..) call.
+ */
+void LineAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
   mPoints.clear();
   // 4th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  foreach (QString point, pointsList) {
-    QStringList linePoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (linePoints.size() >= 2) {
-      addPoint(QPointF(linePoints.at(0).toFloat(), linePoints.at(1).toFloat()));
+  OMCValue points = list.at(3);
+  for (int i = 0 ; i < points.size() ; i++) {
+    OMCValue point = points.at(i);
+    if (point.size() >= 2) {
+      addPoint(QPointF(point.at(0).toReal(), point.at(1).toReal()));
     }
   }
   // 5th item of list contains the color.
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (colorList.size() >= 3) {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+  OMCValue color = list.at(4);
+  if (color.size() >= 3) {
+    mLineColor = QColor(color.at(0).toInt(), color.at(1).toInt(), color.at(2).toInt());
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(list.at(5).toString());
   // 7th item of list contains the Line thickness.
-  mLineThickness = list.at(6).toFloat();
+  mLineThickness = list.at(6).toReal();
   // 8th item of list contains the Line Arrows.
-  QStringList arrowList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(7)));
-  if (arrowList.size() >= 2) {
-    mArrow.replace(0, StringHandler::getArrowType(arrowList.at(0)));
-    mArrow.replace(1, StringHandler::getArrowType(arrowList.at(1)));
+  OMCValue arrows = list.at(7);
+  if (arrows.size() >= 2) {
+    mArrow.replace(0, StringHandler::getArrowType(arrows.at(0).toString()));
+    mArrow.replace(1, StringHandler::getArrowType(arrows.at(1).toString()));
   }
   // 9th item of list contains the Line Arrow Size.
-  mArrowSize = list.at(8).toFloat();
+  mArrowSize = list.at(8).toReal();
   // 10th item of list contains the smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).toString());
 }
 
 QPainterPath LineAnnotation::getShape() const
@@ -782,7 +788,7 @@ void LineAnnotation::updateConnectionAnnotation()
  */
 void LineAnnotation::duplicate()
 {
-  LineAnnotation *pLineAnnotation = new LineAnnotation("", mpGraphicsView);
+  LineAnnotation *pLineAnnotation = new LineAnnotation(OMCValue(), mpGraphicsView);
   pLineAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
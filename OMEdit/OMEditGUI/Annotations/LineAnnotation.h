@@ -50,7 +50,7 @@ public:
     ShapeType  /* Line is a custom shape. */
   };
   // Used for icon/diagram shape
-  LineAnnotation(QString annotation, GraphicsView *pGraphicsView);
+  LineAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView);
   // Used for shape inside a component
   LineAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent);
   // Used for icon/diagram inherited shape
@@ -58,12 +58,13 @@ public:
   // Used for creating connection
   LineAnnotation(Component *pStartComponent, GraphicsView *pGraphicsView);
   // Used for reading a connection
-  LineAnnotation(QString annotation, Component *pStartComponent, Component *pEndComponent, GraphicsView *pGraphicsView);
+  LineAnnotation(const OMCValue &annotation, Component *pStartComponent, Component *pEndComponent, GraphicsView *pGraphicsView);
   // Used for non-exisiting component
   LineAnnotation(Component *pParent);
   // Used for non-existing class
   LineAnnotation(GraphicsView *pGraphicsView);
   void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValue &list);
   QPainterPath getShape() const;
   QRectF boundingRect() const;
   QPainterPath shape() const;
@@ -35,7 +35,7 @@
 #include "PolygonAnnotation.h"
 #include "Commands.h"
 
-PolygonAnnotation::PolygonAnnotation(QString annotation, GraphicsView *pGraphicsView)
+PolygonAnnotation::PolygonAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   // set the default values
@@ -74,20 +74,30 @@ PolygonAnnotation::PolygonAnnotation(ShapeAnnotation *pShapeAnnotation, Graphics
 
 void PolygonAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Polygon.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief PolygonAnnotation::parseShapeAnnotation
+ * Parses the Polygon annotation values.
+ * \param list - the arguments of the Polygon(..) call.
+ */
+void PolygonAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
   mPoints.clear();
   // 9th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  foreach (QString point, pointsList) {
-    QStringList polygonPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (polygonPoints.size() >= 2) {
-      mPoints.append(QPointF(polygonPoints.at(0).toFloat(), polygonPoints.at(1).toFloat()));
+  OMCValue points = list.at(8);
+  for (int i = 0 ; i < points.size() ; i++) {
+    OMCValue point = points.at(i);
+    if (point.size() >= 2) {
+      mPoints.append(QPointF(point.at(0).toReal(), point.at(1).toReal()));
     }
   }
   /* The polygon is automatically closed, if the first and the last points are not identical. */
@@ -103,7 +113,7 @@ void PolygonAnnotation::parseShapeAnnotation(QString annotation)
     }
   }
   // 10th item of the list is smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).toString());
 }
 
 QPainterPath PolygonAnnotation::getShape() const
@@ -273,7 +283,7 @@ void PolygonAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
  */
 void PolygonAnnotation::duplicate()
 {
-  PolygonAnnotation *pPolygonAnnotation = new PolygonAnnotation("", mpGraphicsView);
+  PolygonAnnotation *pPolygonAnnotation = new PolygonAnnotation(OMCValue(), mpGraphicsView);
   pPolygonAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
@@ -35,7 +35,7 @@
 #include "RectangleAnnotation.h"
 #include "Commands.h"
 
-RectangleAnnotation::RectangleAnnotation(QString annotation, GraphicsView *pGraphicsView)
+RectangleAnnotation::RectangleAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   // set the default values
@@ -92,25 +92,35 @@ RectangleAnnotation::RectangleAnnotation(Component *pParent)
 
 void RectangleAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Rectangle.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief RectangleAnnotation::parseShapeAnnotation
+ * Parses the Rectangle annotation values.
+ * \param list - the arguments of the Rectangle(..) call.
+ */
+void RectangleAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item of the list contains the border pattern.
-  mBorderPattern = StringHandler::getBorderPatternType(list.at(8));
+  mBorderPattern = StringHandler::getBorderPatternType(list.at(8).toString());
   // 10th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(9)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  OMCValue extents = list.at(9);
+  for (int i = 0 ; i < qMin(extents.size(), 2) ; i++) {
+    OMCValue extentPoint = extents.at(i);
+    if (extentPoint.size() >= 2) {
+      mExtents.replace(i, QPointF(extentPoint.at(0).toReal(), extentPoint.at(1).toReal()));
     }
   }
   // 11th item of the list contains the corner radius.
-  mRadius = list.at(10).toFloat();
+  mRadius = list.at(10).toReal();
 }
 
 QRectF RectangleAnnotation::boundingRect() const
@@ -217,7 +227,7 @@ void RectangleAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
  */
 void RectangleAnnotation::duplicate()
 {
-  RectangleAnnotation *pRectangleAnnotation = new RectangleAnnotation("", mpGraphicsView);
+  RectangleAnnotation *pRectangleAnnotation = new RectangleAnnotation(OMCValue(), mpGraphicsView);
   pRectangleAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
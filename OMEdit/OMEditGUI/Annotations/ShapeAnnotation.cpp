@@ -63,26 +63,25 @@ void GraphicItem::setDefaults(ShapeAnnotation *pShapeAnnotation)
 }
 
 /*!
-  Parses the GraphicItem annotation values.
-  \param annotation - the annotation string.
-  */
-void GraphicItem::parseShapeAnnotation(QString annotation)
+ * \brief GraphicItem::parseShapeAnnotation
+ * Parses the GraphicItem annotation values.
+ * \param annotation - the shape arguments parsed with OMCValueTree::ArgumentList.
+ */
+void GraphicItem::parseShapeAnnotation(const OMCValue &annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 3)
+  if (annotation.size() < 3)
     return;
-  // if first item of list is true then the shape should be visible.
-  mVisible = list.at(0).contains("true");
+  // if first item of list is true then the shape should be visible. The item may also be DynamicSelect(true, ..).
+  mVisible = annotation.at(0).getSource().toString().contains("true");
   // 2nd item is the origin
-  QStringList originList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(1)));
-  if (originList.size() >= 2)
+  OMCValue origin = annotation.at(1);
+  if (origin.size() >= 2)
   {
-    mOrigin.setX(originList.at(0).toFloat());
-    mOrigin.setY(originList.at(1).toFloat());
+    mOrigin.setX(origin.at(0).toReal());
+    mOrigin.setY(origin.at(1).toReal());
   }
   // 3rd item is the rotation
-  mRotation = list.at(2).toFloat();
+  mRotation = annotation.at(2).toReal();
 }
 
 /*!
@@ -160,41 +159,32 @@ void FilledShape::setDefaults(ShapeAnnotation *pShapeAnnotation)
 }
 
 /*!
-  Parses the FilledShape annotation values.
-  \param annotation - the annotation string.
-  */
-void FilledShape::parseShapeAnnotation(QString annotation)
+ * \brief FilledShape::parseShapeAnnotation
+ * Parses the FilledShape annotation values.
+ * \param annotation - the shape arguments parsed with OMCValueTree::ArgumentList.
+ */
+void FilledShape::parseShapeAnnotation(const OMCValue &annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 8)
+  if (annotation.size() < 8)
     return;
   // 4th item of the list is the line color
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  if (colorList.size() >= 3)
+  OMCValue color = annotation.at(3);
+  if (color.size() >= 3)
   {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+    mLineColor = QColor(color.at(0).toInt(), color.at(1).toInt(), color.at(2).toInt());
   }
   // 5th item of list contains the fill color.
-  QStringList fillColorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (fillColorList.size() >= 3)
+  OMCValue fillColor = annotation.at(4);
+  if (fillColor.size() >= 3)
   {
-    int red, green, blue = 0;
-    red = fillColorList.at(0).toInt();
-    green = fillColorList.at(1).toInt();
-    blue = fillColorList.at(2).toInt();
-    mFillColor = QColor (red, green, blue);
+    mFillColor = QColor(fillColor.at(0).toInt(), fillColor.at(1).toInt(), fillColor.at(2).toInt());
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(annotation.at(5).toString());
   // 7th item of list contains the Fill Pattern.
-  mFillPattern = StringHandler::getFillPatternType(list.at(6));
+  mFillPattern = StringHandler::getFillPatternType(annotation.at(6).toString());
   // 8th item of list contains the thickness.
-  mLineThickness = list.at(7).toFloat();
+  mLineThickness = annotation.at(7).toReal();
 }
 
 /*!
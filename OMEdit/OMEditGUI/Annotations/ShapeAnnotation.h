@@ -46,6 +46,7 @@
 
 #include "Helper.h"
 #include "StringHandler.h"
+#include "OMCValue.h"
 #include "Transformation.h"
 
 class MainWindow;
@@ -60,7 +61,7 @@ public:
   GraphicItem() {}
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
-  void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValue &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setOrigin(QPointF origin) {mOrigin = origin;}
@@ -79,7 +80,7 @@ public:
   FilledShape() {}
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
-  void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValue &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setLineColor(QColor color) {mLineColor = color;}
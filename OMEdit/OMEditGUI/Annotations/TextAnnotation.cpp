@@ -41,11 +41,11 @@
  */
 /*!
  * \brief TextAnnotation::TextAnnotation
- * \param annotation - text annotation string.
+ * \param annotation - the arguments of the Text(..) call.
  * \param inheritedShape
  * \param pGraphicsView - pointer to GraphicsView
  */
-TextAnnotation::TextAnnotation(QString annotation, GraphicsView *pGraphicsView)
+TextAnnotation::TextAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView)
   : ShapeAnnotation(false, pGraphicsView, 0)
 {
   mpComponent = 0;
@@ -108,58 +108,61 @@ TextAnnotation::TextAnnotation(Component *pParent)
  */
 void TextAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Text.
-  QStringList list = StringHandler::getStrings(annotation);
+  OMCValueTree tree(annotation, OMCValueTree::ArgumentList);
+  parseShapeAnnotation(tree.getRoot());
+}
+
+/*!
+ * \brief TextAnnotation::parseShapeAnnotation
+ * Parses the Text annotation values.
+ * \param list - the arguments of the Text(..) call.
+ */
+void TextAnnotation::parseShapeAnnotation(const OMCValue &list)
+{
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item of the list contains the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2)
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  OMCValue extents = list.at(8);
+  for (int i = 0 ; i < qMin(extents.size(), 2) ; i++) {
+    OMCValue extentPoint = extents.at(i);
+    if (extentPoint.size() >= 2)
+      mExtents.replace(i, QPointF(extentPoint.at(0).toReal(), extentPoint.at(1).toReal()));
   }
-  // 10th item of the list contains the textString.
-  mOriginalTextString = StringHandler::removeFirstLastQuotes(list.at(9));
+  // 10th item of the list contains the textString. The text is kept escaped as it is written back to OMC as is.
+  mOriginalTextString = list.at(9).getText().toString();
   mTextString = mOriginalTextString;
   initUpdateTextString();
   // 11th item of the list contains the fontSize.
-  mFontSize = list.at(10).toFloat();
-  //Now comes the optional parameters; fontName and textStyle.
-  annotation = annotation.replace("{", "");
-  annotation = annotation.replace("}", "");
-  // parse the shape to get the list of attributes of Text Annotation.
-  list = StringHandler::getStrings(annotation);
-  int index = 19;
+  mFontSize = list.at(10).toReal();
+  //Now comes the optional parameters; fontName, textStyle and horizontalAlignment.
   mTextStyles.clear();
-  while(index < list.size()) {
-    QString annotationValue = StringHandler::removeFirstLastQuotes(list.at(index));
-    // check textStyles enumeration.
-    if(annotationValue == "TextStyle.Bold") {
-      mTextStyles.append(StringHandler::TextStyleBold);
-      index++;
-    } else if(annotationValue == "TextStyle.Italic") {
-      mTextStyles.append(StringHandler::TextStyleItalic);
-      index++;
-    } else if(annotationValue == "TextStyle.UnderLine") {
-      mTextStyles.append(StringHandler::TextStyleUnderLine);
-      index++;
-    } else if(annotationValue == "TextAlignment.Left") {
-      // check textAlignment enumeration.
-      mHorizontalAlignment = StringHandler::TextAlignmentLeft;
-      index++;
-    } else if(annotationValue == "TextAlignment.Center") {
-      mHorizontalAlignment = StringHandler::TextAlignmentCenter;
-      index++;
-    } else if(annotationValue == "TextAlignment.Right") {
-      mHorizontalAlignment = StringHandler::TextAlignmentRight;
-      index++;
-    } else {
-      mFontName = annotationValue;
-      index++;
+  for (int index = 11 ; index < list.size() ; index++) {
+    OMCValue value = list.at(index);
+    // textStyle is an array of enumeration literals.
+    int count = value.isArray() ? value.size() : 1;
+    for (int i = 0 ; i < count ; i++) {
+      QString annotationValue = value.isArray() ? value.at(i).toString() : value.toString();
+      // check textStyles enumeration.
+      if(annotationValue == "TextStyle.Bold") {
+        mTextStyles.append(StringHandler::TextStyleBold);
+      } else if(annotationValue == "TextStyle.Italic") {
+        mTextStyles.append(StringHandler::TextStyleItalic);
+      } else if(annotationValue == "TextStyle.UnderLine") {
+        mTextStyles.append(StringHandler::TextStyleUnderLine);
+      } else if(annotationValue == "TextAlignment.Left") {
+        // check textAlignment enumeration.
+        mHorizontalAlignment = StringHandler::TextAlignmentLeft;
+      } else if(annotationValue == "TextAlignment.Center") {
+        mHorizontalAlignment = StringHandler::TextAlignmentCenter;
+      } else if(annotationValue == "TextAlignment.Right") {
+        mHorizontalAlignment = StringHandler::TextAlignmentRight;
+      } else {
+        mFontName = annotationValue;
+      }
     }
   }
 }
@@ -499,7 +502,7 @@ void TextAnnotation::updateTextString()
  */
 void TextAnnotation::duplicate()
 {
-  TextAnnotation *pTextAnnotation = new TextAnnotation("", mpGraphicsView);
+  TextAnnotation *pTextAnnotation = new TextAnnotation(OMCValue(), mpGraphicsView);
   pTextAnnotation->updateShape(this);
   QPointF gridStep(mpGraphicsView->mCoOrdinateSystem.getHorizontalGridStep() * 5,
                    mpGraphicsView->mCoOrdinateSystem.getVerticalGridStep() * 5);
@@ -45,7 +45,7 @@ class TextAnnotation : public ShapeAnnotation
   Q_OBJECT
 public:
   // Used for icon/diagram shape
-  TextAnnotation(QString annotation, GraphicsView *pGraphicsView);
+  TextAnnotation(const OMCValue &annotation, GraphicsView *pGraphicsView);
   // Used for shape inside a component
   TextAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent);
   // Used for icon/diagram inherited shape
@@ -53,6 +53,7 @@ public:
   // Used for default component
   TextAnnotation(Component *pParent);
   void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const OMCValue &list);
   QRectF boundingRect() const;
   QPainterPath shape() const;
   void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
@@ -72,6 +72,8 @@ ComponentInfo::ComponentInfo(QObject *pParent)
   mModifiersMap.clear();
   mParameterValueLoaded = false;
   mParameterValue = "";
+  mPlacementAnnotation = "";
+  mDialogAnnotation.clear();
   mStartCommand = "";
   mExactStep = false;
   mModelFile = "";
@@ -118,6 +120,8 @@ void ComponentInfo::updateComponentInfo(const ComponentInfo *pComponentInfo)
   mModifiersMap = pComponentInfo->getModifiersMapWithoutFetching();
   mParameterValueLoaded = pComponentInfo->isParameterValueLoaded();
   mParameterValue = pComponentInfo->getParameterValueWithoutFetching();
+  mPlacementAnnotation = pComponentInfo->getPlacementAnnotation();
+  mDialogAnnotation = pComponentInfo->getDialogAnnotation();
   mStartCommand = pComponentInfo->getStartCommand();
   mExactStep = pComponentInfo->getExactStep();
   mModelFile = pComponentInfo->getModelFile();
@@ -127,93 +131,84 @@ void ComponentInfo::updateComponentInfo(const ComponentInfo *pComponentInfo)
 
 /*!
  * \brief ComponentInfo::parseComponentInfoString
- * Parses the component info string.
+ * Parses the component info, one element of the getComponents result.
  * \param value
  */
-void ComponentInfo::parseComponentInfoString(QString value)
+void ComponentInfo::parseComponentInfoString(const OMCValue &value)
 {
-  if (value.isEmpty()) {
-    return;
-  }
-  QStringList list = StringHandler::unparseStrings(value);
   // read the class name
-  if (list.size() > 0) {
-    mClassName = list.at(0);
+  if (value.size() > 0) {
+    mClassName = value.at(0).toString();
   } else {
     return;
   }
   // read the name
-  if (list.size() > 1) {
-    mName = list.at(1);
+  if (value.size() > 1) {
+    mName = value.at(1).toString();
   } else {
     return;
   }
   // read the class comment
-  if (list.size() > 2) {
-    mComment = list.at(2);
+  if (value.size() > 2) {
+    mComment = value.at(2).toString();
   } else {
     return;
   }
   // read the class access
-  if (list.size() > 3) {
-    mIsProtected = StringHandler::removeFirstLastQuotes(list.at(3)).contains("protected");
+  if (value.size() > 3) {
+    mIsProtected = value.at(3).toString().contains("protected");
   } else {
     return;
   }
   // read the final attribute
-  if (list.size() > 4) {
-    mIsFinal = list.at(4).contains("true");
+  if (value.size() > 4) {
+    mIsFinal = value.at(4).toString().contains("true");
   } else {
     return;
   }
   // read the flow attribute
-  if (list.size() > 5) {
-    mIsFlow = list.at(5).contains("true");
+  if (value.size() > 5) {
+    mIsFlow = value.at(5).toString().contains("true");
   } else {
     return;
   }
   // read the stream attribute
-  if (list.size() > 6) {
-    mIsStream = list.at(6).contains("true");
+  if (value.size() > 6) {
+    mIsStream = value.at(6).toString().contains("true");
   } else {
     return;
   }
   // read the replaceable attribute
-  if (list.size() > 7) {
-    mIsReplaceable = list.at(7).contains("true");
+  if (value.size() > 7) {
+    mIsReplaceable = value.at(7).toString().contains("true");
   } else {
     return;
   }
   // read the variability attribute
-  if (list.size() > 8) {
-    QMap<QString, QString>::iterator variability_it;
-    for (variability_it = mVariabilityMap.begin(); variability_it != mVariabilityMap.end(); ++variability_it) {
-      if (variability_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(8))) == 0) {
-        mVariability = variability_it.value();
-        break;
-      }
+  if (value.size() > 8) {
+    QMap<QString, QString>::iterator variability_it = mVariabilityMap.find(value.at(8).toString());
+    if (variability_it != mVariabilityMap.end()) {
+      mVariability = variability_it.value();
     }
   }
   // read the inner attribute
-  if (list.size() > 9) {
-    mIsInner = list.at(9).contains("inner");
-    mIsOuter = list.at(9).contains("outer");
+  if (value.size() > 9) {
+    QString innerOuter = value.at(9).toString();
+    mIsInner = innerOuter.contains("inner");
+    mIsOuter = innerOuter.contains("outer");
   } else {
     return;
   }
   // read the casuality attribute
-  if (list.size() > 10) {
-    QMap<QString, QString>::iterator casuality_it;
-    for (casuality_it = mCasualityMap.begin(); casuality_it != mCasualityMap.end(); ++casuality_it) {
-      if (casuality_it.key().compare(StringHandler::removeFirstLastQuotes(list.at(10))) == 0) {
-        mCasuality = casuality_it.value();
-        break;
-      }
+  if (value.size() > 10) {
+    QMap<QString, QString>::iterator casuality_it = mCasualityMap.find(value.at(10).toString());
+    if (casuality_it != mCasualityMap.end()) {
+      mCasuality = casuality_it.value();
     }
   }
   // read the array index value
-  if (list.size() > 11) {
-    setArrayIndex(list.at(11));
+  if (value.size() > 11) {
+    setArrayIndex(value.at(11).toString());
   }
 }
 
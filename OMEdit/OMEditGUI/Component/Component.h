@@ -64,7 +64,7 @@ public:
   ComponentInfo(QObject *pParent = 0);
   ComponentInfo(ComponentInfo *pComponentInfo, QObject *pParent = 0);
   void updateComponentInfo(const ComponentInfo *pComponentInfo);
-  void parseComponentInfoString(QString value);
+  void parseComponentInfoString(const OMCValue &value);
   void fetchModifiers(OMCProxy *pOMCProxy, QString className);
   void fetchParameterValue(OMCProxy *pOMCProxy, QString className);
   void applyDefaultPrefixes(QString defaultPrefixes);
@@ -103,6 +103,10 @@ public:
   void setParameterValue(QString parameterValue) {mParameterValue = parameterValue;}
   QString getParameterValueWithoutFetching() const {return mParameterValue;}
   QString getParameterValue(OMCProxy *pOMCProxy, QString className);
+  void setPlacementAnnotation(QString placementAnnotation) {mPlacementAnnotation = placementAnnotation;}
+  QString getPlacementAnnotation() const {return mPlacementAnnotation;}
+  void setDialogAnnotation(QStringList dialogAnnotation) {mDialogAnnotation = dialogAnnotation;}
+  QStringList getDialogAnnotation() const {return mDialogAnnotation;}
   // MetaModel attributes
   void setStartCommand(QString startCommand) {mStartCommand = startCommand;}
   QString getStartCommand() const {return mStartCommand;}
@@ -138,6 +142,8 @@ private:
   QMap<QString, QString> mModifiersMap;
   bool mParameterValueLoaded;
   QString mParameterValue;
+  QString mPlacementAnnotation;
+  QStringList mDialogAnnotation;
   // MetaModel attributes
   QString mStartCommand;
   bool mExactStep;
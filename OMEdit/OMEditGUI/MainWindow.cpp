@@ -79,6 +79,7 @@ MainWindow::MainWindow(QSplashScreen *pSplashScreen, bool debug, QWidget *parent
   if (getExitApplicationStatus()) {
     return;
   }
+  connect(mpOMCProxy, SIGNAL(commandFinished(int,QString)), SLOT(omcJobFinished(int,QString)));
   pSplashScreen->showMessage(tr("Reading Settings"), Qt::AlignRight, Qt::white);
   mpOptionsDialog = new OptionsDialog(this);
   pSplashScreen->showMessage(tr("Loading Widgets"), Qt::AlignRight, Qt::white);
@@ -438,6 +439,8 @@ int MainWindow::askForExit()
  */
 void MainWindow::beforeClosingMainWindow()
 {
+  // save the system libraries cache before the LibraryTreeItems are destroyed.
+  mpLibraryWidget->getLibraryTreeModel()->saveLibraryTreeItemCache();
   mpOMCProxy->quitOMC();
   if (mpOutputFileDataNotifier) {
     mOutputFile.close();
@@ -619,28 +622,13 @@ void MainWindow::instantiateModel(LibraryTreeItem *pLibraryTreeItem)
       return;
     }
   }
-  // set the status message.
-  mpStatusBar->showMessage(QString(Helper::instantiateModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
-  // show the progress bar
-  mpProgressBar->setRange(0, 0);
-  showProgressBar();
   // check reset messages number before instantiating
   if (mpOptionsDialog->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
     mpMessagesWidget->resetMessagesNumber();
   }
-  QString instantiateModelResult = mpOMCProxy->instantiateModel(pLibraryTreeItem->getNameStructure());
-  if (!instantiateModelResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Instantiation of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
-                                                Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
-    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, instantiateModelResult, true, this);
-    pInformationDialog->show();
-  }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
+  int id = mpOMCProxy->instantiateModelAsync(pLibraryTreeItem->getNameStructure());
+  addOMCJob(id, InstantiateModelJob, pLibraryTreeItem->getNameStructure(),
+            QString(Helper::instantiateModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
 }
 
 void MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem)
@@ -651,28 +639,13 @@ void MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem)
       return;
     }
   }
-  // set the status message.
-  mpStatusBar->showMessage(QString(Helper::checkModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
-  // show the progress bar
-  mpProgressBar->setRange(0, 0);
-  showProgressBar();
   // check reset messages number before checking
   if (mpOptionsDialog->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
     mpMessagesWidget->resetMessagesNumber();
   }
-  QString checkModelResult = mpOMCProxy->checkModel(pLibraryTreeItem->getNameStructure());
-  if (!checkModelResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Check of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
-                                                Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::checkModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
-    InformationDialog *pInformationDialog = new InformationDialog(windowTitle, checkModelResult, false, this);
-    pInformationDialog->show();
-  }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
+  int id = mpOMCProxy->checkModelAsync(pLibraryTreeItem->getNameStructure());
+  addOMCJob(id, CheckModelJob, pLibraryTreeItem->getNameStructure(),
+            QString(Helper::checkModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
 }
 
 void MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem)
@@ -683,20 +656,96 @@ void MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem)
       return;
     }
   }
-  // set the status message.
-  mpStatusBar->showMessage(QString(Helper::checkModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
-  // show the progress bar
-  mpProgressBar->setRange(0, 0);
-  showProgressBar();
-  QString checkAllModelsResult = mpOMCProxy->checkAllModelsRecursive(pLibraryTreeItem->getNameStructure());
-  if (!checkAllModelsResult.isEmpty()) {
-    mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, checkAllModelsResult, Helper::scriptingKind,
-                                                Helper::notificationLevel));
+  int id = mpOMCProxy->checkAllModelsRecursiveAsync(pLibraryTreeItem->getNameStructure());
+  addOMCJob(id, CheckAllModelsJob, pLibraryTreeItem->getNameStructure(),
+            QString(Helper::checkModel).append(" ").append(pLibraryTreeItem->getNameStructure()));
+}
+
+/*!
+ * \brief MainWindow::addOMCJob
+ * Remembers a job queued with one of the asynchronous OMCProxy methods and shows the busy state until it is finished.
+ * \param id - the request id returned by OMCProxy.
+ * \param type
+ * \param className
+ * \param message - the status bar message.
+ * \sa MainWindow::omcJobFinished()
+ */
+void MainWindow::addOMCJob(int id, OMCJobType type, QString className, QString message)
+{
+  if (id < 0) {
+    return;
   }
-  // hide progress bar
-  hideProgressBar();
-  // clear the status bar message
-  mpStatusBar->clearMessage();
+  OMCJobInfo omcJobInfo;
+  omcJobInfo.mType = type;
+  omcJobInfo.mClassName = className;
+  omcJobInfo.mMessage = message;
+  mOMCJobs.insert(id, omcJobInfo);
+  updateOMCBusyState();
+}
+
+/*!
+ * \brief MainWindow::updateOMCBusyState
+ * Shows the progress bar and the status message of the oldest pending OMC job, or hides them if there is none.
+ */
+void MainWindow::updateOMCBusyState()
+{
+  if (mOMCJobs.isEmpty()) {
+    hideProgressBar();
+    mpStatusBar->clearMessage();
+  } else {
+    mpStatusBar->showMessage(mOMCJobs.constBegin().value().mMessage);
+    mpProgressBar->setRange(0, 0);
+    showProgressBar();
+  }
+}
+
+/*!
+ * \brief MainWindow::omcJobFinished
+ * Slot activated when OMCProxy::commandFinished signal is raised.\n
+ * Shows the result of the instantiate, check and load library jobs.
+ * \param id
+ * \param result
+ */
+void MainWindow::omcJobFinished(int id, QString result)
+{
+  if (!mOMCJobs.contains(id)) {
+    return;
+  }
+  OMCJobInfo omcJobInfo = mOMCJobs.take(id);
+  switch (omcJobInfo.mType) {
+    case InstantiateModelJob:
+      if (!result.isEmpty()) {
+        mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                    tr("Instantiation of %1 completed successfully.").arg(omcJobInfo.mClassName),
+                                                    Helper::scriptingKind, Helper::notificationLevel));
+        QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(omcJobInfo.mClassName);
+        InformationDialog *pInformationDialog = new InformationDialog(windowTitle, result, true, this);
+        pInformationDialog->show();
+      }
+      break;
+    case CheckModelJob:
+      if (!result.isEmpty()) {
+        mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                    tr("Check of %1 completed successfully.").arg(omcJobInfo.mClassName),
+                                                    Helper::scriptingKind, Helper::notificationLevel));
+        QString windowTitle = QString(Helper::checkModel).append(" - ").append(omcJobInfo.mClassName);
+        InformationDialog *pInformationDialog = new InformationDialog(windowTitle, result, false, this);
+        pInformationDialog->show();
+      }
+      break;
+    case CheckAllModelsJob:
+      if (!result.isEmpty()) {
+        mpMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, result, Helper::scriptingKind,
+                                                    Helper::notificationLevel));
+      }
+      break;
+    case LoadSystemLibraryJob:
+      if (result.compare("true") == 0) {
+        mpLibraryWidget->getLibraryTreeModel()->loadDependentLibraries(mpOMCProxy->getClassNames());
+      }
+      break;
+  }
+  updateOMCBusyState();
 }
 
 void MainWindow::exportModelFMU(LibraryTreeItem *pLibraryTreeItem)
@@ -991,6 +1040,24 @@ TransformationsWidget *MainWindow::showTransformationsWidget(QString fileName)
   return pTransformationsWidget;
 }
 
+/*!
+ * \brief MainWindow::addProfilingRun
+ * Keeps the profiling summary of a simulation run for the profiling report.
+ * A run is only added once even if its profiling data is read again.
+ * \param fileName - the model_info.json file of the simulation.
+ * \param profilingRun
+ */
+void MainWindow::addProfilingRun(QString fileName, const ProfilingRun &profilingRun)
+{
+  QList<ProfilingRun> &profilingRuns = mProfilingRunsHash[fileName];
+  foreach (const ProfilingRun &run, profilingRuns) {
+    if (run.mDateTime == profilingRun.mDateTime) {
+      return;
+    }
+  }
+  profilingRuns.append(profilingRun);
+}
+
 /*!
  * \brief MainWindow::findFileAndGoToLine
  * Finds the file and opens it at specified line number.
@@ -1309,19 +1376,22 @@ void MainWindow::loadSystemLibrary()
                                       .append(GUIMessages::getMessage(GUIMessages::DELETE_AND_LOAD).arg(pAction->text())));
       pMessageBox->setStandardButtons(QMessageBox::Ok);
       pMessageBox->exec();
-    } else {  /* if library is not loaded then load it. */
+    } else if (pAction->text().compare("OpenModelica") == 0) {  /* if library is not loaded then load it. */
       mpProgressBar->setRange(0, 0);
       showProgressBar();
       mpStatusBar->showMessage(QString(Helper::loading).append(": ").append(pAction->text()));
-
-      if (pAction->text().compare("OpenModelica") == 0) {
-        pLibraryTreeModel->createLibraryTreeItem(pAction->text(), pLibraryTreeModel->getRootLibraryTreeItem(), true, true, true);
-        pLibraryTreeModel->checkIfAnyNonExistingClassLoaded();
-      } else if (mpOMCProxy->loadModel(pAction->text())) {
-        mpLibraryWidget->getLibraryTreeModel()->loadDependentLibraries(mpOMCProxy->getClassNames());
+      pLibraryTreeModel->createLibraryTreeItem(pAction->text(), pLibraryTreeModel->getRootLibraryTreeItem(), true, true, true);
+      pLibraryTreeModel->checkIfAnyNonExistingClassLoaded();
+      updateOMCBusyState();
+    } else {
+      // the library is already being loaded.
+      foreach (OMCJobInfo omcJobInfo, mOMCJobs) {
+        if (omcJobInfo.mType == LoadSystemLibraryJob && omcJobInfo.mClassName.compare(pAction->text()) == 0) {
+          return;
+        }
       }
-      mpStatusBar->clearMessage();
-      hideProgressBar();
+      int id = mpOMCProxy->loadModelAsync(pAction->text());
+      addOMCJob(id, LoadSystemLibraryJob, pAction->text(), QString(Helper::loading).append(": ").append(pAction->text()));
     }
   }
 }
@@ -2656,6 +2726,10 @@ void MainWindow::createActions()
   mpReSimulateSetupAction = new QAction(QIcon(":/Resources/icons/re-simulation-center.svg"), Helper::reSimulateSetup, this);
   mpReSimulateSetupAction->setStatusTip(Helper::reSimulateSetupTip);
   connect(mpReSimulateSetupAction, SIGNAL(triggered()), mpVariablesWidget, SLOT(showReSimulateSetup()));
+  // parameter sweep action
+  mpParameterSweepAction = new QAction(QIcon(":/Resources/icons/simulation-parameters.svg"), Helper::parameterSweep, this);
+  mpParameterSweepAction->setStatusTip(Helper::parameterSweepTip);
+  connect(mpParameterSweepAction, SIGNAL(triggered()), mpVariablesWidget, SLOT(showParameterSweepSetup()));
   // new plot window action
   mpNewPlotWindowAction = new QAction(QIcon(":/Resources/icons/plot-window.svg"), tr("New Plot Window"), this);
   mpNewPlotWindowAction->setStatusTip(tr("Inserts new plot window"));
@@ -3214,6 +3288,7 @@ void MainWindow::createToolbars()
   // add actions to Plot Toolbar
   mpPlotToolBar->addAction(mpReSimulateModelAction);
   mpPlotToolBar->addAction(mpReSimulateSetupAction);
+  mpPlotToolBar->addAction(mpParameterSweepAction);
   mpPlotToolBar->addSeparator();
   mpPlotToolBar->addAction(mpNewPlotWindowAction);
   mpPlotToolBar->addAction(mpNewParametricPlotWindowAction);
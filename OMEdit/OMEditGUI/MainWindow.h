@@ -62,6 +62,7 @@
 #include "StringHandler.h"
 #include "MessagesWidget.h"
 #include "TransformationsWidget.h"
+#include "ProfilingReport.h"
 #include "LibraryTreeWidget.h"
 #include "DocumentationWidget.h"
 #include "SimulationDialog.h"
@@ -167,6 +168,7 @@ public:
   QAction* getConnectModeAction() {return mpConnectModeAction;}
   QAction* getReSimulateModelAction() {return mpReSimulateModelAction;}
   QAction* getReSimulateSetupAction() {return mpReSimulateSetupAction;}
+  QAction* getParameterSweepAction() {return mpParameterSweepAction;}
   QAction* getSimulationParamsAction() {return mpSimulationParamsAction;}
   QAction* getFetchInterfaceDataAction() {return mpFetchInterfaceDataAction;}
   QAction* getAlignInterfacesAction() {return mpAlignInterfacesAction;}
@@ -185,6 +187,7 @@ public:
   void instantiateModel(LibraryTreeItem *pLibraryTreeItem);
   void checkModel(LibraryTreeItem *pLibraryTreeItem);
   void checkAllModels(LibraryTreeItem *pLibraryTreeItem);
+  void updateOMCBusyState();
   void exportModelFMU(LibraryTreeItem *pLibraryTreeItem);
   void exportModelXML(LibraryTreeItem *pLibraryTreeItem);
   void exportModelFigaro(LibraryTreeItem *pLibraryTreeItem);
@@ -195,6 +198,8 @@ public:
   void createOMNotebookImageCell(LibraryTreeItem *pLibraryTreeItem, QDomDocument xmlDocument, QDomElement domElement, QString filePath);
   void createOMNotebookCodeCell(LibraryTreeItem *pLibraryTreeItem, QDomDocument xmlDocument, QDomElement domElement);
   TransformationsWidget* showTransformationsWidget(QString fileName);
+  void addProfilingRun(QString fileName, const ProfilingRun &profilingRun);
+  QList<ProfilingRun> getProfilingRuns(QString fileName) {return mProfilingRunsHash.value(fileName);}
   void findFileAndGoToLine(QString fileName, QString lineNumber);
   static void PlotCallbackFunction(void *p, int externalWindow, const char* filename, const char* title, const char* grid,
                                    const char* plotType, const char* logX, const char* logY, const char* xLabel, const char* yLabel,
@@ -245,6 +250,14 @@ private:
   QTabBar *mpPerspectiveTabbar;
   QStatusBar *mpStatusBar;
   QTimer *mpAutoSaveTimer;
+  enum OMCJobType {InstantiateModelJob, CheckModelJob, CheckAllModelsJob, LoadSystemLibraryJob};
+  typedef struct {
+    OMCJobType mType;
+    QString mClassName;
+    QString mMessage;
+  } OMCJobInfo;
+  // the pending OMCProxy asynchronous jobs started from the MainWindow.
+  QMap<int, OMCJobInfo> mOMCJobs;
   // File Menu
   // Modelica File Actions
   QAction *mpNewModelicaClassAction;
@@ -335,6 +348,7 @@ private:
   // Plot Toolbar Actions
   QAction *mpReSimulateModelAction;
   QAction *mpReSimulateSetupAction;
+  QAction *mpParameterSweepAction;
   QAction *mpNewPlotWindowAction;
   QAction *mpNewParametricPlotWindowAction;
   QAction *mpClearPlotWindowAction;
@@ -361,6 +375,7 @@ private:
   QToolBar *mpPlotToolBar;
   QToolBar *mpTLMSimulationToolbar;
   QHash<QString, TransformationsWidget*> mTransformationsWidgetHash;
+  QHash<QString, QList<ProfilingRun> > mProfilingRunsHash;
 public slots:
   void createNewModelicaClass();
   void openModelicaFile();
@@ -427,6 +442,7 @@ public slots:
   void toggleAutoSave();
   void readInterfaceData(LibraryTreeItem *pLibraryTreeItem);
 private slots:
+  void omcJobFinished(int id, QString result);
   void perspectiveTabChanged(int tabIndex);
   void documentationDockWidgetVisibilityChanged(bool visible);
   void autoSave();
@@ -449,6 +465,7 @@ private:
   void closeAllWindowsButThis(QMdiArea *pMdiArea);
   void tileSubWindows(QMdiArea *pMdiArea, bool horizontally);
   void fetchInterfaceDataHelper(LibraryTreeItem *pLibraryTreeItem);
+  void addOMCJob(int id, OMCJobType type, QString className, QString message);
 protected:
   virtual void dragEnterEvent(QDragEnterEvent *event);
   virtual void dragMoveEvent(QDragMoveEvent *event);
@@ -0,0 +1,397 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "LibraryTreeItemCache.h"
+#include "Helper.h"
+#include "StringHandler.h"
+#include "Utilities.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#define LIBRARYTREEITEMCACHE_MAGIC 0x4F4D4C43
+/* Increment whenever the layout of the cache file changes. */
+#define LIBRARYTREEITEMCACHE_VERSION 1
+
+static void writeClassInformation(QDataStream &out, const OMCInterface::getClassInformation_res &classInformation)
+{
+  out << classInformation.restriction << classInformation.comment << (bool)classInformation.partialPrefix
+      << classInformation.fileName << (bool)classInformation.fileReadOnly << (qint64)classInformation.lineNumberStart
+      << (qint64)classInformation.lineNumberEnd << (bool)classInformation.isProtectedClass
+      << (bool)classInformation.isDocumentationClass << classInformation.version << classInformation.preferredView;
+}
+
+static void readClassInformation(QDataStream &in, OMCInterface::getClassInformation_res *pClassInformation)
+{
+  bool partialPrefix, fileReadOnly, isProtectedClass, isDocumentationClass;
+  qint64 lineNumberStart, lineNumberEnd;
+  in >> pClassInformation->restriction >> pClassInformation->comment >> partialPrefix >> pClassInformation->fileName >> fileReadOnly
+     >> lineNumberStart >> lineNumberEnd >> isProtectedClass >> isDocumentationClass >> pClassInformation->version
+     >> pClassInformation->preferredView;
+  pClassInformation->partialPrefix = partialPrefix;
+  pClassInformation->fileReadOnly = fileReadOnly;
+  pClassInformation->lineNumberStart = lineNumberStart;
+  pClassInformation->lineNumberEnd = lineNumberEnd;
+  pClassInformation->isProtectedClass = isProtectedClass;
+  pClassInformation->isDocumentationClass = isDocumentationClass;
+}
+
+static bool isSameClassInformation(const OMCInterface::getClassInformation_res &classInformation1,
+                                   const OMCInterface::getClassInformation_res &classInformation2)
+{
+  return classInformation1.restriction == classInformation2.restriction && classInformation1.comment == classInformation2.comment
+      && classInformation1.partialPrefix == classInformation2.partialPrefix && classInformation1.fileName == classInformation2.fileName
+      && classInformation1.fileReadOnly == classInformation2.fileReadOnly
+      && classInformation1.lineNumberStart == classInformation2.lineNumberStart
+      && classInformation1.lineNumberEnd == classInformation2.lineNumberEnd
+      && classInformation1.isProtectedClass == classInformation2.isProtectedClass
+      && classInformation1.isDocumentationClass == classInformation2.isDocumentationClass
+      && classInformation1.version == classInformation2.version && classInformation1.preferredView == classInformation2.preferredView;
+}
+
+LibraryTreeItemCache::LibraryTreeItemCache()
+{
+
+}
+
+LibraryTreeItemCache::~LibraryTreeItemCache()
+{
+  qDeleteAll(mLibraries);
+}
+
+/*!
+ * \brief LibraryTreeItemCache::restore
+ * Reads the cache file of the top level library.
+ * If the file is missing or out of date then the library is marked for recording so that the next LibraryTreeItemCache::save() writes it.
+ * \param library - the top level library name.
+ * \param classInformation - the class information of the top level library.
+ * \param dependencies - the class information of the libraries it uses. The icons may inherit graphics from them.
+ * \param iconSize - the library icon size. The cached icons are only valid for the same size.
+ * \return true if the cache is valid and can be used instead of querying OMC.
+ */
+bool LibraryTreeItemCache::restore(const QString &library, const OMCInterface::getClassInformation_res &classInformation,
+                                   const QList<OMCInterface::getClassInformation_res> &dependencies, int iconSize)
+{
+  remove(library);
+  QString key = libraryKey(library, classInformation, dependencies, iconSize);
+  if (key.isEmpty()) {
+    return false;
+  }
+  LibraryCache *pLibraryCache = new LibraryCache;
+  pLibraryCache->mKey = key;
+  mLibraries.insert(library, pLibraryCache);
+  if (readLibraryCache(cacheFileName(library), pLibraryCache)) {
+    pLibraryCache->mRestored = true;
+  } else {
+    pLibraryCache->mClassNames.clear();
+    pLibraryCache->mClassInformation.clear();
+    pLibraryCache->mPixmaps.clear();
+    pLibraryCache->mDragPixmaps.clear();
+    pLibraryCache->mModified = true;
+  }
+  return pLibraryCache->mRestored;
+}
+
+/*!
+ * \brief LibraryTreeItemCache::remove
+ * Stops caching the library.
+ * \param library
+ */
+void LibraryTreeItemCache::remove(const QString &library)
+{
+  delete mLibraries.take(library);
+}
+
+/*!
+ * \brief LibraryTreeItemCache::save
+ * Writes the modified libraries to the disk.
+ */
+void LibraryTreeItemCache::save()
+{
+  QHashIterator<QString, LibraryCache*> libraries(mLibraries);
+  while (libraries.hasNext()) {
+    libraries.next();
+    LibraryCache *pLibraryCache = libraries.value();
+    if (pLibraryCache->mModified && writeLibraryCache(cacheFileName(libraries.key()), pLibraryCache)) {
+      pLibraryCache->mModified = false;
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeItemCache::getClassNames
+ * Returns the cached recursive class names of the class.
+ * \param className
+ * \param pClassNames
+ * \return true if found in the cache.
+ */
+bool LibraryTreeItemCache::getClassNames(const QString &className, QStringList *pClassNames) const
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache && pLibraryCache->mRestored && pLibraryCache->mClassNames.contains(className)) {
+    *pClassNames = pLibraryCache->mClassNames.value(className);
+    return true;
+  }
+  return false;
+}
+
+void LibraryTreeItemCache::setClassNames(const QString &className, const QStringList &classNames)
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache) {
+    QHash<QString, QStringList>::iterator it = pLibraryCache->mClassNames.find(className);
+    if (it != pLibraryCache->mClassNames.end() && it.value() == classNames) {
+      return;
+    }
+    pLibraryCache->mClassNames.insert(className, classNames);
+    pLibraryCache->mModified = true;
+  }
+}
+
+/*!
+ * \brief LibraryTreeItemCache::getClassInformation
+ * Returns the cached class information.
+ * \param className
+ * \param pClassInformation
+ * \return true if found in the cache.
+ */
+bool LibraryTreeItemCache::getClassInformation(const QString &className, OMCInterface::getClassInformation_res *pClassInformation) const
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache && pLibraryCache->mRestored) {
+    QHash<QString, OMCInterface::getClassInformation_res>::const_iterator it = pLibraryCache->mClassInformation.constFind(className);
+    if (it != pLibraryCache->mClassInformation.constEnd()) {
+      *pClassInformation = it.value();
+      return true;
+    }
+  }
+  return false;
+}
+
+void LibraryTreeItemCache::setClassInformation(const QString &className, const OMCInterface::getClassInformation_res &classInformation)
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache) {
+    // only mark the cache as modified if the class information has changed, otherwise every start would rewrite the file.
+    QHash<QString, OMCInterface::getClassInformation_res>::iterator it = pLibraryCache->mClassInformation.find(className);
+    if (it != pLibraryCache->mClassInformation.end() && isSameClassInformation(it.value(), classInformation)) {
+      return;
+    }
+    pLibraryCache->mClassInformation.insert(className, classInformation);
+    pLibraryCache->mModified = true;
+  }
+}
+
+/*!
+ * \brief LibraryTreeItemCache::getPixmaps
+ * Returns the cached library and drag pixmaps.
+ * \param className
+ * \param pPixmap
+ * \param pDragPixmap
+ * \return true if found in the cache.
+ */
+bool LibraryTreeItemCache::getPixmaps(const QString &className, QPixmap *pPixmap, QPixmap *pDragPixmap) const
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache && pLibraryCache->mPixmaps.contains(className)) {
+    *pPixmap = pLibraryCache->mPixmaps.value(className);
+    *pDragPixmap = pLibraryCache->mDragPixmaps.value(className);
+    return true;
+  }
+  return false;
+}
+
+void LibraryTreeItemCache::setPixmaps(const QString &className, const QPixmap &pixmap, const QPixmap &dragPixmap)
+{
+  LibraryCache *pLibraryCache = libraryCache(className);
+  if (pLibraryCache) {
+    pLibraryCache->mPixmaps.insert(className, pixmap);
+    pLibraryCache->mDragPixmaps.insert(className, dragPixmap);
+    pLibraryCache->mModified = true;
+  }
+}
+
+/*!
+ * \brief LibraryTreeItemCache::cacheDirectory
+ * Returns the directory of the cache files. The directory is next to the settings file so it survives restarts.
+ * \return
+ */
+QString LibraryTreeItemCache::cacheDirectory()
+{
+  QString directory = QFileInfo(Utilities::getApplicationSettings()->fileName()).absolutePath() + "/LibraryCache";
+  if (!QDir().exists(directory)) {
+    QDir().mkpath(directory);
+  }
+  return directory;
+}
+
+QString LibraryTreeItemCache::cacheFileName(const QString &library)
+{
+  return QString("%1/%2.cache").arg(cacheDirectory(), QString(library).remove('\''));
+}
+
+/*!
+ * \brief LibraryTreeItemCache::libraryKey
+ * Computes the key that identifies the state of the library and the libraries it uses on the disk.
+ * \param library
+ * \param classInformation
+ * \param dependencies
+ * \param iconSize
+ * \return the key or an empty string if the library is not backed by a file.
+ */
+QString LibraryTreeItemCache::libraryKey(const QString &library, const OMCInterface::getClassInformation_res &classInformation,
+                                         const QList<OMCInterface::getClassInformation_res> &dependencies, int iconSize)
+{
+  QString fileKey = libraryFileKey(classInformation.fileName);
+  if (fileKey.isEmpty()) {
+    return "";
+  }
+  QStringList key;
+  key << Helper::OpenModelicaVersion << library << classInformation.version << fileKey;
+  foreach (OMCInterface::getClassInformation_res dependency, dependencies) {
+    key << dependency.version << libraryFileKey(dependency.fileName);
+  }
+  key << QString::number(iconSize);
+  return key.join("|");
+}
+
+/*!
+ * \brief LibraryTreeItemCache::libraryFileKey
+ * Computes the state of the library file on the disk.
+ * For package directories all the Modelica files are visited so that editing any of them invalidates the cache.
+ * \param fileName
+ * \return the key or an empty string if the file doesn't exist.
+ */
+QString LibraryTreeItemCache::libraryFileKey(const QString &fileName)
+{
+  QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists()) {
+    return "";
+  }
+  qint64 filesCount = 0;
+  qint64 filesSize = 0;
+  uint lastModified = 0;
+  if (fileInfo.fileName().compare("package.mo") == 0) {
+    QDirIterator files(fileInfo.absolutePath(), QStringList() << "*.mo" << "package.order", QDir::Files, QDirIterator::Subdirectories);
+    while (files.hasNext()) {
+      files.next();
+      QFileInfo file = files.fileInfo();
+      filesCount++;
+      filesSize += file.size();
+      lastModified = qMax(lastModified, file.lastModified().toTime_t());
+    }
+  } else {
+    filesCount = 1;
+    filesSize = fileInfo.size();
+    lastModified = fileInfo.lastModified().toTime_t();
+  }
+  QStringList key;
+  key << fileInfo.absoluteFilePath() << QString::number(filesCount) << QString::number(filesSize) << QString::number(lastModified);
+  return key.join("|");
+}
+
+/*!
+ * \brief LibraryTreeItemCache::libraryCache
+ * Returns the cache of the top level library containing the class.
+ * \param className
+ * \return
+ */
+LibraryTreeItemCache::LibraryCache* LibraryTreeItemCache::libraryCache(const QString &className) const
+{
+  return mLibraries.value(StringHandler::getFirstWordBeforeDot(className), 0);
+}
+
+bool LibraryTreeItemCache::readLibraryCache(const QString &fileName, LibraryCache *pLibraryCache)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_4_6);
+  quint32 magic;
+  qint32 version;
+  QString key;
+  in >> magic >> version;
+  if (magic != LIBRARYTREEITEMCACHE_MAGIC || version != LIBRARYTREEITEMCACHE_VERSION) {
+    return false;
+  }
+  in >> key;
+  if (key.compare(pLibraryCache->mKey) != 0) {
+    return false;
+  }
+  qint32 count;
+  in >> pLibraryCache->mClassNames >> count;
+  for (qint32 i = 0 ; i < count && in.status() == QDataStream::Ok ; i++) {
+    QString className;
+    OMCInterface::getClassInformation_res classInformation;
+    in >> className;
+    readClassInformation(in, &classInformation);
+    pLibraryCache->mClassInformation.insert(className, classInformation);
+  }
+  in >> pLibraryCache->mPixmaps >> pLibraryCache->mDragPixmaps;
+  return in.status() == QDataStream::Ok;
+}
+
+bool LibraryTreeItemCache::writeLibraryCache(const QString &fileName, LibraryCache *pLibraryCache)
+{
+  // write to a temporary file first so that a crash never leaves a truncated cache file behind.
+  QString temporaryFileName = fileName + ".tmp";
+  QFile file(temporaryFileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << (quint32)LIBRARYTREEITEMCACHE_MAGIC << (qint32)LIBRARYTREEITEMCACHE_VERSION << pLibraryCache->mKey << pLibraryCache->mClassNames;
+  out << (qint32)pLibraryCache->mClassInformation.size();
+  QHashIterator<QString, OMCInterface::getClassInformation_res> classInformation(pLibraryCache->mClassInformation);
+  while (classInformation.hasNext()) {
+    classInformation.next();
+    out << classInformation.key();
+    writeClassInformation(out, classInformation.value());
+  }
+  out << pLibraryCache->mPixmaps << pLibraryCache->mDragPixmaps;
+  file.close();
+  if (out.status() != QDataStream::Ok) {
+    QFile::remove(temporaryFileName);
+    return false;
+  }
+  QFile::remove(fileName);
+  return QFile::rename(temporaryFileName, fileName);
+}
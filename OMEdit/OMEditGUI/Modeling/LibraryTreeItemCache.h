@@ -0,0 +1,92 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef LIBRARYTREEITEMCACHE_H
+#define LIBRARYTREEITEMCACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QStringList>
+
+#include "OpenModelicaScriptingAPIQt.h"
+
+/*!
+ * \class LibraryTreeItemCache
+ * \brief Persistent on-disk cache of the system libraries class information and icons.
+ * Each top level system library is stored in its own file. The file is only used when its key matches the library i.e.,
+ * same OpenModelica version, library version, library path, file modification times and library icon size.
+ * The versions and file modification times of the libraries it uses are part of the key as well since the icons
+ * may inherit their graphics from them.
+ * Only the data stored in the file is used, the library itself is still loaded in OMC.
+ */
+class LibraryTreeItemCache
+{
+public:
+  LibraryTreeItemCache();
+  ~LibraryTreeItemCache();
+  bool restore(const QString &library, const OMCInterface::getClassInformation_res &classInformation,
+               const QList<OMCInterface::getClassInformation_res> &dependencies, int iconSize);
+  void remove(const QString &library);
+  void save();
+  bool getClassNames(const QString &className, QStringList *pClassNames) const;
+  void setClassNames(const QString &className, const QStringList &classNames);
+  bool getClassInformation(const QString &className, OMCInterface::getClassInformation_res *pClassInformation) const;
+  void setClassInformation(const QString &className, const OMCInterface::getClassInformation_res &classInformation);
+  bool getPixmaps(const QString &className, QPixmap *pPixmap, QPixmap *pDragPixmap) const;
+  void setPixmaps(const QString &className, const QPixmap &pixmap, const QPixmap &dragPixmap);
+  static QString libraryFileKey(const QString &fileName);
+private:
+  class LibraryCache
+  {
+  public:
+    LibraryCache() : mRestored(false), mModified(false) {}
+    QString mKey;
+    bool mRestored;
+    bool mModified;
+    QHash<QString, QStringList> mClassNames;
+    QHash<QString, OMCInterface::getClassInformation_res> mClassInformation;
+    QHash<QString, QPixmap> mPixmaps;
+    QHash<QString, QPixmap> mDragPixmaps;
+  };
+  QHash<QString, LibraryCache*> mLibraries;
+  static QString cacheDirectory();
+  static QString cacheFileName(const QString &library);
+  static QString libraryKey(const QString &library, const OMCInterface::getClassInformation_res &classInformation,
+                            const QList<OMCInterface::getClassInformation_res> &dependencies, int iconSize);
+  LibraryCache* libraryCache(const QString &className) const;
+  bool readLibraryCache(const QString &fileName, LibraryCache *pLibraryCache);
+  bool writeLibraryCache(const QString &fileName, LibraryCache *pLibraryCache);
+};
+
+#endif // LIBRARYTREEITEMCACHE_H
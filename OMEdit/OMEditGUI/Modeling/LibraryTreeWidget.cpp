@@ -963,6 +963,13 @@ LibraryTreeModel::LibraryTreeModel(LibraryWidget *pLibraryWidget)
 {
   mpLibraryWidget = pLibraryWidget;
   mpRootLibraryTreeItem = new LibraryTreeItem;
+  addLibraryTreeItemToHash(mpRootLibraryTreeItem);
+  mLoadPixmapsTimer.setSingleShot(true);
+  mLoadPixmapsTimer.setInterval(0);
+  connect(&mLoadPixmapsTimer, SIGNAL(timeout()), SLOT(loadPendingLibraryTreeItemPixmaps()));
+  connect(mpLibraryWidget->getMainWindow()->getOMCProxy(),
+          SIGNAL(classesInformationFinished(int,QStringList,QList<OMCInterface::getClassInformation_res>)),
+          SLOT(classesInformationFinished(int,QStringList,QList<OMCInterface::getClassInformation_res>)));
 }
 
 /*!
@@ -1098,17 +1105,155 @@ Qt::ItemFlags LibraryTreeModel::flags(const QModelIndex &index) const
   }
 }
 
+/*!
+ * \brief LibraryTreeModel::hasChildren
+ * Returns true if parent has children or if its children are not fetched yet.
+ * \param parent
+ * \return
+ */
+bool LibraryTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  if (parent.column() > 0) {
+    return false;
+  }
+  LibraryTreeItem *pParentLibraryTreeItem = parent.isValid() ? static_cast<LibraryTreeItem*>(parent.internalPointer()) : mpRootLibraryTreeItem;
+  return pParentLibraryTreeItem->childrenSize() > 0 || canFetchMore(parent);
+}
+
+/*!
+ * \brief LibraryTreeModel::canFetchMore
+ * Returns true if the children of parent are not created yet.
+ * \param parent
+ * \return
+ * \sa LibraryTreeModel::fetchMore()
+ */
+bool LibraryTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  LibraryTreeItem *pParentLibraryTreeItem = parent.isValid() ? static_cast<LibraryTreeItem*>(parent.internalPointer()) : mpRootLibraryTreeItem;
+  return pParentLibraryTreeItem->getLibraryType() == LibraryTreeItem::Modelica &&
+      mPendingClassNames.contains(pParentLibraryTreeItem->getNameStructure());
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchMore
+ * Creates the children of parent. Called by the view when parent is expanded or scrolled into view.\n
+ * The class information of the children that is not cached is read with one OMCProxy::getClassesInformationAsync() request,
+ * the children are created once it is finished, see LibraryTreeModel::classesInformationFinished().
+ * \param parent
+ */
+void LibraryTreeModel::fetchMore(const QModelIndex &parent)
+{
+  LibraryTreeItem *pParentLibraryTreeItem = parent.isValid() ? static_cast<LibraryTreeItem*>(parent.internalPointer()) : mpRootLibraryTreeItem;
+  QString nameStructure = pParentLibraryTreeItem->getNameStructure();
+  // the view calls fetchMore again while the children are being fetched.
+  if (mFetchingClassNames.key(nameStructure, -1) != -1) {
+    return;
+  }
+  QStringList classNames;
+  foreach (QString name, mPendingClassNames.value(nameStructure)) {
+    QString childNameStructure = nameStructure + "." + name;
+    OMCInterface::getClassInformation_res classInformation;
+    if (!mLibraryTreeItemsHash.contains(childNameStructure) && !findNonExistingLibraryTreeItem(childNameStructure)
+        && !mLibraryTreeItemCache.getClassInformation(childNameStructure, &classInformation)) {
+      classNames << childNameStructure;
+    }
+  }
+  if (classNames.isEmpty()) {
+    fetchLibraryTreeItems(pParentLibraryTreeItem);
+    return;
+  }
+  if (mFetchingClassNames.isEmpty()) {
+    QApplication::setOverrideCursor(Qt::BusyCursor);
+  }
+  int id = mpLibraryWidget->getMainWindow()->getOMCProxy()->getClassesInformationAsync(classNames);
+  mFetchingClassNames.insert(id, nameStructure);
+}
+
+/*!
+ * \brief LibraryTreeModel::classesInformationFinished
+ * Slot activated when OMCProxy::classesInformationFinished signal is raised.\n
+ * Creates the children of the class that requested the class information.
+ * Nothing is created if the children are already created or the class is unloaded in the meantime.
+ * \param id
+ * \param classNames
+ * \param classesInformation
+ */
+void LibraryTreeModel::classesInformationFinished(int id, QStringList classNames,
+                                                  QList<OMCInterface::getClassInformation_res> classesInformation)
+{
+  if (!mFetchingClassNames.contains(id)) {
+    return;
+  }
+  QString nameStructure = mFetchingClassNames.take(id);
+  if (mFetchingClassNames.isEmpty()) {
+    QApplication::restoreOverrideCursor();
+  }
+  LibraryTreeItem *pLibraryTreeItem = mLibraryTreeItemsHash.value(nameStructure, 0);
+  if (!pLibraryTreeItem || !mPendingClassNames.contains(nameStructure)) {
+    return;
+  }
+  for (int i = 0 ; i < classNames.size() && i < classesInformation.size() ; i++) {
+    mFetchedClassInformation.insert(classNames.at(i), classesInformation.at(i));
+  }
+  fetchLibraryTreeItems(pLibraryTreeItem);
+  foreach (QString className, classNames) {
+    mFetchedClassInformation.remove(className);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchLibraryTreeItems
+ * Creates the pending children of LibraryTreeItem.
+ * \param pLibraryTreeItem
+ * \param recursive - if true then the whole subtree is created.
+ */
+void LibraryTreeModel::fetchLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem, bool recursive)
+{
+  QStringList classNames = mPendingClassNames.take(pLibraryTreeItem->getNameStructure());
+  if (!classNames.isEmpty()) {
+    QModelIndex index = libraryTreeItemIndex(pLibraryTreeItem);
+    foreach (QString name, classNames) {
+      QString nameStructure = pLibraryTreeItem->getNameStructure() + "." + name;
+      // the class might already be created e.g., if it is added by the user before its parent is expanded.
+      if (mLibraryTreeItemsHash.contains(nameStructure)) {
+        continue;
+      }
+      // non-existing LibraryTreeItem is inserted in the model by createNonExistingLibraryTreeItem()
+      LibraryTreeItem *pNonExistingLibraryTreeItem = findNonExistingLibraryTreeItem(nameStructure);
+      if (pNonExistingLibraryTreeItem && pNonExistingLibraryTreeItem->isNonExisting()) {
+        createLibraryTreeItemImpl(name, pLibraryTreeItem, pLibraryTreeItem->isSaved(), false, false);
+      } else {
+        int row = pLibraryTreeItem->childrenSize();
+        beginInsertRows(index, row, row);
+        createLibraryTreeItemImpl(name, pLibraryTreeItem, pLibraryTreeItem->isSaved(), false, false, row);
+        endInsertRows();
+      }
+    }
+  }
+  if (recursive) {
+    for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+      fetchLibraryTreeItems(pLibraryTreeItem->child(i), true);
+    }
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
  * Finds the LibraryTreeItem based on the name and case sensitivity.
+ * A case sensitive search of the whole tree is a lookup in mLibraryTreeItemsHash.
  * \param name
  * \param pLibraryTreeItem
  * \return
  */
 LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, LibraryTreeItem *pLibraryTreeItem,
-                                                       Qt::CaseSensitivity caseSensitivity) const
+                                                       Qt::CaseSensitivity caseSensitivity)
 {
   if (!pLibraryTreeItem) {
+    // create the not yet fetched parents of the class so that it is found.
+    fetchLibraryTreeItemPath(name, caseSensitivity);
+    if (caseSensitivity == Qt::CaseSensitive) {
+      return mLibraryTreeItemsHash.value(name, 0);
+    }
     pLibraryTreeItem = mpRootLibraryTreeItem;
   }
   if (pLibraryTreeItem->getNameStructure().compare(name, caseSensitivity) == 0) {
@@ -1175,6 +1320,9 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItemOneLevel(const QString &na
  */
 LibraryTreeItem* LibraryTreeModel::findNonExistingLibraryTreeItem(const QString &name, Qt::CaseSensitivity caseSensitivity) const
 {
+  if (caseSensitivity == Qt::CaseSensitive) {
+    return mNonExistingLibraryTreeItemsHash.value(name, 0);
+  }
   foreach (LibraryTreeItem *pLibraryTreeItem, mNonExistingLibraryTreeItemsList) {
     if (pLibraryTreeItem->getNameStructure().compare(name, caseSensitivity) == 0) {
       return pLibraryTreeItem;
@@ -1214,6 +1362,8 @@ void LibraryTreeModel::addModelicaLibraries(QSplashScreen *pSplashScreen)
     createLibraryTreeItem(lib, mpRootLibraryTreeItem, true, true, true);
     checkIfAnyNonExistingClassLoaded();
   }
+  // write the system libraries cache now so that a crash later on doesn't lose it.
+  mLibraryTreeItemCache.save();
   // load Modelica User Libraries.
   pOMCProxy->loadUserLibraries();
   QStringList userLibs = pOMCProxy->getClassNames();
@@ -1347,6 +1497,8 @@ void LibraryTreeModel::checkIfAnyNonExistingClassLoaded()
   int i = 0;
   while(i < mNonExistingLibraryTreeItemsList.size()) {
     LibraryTreeItem *pLibraryTreeItem = mNonExistingLibraryTreeItemsList.at(i);
+    // the class might be in a part of the tree that is not fetched yet.
+    fetchLibraryTreeItemPath(pLibraryTreeItem->getNameStructure(), Qt::CaseSensitive);
     if (!pLibraryTreeItem->isNonExisting()) {
       removeNonExistingLibraryTreeItem(pLibraryTreeItem);
       loadNonExistingLibraryTreeItem(pLibraryTreeItem);
@@ -1357,6 +1509,48 @@ void LibraryTreeModel::checkIfAnyNonExistingClassLoaded()
   }
 }
 
+/*!
+ * \brief LibraryTreeModel::addNonExistingLibraryTreeItem
+ * Adds the LibraryTreeItem to the list of non-existing classes.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::addNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
+{
+  mNonExistingLibraryTreeItemsList.append(pLibraryTreeItem);
+  mNonExistingLibraryTreeItemsHash.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+}
+
+/*!
+ * \brief LibraryTreeModel::removeNonExistingLibraryTreeItem
+ * Removes the LibraryTreeItem from the list of non-existing classes.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::removeNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
+{
+  mNonExistingLibraryTreeItemsList.removeOne(pLibraryTreeItem);
+  if (mNonExistingLibraryTreeItemsHash.value(pLibraryTreeItem->getNameStructure(), 0) == pLibraryTreeItem) {
+    mNonExistingLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure());
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemNameStructure
+ * Sets the name structure of the LibraryTreeItem and updates the name lookup hash.
+ * \param pLibraryTreeItem
+ * \param nameStructure
+ */
+void LibraryTreeModel::updateLibraryTreeItemNameStructure(LibraryTreeItem *pLibraryTreeItem, QString nameStructure)
+{
+  bool indexed = mLibraryTreeItemsHash.value(pLibraryTreeItem->getNameStructure(), 0) == pLibraryTreeItem;
+  if (indexed) {
+    removeLibraryTreeItemFromHash(pLibraryTreeItem);
+  }
+  pLibraryTreeItem->setNameStructure(nameStructure);
+  if (indexed) {
+    addLibraryTreeItemToHash(pLibraryTreeItem);
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::updateLibraryTreeItem
  * Triggers a view update for the LibraryTreeItem in the Libraries Browser.
@@ -1548,6 +1742,37 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
     pLibraryTreeItem->setPixmap(QPixmap());
     pLibraryTreeItem->setDragPixmap(QPixmap());
   }
+  mLibraryTreeItemCache.setPixmaps(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem->getPixmap(), pLibraryTreeItem->getDragPixmap());
+}
+
+/*!
+ * \brief LibraryTreeModel::loadCachedLibraryTreeItemPixmap
+ * Loads the pixmap for LibraryTreeItem from the LibraryTreeItemCache.
+ * Renders the pixmap using LibraryTreeModel::loadLibraryTreeItemPixmap() if it is not cached.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::loadCachedLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem)
+{
+  QPixmap pixmap, dragPixmap;
+  if (mLibraryTreeItemCache.getPixmaps(pLibraryTreeItem->getNameStructure(), &pixmap, &dragPixmap)) {
+    pLibraryTreeItem->setPixmap(pixmap);
+    pLibraryTreeItem->setDragPixmap(dragPixmap);
+  } else {
+    loadLibraryTreeItemPixmap(pLibraryTreeItem);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::loadLibraryTreeItemPixmapLater
+ * Queues the LibraryTreeItem for LibraryTreeModel::loadPendingLibraryTreeItemPixmaps().
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::loadLibraryTreeItemPixmapLater(LibraryTreeItem *pLibraryTreeItem)
+{
+  mPendingPixmapLibraryTreeItems.enqueue(pLibraryTreeItem);
+  if (!mLoadPixmapsTimer.isActive()) {
+    mLoadPixmapsTimer.start();
+  }
 }
 
 /*!
@@ -1806,7 +2031,10 @@ bool LibraryTreeModel::unloadLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem,
     row = pLibraryTreeItem->row();
     beginRemoveRows(libraryTreeItemIndex(pLibraryTreeItem), row, row);
     pLibraryTreeItem->parent()->removeChild(pLibraryTreeItem);
+    removeLibraryTreeItemFromHash(pLibraryTreeItem);
     endRemoveRows();
+    // remove the not yet fetched nested classes as well, otherwise a later class with the same name would get them.
+    removePendingClassNames(pLibraryTreeItem->getNameStructure());
     if (pNextLibraryTreeItem) {
       QModelIndex modelIndex = libraryTreeItemIndex(pNextLibraryTreeItem);
       QModelIndex proxyIndex = mpLibraryWidget->getLibraryTreeProxyModel()->mapFromSource(modelIndex);
@@ -2083,6 +2311,17 @@ QModelIndex LibraryTreeModel::libraryTreeItemIndexHelper(const LibraryTreeItem *
 LibraryTreeItem* LibraryTreeModel::getLibraryTreeItemFromFileHelper(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber)
 {
   LibraryTreeItem *pFoundLibraryTreeItem = 0;
+  /* The nested classes are either in the file of the class or, for a package directory, in its directory.
+   * Only fetch the pending nested classes of such a class, so the search doesn't create the whole library.
+   */
+  if (pLibraryTreeItem != mpRootLibraryTreeItem) {
+    QFileInfo fileInfo(pLibraryTreeItem->getFileName());
+    if (pLibraryTreeItem->getFileName().compare(fileName) != 0
+        && !(fileInfo.fileName().compare("package.mo") == 0 && fileName.startsWith(fileInfo.absolutePath() + "/"))) {
+      return 0;
+    }
+    fetchLibraryTreeItems(pLibraryTreeItem);
+  }
   for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
     LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
     if ((pChildLibraryTreeItem->getFileName().compare(fileName) == 0) && pChildLibraryTreeItem->inRange(lineNumber)) {
@@ -2175,19 +2414,72 @@ QString LibraryTreeModel::readLibraryTreeItemClassTextFromFile(LibraryTreeItem *
   return contents;
 }
 
+/*!
+ * \brief LibraryTreeModel::getLibraryTreeItemClassInformation
+ * Returns the class information from the LibraryTreeItemCache or from OMC if it is not cached.
+ * \param nameStructure
+ * \return
+ */
+OMCInterface::getClassInformation_res LibraryTreeModel::getLibraryTreeItemClassInformation(QString nameStructure)
+{
+  OMCInterface::getClassInformation_res classInformation;
+  if (!mLibraryTreeItemCache.getClassInformation(nameStructure, &classInformation)) {
+    if (mFetchedClassInformation.contains(nameStructure)) {
+      classInformation = mFetchedClassInformation.value(nameStructure);
+    } else {
+      classInformation = mpLibraryWidget->getMainWindow()->getOMCProxy()->getClassInformation(nameStructure);
+    }
+    mLibraryTreeItemCache.setClassInformation(nameStructure, classInformation);
+  }
+  return classInformation;
+}
+
+/*!
+ * \brief LibraryTreeModel::getLibraryDependenciesClassInformation
+ * Returns the class information of the libraries used by the library, directly or through another used library.
+ * \param library
+ * \return
+ */
+QList<OMCInterface::getClassInformation_res> LibraryTreeModel::getLibraryDependenciesClassInformation(QString library)
+{
+  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+  QList<OMCInterface::getClassInformation_res> dependencies;
+  QStringList visitedLibraries;
+  visitedLibraries << library;
+  QStringList libraries;
+  libraries << library;
+  while (!libraries.isEmpty()) {
+    foreach (QList<QString> uses, pOMCProxy->getUses(libraries.takeFirst())) {
+      if (uses.isEmpty() || visitedLibraries.contains(uses.at(0))) {
+        continue;
+      }
+      visitedLibraries << uses.at(0);
+      libraries << uses.at(0);
+      dependencies << pOMCProxy->getClassInformation(uses.at(0));
+    }
+  }
+  return dependencies;
+}
+
 /*!
  * \brief LibraryTreeModel::createLibraryTreeItems
  * Creates all the nested Library items.
+ * The class names of the system libraries are read from the LibraryTreeItemCache when possible.
  * \param pLibraryTreeItem
  */
 void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
 {
-  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
-  QStringList libs = pOMCProxy->getClassNames(pLibraryTreeItem->getNameStructure(), true, true);
+  QStringList libs;
+  if (!mLibraryTreeItemCache.getClassNames(pLibraryTreeItem->getNameStructure(), &libs)) {
+    OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+    libs = pOMCProxy->getClassNames(pLibraryTreeItem->getNameStructure(), true, true);
+    mLibraryTreeItemCache.setClassNames(pLibraryTreeItem->getNameStructure(), libs);
+  }
   if (!libs.isEmpty()) {
     libs.removeFirst();
   }
-  LibraryTreeItem *pParentLibraryTreeItem = 0;
+  // forget the class names of a previously loaded class with the same name.
+  removePendingClassNames(pLibraryTreeItem->getNameStructure());
   foreach (QString lib, libs) {
     /* $Code is a special OpenModelica keyword. No API command will work if we use it. */
     if (lib.contains("$Code")) {
@@ -2195,11 +2487,79 @@ void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
     }
     QString name = StringHandler::getLastWordAfterDot(lib);
     QString parentName = StringHandler::removeLastWordAfterDot(lib);
-    if (!(pParentLibraryTreeItem && pParentLibraryTreeItem->getNameStructure().compare(parentName) == 0)) {
-      pParentLibraryTreeItem = findLibraryTreeItem(parentName, pLibraryTreeItem);
+    mPendingClassNames[parentName].append(name);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchLibraryTreeItemPath
+ * Fetches the children of all the parents of the class.
+ * \param name
+ * \param caseSensitivity
+ */
+void LibraryTreeModel::fetchLibraryTreeItemPath(const QString &name, Qt::CaseSensitivity caseSensitivity)
+{
+  if (mPendingClassNames.isEmpty()) {
+    return;
+  }
+  QStringList parentNames;
+  QString className = name;
+  QString parentName = StringHandler::removeLastWordAfterDot(className);
+  while (parentName.compare(className) != 0) {
+    parentNames.prepend(parentName);
+    className = parentName;
+    parentName = StringHandler::removeLastWordAfterDot(className);
+  }
+  if (caseSensitivity == Qt::CaseSensitive) {
+    foreach (QString parentName, parentNames) {
+      if (mPendingClassNames.contains(parentName)) {
+        LibraryTreeItem *pLibraryTreeItem = mLibraryTreeItemsHash.value(parentName, 0);
+        if (!pLibraryTreeItem) {
+          return;
+        }
+        fetchLibraryTreeItems(pLibraryTreeItem);
+      }
     }
-    if (pParentLibraryTreeItem) {
-      createLibraryTreeItemImpl(name, pParentLibraryTreeItem, pParentLibraryTreeItem->isSaved(), false, false);
+  } else {
+    LibraryTreeItem *pLibraryTreeItem = mpRootLibraryTreeItem;
+    foreach (QString parentName, parentNames) {
+      pLibraryTreeItem = findLibraryTreeItemOneLevel(parentName, pLibraryTreeItem, caseSensitivity);
+      if (!pLibraryTreeItem) {
+        return;
+      }
+      if (mPendingClassNames.contains(pLibraryTreeItem->getNameStructure())) {
+        fetchLibraryTreeItems(pLibraryTreeItem);
+      }
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removePendingClassNames
+ * Removes the not yet fetched class names of the class and its nested classes.
+ * \param nameStructure
+ */
+void LibraryTreeModel::removePendingClassNames(const QString &nameStructure)
+{
+  QString prefix = nameStructure + ".";
+  QHash<QString, QStringList>::iterator it = mPendingClassNames.begin();
+  while (it != mPendingClassNames.end()) {
+    if (it.key().compare(nameStructure) == 0 || it.key().startsWith(prefix)) {
+      it = mPendingClassNames.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // the class information being fetched might be outdated, so forget the requests.
+  QHash<int, QString>::iterator fetchingIt = mFetchingClassNames.begin();
+  while (fetchingIt != mFetchingClassNames.end()) {
+    if (fetchingIt.value().compare(nameStructure) == 0 || fetchingIt.value().startsWith(prefix)) {
+      fetchingIt = mFetchingClassNames.erase(fetchingIt);
+      if (mFetchingClassNames.isEmpty()) {
+        QApplication::restoreOverrideCursor();
+      }
+    } else {
+      ++fetchingIt;
     }
   }
 }
@@ -2228,23 +2588,35 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(QString name, Libra
       // create library tree items
       createLibraryTreeItems(pLibraryTreeItem);
       // load the LibraryTreeItem pixmap
-      loadLibraryTreeItemPixmap(pLibraryTreeItem);
+      loadCachedLibraryTreeItemPixmap(pLibraryTreeItem);
     }
     updateLibraryTreeItem(pLibraryTreeItem);
   } else {
-    OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
-    OMCInterface::getClassInformation_res classInformation = pOMCProxy->getClassInformation(nameStructure);
+    OMCInterface::getClassInformation_res classInformation;
+    if (pParentLibraryTreeItem == mpRootLibraryTreeItem && isSystemLibrary && load) {
+      /* The top level system library information is always read from OMC since it is the key of the LibraryTreeItemCache.
+       * If the cache is valid then the nested classes are created from it without querying OMC.
+       */
+      OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
+      classInformation = pOMCProxy->getClassInformation(nameStructure);
+      int libraryIconSize = mpLibraryWidget->getMainWindow()->getOptionsDialog()->getGeneralSettingsPage()->getLibraryIconSizeSpinBox()->value();
+      mLibraryTreeItemCache.restore(nameStructure, classInformation, getLibraryDependenciesClassInformation(nameStructure), libraryIconSize);
+      mLibraryTreeItemCache.setClassInformation(nameStructure, classInformation);
+    } else {
+      classInformation = getLibraryTreeItemClassInformation(nameStructure);
+    }
     pLibraryTreeItem = new LibraryTreeItem(LibraryTreeItem::Modelica, name, nameStructure, classInformation, "", isSaved, pParentLibraryTreeItem);
     pLibraryTreeItem->setSystemLibrary(pParentLibraryTreeItem == mpRootLibraryTreeItem ? isSystemLibrary : pParentLibraryTreeItem->isSystemLibrary());
     if (row == -1) {
       row = pParentLibraryTreeItem->childrenSize();
     }
     pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+    addLibraryTreeItemToHash(pLibraryTreeItem);
     if (load) {
       // create library tree items
       createLibraryTreeItems(pLibraryTreeItem);
       // load the LibraryTreeItem pixmap
-      loadLibraryTreeItemPixmap(pLibraryTreeItem);
+      loadCachedLibraryTreeItemPixmap(pLibraryTreeItem);
     }
   }
   return pLibraryTreeItem;
@@ -2261,9 +2633,8 @@ void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibrar
                                                         bool isSaved, int row)
 {
   pLibraryTreeItem->setParent(pParentLibraryTreeItem);
-  OMCProxy *pOMCProxy = mpLibraryWidget->getMainWindow()->getOMCProxy();
   pLibraryTreeItem->setFileName("");
-  pLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pLibraryTreeItem->getNameStructure()));
+  pLibraryTreeItem->setClassInformation(getLibraryTreeItemClassInformation(pLibraryTreeItem->getNameStructure()));
   pLibraryTreeItem->setIsSaved(isSaved);
   if (row == -1) {
     row = pParentLibraryTreeItem->childrenSize();
@@ -2271,6 +2642,7 @@ void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibrar
   QModelIndex index = libraryTreeItemIndex(pParentLibraryTreeItem);
   beginInsertRows(index, row, row);
   pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToHash(pLibraryTreeItem);
   endInsertRows();
   pLibraryTreeItem->setNonExisting(false);
 }
@@ -2318,6 +2690,7 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(LibraryTreeItem::Li
     row = pParentLibraryTreeItem->childrenSize();
   }
   pParentLibraryTreeItem->insertChild(row, pLibraryTreeItem);
+  addLibraryTreeItemToHash(pLibraryTreeItem);
   return pLibraryTreeItem;
 }
 
@@ -2345,11 +2718,14 @@ void LibraryTreeModel::unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, Libr
   pLibraryTreeItem->setClassText("");
   // make the class non expanded
   pLibraryTreeItem->setExpanded(false);
+  // the nested classes that are not fetched yet are unloaded along with the class.
+  removePendingClassNames(pLibraryTreeItem->getNameStructure());
   pLibraryTreeItem->removeInheritedClasses();
   // notify the inherits classes
   pLibraryTreeItem->emitUnLoaded();
   addNonExistingLibraryTreeItem(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
 }
 
 /*!
@@ -2385,6 +2761,7 @@ void LibraryTreeModel::unloadFileHelper(LibraryTreeItem *pLibraryTreeItem, Libra
     pLibraryTreeItem->getModelWidget()->deleteLater();
   }
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
   pLibraryTreeItem->deleteLater();
 }
 
@@ -2421,6 +2798,7 @@ void LibraryTreeModel::deleteFileHelper(LibraryTreeItem *pLibraryTreeItem, Libra
     pLibraryTreeItem->getModelWidget()->deleteLater();
   }
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
+  removeLibraryTreeItemFromHash(pLibraryTreeItem);
   QFileInfo fileInfo(pLibraryTreeItem->getFileName());
   // delete the file/folder
   bool fail = false;
@@ -2452,6 +2830,57 @@ void LibraryTreeModel::deleteFileChildren(LibraryTreeItem *pLibraryTreeItem)
   deleteFileHelper(pLibraryTreeItem, pLibraryTreeItem->parent());
 }
 
+/*!
+ * \brief LibraryTreeModel::addLibraryTreeItemToHash
+ * Adds the LibraryTreeItem and its already created children to the name lookup hash.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::addLibraryTreeItemToHash(LibraryTreeItem *pLibraryTreeItem)
+{
+  mLibraryTreeItemsHash.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    addLibraryTreeItemToHash(pLibraryTreeItem->child(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removeLibraryTreeItemFromHash
+ * Removes the LibraryTreeItem and its children from the name lookup hash.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::removeLibraryTreeItemFromHash(LibraryTreeItem *pLibraryTreeItem)
+{
+  // another LibraryTreeItem with the same name might be added before this one is removed.
+  if (mLibraryTreeItemsHash.value(pLibraryTreeItem->getNameStructure(), 0) == pLibraryTreeItem) {
+    mLibraryTreeItemsHash.remove(pLibraryTreeItem->getNameStructure());
+  }
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    removeLibraryTreeItemFromHash(pLibraryTreeItem->child(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::loadPendingLibraryTreeItemPixmaps
+ * Renders the pixmaps of the queued LibraryTreeItems in small batches so that the Libraries Browser stays responsive.
+ * Reschedules itself until the queue is empty.
+ */
+void LibraryTreeModel::loadPendingLibraryTreeItemPixmaps()
+{
+  QTime time;
+  time.start();
+  while (!mPendingPixmapLibraryTreeItems.isEmpty() && time.elapsed() < 50) {
+    LibraryTreeItem *pLibraryTreeItem = mPendingPixmapLibraryTreeItems.dequeue();
+    // the LibraryTreeItem might be deleted or unloaded in the meantime.
+    if (pLibraryTreeItem && !pLibraryTreeItem->isNonExisting()) {
+      loadCachedLibraryTreeItemPixmap(pLibraryTreeItem);
+      updateLibraryTreeItem(pLibraryTreeItem);
+    }
+  }
+  if (!mPendingPixmapLibraryTreeItems.isEmpty()) {
+    mLoadPixmapsTimer.start();
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::supportedDropActions
  * \return
@@ -2653,19 +3082,12 @@ LibraryTreeItem* LibraryTreeView::getSelectedLibraryTreeItem()
 void LibraryTreeView::libraryTreeItemExpanded(LibraryTreeItem *pLibraryTreeItem)
 {
   if (!pLibraryTreeItem->isExpanded()) {
-    // set the range for progress bar.
-    int progressValue = 0;
-    mpLibraryWidget->getMainWindow()->getProgressBar()->setRange(0, pLibraryTreeItem->childrenSize());
-    mpLibraryWidget->getMainWindow()->showProgressBar();
     pLibraryTreeItem->setExpanded(true);
+    // make sure the children exist and then render their icons in the background.
+    mpLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItems(pLibraryTreeItem);
     for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
-      LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
-      mpLibraryWidget->getMainWindow()->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(pChildLibraryTreeItem->getNameStructure()));
-      mpLibraryWidget->getLibraryTreeModel()->loadLibraryTreeItemPixmap(pChildLibraryTreeItem);
-      mpLibraryWidget->getMainWindow()->getStatusBar()->clearMessage();
-      mpLibraryWidget->getMainWindow()->getProgressBar()->setValue(++progressValue);
+      mpLibraryWidget->getLibraryTreeModel()->loadLibraryTreeItemPixmapLater(pLibraryTreeItem->child(i));
     }
-    mpLibraryWidget->getMainWindow()->hideProgressBar();
   }
 }
 
@@ -3745,13 +4167,15 @@ bool LibraryWidget::saveModelicaLibraryTreeItem(LibraryTreeItem *pLibraryTreeIte
   bool result = false;
   // if some file within folder structure package is changed and has valid file path then we should only save it.
   pLibraryTreeItem = mpLibraryTreeModel->getContainingFileParentLibraryTreeItem(pLibraryTreeItem);
-  if (pLibraryTreeItem->isFilePathValid() && mpLibraryTreeModel->getContainingFileParentLibraryTreeItem(pLibraryTreeItem) == pLibraryTreeItem) {
-    result = saveModelicaLibraryTreeItemHelper(pLibraryTreeItem);
-  } else {
+  if (!(pLibraryTreeItem->isFilePathValid() && mpLibraryTreeModel->getContainingFileParentLibraryTreeItem(pLibraryTreeItem) == pLibraryTreeItem)) {
     QString topLevelClassName = StringHandler::getFirstWordBeforeDot(pLibraryTreeItem->getNameStructure());
-    LibraryTreeItem *pTopLevelLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(topLevelClassName);
-    result = saveModelicaLibraryTreeItemHelper(pTopLevelLibraryTreeItem);
+    pLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(topLevelClassName);
   }
+  /* The save walks the LibraryTreeItem children e.g., to write package.order and to rename the removed classes as .bak-mo.
+   * Create the nested classes that are not fetched yet, otherwise they are treated as removed.
+   */
+  mpLibraryTreeModel->fetchLibraryTreeItems(pLibraryTreeItem, true);
+  result = saveModelicaLibraryTreeItemHelper(pLibraryTreeItem);
 //  if (result) {
 //    /* We need to load the file again so that the line number information for model_info.json is correct.
 //     * Update to AST (makes source info WRONG), saving it (source info STILL WRONG), reload it (and omc knows the new lines)
@@ -4133,5 +4557,11 @@ void LibraryWidget::searchClasses()
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
   Qt::CaseSensitivity caseSensitivity = mpTreeSearchFilters->getCaseSensitiveCheckBox()->isChecked() ? Qt::CaseSensitive: Qt::CaseInsensitive;
   QRegExp regExp(searchText, caseSensitivity, syntax);
+  // the filter can only match the classes that exist in the model so create all of them before searching.
+  if (!searchText.isEmpty()) {
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    mpLibraryTreeModel->fetchLibraryTreeItems(mpLibraryTreeModel->getRootLibraryTreeItem(), true);
+    QApplication::restoreOverrideCursor();
+  }
   mpLibraryTreeProxyModel->setFilterRegExp(regExp);
 }
@@ -37,6 +37,7 @@
 
 #include "MainWindow.h"
 #include "StringHandler.h"
+#include "LibraryTreeItemCache.h"
 
 class ItemDelegate : public QItemDelegate
 {
@@ -219,8 +220,12 @@ public:
   QModelIndex parent(const QModelIndex & index) const;
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   Qt::ItemFlags flags(const QModelIndex &index) const;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+  bool canFetchMore(const QModelIndex &parent) const;
+  void fetchMore(const QModelIndex &parent);
+  void fetchLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem, bool recursive = false);
   LibraryTreeItem* findLibraryTreeItem(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0,
-                                       Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
+                                       Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
   LibraryTreeItem* findLibraryTreeItem(const QRegExp &regExp, LibraryTreeItem *pLibraryTreeItem = 0) const;
   LibraryTreeItem* findLibraryTreeItemOneLevel(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0,
                                                Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
@@ -235,14 +240,18 @@ public:
                                          LibraryTreeItem *pParentLibraryTreeItem, int row = -1);
   void loadNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void checkIfAnyNonExistingClassLoaded();
-  void addNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem) {mNonExistingLibraryTreeItemsList.append(pLibraryTreeItem);}
-  void removeNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem) {mNonExistingLibraryTreeItemsList.removeOne(pLibraryTreeItem);}
+  void addNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
+  void removeNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
+  void updateLibraryTreeItemNameStructure(LibraryTreeItem *pLibraryTreeItem, QString nameStructure);
   void updateLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void updateLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
   void updateLibraryTreeItemClassTextManually(LibraryTreeItem *pLibraryTreeItem, QString contents);
   void readLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
   LibraryTreeItem* getContainingFileParentLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem);
+  void loadCachedLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem);
+  void loadLibraryTreeItemPixmapLater(LibraryTreeItem *pLibraryTreeItem);
+  void saveLibraryTreeItemCache() {mLibraryTreeItemCache.save();}
   void loadDependentLibraries(QStringList libraries);
   LibraryTreeItem* getLibraryTreeItemFromFile(QString fileName, int lineNumber);
   void showModelWidget(LibraryTreeItem *pLibraryTreeItem, bool show = true);
@@ -261,12 +270,28 @@ private:
   LibraryWidget *mpLibraryWidget;
   LibraryTreeItem *mpRootLibraryTreeItem;
   QList<LibraryTreeItem*> mNonExistingLibraryTreeItemsList;
+  QHash<QString, LibraryTreeItem*> mLibraryTreeItemsHash;
+  QHash<QString, LibraryTreeItem*> mNonExistingLibraryTreeItemsHash;
+  LibraryTreeItemCache mLibraryTreeItemCache;
+  QHash<QString, QStringList> mPendingClassNames;
+  // the classes whose children are being fetched, by the id of their OMCProxy::getClassesInformationAsync() request.
+  QHash<int, QString> mFetchingClassNames;
+  // the class information read by OMCProxy::getClassesInformationAsync() for the children being created.
+  QHash<QString, OMCInterface::getClassInformation_res> mFetchedClassInformation;
+  QQueue<QPointer<LibraryTreeItem> > mPendingPixmapLibraryTreeItems;
+  QTimer mLoadPixmapsTimer;
+  void fetchLibraryTreeItemPath(const QString &name, Qt::CaseSensitivity caseSensitivity);
+  void removePendingClassNames(const QString &nameStructure);
+  void addLibraryTreeItemToHash(LibraryTreeItem *pLibraryTreeItem);
+  void removeLibraryTreeItemFromHash(LibraryTreeItem *pLibraryTreeItem);
   QModelIndex libraryTreeItemIndexHelper(const LibraryTreeItem *pLibraryTreeItem, const LibraryTreeItem *pParentLibraryTreeItem,
                                          const QModelIndex &parentIndex) const;
   LibraryTreeItem* getLibraryTreeItemFromFileHelper(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber);
   void updateChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName);
   void readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents);
   QString readLibraryTreeItemClassTextFromFile(LibraryTreeItem *pLibraryTreeItem);
+  OMCInterface::getClassInformation_res getLibraryTreeItemClassInformation(QString nameStructure);
+  QList<OMCInterface::getClassInformation_res> getLibraryDependenciesClassInformation(QString library);
   void createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
   LibraryTreeItem* createLibraryTreeItemImpl(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
                                              bool isSystemLibrary = false, bool load = false, int row = -1);
@@ -281,6 +306,9 @@ private:
   void unloadFileChildren(LibraryTreeItem *pLibraryTreeItem);
   void deleteFileHelper(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
   void deleteFileChildren(LibraryTreeItem *pLibraryTreeItem);
+private slots:
+  void loadPendingLibraryTreeItemPixmaps();
+  void classesInformationFinished(int id, QStringList classNames, QList<OMCInterface::getClassInformation_res> classesInformation);
 protected:
   Qt::DropActions supportedDropActions() const;
 };
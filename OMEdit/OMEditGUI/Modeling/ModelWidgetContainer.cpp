@@ -674,7 +674,7 @@ void GraphicsView::createLineShape(QPointF point)
   }
 
   if (!isCreatingLineShape()) {
-    mpLineShapeAnnotation = new LineAnnotation("", this);
+    mpLineShapeAnnotation = new LineAnnotation(OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpLineShapeAnnotation));
     reOrderShapes();
     setIsCreatingLineShape(true);
@@ -692,7 +692,7 @@ void GraphicsView::createPolygonShape(QPointF point)
   }
 
   if (!isCreatingPolygonShape()) {
-    mpPolygonShapeAnnotation = new PolygonAnnotation("", this);
+    mpPolygonShapeAnnotation = new PolygonAnnotation(OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpPolygonShapeAnnotation));
     reOrderShapes();
     setIsCreatingPolygonShape(true);
@@ -711,7 +711,7 @@ void GraphicsView::createRectangleShape(QPointF point)
   }
 
   if (!isCreatingRectangleShape()) {
-    mpRectangleShapeAnnotation = new RectangleAnnotation("", this);
+    mpRectangleShapeAnnotation = new RectangleAnnotation(OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpRectangleShapeAnnotation));
     reOrderShapes();
     setIsCreatingRectangleShape(true);
@@ -744,7 +744,7 @@ void GraphicsView::createEllipseShape(QPointF point)
   }
 
   if (!isCreatingEllipseShape()) {
-    mpEllipseShapeAnnotation = new EllipseAnnotation("", this);
+    mpEllipseShapeAnnotation = new EllipseAnnotation(OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpEllipseShapeAnnotation));
     reOrderShapes();
     setIsCreatingEllipseShape(true);
@@ -777,7 +777,7 @@ void GraphicsView::createTextShape(QPointF point)
   }
 
   if (!isCreatingTextShape()) {
-    mpTextShapeAnnotation = new TextAnnotation("", this);
+    mpTextShapeAnnotation = new TextAnnotation(OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpTextShapeAnnotation));
     reOrderShapes();
     setIsCreatingTextShape(true);
@@ -812,7 +812,7 @@ void GraphicsView::createBitmapShape(QPointF point)
   }
 
   if (!isCreatingBitmapShape()) {
-    mpBitmapShapeAnnotation = new BitmapAnnotation(mpModelWidget->getLibraryTreeItem()->getFileName(), "", this);
+    mpBitmapShapeAnnotation = new BitmapAnnotation(mpModelWidget->getLibraryTreeItem()->getFileName(), OMCValue(), this);
     mpModelWidget->getUndoStack()->push(new AddShapeCommand(mpBitmapShapeAnnotation));
     reOrderShapes();
     setIsCreatingBitmapShape(true);
@@ -2865,7 +2865,6 @@ void ModelWidget::reDrawModelWidget()
     getModelIconDiagramShapes(StringHandler::Icon);
     // clear the components and their annotations
     mComponentsList.clear();
-    mComponentsAnnotationsList.clear();
     // get the model components
     getModelComponents();
     // Draw Icon components and inherited components
@@ -3237,93 +3236,63 @@ void ModelWidget::getModelIconDiagramShapes(StringHandler::ViewType viewType)
 {
   OMCProxy *pOMCProxy = mpModelWidgetContainer->getMainWindow()->getOMCProxy();
   GraphicsView *pGraphicsView = 0;
-  QString annotationString;
+  GraphicsAnnotationInfo graphicsAnnotationInfo;
   if (viewType == StringHandler::Icon) {
     pGraphicsView = mpIconGraphicsView;
-    annotationString = pOMCProxy->getIconAnnotation(mpLibraryTreeItem->getNameStructure());
+    graphicsAnnotationInfo = pOMCProxy->getIconAnnotation(mpLibraryTreeItem->getNameStructure());
   } else {
     pGraphicsView = mpDiagramGraphicsView;
-    annotationString = pOMCProxy->getDiagramAnnotation(mpLibraryTreeItem->getNameStructure());
-  }
-  annotationString = StringHandler::removeFirstLastCurlBrackets(annotationString);
-  if (annotationString.isEmpty()) {
-    return;
+    graphicsAnnotationInfo = pOMCProxy->getDiagramAnnotation(mpLibraryTreeItem->getNameStructure());
   }
-  QStringList list = StringHandler::getStrings(annotationString);
   // read the coordinate system
-  if (list.size() < 8) {
+  if (!graphicsAnnotationInfo.mHasCoOrdinateSystem) {
     return;
   }
-
-  qreal left = qMin(list.at(0).toFloat(), list.at(2).toFloat());
-  qreal bottom = qMin(list.at(1).toFloat(), list.at(3).toFloat());
-  qreal right = qMax(list.at(0).toFloat(), list.at(2).toFloat());
-  qreal top = qMax(list.at(1).toFloat(), list.at(3).toFloat());
-  QList<QPointF> extent;
-  extent << QPointF(left, bottom) << QPointF(right, top);
-  pGraphicsView->mCoOrdinateSystem.setExtent(extent);
-  pGraphicsView->mCoOrdinateSystem.setPreserveAspectRatio((list.at(4).compare("true") == 0) ? true : false);
-  pGraphicsView->mCoOrdinateSystem.setInitialScale(list.at(5).toFloat());
-  qreal horizontal = list.at(6).toFloat();
-  qreal vertical = list.at(7).toFloat();
-  pGraphicsView->mCoOrdinateSystem.setGrid(QPointF(horizontal, vertical));
-  pGraphicsView->setExtentRectangle(left, bottom, right, top);
+  pGraphicsView->mCoOrdinateSystem = graphicsAnnotationInfo.mCoOrdinateSystem;
+  QList<QPointF> extent = graphicsAnnotationInfo.mCoOrdinateSystem.getExtent();
+  pGraphicsView->setExtentRectangle(extent.at(0).x(), extent.at(0).y(), extent.at(1).x(), extent.at(1).y());
   pGraphicsView->resize(pGraphicsView->size());
-  // read the shapes
-  if (list.size() < 9)
-    return;
-  QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)), '(', ')');
-  // Now parse the shapes available in list
-  foreach (QString shape, shapesList) {
-    if (shape.startsWith("Line")) {
-      shape = shape.mid(QString("Line").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
+  // Now create the shapes, each shape is created from the arguments of its Line(..), Polygon(..) etc. call.
+  foreach (GraphicItemInfo graphicItemInfo, graphicsAnnotationInfo.mGraphicItems) {
+    const QString &shapeName = graphicItemInfo.mName;
+    const OMCValue &shape = graphicItemInfo.mAnnotation;
+    if (shapeName == QLatin1String("Line")) {
       LineAnnotation *pLineAnnotation = new LineAnnotation(shape, pGraphicsView);
       pLineAnnotation->initializeTransformation();
       pLineAnnotation->drawCornerItems();
       pLineAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pLineAnnotation);
       pGraphicsView->addItem(pLineAnnotation);
-    } else if (shape.startsWith("Polygon")) {
-      shape = shape.mid(QString("Polygon").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
+    } else if (shapeName == QLatin1String("Polygon")) {
       PolygonAnnotation *pPolygonAnnotation = new PolygonAnnotation(shape, pGraphicsView);
       pPolygonAnnotation->initializeTransformation();
       pPolygonAnnotation->drawCornerItems();
       pPolygonAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pPolygonAnnotation);
       pGraphicsView->addItem(pPolygonAnnotation);
-    } else if (shape.startsWith("Rectangle")) {
-      shape = shape.mid(QString("Rectangle").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
+    } else if (shapeName == QLatin1String("Rectangle")) {
       RectangleAnnotation *pRectangleAnnotation = new RectangleAnnotation(shape, pGraphicsView);
       pRectangleAnnotation->initializeTransformation();
       pRectangleAnnotation->drawCornerItems();
       pRectangleAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pRectangleAnnotation);
       pGraphicsView->addItem(pRectangleAnnotation);
-    } else if (shape.startsWith("Ellipse")) {
-      shape = shape.mid(QString("Ellipse").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
+    } else if (shapeName == QLatin1String("Ellipse")) {
       EllipseAnnotation *pEllipseAnnotation = new EllipseAnnotation(shape, pGraphicsView);
       pEllipseAnnotation->initializeTransformation();
       pEllipseAnnotation->drawCornerItems();
       pEllipseAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pEllipseAnnotation);
       pGraphicsView->addItem(pEllipseAnnotation);
-    } else if (shape.startsWith("Text")) {
-      shape = shape.mid(QString("Text").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
+    } else if (shapeName == QLatin1String("Text")) {
       TextAnnotation *pTextAnnotation = new TextAnnotation(shape, pGraphicsView);
       pTextAnnotation->initializeTransformation();
       pTextAnnotation->drawCornerItems();
       pTextAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pTextAnnotation);
       pGraphicsView->addItem(pTextAnnotation);
-    } else if (shape.startsWith("Bitmap")) {
+    } else if (shapeName == QLatin1String("Bitmap")) {
       /* create the bitmap shape */
-      shape = shape.mid(QString("Bitmap").length());
-      shape = StringHandler::removeFirstLastBrackets(shape);
       BitmapAnnotation *pBitmapAnnotation = new BitmapAnnotation(mpLibraryTreeItem->mClassInformation.fileName, shape, pGraphicsView);
       pBitmapAnnotation->initializeTransformation();
       pBitmapAnnotation->drawCornerItems();
@@ -3394,7 +3363,7 @@ void ModelWidget::getModelComponents()
   mComponentsList = pMainWindow->getOMCProxy()->getComponents(mpLibraryTreeItem->getNameStructure());
   // get the components annotations
   if (!mComponentsList.isEmpty()) {
-    mComponentsAnnotationsList = pMainWindow->getOMCProxy()->getComponentAnnotations(mpLibraryTreeItem->getNameStructure());
+    pMainWindow->getOMCProxy()->getComponentAnnotations(mpLibraryTreeItem->getNameStructure(), mComponentsList);
   }
 }
 
@@ -3405,11 +3374,9 @@ void ModelWidget::getModelComponents()
 void ModelWidget::drawModelIconComponents()
 {
   MainWindow *pMainWindow = mpModelWidgetContainer->getMainWindow();
-  int i = 0;
   foreach (ComponentInfo *pComponentInfo, mComponentsList) {
     // if the component type is one of the builtin type then don't try to load it here. we load it when loading diagram view.
     if (pMainWindow->getOMCProxy()->isBuiltinType(pComponentInfo->getClassName())) {
-      i++;
       continue;
     }
     LibraryTreeItem *pLibraryTreeItem = 0;
@@ -3423,19 +3390,13 @@ void ModelWidget::drawModelIconComponents()
       if (!pLibraryTreeItem->isNonExisting() && !pLibraryTreeItem->getModelWidget()) {
         pLibraryTreeModel->showModelWidget(pLibraryTreeItem, false);
       }
-      QString transformation = "";
-      QStringList dialogAnnotation;
-      if (mComponentsAnnotationsList.size() >= i) {
-        transformation = StringHandler::getPlacementAnnotation(mComponentsAnnotationsList.at(i));
-        dialogAnnotation = StringHandler::getDialogAnnotation(mComponentsAnnotationsList.at(i));
-        if (transformation.isEmpty()) {
-          transformation = "Placement(false,0.0,0.0,-10.0,-10.0,10.0,10.0,0.0,-,-,-,-,-,-,)";
-        }
+      QString transformation = pComponentInfo->getPlacementAnnotation();
+      if (transformation.isEmpty()) {
+        transformation = "Placement(false,0.0,0.0,-10.0,-10.0,10.0,10.0,0.0,-,-,-,-,-,-,)";
       }
-      mpIconGraphicsView->addComponentToView(pComponentInfo->getName(), pLibraryTreeItem, transformation, QPointF(0, 0), dialogAnnotation,
-                                             pComponentInfo, false, true);
+      mpIconGraphicsView->addComponentToView(pComponentInfo->getName(), pLibraryTreeItem, transformation, QPointF(0, 0),
+                                             pComponentInfo->getDialogAnnotation(), pComponentInfo, false, true);
     }
-    i++;
   }
 }
 
@@ -3446,7 +3407,6 @@ void ModelWidget::drawModelIconComponents()
 void ModelWidget::drawModelDiagramComponents()
 {
   MainWindow *pMainWindow = mpModelWidgetContainer->getMainWindow();
-  int i = 0;
   foreach (ComponentInfo *pComponentInfo, mComponentsList) {
     LibraryTreeItem *pLibraryTreeItem = 0;
     // if the component type is one of the builtin type then don't try to load it.
@@ -3458,25 +3418,18 @@ void ModelWidget::drawModelDiagramComponents()
       }
       // we only load and draw non-connectors here. Connector components are drawn in drawModelIconComponents().
       if (pLibraryTreeItem->isConnector()) {
-        i++;
         continue;
       }
       if (!pLibraryTreeItem->isNonExisting() && !pLibraryTreeItem->getModelWidget()) {
         pLibraryTreeModel->showModelWidget(pLibraryTreeItem, false);
       }
     }
-    QString transformation = "";
-    QStringList dialogAnnotation;
-    if (mComponentsAnnotationsList.size() >= i) {
-      transformation = StringHandler::getPlacementAnnotation(mComponentsAnnotationsList.at(i));
-      dialogAnnotation = StringHandler::getDialogAnnotation(mComponentsAnnotationsList.at(i));
-      if (transformation.isEmpty()) {
-        transformation = "Placement(false,0.0,0.0,-10.0,-10.0,10.0,10.0,0.0,-,-,-,-,-,-,)";
-      }
+    QString transformation = pComponentInfo->getPlacementAnnotation();
+    if (transformation.isEmpty()) {
+      transformation = "Placement(false,0.0,0.0,-10.0,-10.0,10.0,10.0,0.0,-,-,-,-,-,-,)";
     }
-    mpDiagramGraphicsView->addComponentToView(pComponentInfo->getName(), pLibraryTreeItem, transformation, QPointF(0, 0), dialogAnnotation,
-                                              pComponentInfo, false, true);
-    i++;
+    mpDiagramGraphicsView->addComponentToView(pComponentInfo->getName(), pLibraryTreeItem, transformation, QPointF(0, 0),
+                                              pComponentInfo->getDialogAnnotation(), pComponentInfo, false, true);
   }
 }
 
@@ -3518,21 +3471,13 @@ void ModelWidget::removeInheritedClassConnections()
 void ModelWidget::getModelConnections()
 {
   MainWindow *pMainWindow = mpModelWidgetContainer->getMainWindow();
-  int connectionCount = pMainWindow->getOMCProxy()->getConnectionCount(mpLibraryTreeItem->getNameStructure());
-  for (int i = 1 ; i <= connectionCount ; i++) {
-    // get the connection from OMC
-    QString connectionString;
-    QStringList connectionList;
-    connectionString = pMainWindow->getOMCProxy()->getNthConnection(mpLibraryTreeItem->getNameStructure(), i);
-    connectionList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionString));
-    // if the connectionString only contains two items then continue the loop,
-    // because connection is not valid then
-    if (connectionList.size() < 3) {
-      continue;
-    }
+  // get all the connections and their annotations from OMC in one go
+  QList<ConnectionInfo> connections = pMainWindow->getOMCProxy()->getConnections(mpLibraryTreeItem->getNameStructure());
+  foreach (ConnectionInfo connectionInfo, connections) {
+    QString connectionString = connectionInfo.mConnection;
     // get start and end components
-    QStringList startComponentList = connectionList.at(0).split(".");
-    QStringList endComponentList = connectionList.at(1).split(".");
+    QStringList startComponentList = connectionInfo.mStartConnector.split(".");
+    QStringList endComponentList = connectionInfo.mEndConnector.split(".");
     // get start component
     Component *pStartComponent = 0;
     if (startComponentList.size() > 0) {
@@ -3566,7 +3511,7 @@ void ModelWidget::getModelConnections()
     if (!pStartConnectorComponent) {
       pMainWindow->getMessagesWidget()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
                                                                   GUIMessages::getMessage(GUIMessages::UNABLE_FIND_COMPONENT)
-                                                                  .arg(connectionList.at(0)).arg(connectionString),
+                                                                  .arg(connectionInfo.mStartConnector).arg(connectionString),
                                                                   Helper::scriptingKind, Helper::errorLevel));
       continue;
     }
@@ -3600,26 +3545,15 @@ void ModelWidget::getModelConnections()
     if (!pEndConnectorComponent) {
       pMainWindow->getMessagesWidget()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
                                                                   GUIMessages::getMessage(GUIMessages::UNABLE_FIND_COMPONENT)
-                                                                  .arg(connectionList.at(1)).arg(connectionString),
+                                                                  .arg(connectionInfo.mEndConnector).arg(connectionString),
                                                                   Helper::scriptingKind, Helper::errorLevel));
       continue;
     }
-    // get the connector annotations from OMC
-    QString connectionAnnotationString = pMainWindow->getOMCProxy()->getNthConnectionAnnotation(mpLibraryTreeItem->getNameStructure(), i);
-    QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionAnnotationString), '(', ')');
-    // Now parse the shapes available in list
-    QString lineShape = "";
-    foreach (QString shape, shapesList) {
-      if (shape.startsWith("Line")) {
-        lineShape = shape.mid(QString("Line").length());
-        lineShape = StringHandler::removeFirstLastBrackets(lineShape);
-        break;  // break the loop once we have got the line annotation.
-      }
-    }
     LineAnnotation *pConnectionLineAnnotation;
-    pConnectionLineAnnotation = new LineAnnotation(lineShape, pStartConnectorComponent, pEndConnectorComponent, mpDiagramGraphicsView);
-    pConnectionLineAnnotation->setStartComponentName(connectionList.at(0));
-    pConnectionLineAnnotation->setEndComponentName(connectionList.at(1));
+    pConnectionLineAnnotation = new LineAnnotation(connectionInfo.mLineAnnotation, pStartConnectorComponent, pEndConnectorComponent,
+                                                   mpDiagramGraphicsView);
+    pConnectionLineAnnotation->setStartComponentName(connectionInfo.mStartConnector);
+    pConnectionLineAnnotation->setEndComponentName(connectionInfo.mEndConnector);
     mpUndoStack->push(new AddConnectionCommand(pConnectionLineAnnotation, false));
   }
 }
@@ -3764,8 +3698,9 @@ void ModelWidget::getMetaModelConnections()
         break;  // break the loop once we have got the line annotation.
       }
     }
-    LineAnnotation *pConnectionLineAnnotation = new LineAnnotation(lineShape, pStartInterfacePointComponent, pEndInterfacePointComponent,
-                                                                   mpDiagramGraphicsView);
+    OMCValueTree lineTree(lineShape, OMCValueTree::ArgumentList);
+    LineAnnotation *pConnectionLineAnnotation = new LineAnnotation(lineTree.getRoot(), pStartInterfacePointComponent,
+                                                                   pEndInterfacePointComponent, mpDiagramGraphicsView);
     pConnectionLineAnnotation->setStartComponentName(connection.attribute("From"));
     pConnectionLineAnnotation->setEndComponentName(connection.attribute("To"));
     pConnectionLineAnnotation->setDelay(connection.attribute("Delay"));
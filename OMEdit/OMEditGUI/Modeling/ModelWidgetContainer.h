@@ -396,7 +396,6 @@ private:
   QMap<QString, QMap<QString, QString> > mExtendsModifiersMap;
   QList<LibraryTreeItem*> mInheritedClassesList;
   QList<ComponentInfo*> mComponentsList;
-  QStringList mComponentsAnnotationsList;
 
   void getModelInheritedClasses();
   void drawModelInheritedClassShapes(ModelWidget *pModelWidget, StringHandler::ViewType viewType);
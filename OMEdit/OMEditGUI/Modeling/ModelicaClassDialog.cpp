@@ -1687,7 +1687,7 @@ void RenameItemDialog::updateChildrenPath(LibraryTreeItem *pLibraryTreeItem)
   for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
     LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
     QString newPath = QString("%1/%2").arg(pLibraryTreeItem->getFileName()).arg(pChildLibraryTreeItem->getName());
-    pChildLibraryTreeItem->setNameStructure(newPath);
+    mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->updateLibraryTreeItemNameStructure(pChildLibraryTreeItem, newPath);
     pChildLibraryTreeItem->setFileName(newPath);
     if (pChildLibraryTreeItem->getModelWidget()) {
       pChildLibraryTreeItem->getModelWidget()->setModelFilePathLabel(newPath);
@@ -1728,7 +1728,7 @@ void RenameItemDialog::renameFileOrFolder()
   if (pLibraryTreeItem) {
     if (QFile::rename(oldFileInfo.absoluteFilePath(), fileInfo.absoluteFilePath())) {
       pLibraryTreeItem->setName(mpNameTextBox->text());
-      pLibraryTreeItem->setNameStructure(fileInfo.absoluteFilePath());
+      pLibraryTreeModel->updateLibraryTreeItemNameStructure(pLibraryTreeItem, fileInfo.absoluteFilePath());
       pLibraryTreeItem->setFileName(fileInfo.absoluteFilePath());
       if (pLibraryTreeItem->getModelWidget()) {
         pLibraryTreeItem->getModelWidget()->setModelFilePathLabel(fileInfo.absoluteFilePath());
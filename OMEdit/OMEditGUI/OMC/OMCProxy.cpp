@@ -37,23 +37,11 @@
 #include "version.h"
 #endif
 
-extern "C" {
-void (*omc_assert)(threadData_t*,FILE_INFO info,const char *msg,...) __attribute__((noreturn)) = omc_assert_function;
-void (*omc_assert_warning)(FILE_INFO info,const char *msg,...) = omc_assert_warning_function;
-void (*omc_terminate)(FILE_INFO info,const char *msg,...) = omc_terminate_function;
-void (*omc_throw)(threadData_t*) __attribute__ ((noreturn)) = omc_throw_function;
-int omc_Main_handleCommand(void *threadData, void *imsg, void *ist, void **omsg, void **ost);
-void* omc_Main_init(void *threadData, void *args);
-void* omc_Main_readSettings(void *threadData, void *args);
-#ifdef WIN32
-void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
-#endif
-}
-
 #include <stdlib.h>
 #include <iostream>
 
 #include "OMCProxy.h"
+#include "OMCValue.h"
 #include "simulation_options.h"
 #include "omc_error.h"
 
@@ -68,6 +56,8 @@ OMCProxy::OMCProxy(MainWindow *pMainWindow)
   : QObject(pMainWindow), mHasInitialized(false), mResult(""), mTotalOMCCallsTime(0.0)
 {
   mpMainWindow = pMainWindow;
+  mpOMCThread = new OMCThread(this);
+  connect(mpOMCThread, SIGNAL(jobFinished(OMCJob*)), SLOT(handleJobFinished(OMCJob*)));
   mCurrentCommandIndex = -1;
   // OMC Commands Logger Widget
   mpOMCLoggerWidget = new QWidget;
@@ -128,6 +118,7 @@ OMCProxy::OMCProxy(MainWindow *pMainWindow)
 
 OMCProxy::~OMCProxy()
 {
+  mpOMCThread->stopOMC();
   delete mpOMCLoggerWidget;
   if (mpMainWindow->isDebug()) {
     delete mpOMCDiffWidget;
@@ -193,18 +184,10 @@ bool OMCProxy::initializeOMC()
     mCommandsLogFileTextStream.setCodec(Helper::utf8.toStdString().data());
     mCommandsLogFileTextStream.setGenerateByteOrderMark(false);
   }
-  threadData_t *threadData = (threadData_t *) calloc(1, sizeof(threadData_t));
-  void *st = 0;
-  MMC_TRY_TOP_INTERNAL()
-  omc_Main_init(threadData, mmc_mk_nil());
-  st = omc_Main_readSettings(threadData, mmc_mk_nil());
-  threadData->plotClassPointer = mpMainWindow;
-  threadData->plotCB = MainWindow::PlotCallbackFunction;
-  MMC_CATCH_TOP(return false;)
-  mpOMCInterface = new OMCInterface(threadData, st);
-  connect(mpOMCInterface, SIGNAL(logCommand(QString,QTime*)), this, SLOT(logCommand(QString,QTime*)));
-  connect(mpOMCInterface, SIGNAL(logResponse(QString,QTime*)), this, SLOT(logResponse(QString,QTime*)));
-  connect(mpOMCInterface, SIGNAL(throwException(QString)), SLOT(showException(QString)));
+  // start the OMC thread. It owns the threadData_t and the symbol table.
+  if (!mpOMCThread->startOMC()) {
+    return false;
+  }
   mHasInitialized = true;
   // set the locale
   QSettings *pSettings = Utilities::getApplicationSettings();
@@ -217,12 +200,7 @@ bool OMCProxy::initializeOMC()
   sendCommand("\"" +  QString(GIT_SHA) + "\"");
 #endif
   // set OpenModelicaHome variable
-  Helper::OpenModelicaHome = mpOMCInterface->getInstallationDirectoryPath();
-#ifdef WIN32
-  MMC_TRY_TOP_INTERNAL()
-  omc_Main_setWindowsPaths(threadData, mmc_mk_scon(Helper::OpenModelicaHome.toStdString().c_str()));
-  MMC_CATCH_TOP()
-#endif
+  Helper::OpenModelicaHome = mpOMCThread->call(&OMCInterface::getInstallationDirectoryPath);
   /* set the tmp directory as the working directory */
   changeDirectory(tmpPath);
   // set the OpenModelicaLibrary variable.
@@ -237,14 +215,17 @@ bool OMCProxy::initializeOMC()
 void OMCProxy::quitOMC()
 {
   sendCommand("quit()");
+  mpOMCThread->stopOMC();
   mCommunicationLogFile.close();
   mCommandsMosFile.close();
 }
 
 /*!
  * \brief OMCProxy::sendCommand
- * Sends the user commands to OMC.
+ * Sends the user commands to OMC.\n
+ * The command is executed on the OMC thread. Blocks until the result is available, see OMCThread::execute().
  * \param expression - is used to send command as a string.
+ * \sa OMCProxy::sendCommandAsync()
  */
 void OMCProxy::sendCommand(const QString expression)
 {
@@ -255,35 +236,44 @@ void OMCProxy::sendCommand(const QString expression)
       return;
     }
   }
+  OMCCommandJob commandJob(expression);
   // write command to the commands log.
-  QTime commandTime;
-  commandTime.start();
-  logCommand(expression, &commandTime);
-  // TODO: Call this in a thread that loops over received messages? Avoid MMC_TRY_TOP all the time, etc
-  void *reply_str = NULL;
-  threadData_t *threadData = mpOMCInterface->threadData;
-
-  MMC_TRY_TOP_INTERNAL()
-
-  MMC_TRY_STACK()
-
-  if (!omc_Main_handleCommand(threadData, mmc_mk_scon(expression.toStdString().c_str()), mpOMCInterface->st, &reply_str, &mpOMCInterface->st)) {
+  logCommand(expression, commandJob.getCommandTime());
+  mpOMCThread->execute(&commandJob);
+  if (!commandJob.isSuccessful()) {
     if (expression == "quit()") {
       return;
     }
     exitApplication();
   }
-  mResult = MMC_STRINGDATA(reply_str);
-  logResponse(mResult.trimmed(), &commandTime);
-
-  MMC_ELSE()
-    mResult = "";
-    fprintf(stderr, "Stack overflow detected and was not caught.\nSend us a bug report at https://trac.openmodelica.org/OpenModelica/newticket\n    Include the following trace:\n");
-    printStacktraceMessages();
-    fflush(NULL);
-  MMC_CATCH_STACK()
+  mResult = commandJob.getResult();
+  logResponse(mResult.trimmed(), commandJob.getCommandTime());
+}
 
-  MMC_CATCH_TOP(mResult = "");
+/*!
+ * \brief OMCProxy::sendCommandAsync
+ * Queues the command on the OMC thread and returns immediately.\n
+ * OMCProxy::commandFinished is emitted with the returned id and the result once OMC has evaluated the command.
+ * Commands are evaluated in the order they are sent so several queries can be pipelined.
+ * \param expression - is used to send command as a string.
+ * \return the request id or -1 if OMC is not running.
+ * \sa OMCProxy::sendCommand()
+ */
+int OMCProxy::sendCommandAsync(const QString expression)
+{
+  if (!mHasInitialized) {
+    // if we are unable to start OMC. Exit the application.
+    if(!initializeOMC()) {
+      mpMainWindow->setExitApplicationStatus(true);
+      return -1;
+    }
+  }
+  OMCCommandJob *pCommandJob = new OMCCommandJob(expression);
+  // write command to the commands log.
+  logCommand(expression, pCommandJob->getCommandTime());
+  int id = mpOMCThread->post(pCommandJob);
+  mAsyncJobs.insert(id, CommandAsyncJob);
+  return id;
 }
 
 /*!
@@ -402,6 +392,99 @@ void OMCProxy::showException(QString exception)
   printMessagesStringInternal();
 }
 
+/*!
+ * \brief OMCProxy::plotCallback
+ * Called on the GUI thread by OMCThread::PlotCallbackFunction when OMC evaluates a plot command.\n
+ * Forwards the plot arguments to MainWindow::PlotCallbackFunction on the GUI thread.
+ * \param arguments - the plot arguments in the order of MainWindow::PlotCallbackFunction.
+ */
+void OMCProxy::plotCallback(QStringList arguments)
+{
+  QList<QByteArray> args;
+  foreach (QString argument, arguments) {
+    args.append(argument.toUtf8());
+  }
+  try {
+    MainWindow::PlotCallbackFunction(mpMainWindow, args.at(0).toInt(), args.at(1).constData(), args.at(2).constData(),
+                                     args.at(3).constData(), args.at(4).constData(), args.at(5).constData(), args.at(6).constData(),
+                                     args.at(7).constData(), args.at(8).constData(), args.at(9).constData(), args.at(10).constData(),
+                                     args.at(11).constData(), args.at(12).constData(), args.at(13).constData(), args.at(14).constData(),
+                                     args.at(15).constData(), args.at(16).constData(), args.at(17).constData(), args.at(18).constData());
+  } catch (OMPlot::PlotException &e) {
+    showException(e.what());
+  }
+}
+
+/*!
+ * \class OMCClassesInformationJob
+ * \brief Reads the class information of several classes in one job.
+ */
+class OMCClassesInformationJob : public OMCJob
+{
+public:
+  OMCClassesInformationJob(const QStringList &classNames) : mClassNames(classNames) {}
+  const QStringList& getClassNames() const {return mClassNames;}
+  QList<OMCInterface::getClassInformation_res> getClassesInformation() const {return mClassesInformation;}
+  virtual void run(OMCInterface *pOMCInterface)
+  {
+    foreach (QString className, mClassNames) {
+      mClassesInformation.append(pOMCInterface->getClassInformation(className));
+    }
+  }
+private:
+  QStringList mClassNames;
+  QList<OMCInterface::getClassInformation_res> mClassesInformation;
+};
+
+/*!
+ * \brief OMCProxy::handleJobFinished
+ * Slot activated when OMCThread::jobFinished signal is raised.\n
+ * Reports the result of the jobs queued by the asynchronous OMCProxy methods.
+ * \param pOMCJob
+ */
+void OMCProxy::handleJobFinished(OMCJob *pOMCJob)
+{
+  if (!mAsyncJobs.contains(pOMCJob->getId())) {
+    return;
+  }
+  int id = pOMCJob->getId();
+  switch (mAsyncJobs.take(id)) {
+    case CommandAsyncJob: {
+      OMCCommandJob *pCommandJob = static_cast<OMCCommandJob*>(pOMCJob);
+      if (!pCommandJob->isSuccessful()) {
+        exitApplication();
+        return;
+      }
+      QString result = pCommandJob->getResult().trimmed();
+      logResponse(result, pCommandJob->getCommandTime());
+      emit commandFinished(id, result);
+      break;
+    }
+    case LoadModelAsyncJob: {
+      bool result = static_cast<OMCInterfaceCall<bool>*>(pOMCJob)->getResult();
+      printMessagesStringInternal();
+      emit commandFinished(id, result ? "true" : "false");
+      break;
+    }
+    case ModelAsyncJob: {
+      QString result = static_cast<OMCInterfaceCall<QString>*>(pOMCJob)->getResult();
+      printMessagesStringInternal();
+      mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
+      emit commandFinished(id, result);
+      break;
+    }
+    case ClassesInformationAsyncJob: {
+      OMCClassesInformationJob *pClassesInformationJob = static_cast<OMCClassesInformationJob*>(pOMCJob);
+      QList<OMCInterface::getClassInformation_res> classesInformation = pClassesInformationJob->getClassesInformation();
+      for (int i = 0 ; i < classesInformation.size() ; i++) {
+        updateClassInformationComment(&classesInformation[i]);
+      }
+      emit classesInformationFinished(id, pClassesInformationJob->getClassNames(), classesInformation);
+      break;
+    }
+  }
+}
+
 /*!
   Opens the OMC Logger widget.
   */
@@ -473,7 +556,7 @@ void OMCProxy::exitApplication()
  */
 QString OMCProxy::getErrorString(bool warningsAsErrors)
 {
-  return mpOMCInterface->getErrorString(warningsAsErrors);
+  return mpOMCThread->call(&OMCInterface::getErrorString, warningsAsErrors);
 }
 
 /*!
@@ -617,7 +700,7 @@ QString OMCProxy::getErrorLevel()
   */
 QString OMCProxy::getVersion(QString className)
 {
-  return mpOMCInterface->getVersion(className);
+  return mpOMCThread->call(&OMCInterface::getVersion, className);
 }
 
 /*!
@@ -731,7 +814,7 @@ void OMCProxy::loadUserLibraries()
  */
 QStringList OMCProxy::getClassNames(QString className, bool recursive, bool qualified, bool sort, bool builtin, bool showProtected)
 {
-  return mpOMCInterface->getClassNames(className, recursive, qualified, sort, builtin, showProtected);
+  return mpOMCThread->call(&OMCInterface::getClassNames, className, recursive, qualified, sort, builtin, showProtected);
 }
 
 /*!
@@ -742,7 +825,7 @@ QStringList OMCProxy::getClassNames(QString className, bool recursive, bool qual
   */
 QStringList OMCProxy::searchClassNames(QString searchText, bool findInText)
 {
-  return mpOMCInterface->searchClassNames(searchText, findInText);
+  return mpOMCThread->call(&OMCInterface::searchClassNames, searchText, findInText);
 }
 
 /*!
@@ -752,8 +835,34 @@ QStringList OMCProxy::searchClassNames(QString searchText, bool findInText)
   */
 OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString className)
 {
-  OMCInterface::getClassInformation_res classInformation = mpOMCInterface->getClassInformation(className);
-  QString comment = classInformation.comment.replace("\\\"", "\"");
+  OMCInterface::getClassInformation_res classInformation = mpOMCThread->call(&OMCInterface::getClassInformation, className);
+  updateClassInformationComment(&classInformation);
+  return classInformation;
+}
+
+/*!
+ * \brief OMCProxy::getClassesInformationAsync
+ * Queues the getClassInformation calls of all the classes as one job and returns immediately.\n
+ * OMCProxy::classesInformationFinished is emitted with the returned id once the information of all the classes is read.
+ * \param classNames
+ * \return the request id.
+ * \sa OMCProxy::getClassInformation()
+ */
+int OMCProxy::getClassesInformationAsync(QStringList classNames)
+{
+  int id = mpOMCThread->post(new OMCClassesInformationJob(classNames));
+  mAsyncJobs.insert(id, ClassesInformationAsyncJob);
+  return id;
+}
+
+/*!
+ * \brief OMCProxy::updateClassInformationComment
+ * Makes the class comment usable in the tooltips.
+ * \param pClassInformation
+ */
+void OMCProxy::updateClassInformationComment(OMCInterface::getClassInformation_res *pClassInformation)
+{
+  QString comment = pClassInformation->comment.replace("\\\"", "\"");
   comment = makeDocumentationUriToFileName(comment);
   // since tooltips can't handle file:// scheme so we have to remove it in order to display images and make links work.
 #ifdef WIN32
@@ -761,8 +870,7 @@ OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString clas
 #else
   comment.replace("src=\"file://", "src=\"");
 #endif
-  classInformation.comment = comment;
-  return classInformation;
+  pClassInformation->comment = comment;
 }
 
 /*!
@@ -772,7 +880,7 @@ OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString clas
   */
 bool OMCProxy::isPackage(QString className)
 {
-  return mpOMCInterface->isPackage(className);
+  return mpOMCThread->call(&OMCInterface::isPackage, className);
 }
 
 /*!
@@ -797,7 +905,7 @@ bool OMCProxy::isBuiltinType(QString typeName)
 QString OMCProxy::getBuiltinType(QString typeName)
 {
   QString result = "";
-  result = mpOMCInterface->getBuiltinType(typeName);
+  result = mpOMCThread->call(&OMCInterface::getBuiltinType, typeName);
   getErrorString();
   return result;
 }
@@ -813,43 +921,43 @@ bool OMCProxy::isWhat(StringHandler::ModelicaClasses type, QString className)
   bool result = false;
   switch (type) {
     case StringHandler::Model:
-      result = mpOMCInterface->isModel(className);
+      result = mpOMCThread->call(&OMCInterface::isModel, className);
       break;
     case StringHandler::Class:
-      result = mpOMCInterface->isClass(className);
+      result = mpOMCThread->call(&OMCInterface::isClass, className);
       break;
     case StringHandler::Connector:
-      result = mpOMCInterface->isConnector(className);
+      result = mpOMCThread->call(&OMCInterface::isConnector, className);
       break;
     case StringHandler::Record:
-      result = mpOMCInterface->isRecord(className);
+      result = mpOMCThread->call(&OMCInterface::isRecord, className);
       break;
     case StringHandler::Block:
-      result = mpOMCInterface->isBlock(className);
+      result = mpOMCThread->call(&OMCInterface::isBlock, className);
       break;
     case StringHandler::Function:
-      result = mpOMCInterface->isFunction(className);
+      result = mpOMCThread->call(&OMCInterface::isFunction, className);
       break;
     case StringHandler::Package:
-      result = mpOMCInterface->isPackage(className);
+      result = mpOMCThread->call(&OMCInterface::isPackage, className);
       break;
     case StringHandler::Type:
-      result = mpOMCInterface->isType(className);
+      result = mpOMCThread->call(&OMCInterface::isType, className);
       break;
     case StringHandler::Operator:
-      result = mpOMCInterface->isOperator(className);
+      result = mpOMCThread->call(&OMCInterface::isOperator, className);
       break;
     case StringHandler::OperatorRecord:
-      result = mpOMCInterface->isOperatorRecord(className);
+      result = mpOMCThread->call(&OMCInterface::isOperatorRecord, className);
       break;
     case StringHandler::OperatorFunction:
-      result = mpOMCInterface->isOperatorFunction(className);
+      result = mpOMCThread->call(&OMCInterface::isOperatorFunction, className);
       break;
     case StringHandler::Optimization:
-      result = mpOMCInterface->isOptimization(className);
+      result = mpOMCThread->call(&OMCInterface::isOptimization, className);
       break;
     case StringHandler::Enumeration:
-      result = mpOMCInterface->isEnumeration(className);
+      result = mpOMCThread->call(&OMCInterface::isEnumeration, className);
       break;
     default:
       result = false;
@@ -868,7 +976,7 @@ bool OMCProxy::isProtectedClass(QString className, QString nestedClassName)
   if (className.isEmpty()) {
     return false;
   } else {
-    return mpOMCInterface->isProtectedClass(className, nestedClassName);
+    return mpOMCThread->call(&OMCInterface::isProtectedClass, className, nestedClassName);
   }
 }
 
@@ -879,7 +987,7 @@ bool OMCProxy::isProtectedClass(QString className, QString nestedClassName)
   */
 bool OMCProxy::isPartial(QString className)
 {
-  return mpOMCInterface->isPartial(className);
+  return mpOMCThread->call(&OMCInterface::isPartial, className);
 }
 
 /*!
@@ -902,7 +1010,7 @@ bool OMCProxy::isReplaceable(QString parentClassName, QString className)
   */
 StringHandler::ModelicaClasses OMCProxy::getClassRestriction(QString className)
 {
-  QString result = mpOMCInterface->getClassRestriction(className);
+  QString result = mpOMCThread->call(&OMCInterface::getClassRestriction, className);
 
   if (result.toLower().contains("model"))
     return StringHandler::Model;
@@ -940,7 +1048,7 @@ StringHandler::ModelicaClasses OMCProxy::getClassRestriction(QString className)
   */
 QString OMCProxy::getParameterValue(QString className, QString parameter)
 {
-  return mpOMCInterface->getParameterValue(className, parameter);
+  return mpOMCThread->call(&OMCInterface::getParameterValue, className, parameter);
 }
 
 /*!
@@ -951,7 +1059,7 @@ QString OMCProxy::getParameterValue(QString className, QString parameter)
   */
 QStringList OMCProxy::getComponentModifierNames(QString className, QString name)
 {
-  return mpOMCInterface->getComponentModifierNames(className, name);
+  return mpOMCThread->call(&OMCInterface::getComponentModifierNames, className, name);
 }
 
 /*!
@@ -1003,7 +1111,7 @@ bool OMCProxy::setComponentModifierValue(QString className, QString modifierName
  */
 bool OMCProxy::removeComponentModifiers(QString className, QString name)
 {
-  return mpOMCInterface->removeComponentModifiers(className, name, true);
+  return mpOMCThread->call(&OMCInterface::removeComponentModifiers, className, name, true);
 }
 
 QStringList OMCProxy::getExtendsModifierNames(QString className, QString extendsClassName)
@@ -1070,7 +1178,50 @@ bool OMCProxy::isExtendsModifierFinal(QString className, QString extendsClassNam
  */
 bool OMCProxy::removeExtendsModifiers(QString className, QString extendsClassName)
 {
-  return mpOMCInterface->removeExtendsModifiers(className, extendsClassName, true);
+  return mpOMCThread->call(&OMCInterface::removeExtendsModifiers, className, extendsClassName, true);
+}
+
+/*!
+ * \brief OMCProxy::parseGraphicsAnnotation
+ * Parses the result of getIconAnnotation or getDiagramAnnotation.\n
+ * The result is a list of the coordinate system values followed by the list of graphic items e.g., {-100,-100,100,100,true,0.1,2,2,{Line(..)}}.
+ * The parsed result is kept in GraphicsAnnotationInfo::mpTree so the graphic items are handed to the shapes without parsing them again.
+ * \param annotation
+ * \return the coordinate system and the graphic items.
+ */
+GraphicsAnnotationInfo OMCProxy::parseGraphicsAnnotation(const QString &annotation)
+{
+  GraphicsAnnotationInfo graphicsAnnotationInfo;
+  graphicsAnnotationInfo.mHasCoOrdinateSystem = false;
+  graphicsAnnotationInfo.mpTree = QSharedPointer<OMCValueTree>(new OMCValueTree(annotation));
+  OMCValue list = graphicsAnnotationInfo.mpTree->getRoot();
+  // read the coordinate system
+  if (list.size() < 8) {
+    return graphicsAnnotationInfo;
+  }
+  qreal left = qMin(list.at(0).toReal(), list.at(2).toReal());
+  qreal bottom = qMin(list.at(1).toReal(), list.at(3).toReal());
+  qreal right = qMax(list.at(0).toReal(), list.at(2).toReal());
+  qreal top = qMax(list.at(1).toReal(), list.at(3).toReal());
+  QList<QPointF> extent;
+  extent << QPointF(left, bottom) << QPointF(right, top);
+  graphicsAnnotationInfo.mHasCoOrdinateSystem = true;
+  graphicsAnnotationInfo.mCoOrdinateSystem.setExtent(extent);
+  graphicsAnnotationInfo.mCoOrdinateSystem.setPreserveAspectRatio(list.at(4).toBool());
+  graphicsAnnotationInfo.mCoOrdinateSystem.setInitialScale(list.at(5).toReal());
+  graphicsAnnotationInfo.mCoOrdinateSystem.setGrid(QPointF(list.at(6).toReal(), list.at(7).toReal()));
+  // read the graphic items, each one is a call like Line(..). Keep its name and the call, its children are the arguments.
+  OMCValue shapes = list.at(8);
+  for (int i = 0 ; i < shapes.size() ; i++) {
+    if (!shapes.at(i).isCall()) {
+      continue;
+    }
+    GraphicItemInfo graphicItemInfo;
+    graphicItemInfo.mName = shapes.at(i).getName().toString();
+    graphicItemInfo.mAnnotation = shapes.at(i);
+    graphicsAnnotationInfo.mGraphicItems.append(graphicItemInfo);
+  }
+  return graphicsAnnotationInfo;
 }
 
 /*!
@@ -1078,11 +1229,11 @@ bool OMCProxy::removeExtendsModifiers(QString className, QString extendsClassNam
   \param className - is the name of the class.
   \return the icon annotation.
   */
-QString OMCProxy::getIconAnnotation(QString className)
+GraphicsAnnotationInfo OMCProxy::getIconAnnotation(QString className)
 {
   QString expression = "getIconAnnotation(" + className + ")";
   sendCommand(expression);
-  return getResult();
+  return parseGraphicsAnnotation(getResult());
 }
 
 /*!
@@ -1090,11 +1241,11 @@ QString OMCProxy::getIconAnnotation(QString className)
   \param className - is the name of the class.
   \return the diagram annotation.
   */
-QString OMCProxy::getDiagramAnnotation(QString className)
+GraphicsAnnotationInfo OMCProxy::getDiagramAnnotation(QString className)
 {
   QString expression = "getDiagramAnnotation(" + className + ")";
   sendCommand(expression);
-  return getResult();
+  return parseGraphicsAnnotation(getResult());
 }
 
 /*!
@@ -1145,6 +1296,66 @@ QString OMCProxy::getNthConnectionAnnotation(QString className, int num)
   return getResult();
 }
 
+/*!
+ * \brief OMCProxy::getConnections
+ * Returns all the connections of a model along with their annotations.\n
+ * The getNthConnection and getNthConnectionAnnotation calls are sent as one array expression
+ * e.g., {getNthConnection(A, 1), getNthConnectionAnnotation(A, 1), ...} and the reply is parsed once,
+ * so a model costs two round-trips, the count and the array, instead of two per connection.
+ * \param className - is the name of the model.
+ * \return the list of connections.
+ * \sa OMCProxy::getNthConnection()
+ * \sa OMCProxy::getNthConnectionAnnotation()
+ */
+QList<ConnectionInfo> OMCProxy::getConnections(QString className)
+{
+  QList<ConnectionInfo> connections;
+  int connectionCount = getConnectionCount(className);
+  if (connectionCount <= 0) {
+    return connections;
+  }
+  QStringList expressions;
+  for (int i = 1 ; i <= connectionCount ; i++) {
+    expressions << QString("getNthConnection(%1, %2)").arg(className).arg(i)
+                << QString("getNthConnectionAnnotation(%1, %2)").arg(className).arg(i);
+  }
+  sendCommand("{" + expressions.join(", ") + "}");
+  QSharedPointer<OMCValueTree> pTree(new OMCValueTree(getResult()));
+  // fall back to one call per item if the reply doesn't have one element per call.
+  if (pTree->getRoot().size() != expressions.size()) {
+    // forget the errors of the array expression.
+    getMessagesStringInternal();
+    QStringList results;
+    for (int i = 1 ; i <= connectionCount ; i++) {
+      results << getNthConnection(className, i) << getNthConnectionAnnotation(className, i);
+    }
+    pTree = QSharedPointer<OMCValueTree>(new OMCValueTree("{" + results.join(", ") + "}"));
+  }
+  OMCValue reply = pTree->getRoot();
+  for (int i = 0 ; i + 1 < reply.size() ; i += 2) {
+    OMCValue connection = reply.at(i);
+    // a connection with less than three items is not valid.
+    if (connection.size() < 3) {
+      continue;
+    }
+    ConnectionInfo connectionInfo;
+    connectionInfo.mConnection = connection.getSource().toString();
+    connectionInfo.mStartConnector = connection.at(0).toString();
+    connectionInfo.mEndConnector = connection.at(1).toString();
+    // only the Line of the connection annotation is used. Keep the parsed reply alive for it.
+    connectionInfo.mpTree = pTree;
+    OMCValue annotation = reply.at(i + 1);
+    for (int j = 0 ; j < annotation.size() ; j++) {
+      if (annotation.at(j).isCall() && annotation.at(j).getName() == QLatin1String("Line")) {
+        connectionInfo.mLineAnnotation = annotation.at(j);
+        break;
+      }
+    }
+    connections.append(connectionInfo);
+  }
+  return connections;
+}
+
 /*!
  * \brief OMCProxy::getInheritanceCount
  * Returns the inheritance count of a model.
@@ -1194,7 +1405,7 @@ QString OMCProxy::getNthInheritedClass(QString className, int num)
  */
 QList<QString> OMCProxy::getInheritedClasses(QString className)
 {
-  QList<QString> result = mpOMCInterface->getInheritedClasses(className);
+  QList<QString> result = mpOMCThread->call(&OMCInterface::getInheritedClasses, className);
   printMessagesStringInternal();
   return result;
 }
@@ -1210,12 +1421,12 @@ QList<ComponentInfo*> OMCProxy::getComponents(QString className)
 {
   QString expression = "getComponents(" + className + ", useQuotes = true)";
   sendCommand(expression);
-  QString result = getResult();
+  OMCValueTree tree(getResult());
+  OMCValue list = tree.getRoot();
   QList<ComponentInfo*> componentInfoList;
-  QStringList list = StringHandler::unparseArrays(result);
 
   for (int i = 0 ; i < list.size() ; i++) {
-    if (list.at(i) == "Error") {
+    if (!list.at(i).isArray() || list.at(i).size() == 0) {
       continue;
     }
     ComponentInfo *pComponentInfo = new ComponentInfo();
@@ -1227,21 +1438,46 @@ QList<ComponentInfo*> OMCProxy::getComponents(QString className)
 }
 
 /*!
-  Returns the component annotations of a model.
-  \param className - is the name of the model.
-  \return the list of component annotations.
-  */
-QStringList OMCProxy::getComponentAnnotations(QString className)
+ * \brief OMCProxy::getComponentAnnotations
+ * Gets the component annotations of a model and sets the Placement and Dialog annotations of the components.\n
+ * The annotations are in the same order as the components returned by OMCProxy::getComponents().
+ * \param className - is the name of the model.
+ * \param componentInfoList - is the list of components of the model.
+ */
+void OMCProxy::getComponentAnnotations(QString className, QList<ComponentInfo*> componentInfoList)
 {
   QString expression = "getComponentAnnotations(" + className + ")";
   sendCommand(expression);
-  return StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(getResult()));
+  OMCValueTree tree(getResult());
+  OMCValue list = tree.getRoot();
+  for (int i = 0 ; i < componentInfoList.size() && i < list.size() ; i++) {
+    OMCValue annotations = list.at(i);
+    // annotations that failed to instantiate are reported as an error string instead of a list.
+    if (!annotations.isArray()) {
+      continue;
+    }
+    for (int j = 0 ; j < annotations.size() ; j++) {
+      OMCValue annotation = annotations.at(j);
+      if (!annotation.isCall()) {
+        continue;
+      }
+      if (annotation.getName() == QLatin1String("Placement")) {
+        componentInfoList.at(i)->setPlacementAnnotation(annotation.getSource().toString());
+      } else if (annotation.getName() == QLatin1String("Dialog")) {
+        QStringList dialogAnnotation;
+        for (int k = 0 ; k < annotation.size() ; k++) {
+          dialogAnnotation.append(annotation.at(k).getSource().toString());
+        }
+        componentInfoList.at(i)->setDialogAnnotation(dialogAnnotation);
+      }
+    }
+  }
 }
 
 QString OMCProxy::getDocumentationAnnotationInfoHeader(LibraryTreeItem *pLibraryTreeItem, QString infoHeader)
 {
   if (pLibraryTreeItem && !pLibraryTreeItem->isRootItem()) {
-    QList<QString> docsList = mpOMCInterface->getDocumentationAnnotation(pLibraryTreeItem->getNameStructure());
+    QList<QString> docsList = mpOMCThread->call(&OMCInterface::getDocumentationAnnotation, pLibraryTreeItem->getNameStructure());
     infoHeader.prepend(docsList.at(2)); // __OpenModelica_infoHeader section is the 3rd item in the list
     return getDocumentationAnnotationInfoHeader(pLibraryTreeItem->parent(), infoHeader);
   } else {
@@ -1258,7 +1494,7 @@ QString OMCProxy::getDocumentationAnnotationInfoHeader(LibraryTreeItem *pLibrary
  */
 QString OMCProxy::getDocumentationAnnotation(LibraryTreeItem *pLibraryTreeItem)
 {
-  QList<QString> docsList = mpOMCInterface->getDocumentationAnnotation(pLibraryTreeItem->getNameStructure());
+  QList<QString> docsList = mpOMCThread->call(&OMCInterface::getDocumentationAnnotation, pLibraryTreeItem->getNameStructure());
   QString infoHeader = "";
   infoHeader = getDocumentationAnnotationInfoHeader(pLibraryTreeItem->parent(), infoHeader);
   // get the class comment and show it as the first line on the documentation page.
@@ -1312,7 +1548,7 @@ QString OMCProxy::getDocumentationAnnotation(LibraryTreeItem *pLibraryTreeItem)
  */
 QString OMCProxy::getClassComment(QString className)
 {
-  return mpOMCInterface->getClassComment(className);
+  return mpOMCThread->call(&OMCInterface::getClassComment, className);
 }
 
 /*!
@@ -1322,7 +1558,7 @@ QString OMCProxy::getClassComment(QString className)
   */
 QString OMCProxy::changeDirectory(QString directory)
 {
-  return mpOMCInterface->cd(directory);
+  return mpOMCThread->call(&OMCInterface::cd, directory);
 }
 
 /*!
@@ -1336,11 +1572,32 @@ bool OMCProxy::loadModel(QString className, QString priorityVersion, bool notify
   bool result = false;
   QList<QString> priorityVersionList;
   priorityVersionList << priorityVersion;
-  result = mpOMCInterface->loadModel(className, priorityVersionList, notify, languageStandard, requireExactVersion);
+  result = mpOMCThread->call(&OMCInterface::loadModel, className, priorityVersionList, notify, languageStandard, requireExactVersion);
   printMessagesStringInternal();
   return result;
 }
 
+/*!
+ * \brief OMCProxy::loadModelAsync
+ * Queues the loading of the library and returns immediately.\n
+ * OMCProxy::commandFinished is emitted with the returned id and "true" or "false" once the library is loaded.
+ * \param className
+ * \param priorityVersion
+ * \param notify
+ * \param languageStandard
+ * \param requireExactVersion
+ * \return the request id.
+ * \sa OMCProxy::loadModel()
+ */
+int OMCProxy::loadModelAsync(QString className, QString priorityVersion, bool notify, QString languageStandard, bool requireExactVersion)
+{
+  QList<QString> priorityVersionList;
+  priorityVersionList << priorityVersion;
+  int id = mpOMCThread->post(&OMCInterface::loadModel, className, priorityVersionList, notify, languageStandard, requireExactVersion);
+  mAsyncJobs.insert(id, LoadModelAsyncJob);
+  return id;
+}
+
 /*!
   Loads a file in OMC
   \param fileName - the file to load.
@@ -1350,7 +1607,7 @@ bool OMCProxy::loadFile(QString fileName, QString encoding, bool uses)
 {
   bool result = false;
   fileName = fileName.replace('\\', '/');
-  result = mpOMCInterface->loadFile(fileName, encoding, uses);
+  result = mpOMCThread->call(&OMCInterface::loadFile, fileName, encoding, uses);
   printMessagesStringInternal();
   return result;
 }
@@ -1367,7 +1624,7 @@ bool OMCProxy::loadFile(QString fileName, QString encoding, bool uses)
  */
 bool OMCProxy::loadString(QString value, QString fileName, QString encoding, bool merge, bool checkError)
 {
-  bool result = mpOMCInterface->loadString(value, fileName, encoding, merge);
+  bool result = mpOMCThread->call(&OMCInterface::loadString, value, fileName, encoding, merge);
   if (checkError) {
     printMessagesStringInternal();
   }
@@ -1383,7 +1640,7 @@ QList<QString> OMCProxy::parseFile(QString fileName, QString encoding)
 {
   QList<QString> result;
   fileName = fileName.replace('\\', '/');
-  result = mpOMCInterface->parseFile(fileName, encoding);
+  result = mpOMCThread->call(&OMCInterface::parseFile, fileName, encoding);
   if (result.isEmpty()) {
     printMessagesStringInternal();
   }
@@ -1398,7 +1655,7 @@ QList<QString> OMCProxy::parseFile(QString fileName, QString encoding)
 QList<QString> OMCProxy::parseString(QString value, QString fileName)
 {
   QList<QString> result;
-  result = mpOMCInterface->parseString(value, fileName);
+  result = mpOMCThread->call(&OMCInterface::parseString, value, fileName);
   printMessagesStringInternal();
   return result;
 }
@@ -1501,7 +1758,7 @@ bool OMCProxy::deleteClass(QString className)
  */
 QString OMCProxy::getSourceFile(QString className)
 {
-  QString file = mpOMCInterface->getSourceFile(className);
+  QString file = mpOMCThread->call(&OMCInterface::getSourceFile, className);
   if (file.compare("<interactive>") == 0) {
     return "";
   } else {
@@ -1518,7 +1775,7 @@ QString OMCProxy::getSourceFile(QString className)
  */
 bool OMCProxy::setSourceFile(QString className, QString path)
 {
-  return mpOMCInterface->setSourceFile(className, path);
+  return mpOMCThread->call(&OMCInterface::setSourceFile, className, path);
 }
 
 /*!
@@ -1556,7 +1813,7 @@ bool OMCProxy::saveModifiedModel(QString modelText)
  */
 bool OMCProxy::saveTotalModel(QString fileName, QString className)
 {
-  bool result = mpOMCInterface->saveTotalModel(fileName, className);
+  bool result = mpOMCThread->call(&OMCInterface::saveTotalModel, fileName, className);
   if (!result) {
     printMessagesStringInternal();
   }
@@ -1586,7 +1843,7 @@ QString OMCProxy::list(QString className)
  */
 QString OMCProxy::listFile(QString className)
 {
-  QString result = mpOMCInterface->listFile(className);
+  QString result = mpOMCThread->call(&OMCInterface::listFile, className);
   printMessagesStringInternal();
   return result;
 }
@@ -1925,7 +2182,7 @@ bool OMCProxy::translateModel(QString className, QString simualtionParameters)
  */
 QStringList OMCProxy::readSimulationResultVars(QString fileName)
 {
-  QStringList variablesList = mpOMCInterface->readSimulationResultVars(fileName, true, false);
+  QStringList variablesList = mpOMCThread->call(&OMCInterface::readSimulationResultVars, fileName, true, false);
   qSort(variablesList.begin(), variablesList.end());
   printMessagesStringInternal();
   return variablesList;
@@ -1941,7 +2198,7 @@ QStringList OMCProxy::readSimulationResultVars(QString fileName)
 bool OMCProxy::closeSimulationResultFile()
 {
 #ifdef Q_OS_WIN
-  return mpOMCInterface->closeSimulationResultFile();
+  return mpOMCThread->call(&OMCInterface::closeSimulationResultFile);
 #else
   return true;
 #endif
@@ -1955,12 +2212,27 @@ bool OMCProxy::closeSimulationResultFile()
  */
 QString OMCProxy::checkModel(QString className)
 {
-  QString result = mpOMCInterface->checkModel(className);
+  QString result = mpOMCThread->call(&OMCInterface::checkModel, className);
   printMessagesStringInternal();
   mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
   return result;
 }
 
+/*!
+ * \brief OMCProxy::checkModelAsync
+ * Queues the checking of the model and returns immediately.\n
+ * OMCProxy::commandFinished is emitted with the returned id and the model check result once it is done.
+ * \param className - the name of the class.
+ * \return the request id.
+ * \sa OMCProxy::checkModel()
+ */
+int OMCProxy::checkModelAsync(QString className)
+{
+  int id = mpOMCThread->post(&OMCInterface::checkModel, className);
+  mAsyncJobs.insert(id, ModelAsyncJob);
+  return id;
+}
+
 /*!
   Converts a given ngspice netlist to equivalent Modelica code.
   Filename is the name of the ngspice netlist. Subcircuit and device model (.lib) files
@@ -1982,12 +2254,27 @@ bool OMCProxy::ngspicetoModelica(QString fileName)
  */
 QString OMCProxy::checkAllModelsRecursive(QString className)
 {
-  QString result = mpOMCInterface->checkAllModelsRecursive(className, false);
+  QString result = mpOMCThread->call(&OMCInterface::checkAllModelsRecursive, className, false);
   printMessagesStringInternal();
   mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
   return result;
 }
 
+/*!
+ * \brief OMCProxy::checkAllModelsRecursiveAsync
+ * Queues the checking of all the nested classes and returns immediately.\n
+ * OMCProxy::commandFinished is emitted with the returned id and the model check result once it is done.
+ * \param className - the name of the class.
+ * \return the request id.
+ * \sa OMCProxy::checkAllModelsRecursive()
+ */
+int OMCProxy::checkAllModelsRecursiveAsync(QString className)
+{
+  int id = mpOMCThread->post(&OMCInterface::checkAllModelsRecursive, className, false);
+  mAsyncJobs.insert(id, ModelAsyncJob);
+  return id;
+}
+
 /*!
  * \brief OMCProxy::instantiateModel
  * Instantiates the model.
@@ -1996,12 +2283,27 @@ QString OMCProxy::checkAllModelsRecursive(QString className)
  */
 QString OMCProxy::instantiateModel(QString className)
 {
-  QString result = mpOMCInterface->instantiateModel(className);
+  QString result = mpOMCThread->call(&OMCInterface::instantiateModel, className);
   printMessagesStringInternal();
   mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
   return result;
 }
 
+/*!
+ * \brief OMCProxy::instantiateModelAsync
+ * Queues the instantiation of the model and returns immediately.\n
+ * OMCProxy::commandFinished is emitted with the returned id and the instantiated model once it is done.
+ * \param className - the name of the class.
+ * \return the request id.
+ * \sa OMCProxy::instantiateModel()
+ */
+int OMCProxy::instantiateModelAsync(QString className)
+{
+  int id = mpOMCThread->post(&OMCInterface::instantiateModel, className);
+  mAsyncJobs.insert(id, ModelAsyncJob);
+  return id;
+}
+
 /*!
  * \brief OMCProxy::isExperiment
  * Returns the simulation options stored in the model.
@@ -2010,7 +2312,7 @@ QString OMCProxy::instantiateModel(QString className)
  */
 bool OMCProxy::isExperiment(QString className)
 {
-  return mpOMCInterface->isExperiment(className);
+  return mpOMCThread->call(&OMCInterface::isExperiment, className);
 }
 
 /*!
@@ -2022,7 +2324,7 @@ bool OMCProxy::isExperiment(QString className)
  */
 OMCInterface::getSimulationOptions_res OMCProxy::getSimulationOptions(QString className, double defaultTolerance)
 {
-  return mpOMCInterface->getSimulationOptions(className, 0.0, 1.0, defaultTolerance, 500, 0.0);
+  return mpOMCThread->call(&OMCInterface::getSimulationOptions, className, 0.0, 1.0, defaultTolerance, 500, 0.0);
 }
 
 /*!
@@ -2039,7 +2341,7 @@ bool OMCProxy::buildModelFMU(QString className, double version, QString type, QS
 {
   bool result = false;
   fileNamePrefix = fileNamePrefix.isEmpty() ? "<default>" : fileNamePrefix;
-  QString res = mpOMCInterface->buildModelFMU(className, QString::number(version), type, fileNamePrefix, platforms);
+  QString res = mpOMCThread->call(&OMCInterface::buildModelFMU, className, QString::number(version), type, fileNamePrefix, platforms);
   if (res.compare("SimCode: The model " + className + " has been translated to FMU") == 0) {
     result = true;
     mpMainWindow->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
@@ -2080,7 +2382,7 @@ QString OMCProxy::importFMU(QString fmuName, QString outputDirectory, int logLev
                             bool generateOutputConnectors)
 {
   outputDirectory = outputDirectory.isEmpty() ? "<default>" : outputDirectory;
-  QString fmuFileName = mpOMCInterface->importFMU(fmuName, outputDirectory, logLevel, true, debugLogging, generateInputConnectors,
+  QString fmuFileName = mpOMCThread->call(&OMCInterface::importFMU, fmuName, outputDirectory, logLevel, true, debugLogging, generateInputConnectors,
                                                   generateOutputConnectors);
   printMessagesStringInternal();
   return fmuFileName;
@@ -2092,7 +2394,7 @@ QString OMCProxy::importFMU(QString fmuName, QString outputDirectory, int logLev
   */
 QString OMCProxy::getMatchingAlgorithm()
 {
-  return mpOMCInterface->getMatchingAlgorithm();
+  return mpOMCThread->call(&OMCInterface::getMatchingAlgorithm);
 }
 
 /*!
@@ -2102,7 +2404,7 @@ QString OMCProxy::getMatchingAlgorithm()
  */
 OMCInterface::getAvailableMatchingAlgorithms_res OMCProxy::getAvailableMatchingAlgorithms()
 {
-  return mpOMCInterface->getAvailableMatchingAlgorithms();
+  return mpOMCThread->call(&OMCInterface::getAvailableMatchingAlgorithms);
 }
 
 /*!
@@ -2112,7 +2414,7 @@ OMCInterface::getAvailableMatchingAlgorithms_res OMCProxy::getAvailableMatchingA
  */
 QString OMCProxy::getIndexReductionMethod()
 {
-  return mpOMCInterface->getIndexReductionMethod();
+  return mpOMCThread->call(&OMCInterface::getIndexReductionMethod);
 }
 
 /*!
@@ -2138,7 +2440,7 @@ bool OMCProxy::setMatchingAlgorithm(QString matchingAlgorithm)
  */
 OMCInterface::getAvailableIndexReductionMethods_res OMCProxy::getAvailableIndexReductionMethods()
 {
-  return mpOMCInterface->getAvailableIndexReductionMethods();
+  return mpOMCThread->call(&OMCInterface::getAvailableIndexReductionMethods);
 }
 
 /*!
@@ -2166,7 +2468,7 @@ bool OMCProxy::setIndexReductionMethod(QString method)
  */
 bool OMCProxy::setCommandLineOptions(QString options)
 {
-  bool result = mpOMCInterface->setCommandLineOptions(options);
+  bool result = mpOMCThread->call(&OMCInterface::setCommandLineOptions, options);
   if (!result) {
     printMessagesStringInternal();
   }
@@ -2180,7 +2482,7 @@ bool OMCProxy::setCommandLineOptions(QString options)
  */
 bool OMCProxy::clearCommandLineOptions()
 {
-  bool result = mpOMCInterface->clearCommandLineOptions();
+  bool result = mpOMCThread->call(&OMCInterface::clearCommandLineOptions);
   if (result) {
     return true;
   } else {
@@ -2189,6 +2491,17 @@ bool OMCProxy::clearCommandLineOptions()
   }
 }
 
+/*!
+ * \brief OMCProxy::getCommandLineOptions
+ * Returns the OMC flags.
+ * \return the list of flags.
+ */
+QStringList OMCProxy::getCommandLineOptions()
+{
+  sendCommand("getCommandLineOptions()");
+  return StringHandler::unparseStrings(getResult());
+}
+
 /*!
  * \brief OMCProxy::makeDocumentationUriToFileName
  * Helper function for getDocumentationAnnotation. Takes the documentation html and replaces the modelica links with absolute pahts.\n
@@ -2273,7 +2586,7 @@ QString OMCProxy::uriToFilename(QString uri)
  */
 QString OMCProxy::getModelicaPath()
 {
-  QString result = mpOMCInterface->getModelicaPath();
+  QString result = mpOMCThread->call(&OMCInterface::getModelicaPath);
   printMessagesStringInternal();
   return result;
 }
@@ -2285,7 +2598,7 @@ QString OMCProxy::getModelicaPath()
  */
 QStringList OMCProxy::getAvailableLibraries()
 {
-  return mpOMCInterface->getAvailableLibraries();
+  return mpOMCThread->call(&OMCInterface::getAvailableLibraries);
 }
 
 /*!
@@ -2297,7 +2610,7 @@ QStringList OMCProxy::getAvailableLibraries()
  */
 QString OMCProxy::getDerivedClassModifierValue(QString className, QString modifierName)
 {
-  return mpOMCInterface->getDerivedClassModifierValue(className, modifierName);
+  return mpOMCThread->call(&OMCInterface::getDerivedClassModifierValue, className, modifierName);
 }
 
 /*!
@@ -2315,7 +2628,7 @@ OMCInterface::convertUnits_res OMCProxy::convertUnits(QString from, QString to)
       return unitConversion.mConvertUnits;
     }
   }
-  OMCInterface::convertUnits_res convertUnits_res = mpOMCInterface->convertUnits(from, to);
+  OMCInterface::convertUnits_res convertUnits_res = mpOMCThread->call(&OMCInterface::convertUnits, from, to);
   UnitConverion unitConverion;
   unitConverion.mFromUnit = from;
   unitConverion.mToUnit = to;
@@ -2336,13 +2649,11 @@ OMCInterface::convertUnits_res OMCProxy::convertUnits(QString from, QString to)
  */
 QList<QString> OMCProxy::getDerivedUnits(QString baseUnit)
 {
-  QMap<QString, QList<QString> >::iterator derivedUnitsIterator;
-  for (derivedUnitsIterator = mDerivedUnitsMap.begin(); derivedUnitsIterator != mDerivedUnitsMap.end(); ++derivedUnitsIterator) {
-    if (derivedUnitsIterator.key().compare(baseUnit) == 0) {
-      return derivedUnitsIterator.value();
-    }
+  QMap<QString, QList<QString> >::const_iterator derivedUnitsIterator = mDerivedUnitsMap.constFind(baseUnit);
+  if (derivedUnitsIterator != mDerivedUnitsMap.constEnd()) {
+    return derivedUnitsIterator.value();
   }
-  QList<QString> result = mpOMCInterface->getDerivedUnits(baseUnit);
+  QList<QString> result = mpOMCThread->call(&OMCInterface::getDerivedUnits, baseUnit);
   getErrorString();
   mDerivedUnitsMap.insert(baseUnit, result);
   return result;
@@ -2380,7 +2691,7 @@ QString OMCProxy::getCommandLineOptionsAnnotation(QString className)
  */
 QList<QString> OMCProxy::getAnnotationNamedModifiers(QString className, QString annotation)
 {
-  QList<QString> result = mpOMCInterface->getAnnotationNamedModifiers(className, annotation);
+  QList<QString> result = mpOMCThread->call(&OMCInterface::getAnnotationNamedModifiers, className, annotation);
   if (result.isEmpty()) {
     printMessagesStringInternal();
   }
@@ -2397,7 +2708,7 @@ QList<QString> OMCProxy::getAnnotationNamedModifiers(QString className, QString
  */
 QString OMCProxy::getAnnotationModifierValue(QString className, QString annotation, QString modifier)
 {
-  return mpOMCInterface->getAnnotationModifierValue(className, annotation, modifier);
+  return mpOMCThread->call(&OMCInterface::getAnnotationModifierValue, className, annotation, modifier);
 }
 
 /*!
@@ -2424,7 +2735,7 @@ QString OMCProxy::getSimulationFlagsAnnotation(QString className)
  */
 int OMCProxy::numProcessors()
 {
-  return mpOMCInterface->numProcessors();
+  return mpOMCThread->call(&OMCInterface::numProcessors);
 }
 
 /*!
@@ -2434,7 +2745,7 @@ int OMCProxy::numProcessors()
  */
 QString OMCProxy::help(QString topic)
 {
-  return mpOMCInterface->help(topic);
+  return mpOMCThread->call(&OMCInterface::help, topic);
 }
 
 /*!
@@ -2444,7 +2755,7 @@ QString OMCProxy::help(QString topic)
  */
 OMCInterface::getConfigFlagValidOptions_res OMCProxy::getConfigFlagValidOptions(QString topic)
 {
-  return mpOMCInterface->getConfigFlagValidOptions(topic);
+  return mpOMCThread->call(&OMCInterface::getConfigFlagValidOptions, topic);
 }
 
 /*!
@@ -2472,7 +2783,7 @@ bool OMCProxy::setDebugFlags(QString debugFlags)
 bool OMCProxy::exportToFigaro(QString className, QString directory, QString database, QString mode, QString options, QString processor)
 {
   bool result = false;
-  result = mpOMCInterface->exportToFigaro(className, directory, database, mode, options, processor);
+  result = mpOMCThread->call(&OMCInterface::exportToFigaro, className, directory, database, mode, options, processor);
   if (!result) {
     printMessagesStringInternal();
   }
@@ -2489,7 +2800,7 @@ bool OMCProxy::exportToFigaro(QString className, QString directory, QString data
  */
 bool OMCProxy::copyClass(QString className, QString newClassName, QString withIn)
 {
-  bool result = mpOMCInterface->copyClass(className, newClassName, withIn.isEmpty() ? "TopLevel" : withIn);
+  bool result = mpOMCThread->call(&OMCInterface::copyClass, className, newClassName, withIn.isEmpty() ? "TopLevel" : withIn);
   if (!result) printMessagesStringInternal();
   return result;
 }
@@ -2610,7 +2921,7 @@ void OMCProxy::getLogStreams(QStringList *names, QStringList *descriptions)
  */
 bool OMCProxy::moveClass(QString className, int offset)
 {
-  return mpOMCInterface->moveClass(className, offset);
+  return mpOMCThread->call(&OMCInterface::moveClass, className, offset);
 }
 
 /*!
@@ -2621,7 +2932,7 @@ bool OMCProxy::moveClass(QString className, int offset)
  */
 bool OMCProxy::moveClassToTop(QString className)
 {
-  return mpOMCInterface->moveClassToTop(className);
+  return mpOMCThread->call(&OMCInterface::moveClassToTop, className);
 }
 
 /*!
@@ -2632,7 +2943,7 @@ bool OMCProxy::moveClassToTop(QString className)
  */
 bool OMCProxy::moveClassToBottom(QString className)
 {
-  return mpOMCInterface->moveClassToBottom(className);
+  return mpOMCThread->call(&OMCInterface::moveClassToBottom, className);
 }
 
 /*!
@@ -2643,7 +2954,7 @@ bool OMCProxy::moveClassToBottom(QString className)
  */
 bool OMCProxy::inferBindings(QString className)
 {
-  bool result = mpOMCInterface->inferBindings(className);
+  bool result = mpOMCThread->call(&OMCInterface::inferBindings, className);
   printMessagesStringInternal();
   return result;
 }
@@ -2656,7 +2967,7 @@ bool OMCProxy::inferBindings(QString className)
  */
 QList<QList<QString > > OMCProxy::getUses(QString className)
 {
-  QList<QList<QString > > result = mpOMCInterface->getUses(className);
+  QList<QList<QString > > result = mpOMCThread->call(&OMCInterface::getUses, className);
   printMessagesStringInternal();
   return result;
 }
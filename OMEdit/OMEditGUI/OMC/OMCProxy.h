@@ -36,10 +36,13 @@
 #define OMCPROXY_H
 
 #include "OpenModelicaScriptingAPIQt.h"
+#include "OMCThread.h"
 #include "MainWindow.h"
 #include "Component.h"
 #include "StringHandler.h"
 #include "Utilities.h"
+#include "CoOrdinateSystem.h"
+#include "OMCValue.h"
 
 class MainWindow;
 class CustomExpressionBox;
@@ -47,6 +50,8 @@ class ComponentInfo;
 class StringHandler;
 class OMCInterface;
 class LibraryTreeItem;
+class OMCThread;
+class OMCJob;
 
 typedef struct {
   QString mFromUnit;
@@ -54,6 +59,28 @@ typedef struct {
   OMCInterface::convertUnits_res mConvertUnits;
 } UnitConverion;
 
+typedef struct {
+  QString mConnection;
+  QString mStartConnector;
+  QString mEndConnector;
+  /* the Line(..) call of the connection annotation, valid as long as mpTree exists. */
+  QSharedPointer<OMCValueTree> mpTree;
+  OMCValue mLineAnnotation;
+} ConnectionInfo;
+
+typedef struct {
+  QString mName;
+  /* the Line(..), Polygon(..) etc. call, valid as long as the GraphicsAnnotationInfo::mpTree it was taken from exists. */
+  OMCValue mAnnotation;
+} GraphicItemInfo;
+
+typedef struct {
+  bool mHasCoOrdinateSystem;
+  CoOrdinateSystem mCoOrdinateSystem;
+  QSharedPointer<OMCValueTree> mpTree;
+  QList<GraphicItemInfo> mGraphicItems;
+} GraphicsAnnotationInfo;
+
 class OMCProxy : public QObject
 {
   Q_OBJECT
@@ -83,7 +110,12 @@ private:
   double mTotalOMCCallsTime;
   QList<UnitConverion> mUnitConversionList;
   QMap<QString, QList<QString> > mDerivedUnitsMap;
-  OMCInterface *mpOMCInterface;
+  OMCThread *mpOMCThread;
+  enum AsyncJobType {CommandAsyncJob, LoadModelAsyncJob, ModelAsyncJob, ClassesInformationAsyncJob};
+  QHash<int, AsyncJobType> mAsyncJobs;
+
+  GraphicsAnnotationInfo parseGraphicsAnnotation(const QString &annotation);
+  void updateClassInformationComment(OMCInterface::getClassInformation_res *pClassInformation);
 public:
   OMCProxy(MainWindow *pMainWindow);
   ~OMCProxy();
@@ -92,6 +124,7 @@ public:
   bool initializeOMC();
   void quitOMC();
   void sendCommand(const QString expression);
+  int sendCommandAsync(const QString expression);
   void setResult(QString value);
   QString getResult();
   void exitApplication();
@@ -116,6 +149,7 @@ public:
                             bool sort = false, bool builtin = false, bool showProtected = true);
   QStringList searchClassNames(QString searchText, bool findInText = false);
   OMCInterface::getClassInformation_res getClassInformation(QString className);
+  int getClassesInformationAsync(QStringList classNames);
   bool isPackage(QString className);
   bool isBuiltinType(QString typeName);
   QString getBuiltinType(QString typeName);
@@ -134,22 +168,25 @@ public:
   bool setExtendsModifierValue(QString className, QString extendsClassName, QString modifierName, QString modifierValue);
   bool isExtendsModifierFinal(QString className, QString extendsClassName, QString modifierName);
   bool removeExtendsModifiers(QString className, QString extendsClassName);
-  QString getIconAnnotation(QString className);
-  QString getDiagramAnnotation(QString className);
+  GraphicsAnnotationInfo getIconAnnotation(QString className);
+  GraphicsAnnotationInfo getDiagramAnnotation(QString className);
   int getConnectionCount(QString className);
   QString getNthConnection(QString className, int num);
   QString getNthConnectionAnnotation(QString className, int num);
+  QList<ConnectionInfo> getConnections(QString className);
   int getInheritanceCount(QString className);
   QString getNthInheritedClass(QString className, int num);
   QList<QString> getInheritedClasses(QString className);
   QList<ComponentInfo*> getComponents(QString className);
-  QStringList getComponentAnnotations(QString className);
+  void getComponentAnnotations(QString className, QList<ComponentInfo*> componentInfoList);
   QString getDocumentationAnnotationInfoHeader(LibraryTreeItem *pLibraryTreeItem, QString infoHeader);
   QString getDocumentationAnnotation(LibraryTreeItem *pLibraryTreeItem);
   QString getClassComment(QString className);
   QString changeDirectory(QString directory = QString(""));
   bool loadModel(QString className, QString priorityVersion = QString("default"), bool notify = false, QString languageStandard = QString(""),
                  bool requireExactVersion = false);
+  int loadModelAsync(QString className, QString priorityVersion = QString("default"), bool notify = false,
+                     QString languageStandard = QString(""), bool requireExactVersion = false);
   bool loadFile(QString fileName, QString encoding = Helper::utf8, bool uses = true);
   bool loadString(QString value, QString fileName, QString encoding = Helper::utf8, bool merge = false, bool checkError = true);
   QList<QString> parseFile(QString fileName, QString encoding = Helper::utf8);
@@ -168,6 +205,7 @@ public:
   QString listFile(QString className);
   QString diffModelicaFileListings(QString before, QString after);
   QString instantiateModel(QString className);
+  int instantiateModelAsync(QString className);
   bool addClassAnnotation(QString className, QString annotation);
   QString getDefaultComponentName(QString className);
   QString getDefaultComponentPrefixes(QString className);
@@ -189,8 +227,10 @@ public:
   QStringList readSimulationResultVars(QString fileName);
   bool closeSimulationResultFile();
   QString checkModel(QString className);
+  int checkModelAsync(QString className);
   bool ngspicetoModelica(QString fileName);
   QString checkAllModelsRecursive(QString className);
+  int checkAllModelsRecursiveAsync(QString className);
   bool isExperiment(QString className);
   OMCInterface::getSimulationOptions_res getSimulationOptions(QString className, double defaultTolerance = 1e-4);
   bool buildModelFMU(QString className, double version, QString type, QString fileNamePrefix, QList<QString> platforms);
@@ -204,6 +244,7 @@ public:
   bool setIndexReductionMethod(QString method);
   bool setCommandLineOptions(QString options);
   bool clearCommandLineOptions();
+  QStringList getCommandLineOptions();
   QString makeDocumentationUriToFileName(QString documentation);
   QString uriToFilename(QString uri);
   QString getModelicaPath();
@@ -236,11 +277,14 @@ public:
   bool inferBindings(QString className);
   QList<QList<QString > > getUses(QString className);
 signals:
-  void commandFinished();
+  void commandFinished(int id, QString result);
+  void classesInformationFinished(int id, QStringList classNames, QList<OMCInterface::getClassInformation_res> classesInformation);
 public slots:
   void logCommand(QString command, QTime *commandTime);
   void logResponse(QString response, QTime *responseTime);
   void showException(QString exception);
+  void plotCallback(QStringList arguments);
+  void handleJobFinished(OMCJob *pOMCJob);
   void openOMCLoggerWidget();
   void sendCustomExpression();
   void openOMCDiffWidget();
@@ -0,0 +1,453 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "meta/meta_modelica.h"
+
+extern "C" {
+void (*omc_assert)(threadData_t*,FILE_INFO info,const char *msg,...) __attribute__((noreturn)) = omc_assert_function;
+void (*omc_assert_warning)(FILE_INFO info,const char *msg,...) = omc_assert_warning_function;
+void (*omc_terminate)(FILE_INFO info,const char *msg,...) = omc_terminate_function;
+void (*omc_throw)(threadData_t*) __attribute__ ((noreturn)) = omc_throw_function;
+int omc_Main_handleCommand(void *threadData, void *imsg, void *ist, void **omsg, void **ost);
+void* omc_Main_init(void *threadData, void *args);
+void* omc_Main_readSettings(void *threadData, void *args);
+#ifdef WIN32
+void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
+#endif
+}
+
+#include <stdlib.h>
+
+#include "OMCThread.h"
+#include "OMCProxy.h"
+#include "omc_error.h"
+
+/*!
+ * \brief OMCCommandJob::run
+ * Sends the expression to OMC. Called on the OMC thread.
+ * \param pOMCInterface
+ */
+void OMCCommandJob::run(OMCInterface *pOMCInterface)
+{
+  void *reply_str = NULL;
+  threadData_t *threadData = pOMCInterface->threadData;
+
+  MMC_TRY_TOP_INTERNAL()
+
+  MMC_TRY_STACK()
+
+  if (!omc_Main_handleCommand(threadData, mmc_mk_scon(mExpression.toStdString().c_str()), pOMCInterface->st, &reply_str, &pOMCInterface->st)) {
+    mSuccess = false;
+  } else {
+    mResult = MMC_STRINGDATA(reply_str);
+  }
+
+  MMC_ELSE()
+    mResult = "";
+    fprintf(stderr, "Stack overflow detected and was not caught.\nSend us a bug report at https://trac.openmodelica.org/OpenModelica/newticket\n    Include the following trace:\n");
+    printStacktraceMessages();
+    fflush(NULL);
+  MMC_CATCH_STACK()
+
+  MMC_CATCH_TOP(mResult = "");
+}
+
+/*!
+ * \class OMCLogRequest
+ * \brief Writes a command or a response of the OMC thread to the OMC Logger on the GUI thread.
+ */
+class OMCLogRequest : public OMCGuiRequest
+{
+public:
+  OMCLogRequest(bool response, const QString &text, QTime *pTime) : mResponse(response), mText(text), mpTime(pTime) {}
+  virtual void run(OMCProxy *pOMCProxy)
+  {
+    if (mResponse) {
+      pOMCProxy->logResponse(mText, mpTime);
+    } else {
+      pOMCProxy->logCommand(mText, mpTime);
+    }
+  }
+private:
+  bool mResponse;
+  QString mText;
+  QTime *mpTime;
+};
+
+/*!
+ * \class OMCPlotRequest
+ * \brief Calls OMCProxy::plotCallback on the GUI thread.
+ */
+class OMCPlotRequest : public OMCGuiRequest
+{
+public:
+  OMCPlotRequest(const QStringList &arguments) : mArguments(arguments) {}
+  virtual void run(OMCProxy *pOMCProxy) {pOMCProxy->plotCallback(mArguments);}
+private:
+  QStringList mArguments;
+};
+
+/*!
+ * \class OMCThread
+ * \brief The dedicated thread that owns the OMC runtime state.
+ */
+/*!
+ * \param pOMCProxy - pointer to OMCProxy
+ */
+OMCThread::OMCThread(OMCProxy *pOMCProxy)
+  : QThread(pOMCProxy), mpOMCProxy(pOMCProxy), mpOMCInterface(0), mInitialized(false), mStartupFinished(false), mRunning(true),
+    mLastJobId(0)
+{
+  // OMC uses deep recursion so give the thread the same stack size as the main thread.
+#if defined(__MINGW32__) && !defined(__MINGW64__)
+  setStackSize(16777216);
+#else
+  setStackSize(33554432);
+#endif
+#if defined(GC_THREADS)
+  // must be called from the main thread before any other thread registers itself with the garbage collector.
+  GC_allow_register_threads();
+#endif
+}
+
+OMCThread::~OMCThread()
+{
+  stopOMC();
+}
+
+/*!
+ * \brief OMCThread::startOMC
+ * Starts the thread and waits until the OMC runtime is initialized.
+ * \return true if OMC is initialized successfully.
+ */
+bool OMCThread::startOMC()
+{
+  if (isRunning()) {
+    return mInitialized;
+  }
+  start();
+  QMutexLocker locker(&mMutex);
+  while (!mStartupFinished) {
+    if (!runGuiRequest(&locker)) {
+      mJobFinished.wait(&mMutex);
+    }
+  }
+  return mInitialized;
+}
+
+/*!
+ * \brief OMCThread::stopOMC
+ * Stops the job loop and waits for the thread to finish. Jobs still in the queue are discarded.
+ */
+void OMCThread::stopOMC()
+{
+  if (!isRunning()) {
+    return;
+  }
+  mMutex.lock();
+  mRunning = false;
+  mJobAvailable.wakeAll();
+  mMutex.unlock();
+  wait();
+  // the posted jobs are owned by the thread, the others by the callers of OMCThread::execute().
+  while (!mJobsQueue.isEmpty()) {
+    OMCJob *pOMCJob = mJobsQueue.dequeue();
+    if (pOMCJob->getId() > 0) {
+      delete pOMCJob;
+    }
+  }
+  qDeleteAll(mFinishedJobsQueue);
+  mFinishedJobsQueue.clear();
+}
+
+/*!
+ * \brief OMCThread::execute
+ * Queues the job and blocks until it is finished.\n
+ * Only the OMCGuiRequest sent by the OMC thread are run while waiting.
+ * \param pOMCJob - the job to execute. The caller owns the job.
+ */
+void OMCThread::execute(OMCJob *pOMCJob)
+{
+  // a job executed from the OMC thread itself e.g., from OMCJob::run() can't wait for the queue.
+  if (QThread::currentThread() == this) {
+    pOMCJob->run(mpOMCInterface);
+    pOMCJob->setFinished();
+    return;
+  }
+  mMutex.lock();
+  mJobsQueue.enqueue(pOMCJob);
+  mJobAvailable.wakeAll();
+  mMutex.unlock();
+  waitForJobs(pOMCJob);
+}
+
+/*!
+ * \brief OMCThread::post
+ * Queues the job and returns immediately.\n
+ * OMCThread::jobFinished is emitted on the GUI thread once the job is done, after that the job is deleted.
+ * Jobs are executed in the order they are queued, so several calls can be pipelined and
+ * a later OMCThread::execute() waits for the posted jobs before it.
+ * \param pOMCJob - the job to execute. The OMCThread takes the ownership.
+ * \return the id of the job.
+ */
+int OMCThread::post(OMCJob *pOMCJob)
+{
+  QMutexLocker locker(&mMutex);
+  pOMCJob->setId(++mLastJobId);
+  mJobsQueue.enqueue(pOMCJob);
+  mJobAvailable.wakeAll();
+  return pOMCJob->getId();
+}
+
+/*!
+ * \brief OMCThread::PlotCallbackFunction
+ * OMC calls this from the OMC thread when a plot command is evaluated.\n
+ * Sends OMCProxy::plotCallback to the GUI thread and keeps processing the jobs until it is done,
+ * since plotting reads the result file through OMC again.
+ */
+void OMCThread::PlotCallbackFunction(void *p, int externalWindow, const char* filename, const char *title, const char *grid,
+                                     const char *plotType, const char *logX, const char *logY, const char *xLabel, const char *yLabel,
+                                     const char *x1, const char *x2, const char *y1, const char *y2, const char *curveWidth,
+                                     const char *curveStyle, const char *legendPosition, const char *footer, const char *autoScale,
+                                     const char *variables)
+{
+  OMCThread *pOMCThread = (OMCThread*)p;
+  if (!pOMCThread) {
+    return;
+  }
+  QStringList arguments;
+  arguments << QString::number(externalWindow) << filename << title << grid << plotType << logX << logY << xLabel << yLabel << x1 << x2
+            << y1 << y2 << curveWidth << curveStyle << legendPosition << footer << autoScale << variables;
+  OMCPlotRequest plotRequest(arguments);
+  pOMCThread->sendGuiRequest(&plotRequest);
+  pOMCThread->processJobs(&plotRequest);
+}
+
+/*!
+ * \brief OMCThread::logCommand
+ * Connected directly to OMCInterface::logCommand so it is called on the OMC thread.
+ * Blocks until the GUI thread has logged the command since commandTime belongs to the caller.
+ * \param command
+ * \param commandTime
+ */
+void OMCThread::logCommand(QString command, QTime *commandTime)
+{
+  OMCLogRequest logRequest(false, command, commandTime);
+  sendGuiRequest(&logRequest);
+  QMutexLocker locker(&mMutex);
+  while (!logRequest.isFinished()) {
+    mJobAvailable.wait(&mMutex);
+  }
+}
+
+/*!
+ * \brief OMCThread::logResponse
+ * Connected directly to OMCInterface::logResponse so it is called on the OMC thread.
+ * Blocks until the GUI thread has logged the response since responseTime belongs to the caller.
+ * \param response
+ * \param responseTime
+ */
+void OMCThread::logResponse(QString response, QTime *responseTime)
+{
+  OMCLogRequest logRequest(true, response, responseTime);
+  sendGuiRequest(&logRequest);
+  QMutexLocker locker(&mMutex);
+  while (!logRequest.isFinished()) {
+    mJobAvailable.wait(&mMutex);
+  }
+}
+
+/*!
+ * \brief OMCThread::run
+ * Initializes the OMC runtime and then processes the queued jobs until OMCThread::stopOMC() is called.
+ */
+void OMCThread::run()
+{
+#if defined(GC_THREADS)
+  struct GC_stack_base stackBase;
+  GC_get_stack_base(&stackBase);
+  GC_register_my_thread(&stackBase);
+#endif
+  bool initialized = initializeOMC();
+  // wake up OMCThread::startOMC()
+  mMutex.lock();
+  mInitialized = initialized;
+  mStartupFinished = true;
+  mJobFinished.wakeAll();
+  mMutex.unlock();
+  if (initialized) {
+    processJobs(0);
+  }
+#if defined(GC_THREADS)
+  GC_unregister_my_thread();
+#endif
+}
+
+/*!
+ * \brief OMCThread::initializeOMC
+ * Creates the threadData_t and the symbol table and wraps them in OMCInterface. Called on the OMC thread.
+ * \return true on success.
+ */
+bool OMCThread::initializeOMC()
+{
+  threadData_t *threadData = (threadData_t *) calloc(1, sizeof(threadData_t));
+  void *st = 0;
+  MMC_TRY_TOP_INTERNAL()
+  omc_Main_init(threadData, mmc_mk_nil());
+  st = omc_Main_readSettings(threadData, mmc_mk_nil());
+  threadData->plotClassPointer = this;
+  threadData->plotCB = OMCThread::PlotCallbackFunction;
+  MMC_CATCH_TOP(return false;)
+  // OMCInterface lives in this thread so its log signals are sent to the GUI thread as OMCGuiRequest.
+  mpOMCInterface = new OMCInterface(threadData, st);
+  connect(mpOMCInterface, SIGNAL(logCommand(QString,QTime*)), this, SLOT(logCommand(QString,QTime*)), Qt::DirectConnection);
+  connect(mpOMCInterface, SIGNAL(logResponse(QString,QTime*)), this, SLOT(logResponse(QString,QTime*)), Qt::DirectConnection);
+  connect(mpOMCInterface, SIGNAL(throwException(QString)), mpOMCProxy, SLOT(showException(QString)), Qt::QueuedConnection);
+#ifdef WIN32
+  QString openModelicaHome = mpOMCInterface->getInstallationDirectoryPath();
+  MMC_TRY_TOP_INTERNAL()
+  omc_Main_setWindowsPaths(threadData, mmc_mk_scon(openModelicaHome.toStdString().c_str()));
+  MMC_CATCH_TOP()
+#endif
+  return true;
+}
+
+/*!
+ * \brief OMCThread::processJobs
+ * Runs the queued jobs. Called on the OMC thread.\n
+ * If pOMCGuiRequest is given then returns once the GUI thread has finished it, otherwise once the thread is stopped.
+ * \param pOMCGuiRequest
+ */
+void OMCThread::processJobs(OMCGuiRequest *pOMCGuiRequest)
+{
+  QMutexLocker locker(&mMutex);
+  while (pOMCGuiRequest ? !pOMCGuiRequest->isFinished() : mRunning) {
+    if (mJobsQueue.isEmpty()) {
+      mJobAvailable.wait(&mMutex);
+      continue;
+    }
+    OMCJob *pOMCJob = mJobsQueue.dequeue();
+    locker.unlock();
+    pOMCJob->run(mpOMCInterface);
+    locker.relock();
+    if (pOMCJob->getId() > 0) {
+      // a posted job is reported from the GUI event loop, see OMCThread::finishJobs().
+      pOMCJob->setFinished();
+      mFinishedJobsQueue.enqueue(pOMCJob);
+      QMetaObject::invokeMethod(this, "finishJobs", Qt::QueuedConnection);
+    } else {
+      // the job might be deleted by its owner as soon as it is marked as finished so don't touch it afterwards.
+      pOMCJob->setFinished();
+      mJobFinished.wakeAll();
+    }
+  }
+}
+
+/*!
+ * \brief OMCThread::waitForJobs
+ * Blocks the GUI thread until the job is finished and runs the OMCGuiRequest sent in the meantime.
+ * \param pOMCJob
+ */
+void OMCThread::waitForJobs(OMCJob *pOMCJob)
+{
+  QMutexLocker locker(&mMutex);
+  while (!pOMCJob->isFinished()) {
+    if (!runGuiRequest(&locker)) {
+      mJobFinished.wait(&mMutex);
+    }
+  }
+}
+
+/*!
+ * \brief OMCThread::runGuiRequest
+ * Runs the next queued OMCGuiRequest. Called on the GUI thread with mMutex locked.
+ * \param pLocker - the locker of mMutex. Unlocked while the request runs.
+ * \return false if there is no request.
+ */
+bool OMCThread::runGuiRequest(QMutexLocker *pLocker)
+{
+  if (mGuiRequestsQueue.isEmpty()) {
+    return false;
+  }
+  OMCGuiRequest *pOMCGuiRequest = mGuiRequestsQueue.dequeue();
+  pLocker->unlock();
+  pOMCGuiRequest->run(mpOMCProxy);
+  pLocker->relock();
+  // the OMC thread deletes the request as soon as it is marked as finished so don't touch it afterwards.
+  pOMCGuiRequest->setFinished();
+  mJobAvailable.wakeAll();
+  return true;
+}
+
+/*!
+ * \brief OMCThread::sendGuiRequest
+ * Queues the request for the GUI thread. Called on the OMC thread.\n
+ * The GUI thread runs it in OMCThread::waitForJobs() or, if it isn't waiting for a job, from its event loop.
+ * \param pOMCGuiRequest
+ */
+void OMCThread::sendGuiRequest(OMCGuiRequest *pOMCGuiRequest)
+{
+  mMutex.lock();
+  mGuiRequestsQueue.enqueue(pOMCGuiRequest);
+  mJobFinished.wakeAll();
+  mMutex.unlock();
+  QMetaObject::invokeMethod(this, "runGuiRequests", Qt::QueuedConnection);
+}
+
+/*!
+ * \brief OMCThread::runGuiRequests
+ * Runs the queued OMCGuiRequest from the GUI event loop.
+ */
+void OMCThread::runGuiRequests()
+{
+  QMutexLocker locker(&mMutex);
+  while (runGuiRequest(&locker)) {
+  }
+}
+
+/*!
+ * \brief OMCThread::finishJobs
+ * Emits OMCThread::jobFinished for the finished posted jobs and deletes them. Runs from the GUI event loop.
+ */
+void OMCThread::finishJobs()
+{
+  QMutexLocker locker(&mMutex);
+  while (!mFinishedJobsQueue.isEmpty()) {
+    OMCJob *pOMCJob = mFinishedJobsQueue.dequeue();
+    locker.unlock();
+    emit jobFinished(pOMCJob);
+    delete pOMCJob;
+    locker.relock();
+  }
+}
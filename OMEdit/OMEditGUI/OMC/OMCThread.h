@@ -0,0 +1,439 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCTHREAD_H
+#define OMCTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QTime>
+#include <QStringList>
+
+#include "OpenModelicaScriptingAPIQt.h"
+
+class OMCProxy;
+
+/*!
+ * \class OMCJob
+ * \brief A unit of work executed by the OMCThread.
+ * OMCJob::run() is always called on the OMC thread and is the only place where the OMC runtime state is touched.
+ */
+class OMCJob
+{
+public:
+  OMCJob() : mId(0), mFinished(false) {}
+  virtual ~OMCJob() {}
+  int getId() const {return mId;}
+  void setId(int id) {mId = id;}
+  bool isFinished() const {return mFinished;}
+  void setFinished() {mFinished = true;}
+  virtual void run(OMCInterface *pOMCInterface) = 0;
+private:
+  // the id assigned by OMCThread::post(), 0 for the jobs waited for with OMCThread::execute().
+  int mId;
+  // guarded by OMCThread::mMutex
+  bool mFinished;
+};
+
+/*!
+ * \class OMCGuiRequest
+ * \brief Work that the OMC thread hands back to the GUI thread e.g., logging a command or showing a plot.
+ * OMCGuiRequest::run() is always called on the GUI thread, either while it waits for a job in OMCThread::execute()
+ * or from its event loop.
+ */
+class OMCGuiRequest
+{
+public:
+  OMCGuiRequest() : mFinished(false) {}
+  virtual ~OMCGuiRequest() {}
+  bool isFinished() const {return mFinished;}
+  void setFinished() {mFinished = true;}
+  virtual void run(OMCProxy *pOMCProxy) = 0;
+private:
+  // guarded by OMCThread::mMutex
+  bool mFinished;
+};
+
+/*!
+ * \class OMCCommandJob
+ * \brief Sends a scripting expression to OMC using omc_Main_handleCommand.
+ */
+class OMCCommandJob : public OMCJob
+{
+public:
+  OMCCommandJob(const QString &expression) : mExpression(expression), mResult(""), mSuccess(true) {mCommandTime.start();}
+  QString getExpression() const {return mExpression;}
+  QString getResult() const {return mResult;}
+  bool isSuccessful() const {return mSuccess;}
+  QTime* getCommandTime() {return &mCommandTime;}
+  virtual void run(OMCInterface *pOMCInterface);
+private:
+  QString mExpression;
+  QString mResult;
+  bool mSuccess;
+  QTime mCommandTime;
+};
+
+//! Strips the const reference from the OMCInterface method parameter so that OMCInterfaceCall can store its own copy.
+template <typename T> struct OMCArgument {typedef T Type;};
+template <typename T> struct OMCArgument<const T&> {typedef T Type;};
+
+/*!
+ * \class OMCInterfaceCall
+ * \brief Base class of the jobs that call one of the typed OMCInterface methods on the OMC thread.
+ * Use OMCThread::call() instead of creating these directly.
+ */
+template <typename R>
+class OMCInterfaceCall : public OMCJob
+{
+public:
+  R getResult() const {return mResult;}
+protected:
+  R mResult;
+};
+
+template <typename R>
+class OMCInterfaceCall0 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)();
+  OMCInterfaceCall0(Function function) : mFunction(function) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)();}
+private:
+  Function mFunction;
+};
+
+template <typename R, typename P1>
+class OMCInterfaceCall1 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1);
+  OMCInterfaceCall1(Function function, const typename OMCArgument<P1>::Type &a1)
+    : mFunction(function), mA1(a1) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+};
+
+template <typename R, typename P1, typename P2>
+class OMCInterfaceCall2 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2);
+  OMCInterfaceCall2(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2)
+    : mFunction(function), mA1(a1), mA2(a2) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+};
+
+template <typename R, typename P1, typename P2, typename P3>
+class OMCInterfaceCall3 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2, P3);
+  OMCInterfaceCall3(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2,
+                    const typename OMCArgument<P3>::Type &a3)
+    : mFunction(function), mA1(a1), mA2(a2), mA3(a3) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2, mA3);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+  typename OMCArgument<P3>::Type mA3;
+};
+
+template <typename R, typename P1, typename P2, typename P3, typename P4>
+class OMCInterfaceCall4 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2, P3, P4);
+  OMCInterfaceCall4(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2,
+                    const typename OMCArgument<P3>::Type &a3, const typename OMCArgument<P4>::Type &a4)
+    : mFunction(function), mA1(a1), mA2(a2), mA3(a3), mA4(a4) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2, mA3, mA4);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+  typename OMCArgument<P3>::Type mA3;
+  typename OMCArgument<P4>::Type mA4;
+};
+
+template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+class OMCInterfaceCall5 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2, P3, P4, P5);
+  OMCInterfaceCall5(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2,
+                    const typename OMCArgument<P3>::Type &a3, const typename OMCArgument<P4>::Type &a4,
+                    const typename OMCArgument<P5>::Type &a5)
+    : mFunction(function), mA1(a1), mA2(a2), mA3(a3), mA4(a4), mA5(a5) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2, mA3, mA4, mA5);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+  typename OMCArgument<P3>::Type mA3;
+  typename OMCArgument<P4>::Type mA4;
+  typename OMCArgument<P5>::Type mA5;
+};
+
+template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+class OMCInterfaceCall6 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2, P3, P4, P5, P6);
+  OMCInterfaceCall6(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2,
+                    const typename OMCArgument<P3>::Type &a3, const typename OMCArgument<P4>::Type &a4,
+                    const typename OMCArgument<P5>::Type &a5, const typename OMCArgument<P6>::Type &a6)
+    : mFunction(function), mA1(a1), mA2(a2), mA3(a3), mA4(a4), mA5(a5), mA6(a6) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2, mA3, mA4, mA5, mA6);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+  typename OMCArgument<P3>::Type mA3;
+  typename OMCArgument<P4>::Type mA4;
+  typename OMCArgument<P5>::Type mA5;
+  typename OMCArgument<P6>::Type mA6;
+};
+
+template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename P7>
+class OMCInterfaceCall7 : public OMCInterfaceCall<R>
+{
+public:
+  typedef R (OMCInterface::*Function)(P1, P2, P3, P4, P5, P6, P7);
+  OMCInterfaceCall7(Function function, const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2,
+                    const typename OMCArgument<P3>::Type &a3, const typename OMCArgument<P4>::Type &a4,
+                    const typename OMCArgument<P5>::Type &a5, const typename OMCArgument<P6>::Type &a6,
+                    const typename OMCArgument<P7>::Type &a7)
+    : mFunction(function), mA1(a1), mA2(a2), mA3(a3), mA4(a4), mA5(a5), mA6(a6), mA7(a7) {}
+  virtual void run(OMCInterface *pOMCInterface) {this->mResult = (pOMCInterface->*mFunction)(mA1, mA2, mA3, mA4, mA5, mA6, mA7);}
+private:
+  Function mFunction;
+  typename OMCArgument<P1>::Type mA1;
+  typename OMCArgument<P2>::Type mA2;
+  typename OMCArgument<P3>::Type mA3;
+  typename OMCArgument<P4>::Type mA4;
+  typename OMCArgument<P5>::Type mA5;
+  typename OMCArgument<P6>::Type mA6;
+  typename OMCArgument<P7>::Type mA7;
+};
+
+/*!
+ * \class OMCThread
+ * \brief The dedicated thread that owns the OMC runtime state i.e., threadData_t and the symbol table.
+ * All the communication with OMC is queued as OMCJob and executed here one by one.
+ * OMCThread::execute() blocks the GUI thread on a wait condition until the job is done. It doesn't process the GUI events,
+ * so no timer or queued slot can send another command in the middle of a job. The only work done while waiting is
+ * the OMCGuiRequest sent by the running job, i.e., logging and the plot callback.
+ * It is meant for the short queries. The long running calls are queued with OMCThread::post() which returns immediately,
+ * the GUI keeps running and OMCThread::jobFinished is emitted on the GUI thread once the job is done.
+ */
+class OMCThread : public QThread
+{
+  Q_OBJECT
+public:
+  OMCThread(OMCProxy *pOMCProxy);
+  ~OMCThread();
+  bool startOMC();
+  void stopOMC();
+  bool isInitialized() {return mInitialized;}
+  OMCInterface* getOMCInterface() {return mpOMCInterface;}
+  void execute(OMCJob *pOMCJob);
+  int post(OMCJob *pOMCJob);
+  static void PlotCallbackFunction(void *p, int externalWindow, const char* filename, const char* title, const char* grid,
+                                   const char* plotType, const char* logX, const char* logY, const char* xLabel, const char* yLabel,
+                                   const char* x1, const char* x2, const char* y1, const char* y2, const char* curveWidth,
+                                   const char* curveStyle, const char* legendPosition, const char* footer, const char* autoScale,
+                                   const char* variables);
+  template <typename R>
+  R call(R (OMCInterface::*function)())
+  {
+    OMCInterfaceCall0<R> omcInterfaceCall(function);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1>
+  R call(R (OMCInterface::*function)(P1), const typename OMCArgument<P1>::Type &a1)
+  {
+    OMCInterfaceCall1<R, P1> omcInterfaceCall(function, a1);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2>
+  R call(R (OMCInterface::*function)(P1, P2), const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2)
+  {
+    OMCInterfaceCall2<R, P1, P2> omcInterfaceCall(function, a1, a2);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2, typename P3>
+  R call(R (OMCInterface::*function)(P1, P2, P3), const typename OMCArgument<P1>::Type &a1,
+         const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3)
+  {
+    OMCInterfaceCall3<R, P1, P2, P3> omcInterfaceCall(function, a1, a2, a3);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4>
+  R call(R (OMCInterface::*function)(P1, P2, P3, P4), const typename OMCArgument<P1>::Type &a1,
+         const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+         const typename OMCArgument<P4>::Type &a4)
+  {
+    OMCInterfaceCall4<R, P1, P2, P3, P4> omcInterfaceCall(function, a1, a2, a3, a4);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+  R call(R (OMCInterface::*function)(P1, P2, P3, P4, P5), const typename OMCArgument<P1>::Type &a1,
+         const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+         const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5)
+  {
+    OMCInterfaceCall5<R, P1, P2, P3, P4, P5> omcInterfaceCall(function, a1, a2, a3, a4, a5);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+  R call(R (OMCInterface::*function)(P1, P2, P3, P4, P5, P6), const typename OMCArgument<P1>::Type &a1,
+         const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+         const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5,
+         const typename OMCArgument<P6>::Type &a6)
+  {
+    OMCInterfaceCall6<R, P1, P2, P3, P4, P5, P6> omcInterfaceCall(function, a1, a2, a3, a4, a5, a6);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename P7>
+  R call(R (OMCInterface::*function)(P1, P2, P3, P4, P5, P6, P7), const typename OMCArgument<P1>::Type &a1,
+         const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+         const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5,
+         const typename OMCArgument<P6>::Type &a6, const typename OMCArgument<P7>::Type &a7)
+  {
+    OMCInterfaceCall7<R, P1, P2, P3, P4, P5, P6, P7> omcInterfaceCall(function, a1, a2, a3, a4, a5, a6, a7);
+    execute(&omcInterfaceCall);
+    return omcInterfaceCall.getResult();
+  }
+  template <typename R>
+  int post(R (OMCInterface::*function)())
+  {
+    return post(new OMCInterfaceCall0<R>(function));
+  }
+  template <typename R, typename P1>
+  int post(R (OMCInterface::*function)(P1), const typename OMCArgument<P1>::Type &a1)
+  {
+    return post(new OMCInterfaceCall1<R, P1>(function, a1));
+  }
+  template <typename R, typename P1, typename P2>
+  int post(R (OMCInterface::*function)(P1, P2), const typename OMCArgument<P1>::Type &a1, const typename OMCArgument<P2>::Type &a2)
+  {
+    return post(new OMCInterfaceCall2<R, P1, P2>(function, a1, a2));
+  }
+  template <typename R, typename P1, typename P2, typename P3>
+  int post(R (OMCInterface::*function)(P1, P2, P3), const typename OMCArgument<P1>::Type &a1,
+           const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3)
+  {
+    return post(new OMCInterfaceCall3<R, P1, P2, P3>(function, a1, a2, a3));
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4>
+  int post(R (OMCInterface::*function)(P1, P2, P3, P4), const typename OMCArgument<P1>::Type &a1,
+           const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+           const typename OMCArgument<P4>::Type &a4)
+  {
+    return post(new OMCInterfaceCall4<R, P1, P2, P3, P4>(function, a1, a2, a3, a4));
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+  int post(R (OMCInterface::*function)(P1, P2, P3, P4, P5), const typename OMCArgument<P1>::Type &a1,
+           const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+           const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5)
+  {
+    return post(new OMCInterfaceCall5<R, P1, P2, P3, P4, P5>(function, a1, a2, a3, a4, a5));
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+  int post(R (OMCInterface::*function)(P1, P2, P3, P4, P5, P6), const typename OMCArgument<P1>::Type &a1,
+           const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+           const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5,
+           const typename OMCArgument<P6>::Type &a6)
+  {
+    return post(new OMCInterfaceCall6<R, P1, P2, P3, P4, P5, P6>(function, a1, a2, a3, a4, a5, a6));
+  }
+  template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename P7>
+  int post(R (OMCInterface::*function)(P1, P2, P3, P4, P5, P6, P7), const typename OMCArgument<P1>::Type &a1,
+           const typename OMCArgument<P2>::Type &a2, const typename OMCArgument<P3>::Type &a3,
+           const typename OMCArgument<P4>::Type &a4, const typename OMCArgument<P5>::Type &a5,
+           const typename OMCArgument<P6>::Type &a6, const typename OMCArgument<P7>::Type &a7)
+  {
+    return post(new OMCInterfaceCall7<R, P1, P2, P3, P4, P5, P6, P7>(function, a1, a2, a3, a4, a5, a6, a7));
+  }
+protected:
+  virtual void run();
+private:
+  OMCProxy *mpOMCProxy;
+  OMCInterface *mpOMCInterface;
+  bool mInitialized;
+  bool mStartupFinished;
+  bool mRunning;
+  QMutex mMutex;
+  // wakes up the OMC thread when a job is queued, a request is finished or the thread is stopped.
+  QWaitCondition mJobAvailable;
+  // wakes up the GUI thread when a job is finished, a request is queued or the startup is finished.
+  QWaitCondition mJobFinished;
+  QQueue<OMCJob*> mJobsQueue;
+  QQueue<OMCGuiRequest*> mGuiRequestsQueue;
+  // the jobs queued with OMCThread::post() that are done but not yet reported on the GUI thread.
+  QQueue<OMCJob*> mFinishedJobsQueue;
+  int mLastJobId;
+
+  bool initializeOMC();
+  void processJobs(OMCGuiRequest *pOMCGuiRequest);
+  void waitForJobs(OMCJob *pOMCJob);
+  bool runGuiRequest(QMutexLocker *pLocker);
+  void sendGuiRequest(OMCGuiRequest *pOMCGuiRequest);
+signals:
+  void jobFinished(OMCJob *pOMCJob);
+public slots:
+  void logCommand(QString command, QTime *commandTime);
+  void logResponse(QString response, QTime *responseTime);
+private slots:
+  void runGuiRequests();
+  void finishJobs();
+};
+
+#endif // OMCTHREAD_H
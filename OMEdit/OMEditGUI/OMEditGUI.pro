@@ -30,7 +30,7 @@
 
 QT += network core gui webkit xml xmlpatterns svg
 greaterThan(QT_MAJOR_VERSION, 4) {
-  QT += printsupport widgets webkitwidgets
+  QT += printsupport widgets webkitwidgets concurrent
 }
 
 TRANSLATIONS = Resources/nls/OMEdit_de.ts \
@@ -98,11 +98,14 @@ SOURCES += main.cpp \
   Util/Helper.cpp \
   Util/Utilities.cpp \
   Util/StringHandler.cpp \
+  Util/OMCValue.cpp \
   MainWindow.cpp \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.cpp \
   OMC/OMCProxy.cpp \
+  OMC/OMCThread.cpp \
   Modeling/MessagesWidget.cpp \
   Modeling/LibraryTreeWidget.cpp \
+  Modeling/LibraryTreeItemCache.cpp \
   Modeling/Commands.cpp \
   Modeling/CoOrdinateSystem.cpp \
   Modeling/ModelWidgetContainer.cpp \
@@ -116,6 +119,7 @@ SOURCES += main.cpp \
   Editors/MetaModelEditor.cpp \
   Editors/MetaModelicaEditor.cpp \
   Plotting/PlotWindowContainer.cpp \
+  Plotting/PlotCurveDecimator.cpp \
   Component/Component.cpp \
   Annotations/ShapeAnnotation.cpp \
   Component/CornerItem.cpp \
@@ -131,6 +135,8 @@ SOURCES += main.cpp \
   Simulation/SimulationDialog.cpp \
   Simulation/SimulationOutputWidget.cpp \
   Simulation/SimulationProcessThread.cpp \
+  Simulation/ParameterSweep.cpp \
+  Simulation/SimulationBuildCache.cpp \
   Simulation/SimulationOutputHandler.cpp \
   TLM/FetchInterfaceDataDialog.cpp \
   TLM/FetchInterfaceDataThread.cpp \
@@ -139,11 +145,17 @@ SOURCES += main.cpp \
   TLM/TLMCoSimulationThread.cpp \
   FMI/ImportFMUDialog.cpp \
   Plotting/VariablesWidget.cpp \
+  Plotting/InitXmlIndex.cpp \
   Options/NotificationsDialog.cpp \
   Annotations/ShapePropertiesDialog.cpp \
   TransformationalDebugger/OMDumpXML.cpp \
-  TransformationalDebugger/diff_match_patch.cpp \
+  TransformationalDebugger/TokenDiff.cpp \
   TransformationalDebugger/TransformationsWidget.cpp \
+  TransformationalDebugger/InfoJSONReader.cpp \
+  TransformationalDebugger/TransformationsCache.cpp \
+  TransformationalDebugger/ProfilingWidget.cpp \
+  TransformationalDebugger/ProfilingReport.cpp \
+  TransformationalDebugger/EquationDependencyGraph.cpp \
   Debugger/GDB/CommandFactory.cpp \
   Debugger/GDB/GDBAdapter.cpp \
   Debugger/StackFrames/StackFramesWidget.cpp \
@@ -161,11 +173,14 @@ SOURCES += main.cpp \
 HEADERS  += Util/Helper.h \
   Util/Utilities.h \
   Util/StringHandler.h \
+  Util/OMCValue.h \
   MainWindow.h \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.h \
   OMC/OMCProxy.h \
+  OMC/OMCThread.h \
   Modeling/MessagesWidget.h \
   Modeling/LibraryTreeWidget.h \
+  Modeling/LibraryTreeItemCache.h \
   Modeling/Commands.h \
   Modeling/CoOrdinateSystem.h \
   Modeling/ModelWidgetContainer.h \
@@ -179,6 +194,7 @@ HEADERS  += Util/Helper.h \
   Editors/MetaModelEditor.h \
   Editors/MetaModelicaEditor.h \
   Plotting/PlotWindowContainer.h \
+  Plotting/PlotCurveDecimator.h \
   Component/Component.h \
   Annotations/ShapeAnnotation.h \
   Component/CornerItem.h \
@@ -195,6 +211,8 @@ HEADERS  += Util/Helper.h \
   Simulation/SimulationDialog.h \
   Simulation/SimulationOutputWidget.h \
   Simulation/SimulationProcessThread.h \
+  Simulation/ParameterSweep.h \
+  Simulation/SimulationBuildCache.h \
   Simulation/SimulationOutputHandler.h \
   TLM/FetchInterfaceDataDialog.h \
   TLM/FetchInterfaceDataThread.h \
@@ -204,11 +222,17 @@ HEADERS  += Util/Helper.h \
   TLM/TLMCoSimulationThread.h \
   FMI/ImportFMUDialog.h \
   Plotting/VariablesWidget.h \
+  Plotting/InitXmlIndex.h \
   Options/NotificationsDialog.h \
   Annotations/ShapePropertiesDialog.h \
   TransformationalDebugger/OMDumpXML.cpp \
-  TransformationalDebugger/diff_match_patch.h \
+  TransformationalDebugger/TokenDiff.h \
   TransformationalDebugger/TransformationsWidget.h \
+  TransformationalDebugger/InfoJSONReader.h \
+  TransformationalDebugger/TransformationsCache.h \
+  TransformationalDebugger/ProfilingWidget.h \
+  TransformationalDebugger/ProfilingReport.h \
+  TransformationalDebugger/EquationDependencyGraph.h \
   Debugger/GDB/CommandFactory.h \
   Debugger/GDB/GDBAdapter.h \
   Debugger/StackFrames/StackFramesWidget.h \
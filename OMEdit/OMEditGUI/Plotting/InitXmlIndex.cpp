@@ -0,0 +1,506 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "InitXmlIndex.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QVarLengthArray>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+#include <QSaveFile>
+#endif
+
+#include <string.h>
+
+namespace {
+
+struct XmlAttribute {
+  const char *pName;
+  int nameLength;
+  const char *pValue;
+  int valueLength;
+};
+
+struct StartValuePatch {
+  int index;
+  QByteArray value;
+  bool operator<(const StartValuePatch &patch) const {return index < patch.index;}
+};
+
+/*!
+ * \brief saveFile
+ * Replaces the file with data. The data is written to a temporary file first which is then renamed to the file.
+ * \param fileName
+ * \param data
+ * \param errorString - set if the file can't be saved.
+ * \return
+ */
+bool saveFile(const QString &fileName, const QByteArray &data, QString &errorString)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 1, 0))
+  QSaveFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+    errorString = file.errorString();
+    return false;
+  }
+  return true;
+#else
+  QFile file(fileName + ".tmp");
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size() || !file.flush()) {
+    errorString = file.errorString();
+    file.close();
+    file.remove();
+    return false;
+  }
+  file.close();
+  if ((QFile::exists(fileName) && !QFile::remove(fileName)) || !file.rename(fileName)) {
+    errorString = file.errorString();
+    file.remove();
+    return false;
+  }
+  return true;
+#endif
+}
+
+inline bool isXmlSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isAttribute(const XmlAttribute &attribute, const char *name)
+{
+  return attribute.nameLength == (int)strlen(name) && memcmp(attribute.pName, name, attribute.nameLength) == 0;
+}
+
+/*!
+ * \brief parseTag
+ * Reads the attributes of the tag starting at pTag.
+ * \param pTag - points to the '<' of the tag.
+ * \param pEnd
+ * \param ppNameEnd - set to the end of the tag name.
+ * \param attributes
+ * \param pEmpty - set to true if the tag is closed with "/>".
+ * \return the position after the tag or 0 if the tag is not complete.
+ */
+const char* parseTag(const char *pTag, const char *pEnd, const char **ppNameEnd, QVarLengthArray<XmlAttribute, 16> &attributes, bool *pEmpty)
+{
+  attributes.clear();
+  const char *p = pTag + 1;
+  while (p < pEnd && !isXmlSpace(*p) && *p != '>' && *p != '/') {
+    p++;
+  }
+  *ppNameEnd = p;
+  while (true) {
+    while (p < pEnd && isXmlSpace(*p)) {
+      p++;
+    }
+    if (p >= pEnd) {
+      return 0;
+    } else if (*p == '>') {
+      *pEmpty = false;
+      return p + 1;
+    } else if (*p == '/') {
+      *pEmpty = true;
+      return (p + 1 < pEnd && p[1] == '>') ? p + 2 : 0;
+    }
+    XmlAttribute attribute;
+    attribute.pName = p;
+    while (p < pEnd && !isXmlSpace(*p) && *p != '=' && *p != '>' && *p != '/') {
+      p++;
+    }
+    attribute.nameLength = p - attribute.pName;
+    while (p < pEnd && isXmlSpace(*p)) {
+      p++;
+    }
+    if (p >= pEnd || *p != '=') {
+      return 0;
+    }
+    p++;
+    while (p < pEnd && isXmlSpace(*p)) {
+      p++;
+    }
+    if (p >= pEnd || (*p != '"' && *p != '\'')) {
+      return 0;
+    }
+    char quote = *p++;
+    const char *pQuote = (const char*)memchr(p, quote, pEnd - p);
+    if (!pQuote) {
+      return 0;
+    }
+    attribute.pValue = p;
+    attribute.valueLength = pQuote - p;
+    attributes.append(attribute);
+    p = pQuote + 1;
+  }
+}
+
+/*!
+ * \brief unescape
+ * Returns the attribute value with the xml entities replaced.
+ * \param pValue
+ * \param length
+ * \return
+ */
+QString unescape(const char *pValue, int length)
+{
+  QString value = QString::fromUtf8(pValue, length);
+  if (!memchr(pValue, '&', length)) {
+    return value;
+  }
+  QString result;
+  result.reserve(value.size());
+  int i = 0;
+  while (i < value.size()) {
+    int semicolon;
+    if (value.at(i) != '&' || (semicolon = value.indexOf(';', i)) < 0) {
+      result.append(value.at(i++));
+      continue;
+    }
+    QString entity = value.mid(i + 1, semicolon - i - 1);
+    bool ok = true;
+    if (entity == "amp") {
+      result.append('&');
+    } else if (entity == "lt") {
+      result.append('<');
+    } else if (entity == "gt") {
+      result.append('>');
+    } else if (entity == "quot") {
+      result.append('"');
+    } else if (entity == "apos") {
+      result.append('\'');
+    } else if (entity.startsWith("#x")) {
+      result.append(QChar(entity.mid(2).toUShort(&ok, 16)));
+    } else if (entity.startsWith("#")) {
+      result.append(QChar(entity.mid(1).toUShort(&ok, 10)));
+    } else {
+      ok = false;
+    }
+    if (ok) {
+      i = semicolon + 1;
+    } else {
+      result.append(value.at(i++));
+    }
+  }
+  return result;
+}
+
+/*!
+ * \brief escape
+ * Returns the value encoded for an attribute.
+ * \param value
+ * \return
+ */
+QByteArray escape(const QString &value)
+{
+  QByteArray bytes = value.toUtf8();
+  if (bytes.contains('&')) {
+    bytes.replace("&", "&amp;");
+  }
+  if (bytes.contains('<')) {
+    bytes.replace("<", "&lt;");
+  }
+  if (bytes.contains('>')) {
+    bytes.replace(">", "&gt;");
+  }
+  if (bytes.contains('"')) {
+    bytes.replace("\"", "&quot;");
+  }
+  if (bytes.contains('\'')) {
+    bytes.replace("'", "&apos;");
+  }
+  return bytes;
+}
+
+}
+
+InitXmlIndex::InitXmlIndex()
+{
+  clear();
+}
+
+/*!
+ * \brief InitXmlIndex::clear
+ * Clears the index.
+ */
+void InitXmlIndex::clear()
+{
+  mFileName.clear();
+  mFileSize = -1;
+  mLastModified = QDateTime();
+  mErrorString.clear();
+  mScalarVariables.clear();
+  mScalarVariablesIndexes.clear();
+}
+
+/*!
+ * \brief InitXmlIndex::read
+ * Reads the ScalarVariables of the file.
+ * \param fileName
+ * \return false if the file can't be read.
+ */
+bool InitXmlIndex::read(const QString &fileName)
+{
+  /* fileName may refer to mFileName which is cleared below. */
+  QString name = fileName;
+  clear();
+  mFileName = name;
+  QFile file(mFileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    mErrorString = file.errorString();
+    return false;
+  }
+  qint64 size = file.size();
+  uchar *pData = size > 0 ? file.map(0, size) : 0;
+  if (pData) {
+    readScalarVariables((const char*)pData, size);
+    file.unmap(pData);
+  } else {
+    QByteArray data = file.readAll();
+    readScalarVariables(data.constData(), data.size());
+  }
+  file.close();
+  updateFileInformation();
+  return true;
+}
+
+/*!
+ * \brief InitXmlIndex::isUpToDate
+ * Returns true if the index is read from the file and the file is not modified since then.
+ * \param fileName
+ * \return
+ */
+bool InitXmlIndex::isUpToDate(const QString &fileName) const
+{
+  if (mFileName.isEmpty() || mFileName != fileName) {
+    return false;
+  }
+  QFileInfo fileInfo(fileName);
+  return fileInfo.exists() && fileInfo.size() == mFileSize && fileInfo.lastModified() == mLastModified;
+}
+
+/*!
+ * \brief InitXmlIndex::getScalarVariable
+ * Returns the ScalarVariable or 0 if the file doesn't contain it.
+ * \param name
+ * \return
+ */
+const InitXmlIndex::ScalarVariable* InitXmlIndex::getScalarVariable(const QString &name) const
+{
+  int index = mScalarVariablesIndexes.value(name, -1);
+  return index < 0 ? 0 : &mScalarVariables.at(index);
+}
+
+/*!
+ * \brief InitXmlIndex::updateStartValues
+ * Writes the start values to the file. If the new values have the same length as the old ones they are written in place,
+ * otherwise the file is replaced once with a copy containing the new values. The variables which are not in the file are ignored.
+ * \param values - the start values indexed by the variable name.
+ * \return false if the file can't be written.
+ */
+bool InitXmlIndex::updateStartValues(const QHash<QString, QString> &values)
+{
+  if (values.isEmpty()) {
+    return true;
+  }
+  if (!isUpToDate(mFileName) && !read(mFileName)) {
+    return false;
+  }
+  QVector<StartValuePatch> patches;
+  bool inPlace = true;
+  QHash<QString, QString>::const_iterator iterator;
+  for (iterator = values.constBegin() ; iterator != values.constEnd() ; ++iterator) {
+    int index = mScalarVariablesIndexes.value(iterator.key(), -1);
+    if (index < 0 || mScalarVariables.at(index).startOffset < 0) {
+      continue;
+    }
+    StartValuePatch patch;
+    patch.index = index;
+    patch.value = escape(iterator.value());
+    inPlace = inPlace && mScalarVariables.at(index).startLength == patch.value.size();
+    patches.append(patch);
+  }
+  if (patches.isEmpty()) {
+    return true;
+  }
+  qSort(patches);
+  QFile file(mFileName);
+  if (inPlace) {
+    if (!file.open(QIODevice::ReadWrite)) {
+      mErrorString = file.errorString();
+      return false;
+    }
+    foreach (const StartValuePatch &patch, patches) {
+      if (!file.seek(mScalarVariables.at(patch.index).startOffset) || file.write(patch.value) != patch.value.size()) {
+        mErrorString = file.errorString();
+        file.close();
+        /* some values might be written already, so read the file again next time. */
+        mFileSize = -1;
+        return false;
+      }
+    }
+    if (!file.flush()) {
+      mErrorString = file.errorString();
+      file.close();
+      mFileSize = -1;
+      return false;
+    }
+    file.close();
+  } else {
+    if (!file.open(QIODevice::ReadOnly)) {
+      mErrorString = file.errorString();
+      return false;
+    }
+    QByteArray data = file.readAll();
+    file.close();
+    QByteArray patchedData;
+    patchedData.reserve(data.size() + patches.size() * 16);
+    qint64 position = 0;
+    foreach (const StartValuePatch &patch, patches) {
+      const ScalarVariable &scalarVariable = mScalarVariables.at(patch.index);
+      patchedData.append(data.constData() + position, scalarVariable.startOffset - position);
+      if (scalarVariable.startLength < 0) {
+        patchedData.append(" start=\"");
+        patchedData.append(patch.value);
+        patchedData.append("\"");
+        position = scalarVariable.startOffset;
+      } else {
+        patchedData.append(patch.value);
+        position = scalarVariable.startOffset + scalarVariable.startLength;
+      }
+    }
+    patchedData.append(data.constData() + position, data.size() - position);
+    /* the file is replaced only once all of it is written, so a failed write leaves the old file. */
+    if (!saveFile(mFileName, patchedData, mErrorString)) {
+      return false;
+    }
+  }
+  /* move the offsets of the values after the patched ones */
+  qint64 delta = 0;
+  int next = 0;
+  for (int i = 0 ; i < mScalarVariables.size() ; i++) {
+    ScalarVariable &scalarVariable = mScalarVariables[i];
+    scalarVariable.startOffset += delta;
+    if (next < patches.size() && patches.at(next).index == i) {
+      const QByteArray &value = patches.at(next).value;
+      if (scalarVariable.startLength < 0) {
+        /* skip ` start="` */
+        scalarVariable.startOffset += 8;
+        delta += value.size() + 9;
+      } else {
+        delta += value.size() - scalarVariable.startLength;
+      }
+      scalarVariable.startLength = value.size();
+      scalarVariable.start = values.value(scalarVariable.name);
+      next++;
+    }
+  }
+  updateFileInformation();
+  return true;
+}
+
+/*!
+ * \brief InitXmlIndex::readScalarVariables
+ * Reads the ScalarVariable elements and the attributes of their first child element i.e., Real, Integer, Boolean etc.
+ * \param pData
+ * \param size
+ */
+void InitXmlIndex::readScalarVariables(const char *pData, qint64 size)
+{
+  static const char scalarVariableTag[] = "<ScalarVariable";
+  const int scalarVariableTagLength = sizeof(scalarVariableTag) - 1;
+  QVarLengthArray<XmlAttribute, 16> attributes;
+  const char *pEnd = pData + size;
+  const char *p = pData;
+  while (p < pEnd && (p = (const char*)memchr(p, '<', pEnd - p))) {
+    if (pEnd - p <= scalarVariableTagLength || memcmp(p, scalarVariableTag, scalarVariableTagLength) != 0
+        || !(isXmlSpace(p[scalarVariableTagLength]) || p[scalarVariableTagLength] == '>' || p[scalarVariableTagLength] == '/')) {
+      p++;
+      continue;
+    }
+    const char *pNameEnd;
+    bool empty;
+    p = parseTag(p, pEnd, &pNameEnd, attributes, &empty);
+    if (!p) {
+      break;
+    }
+    ScalarVariable scalarVariable;
+    scalarVariable.isValueChangeable = false;
+    scalarVariable.startOffset = -1;
+    scalarVariable.startLength = -1;
+    for (int i = 0 ; i < attributes.size() ; i++) {
+      const XmlAttribute &attribute = attributes.at(i);
+      if (isAttribute(attribute, "name")) {
+        scalarVariable.name = unescape(attribute.pValue, attribute.valueLength);
+      } else if (isAttribute(attribute, "description")) {
+        scalarVariable.description = unescape(attribute.pValue, attribute.valueLength);
+      } else if (isAttribute(attribute, "isValueChangeable")) {
+        scalarVariable.isValueChangeable = attribute.valueLength == 4 && memcmp(attribute.pValue, "true", 4) == 0;
+      }
+    }
+    /* read the Real, Integer, Boolean etc. element */
+    const char *pChild = empty ? 0 : (const char*)memchr(p, '<', pEnd - p);
+    if (pChild && pChild + 1 < pEnd && pChild[1] != '/') {
+      const char *pChildEnd = parseTag(pChild, pEnd, &pNameEnd, attributes, &empty);
+      if (pChildEnd) {
+        scalarVariable.startOffset = pNameEnd - pData;
+        for (int i = 0 ; i < attributes.size() ; i++) {
+          const XmlAttribute &attribute = attributes.at(i);
+          if (isAttribute(attribute, "start")) {
+            scalarVariable.start = unescape(attribute.pValue, attribute.valueLength);
+            scalarVariable.startOffset = attribute.pValue - pData;
+            scalarVariable.startLength = attribute.valueLength;
+          } else if (isAttribute(attribute, "unit")) {
+            scalarVariable.unit = unescape(attribute.pValue, attribute.valueLength);
+          } else if (isAttribute(attribute, "displayUnit")) {
+            scalarVariable.displayUnit = unescape(attribute.pValue, attribute.valueLength);
+          }
+        }
+        p = pChildEnd;
+      }
+    }
+    mScalarVariablesIndexes.insert(scalarVariable.name, mScalarVariables.size());
+    mScalarVariables.append(scalarVariable);
+  }
+}
+
+/*!
+ * \brief InitXmlIndex::updateFileInformation
+ * Remembers the size and the modification time of the file.
+ */
+void InitXmlIndex::updateFileInformation()
+{
+  QFileInfo fileInfo(mFileName);
+  mFileSize = fileInfo.size();
+  mLastModified = fileInfo.lastModified();
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef INITXMLINDEX_H
+#define INITXMLINDEX_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+/*!
+ * \class InitXmlIndex
+ * \brief Index of the ScalarVariables of a model_init.xml file.
+ * The file is read in one pass without building a document. The byte offset of each start value is kept so that the changed
+ * start values are written by patching the file instead of parsing and writing the whole document again.
+ */
+class InitXmlIndex
+{
+public:
+  struct ScalarVariable {
+    QString name;
+    QString description;
+    QString start;
+    QString unit;
+    QString displayUnit;
+    bool isValueChangeable;
+    qint64 startOffset;   /* the offset of the start value or where the start attribute is inserted. */
+    int startLength;      /* the length of the start value in bytes or -1 if the variable has no start attribute. */
+  };
+  InitXmlIndex();
+  void clear();
+  bool read(const QString &fileName);
+  bool isUpToDate(const QString &fileName) const;
+  QString getFileName() const {return mFileName;}
+  QString getErrorString() const {return mErrorString;}
+  int getScalarVariablesCount() const {return mScalarVariables.size();}
+  const ScalarVariable* getScalarVariable(const QString &name) const;
+  bool updateStartValues(const QHash<QString, QString> &values);
+private:
+  QString mFileName;
+  qint64 mFileSize;
+  QDateTime mLastModified;
+  QString mErrorString;
+  QVector<ScalarVariable> mScalarVariables;
+  QHash<QString, int> mScalarVariablesIndexes;
+
+  void readScalarVariables(const char *pData, qint64 size);
+  void updateFileInformation();
+};
+
+#endif // INITXMLINDEX_H
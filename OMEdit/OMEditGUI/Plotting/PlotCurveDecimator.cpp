@@ -0,0 +1,272 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "PlotCurveDecimator.h"
+#include "Utilities.h"
+
+#include <string.h>
+
+using namespace OMPlot;
+
+/*!
+ * \brief PlotCurveDecimator::PlotCurveDecimator
+ * \param pPlotWindow
+ */
+PlotCurveDecimator::PlotCurveDecimator(PlotWindow *pPlotWindow)
+  : QObject(pPlotWindow)
+{
+  mpPlotWindow = pPlotWindow;
+  mUpdateTimer.setSingleShot(true);
+  mUpdateTimer.setInterval(0);
+  connect(&mUpdateTimer, SIGNAL(timeout()), SLOT(updatePlotCurves()));
+  connect(mpPlotWindow->getPlot()->axisWidget(QwtPlot::xBottom), SIGNAL(scaleDivChanged()), SLOT(updatePlotCurvesLater()));
+}
+
+/*!
+ * \brief PlotCurveDecimator::getPlotCurveDecimator
+ * Returns the PlotCurveDecimator of the plot window. Creates it if the plot window doesn't have one.
+ * \param pPlotWindow
+ * \return
+ */
+PlotCurveDecimator* PlotCurveDecimator::getPlotCurveDecimator(PlotWindow *pPlotWindow)
+{
+  PlotCurveDecimator *pPlotCurveDecimator = pPlotWindow->findChild<PlotCurveDecimator*>();
+  if (!pPlotCurveDecimator) {
+    pPlotCurveDecimator = new PlotCurveDecimator(pPlotWindow);
+  }
+  return pPlotCurveDecimator;
+}
+
+/*!
+ * \brief PlotCurveDecimator::addPlotCurve
+ * Adds a new curve of the plot window. Converts its values and decimates it.
+ * \param pPlotCurve
+ * \param xOffset
+ * \param xScaleFactor
+ * \param yOffset
+ * \param yScaleFactor
+ */
+void PlotCurveDecimator::addPlotCurve(PlotCurve *pPlotCurve, qreal xOffset, qreal xScaleFactor, qreal yOffset, qreal yScaleFactor)
+{
+  /* a removed curve might have had the same address. */
+  mYAxisVectors.remove(pPlotCurve);
+  setPlotCurveData(pPlotCurve, xOffset, xScaleFactor, yOffset, yScaleFactor);
+}
+
+/*!
+ * \brief PlotCurveDecimator::setPlotCurveDisplayUnit
+ * Sets the values of the curve in the display unit. The values are only converted the first time a display unit is used.
+ * \param pPlotCurve
+ * \param previousUnit - the unit of the current values of the curve.
+ * \param displayUnit
+ * \param offset - the offset to convert from the previous unit to the display unit.
+ * \param scaleFactor - the scale factor to convert from the previous unit to the display unit.
+ */
+void PlotCurveDecimator::setPlotCurveDisplayUnit(PlotCurve *pPlotCurve, const QString &previousUnit, const QString &displayUnit,
+                                                 qreal offset, qreal scaleFactor)
+{
+  QHash<QString, QVector<double> > &yAxisVectors = mYAxisVectors[pPlotCurve];
+  int size = pPlotCurve->getSize();
+  if (!yAxisVectors.contains(previousUnit)) {
+    QVector<double> yAxisVector(size);
+    memcpy(yAxisVector.data(), pPlotCurve->getYAxisVector(), size * sizeof(double));
+    yAxisVectors.insert(previousUnit, yAxisVector);
+  }
+  QHash<QString, QVector<double> >::const_iterator iterator = yAxisVectors.constFind(displayUnit);
+  if (iterator == yAxisVectors.constEnd()) {
+    QVector<double> yAxisVector = Utilities::convertUnit(yAxisVectors.value(previousUnit).constData(), size, offset, scaleFactor);
+    iterator = yAxisVectors.insert(displayUnit, yAxisVector);
+  }
+  pPlotCurve->setYAxisVector(iterator.value());
+  setPlotCurveData(pPlotCurve);
+}
+
+/*!
+ * \brief PlotCurveDecimator::setPlotCurveData
+ * Converts the curve values with the offsets and scale factors and decimates the curve in the same pass.\n
+ * The converted values are stored in the curve. Parametric curves are converted but not decimated.
+ * \param pPlotCurve
+ * \param xOffset
+ * \param xScaleFactor
+ * \param yOffset
+ * \param yScaleFactor
+ */
+void PlotCurveDecimator::setPlotCurveData(PlotCurve *pPlotCurve, qreal xOffset, qreal xScaleFactor, qreal yOffset, qreal yScaleFactor)
+{
+  bool convertXAxis = (xOffset != 0 || xScaleFactor != 1);
+  bool convertYAxis = (yOffset != 0 || yScaleFactor != 1);
+  const double *pXAxisVector = pPlotCurve->getXAxisVector();
+  const double *pYAxisVector = pPlotCurve->getYAxisVector();
+  int size = pPlotCurve->getSize();
+  QwtScaleMap xMap = mpPlotWindow->getPlot()->canvasMap(QwtPlot::xBottom);
+  double x1 = qMin(xMap.s1(), xMap.s2());
+  double x2 = qMax(xMap.s1(), xMap.s2());
+  double p1 = qMin(xMap.p1(), xMap.p2());
+  int pixels = qRound(qAbs(xMap.p2() - xMap.p1()));
+  if (mpPlotWindow->getPlotType() != PlotWindow::PLOT || pixels <= 0 || x2 <= x1 || size <= 4 * pixels) {
+    if (convertXAxis) {
+      pPlotCurve->setXAxisVector(Utilities::convertUnit(pXAxisVector, size, xOffset, xScaleFactor));
+    }
+    if (convertYAxis) {
+      pPlotCurve->setYAxisVector(Utilities::convertUnit(pYAxisVector, size, yOffset, yScaleFactor));
+    }
+    pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+    mDecimatedData.insert(pPlotCurve, DecimatedData());
+    return;
+  }
+  /* the converted values are written to contiguous vectors which replace the curve values after the pass. */
+  QVector<double> xAxisVector, yAxisVector;
+  double *pConvertedXAxisVector = 0;
+  double *pConvertedYAxisVector = 0;
+  if (convertXAxis) {
+    xAxisVector.resize(size);
+    pConvertedXAxisVector = xAxisVector.data();
+  }
+  if (convertYAxis) {
+    yAxisVector.resize(size);
+    pConvertedYAxisVector = yAxisVector.data();
+  }
+  /* the first, minimum, maximum and last point of the current pixel column. */
+  int indexes[4];
+  double xValues[4];
+  double yValues[4];
+  int column = 0;
+  DecimatedData decimatedData;
+  decimatedData.mXAxisVector.reserve(4 * (pixels + 2));
+  decimatedData.mYAxisVector.reserve(4 * (pixels + 2));
+  for (int i = 0 ; i <= size ; i++) {
+    double x = 0, y = 0;
+    int pointColumn = -2;
+    if (i < size) {
+      x = pXAxisVector[i];
+      y = pYAxisVector[i];
+      if (convertXAxis) {
+        x = (x - xOffset) / xScaleFactor;
+        pConvertedXAxisVector[i] = x;
+      }
+      if (convertYAxis) {
+        y = (y - yOffset) / yScaleFactor;
+        pConvertedYAxisVector[i] = y;
+      }
+      if (x < x1) {
+        pointColumn = -1;
+      } else if (x > x2) {
+        pointColumn = pixels;
+      } else {
+        pointColumn = qBound(0, (int)(xMap.transform(x) - p1), pixels - 1);
+      }
+    }
+    if (i > 0 && pointColumn == column) {
+      if (y < yValues[1]) {
+        indexes[1] = i;
+        xValues[1] = x;
+        yValues[1] = y;
+      }
+      if (y > yValues[2]) {
+        indexes[2] = i;
+        xValues[2] = x;
+        yValues[2] = y;
+      }
+      indexes[3] = i;
+      xValues[3] = x;
+      yValues[3] = y;
+      continue;
+    }
+    if (i > 0) {
+      /* add the points of the finished column in the order they appear in the curve. */
+      int order[4] = {0, 1, 2, 3};
+      if (indexes[order[1]] > indexes[order[2]]) {
+        qSwap(order[1], order[2]);
+      }
+      int lastIndex = -1;
+      for (int j = 0 ; j < 4 ; j++) {
+        if (indexes[order[j]] != lastIndex) {
+          lastIndex = indexes[order[j]];
+          decimatedData.mXAxisVector.append(xValues[order[j]]);
+          decimatedData.mYAxisVector.append(yValues[order[j]]);
+        }
+      }
+    }
+    for (int j = 0 ; j < 4 ; j++) {
+      indexes[j] = i;
+      xValues[j] = x;
+      yValues[j] = y;
+    }
+    column = pointColumn;
+  }
+  if (convertXAxis) {
+    pPlotCurve->setXAxisVector(xAxisVector);
+  }
+  if (convertYAxis) {
+    pPlotCurve->setYAxisVector(yAxisVector);
+  }
+  pPlotCurve->setData(decimatedData.mXAxisVector.constData(), decimatedData.mYAxisVector.constData(), decimatedData.mXAxisVector.size());
+  /* the curve draws the decimated data directly so it must be kept until the curve is decimated again. */
+  mDecimatedData.insert(pPlotCurve, decimatedData);
+}
+
+/*!
+ * \brief PlotCurveDecimator::updatePlotCurvesLater
+ * Slot activated when the time axis of the plot window is changed.\n
+ * The curves are decimated after the plot is updated so that the new axis range is used.
+ */
+void PlotCurveDecimator::updatePlotCurvesLater()
+{
+  mUpdateTimer.start();
+}
+
+/*!
+ * \brief PlotCurveDecimator::updatePlotCurves
+ * Decimates the curves again for the current axis range and removes the curves which are not in the plot window anymore.
+ */
+void PlotCurveDecimator::updatePlotCurves()
+{
+  QList<PlotCurve*> plotCurves = mpPlotWindow->getPlot()->getPlotCurvesList();
+  QHash<PlotCurve*, DecimatedData>::iterator iterator = mDecimatedData.begin();
+  while (iterator != mDecimatedData.end()) {
+    if (plotCurves.contains(iterator.key())) {
+      ++iterator;
+    } else {
+      mYAxisVectors.remove(iterator.key());
+      iterator = mDecimatedData.erase(iterator);
+    }
+  }
+  if (mDecimatedData.isEmpty()) {
+    return;
+  }
+  foreach (PlotCurve *pPlotCurve, mDecimatedData.keys()) {
+    setPlotCurveData(pPlotCurve);
+  }
+  mpPlotWindow->getPlot()->replot();
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PLOTCURVEDECIMATOR_H
+#define PLOTCURVEDECIMATOR_H
+
+#include <QHash>
+#include <QTimer>
+#include <QVector>
+
+#include "OMPlot.h"
+
+/*!
+ * \class PlotCurveDecimator
+ * \brief Draws the curves of a plot window with at most four points per pixel column of the visible time range.
+ * The curve keeps its full resolution data. Only the points that are drawn are reduced i.e., the first, minimum, maximum
+ * and last point of each pixel column. The points outside the visible range are reduced to one column on each side so
+ * that the bounding rectangle of the curve stays the same. The curves are decimated again when the time axis is zoomed or panned.
+ * The values of each curve are also kept per display unit so that switching back to a display unit doesn't convert the values again.
+ */
+class PlotCurveDecimator : public QObject
+{
+  Q_OBJECT
+public:
+  static PlotCurveDecimator* getPlotCurveDecimator(OMPlot::PlotWindow *pPlotWindow);
+  void addPlotCurve(OMPlot::PlotCurve *pPlotCurve, qreal xOffset = 0, qreal xScaleFactor = 1, qreal yOffset = 0, qreal yScaleFactor = 1);
+  void setPlotCurveDisplayUnit(OMPlot::PlotCurve *pPlotCurve, const QString &previousUnit, const QString &displayUnit, qreal offset,
+                               qreal scaleFactor);
+  void setPlotCurveData(OMPlot::PlotCurve *pPlotCurve, qreal xOffset = 0, qreal xScaleFactor = 1, qreal yOffset = 0,
+                        qreal yScaleFactor = 1);
+private:
+  PlotCurveDecimator(OMPlot::PlotWindow *pPlotWindow);
+  class DecimatedData
+  {
+  public:
+    QVector<double> mXAxisVector;
+    QVector<double> mYAxisVector;
+  };
+  OMPlot::PlotWindow *mpPlotWindow;
+  QHash<OMPlot::PlotCurve*, DecimatedData> mDecimatedData;
+  QHash<OMPlot::PlotCurve*, QHash<QString, QVector<double> > > mYAxisVectors;
+  QTimer mUpdateTimer;
+private slots:
+  void updatePlotCurvesLater();
+  void updatePlotCurves();
+};
+
+#endif // PLOTCURVEDECIMATOR_H
@@ -34,9 +34,66 @@
 
 #include "PlotWindowContainer.h"
 #include "VariablesWidget.h"
+#include "PlotCurveDecimator.h"
+
+#include <string.h>
 
 using namespace OMPlot;
 
+/*!
+ * \brief LivePlotBuffer::LivePlotBuffer
+ * \param variables - the variables of the values. The time is not part of the variables.
+ * \param capacity - the maximum number of rows.
+ */
+LivePlotBuffer::LivePlotBuffer(const QStringList &variables, int capacity)
+{
+  mVariables = variables;
+  mColumns = variables.size() + 1;
+  mCapacity = capacity;
+  mStart = 0;
+  mSize = 0;
+}
+
+/*!
+ * \brief LivePlotBuffer::append
+ * Appends a row of values. Overwrites the oldest row if the buffer is full.
+ * \param values - the time followed by the values of the variables.
+ */
+void LivePlotBuffer::append(const QVector<double> &values)
+{
+  if (values.size() != mColumns || mCapacity <= 0) {
+    return;
+  }
+  /* allocate the storage on first use so that an unused buffer doesn't take any memory. */
+  if (mValues.isEmpty()) {
+    mValues.resize(mCapacity * mColumns);
+  }
+  int row = (mStart + mSize) % mCapacity;
+  if (mSize < mCapacity) {
+    mSize++;
+  } else {
+    mStart = (mStart + 1) % mCapacity;
+  }
+  memcpy(mValues.data() + row * mColumns, values.constData(), mColumns * sizeof(double));
+}
+
+/*!
+ * \brief LivePlotBuffer::getValues
+ * Returns the values of a column from the oldest to the newest row.
+ * \param column - 0 is the time and i is the ith variable.
+ * \return
+ */
+QVector<double> LivePlotBuffer::getValues(int column) const
+{
+  QVector<double> values(mSize);
+  double *pValues = values.data();
+  const double *pBuffer = mValues.constData();
+  for (int i = 0 ; i < mSize ; i++) {
+    pValues[i] = pBuffer[((mStart + i) % mCapacity) * mColumns + column];
+  }
+  return values;
+}
+
 /*!
   \class PlotWindowContainer
   \brief A MDI area for plot windows.
@@ -55,6 +112,9 @@ PlotWindowContainer::PlotWindowContainer(MainWindow *pParent)
   }
   // dont show this widget at startup
   setVisible(false);
+  // the live plot curves are updated at most five times a second.
+  mLivePlotTimer.setInterval(200);
+  connect(&mLivePlotTimer, SIGNAL(timeout()), SLOT(updateLivePlotCurves()));
 }
 
 /*!
@@ -113,6 +173,29 @@ bool PlotWindowContainer::eventFilter(QObject *pObject, QEvent *pEvent)
   return QMdiArea::eventFilter(pObject, pEvent);
 }
 
+/*!
+ * \brief PlotWindowContainer::getPlotVariables
+ * Returns the variables of the result file which are plotted against time in any plot window.
+ * \param fileName - the result file name.
+ * \return
+ */
+QStringList PlotWindowContainer::getPlotVariables(QString fileName)
+{
+  QStringList variables;
+  foreach (QMdiSubWindow *pSubWindow, subWindowList()) {
+    PlotWindow *pPlotWindow = qobject_cast<PlotWindow*>(pSubWindow->widget());
+    if (!pPlotWindow || pPlotWindow->getPlotType() != PlotWindow::PLOT) {
+      continue;
+    }
+    foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
+      if (pPlotCurve->getFileName().compare(fileName) == 0 && !variables.contains(pPlotCurve->getYVariable())) {
+        variables.append(pPlotCurve->getYVariable());
+      }
+    }
+  }
+  return variables;
+}
+
 /*!
  * \brief PlotWindowContainer::addPlotWindow
  * Adds a new Plot Window.
@@ -260,3 +343,168 @@ void PlotWindowContainer::updatePlotWindows(QString variable)
     }
   }
 }
+
+/*!
+ * \brief PlotWindowContainer::startLivePlot
+ * Starts collecting the values streamed by the running simulation of the result file.
+ * \param fileName - the result file name.
+ * \param variables - the variables streamed by the simulation.
+ */
+void PlotWindowContainer::startLivePlot(QString fileName, QStringList variables)
+{
+  mLivePlotBuffers.insert(fileName, LivePlotBuffer(variables));
+  mModifiedLivePlotBuffers.remove(fileName);
+  // the units of a previous run of the same model might be different.
+  QString prefix = fileName + ".";
+  QHash<QString, QPair<qreal, qreal> >::iterator iterator = mLivePlotVariableConversions.begin();
+  while (iterator != mLivePlotVariableConversions.end()) {
+    if (iterator.key().startsWith(prefix)) {
+      iterator = mLivePlotVariableConversions.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+  if (!mLivePlotTimer.isActive()) {
+    mLivePlotTimer.start();
+  }
+}
+
+/*!
+ * \brief PlotWindowContainer::appendLivePlotValues
+ * Appends the values streamed by the running simulation. The curves are updated by the live plot timer.
+ * \param fileName - the result file name.
+ * \param values - the time followed by the values of the variables.
+ */
+void PlotWindowContainer::appendLivePlotValues(QString fileName, QVector<double> values)
+{
+  QHash<QString, LivePlotBuffer>::iterator iterator = mLivePlotBuffers.find(fileName);
+  if (iterator != mLivePlotBuffers.end()) {
+    iterator.value().append(values);
+    mModifiedLivePlotBuffers.insert(fileName);
+  }
+}
+
+/*!
+ * \brief PlotWindowContainer::stopLivePlot
+ * Stops collecting the values of the result file. The curves are read from the result file once the simulation is finished.
+ * \param fileName - the result file name.
+ */
+void PlotWindowContainer::stopLivePlot(QString fileName)
+{
+  mLivePlotBuffers.remove(fileName);
+  mModifiedLivePlotBuffers.remove(fileName);
+  if (mLivePlotBuffers.isEmpty()) {
+    mLivePlotTimer.stop();
+    mLivePlotTimeConversions.clear();
+    mLivePlotVariableConversions.clear();
+  }
+}
+
+/*!
+ * \brief PlotWindowContainer::resetLivePlotVariableConversion
+ * Forgets the unit conversion of the variable e.g., when its display unit is changed.
+ * \param variable - the variable name prefixed with the result file name.
+ */
+void PlotWindowContainer::resetLivePlotVariableConversion(QString variable)
+{
+  mLivePlotVariableConversions.remove(variable);
+}
+
+/*!
+ * \brief PlotWindowContainer::getLivePlotTimeConversion
+ * Returns the offset and scale factor converting the time from seconds to timeUnit.
+ * The conversion is looked up once per time unit.
+ * \param timeUnit
+ * \return
+ */
+QPair<qreal, qreal> PlotWindowContainer::getLivePlotTimeConversion(QString timeUnit)
+{
+  QHash<QString, QPair<qreal, qreal> >::const_iterator iterator = mLivePlotTimeConversions.find(timeUnit);
+  if (iterator != mLivePlotTimeConversions.end()) {
+    return iterator.value();
+  }
+  QPair<qreal, qreal> conversion(0, 1);
+  if (timeUnit.compare("s") != 0) {
+    OMCInterface::convertUnits_res convertUnit = mpMainWindow->getOMCProxy()->convertUnits("s", timeUnit);
+    if (convertUnit.unitsCompatible) {
+      conversion = qMakePair(convertUnit.offset, convertUnit.scaleFactor);
+    }
+  }
+  mLivePlotTimeConversions.insert(timeUnit, conversion);
+  return conversion;
+}
+
+/*!
+ * \brief PlotWindowContainer::getLivePlotVariableConversion
+ * Returns the offset and scale factor converting the values of the variable to its display unit.
+ * The conversion is looked up once per variable until PlotWindowContainer::resetLivePlotVariableConversion() is called.
+ * \param variable - the variable name prefixed with the result file name.
+ * \return
+ */
+QPair<qreal, qreal> PlotWindowContainer::getLivePlotVariableConversion(QString variable)
+{
+  QHash<QString, QPair<qreal, qreal> >::const_iterator iterator = mLivePlotVariableConversions.find(variable);
+  if (iterator != mLivePlotVariableConversions.end()) {
+    return iterator.value();
+  }
+  QPair<qreal, qreal> conversion(0, 1);
+  VariablesTreeModel *pVariablesTreeModel = mpMainWindow->getVariablesWidget()->getVariablesTreeModel();
+  VariablesTreeItem *pVariablesTreeItem = pVariablesTreeModel->findVariablesTreeItem(variable, pVariablesTreeModel->getRootVariablesTreeItem());
+  if (pVariablesTreeItem && pVariablesTreeItem->getUnit().compare(pVariablesTreeItem->getDisplayUnit()) != 0) {
+    OMCInterface::convertUnits_res convertUnit = mpMainWindow->getOMCProxy()->convertUnits(pVariablesTreeItem->getUnit(),
+                                                                                           pVariablesTreeItem->getDisplayUnit());
+    if (convertUnit.unitsCompatible) {
+      conversion = qMakePair(convertUnit.offset, convertUnit.scaleFactor);
+    }
+  }
+  // the variables tree might not have the variable yet, so look it up again on the next update.
+  if (pVariablesTreeItem) {
+    mLivePlotVariableConversions.insert(variable, conversion);
+  }
+  return conversion;
+}
+
+/*!
+ * \brief PlotWindowContainer::updateLivePlotCurves
+ * Slot activated when mLivePlotTimer timeout signal is raised.\n
+ * Sets the buffered values on the curves of the plot windows and converts them to the time and display units.
+ * The unit conversions are cached so no OMC call is made once a curve has been updated.
+ */
+void PlotWindowContainer::updateLivePlotCurves()
+{
+  if (mModifiedLivePlotBuffers.isEmpty()) {
+    return;
+  }
+  foreach (QMdiSubWindow *pSubWindow, subWindowList()) {
+    PlotWindow *pPlotWindow = qobject_cast<PlotWindow*>(pSubWindow->widget());
+    if (!pPlotWindow || pPlotWindow->getPlotType() != PlotWindow::PLOT) {
+      continue;
+    }
+    QPair<qreal, qreal> xConversion = getLivePlotTimeConversion(pPlotWindow->getTimeUnit());
+    bool updated = false;
+    foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
+      if (!mModifiedLivePlotBuffers.contains(pPlotCurve->getFileName())) {
+        continue;
+      }
+      const LivePlotBuffer &livePlotBuffer = mLivePlotBuffers[pPlotCurve->getFileName()];
+      int column = livePlotBuffer.getVariables().indexOf(pPlotCurve->getYVariable());
+      if (column < 0) {
+        continue;
+      }
+      QPair<qreal, qreal> yConversion = getLivePlotVariableConversion(pPlotCurve->getFileName() + "." + pPlotCurve->getYVariable());
+      pPlotCurve->setXAxisVector(livePlotBuffer.getValues(0));
+      pPlotCurve->setYAxisVector(livePlotBuffer.getValues(column + 1));
+      PlotCurveDecimator::getPlotCurveDecimator(pPlotWindow)->addPlotCurve(pPlotCurve, xConversion.first, xConversion.second,
+                                                                           yConversion.first, yConversion.second);
+      updated = true;
+    }
+    if (updated) {
+      if (pPlotWindow->getAutoScaleButton()->isChecked()) {
+        pPlotWindow->fitInView();
+      } else {
+        pPlotWindow->getPlot()->replot();
+      }
+    }
+  }
+  mModifiedLivePlotBuffers.clear();
+}
@@ -40,6 +40,28 @@
 
 class MainWindow;
 
+/*!
+ * \class LivePlotBuffer
+ * \brief Ring buffer of the latest values streamed by a running simulation.
+ * Each row holds the time followed by the values of the variables. When the buffer is full the oldest row is overwritten.
+ */
+class LivePlotBuffer
+{
+public:
+  LivePlotBuffer(const QStringList &variables = QStringList(), int capacity = 100000);
+  QStringList getVariables() const {return mVariables;}
+  int size() const {return mSize;}
+  void append(const QVector<double> &values);
+  QVector<double> getValues(int column) const;
+private:
+  QStringList mVariables;
+  int mColumns;
+  int mCapacity;
+  int mStart;
+  int mSize;
+  QVector<double> mValues;
+};
+
 class PlotWindowContainer : public MdiArea
 {
   Q_OBJECT
@@ -48,12 +70,28 @@ public:
   QString getUniqueName(QString name = QString("Plot"), int number = 1);
   OMPlot::PlotWindow* getCurrentWindow();
   bool eventFilter(QObject *pObject, QEvent *pEvent);
+  QStringList getPlotVariables(QString fileName);
+private:
+  QHash<QString, LivePlotBuffer> mLivePlotBuffers;
+  QSet<QString> mModifiedLivePlotBuffers;
+  QTimer mLivePlotTimer;
+  // the offset and scale factor of the live plot curves, looked up once instead of on every update.
+  QHash<QString, QPair<qreal, qreal> > mLivePlotTimeConversions;
+  QHash<QString, QPair<qreal, qreal> > mLivePlotVariableConversions;
+  QPair<qreal, qreal> getLivePlotTimeConversion(QString timeUnit);
+  QPair<qreal, qreal> getLivePlotVariableConversion(QString variable);
 public slots:
   void addPlotWindow(bool maximized = false);
   void addParametricPlotWindow();
   void clearPlotWindow();
   void exportVariables();
   void updatePlotWindows(QString variable);
+  void startLivePlot(QString fileName, QStringList variables);
+  void appendLivePlotValues(QString fileName, QVector<double> values);
+  void stopLivePlot(QString fileName);
+  void resetLivePlotVariableConversion(QString variable);
+private slots:
+  void updateLivePlotCurves();
 };
 
 #endif // PLOTWINDOWCONTAINER_H
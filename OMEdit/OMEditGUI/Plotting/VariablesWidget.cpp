@@ -33,6 +33,8 @@
  */
 
 #include "VariablesWidget.h"
+#include "PlotCurveDecimator.h"
+#include "ParameterSweep.h"
 #include "util/read_matlab4.h"
 
 using namespace OMPlot;
@@ -72,6 +74,7 @@ VariablesTreeItem::VariablesTreeItem(const QVector<QVariant> &variableItemData,
   mToolTip = variableItemData[9].toString();
   mChecked = false;
   mEditable = false;
+  mHasPendingChildren = false;
 }
 
 VariablesTreeItem::~VariablesTreeItem()
@@ -168,7 +171,7 @@ QVariant VariablesTreeItem::data(int column, int role) const
         case Qt::ToolTipRole:
           return mToolTip;
         case Qt::CheckStateRole:
-          if (mChildren.size() > 0)
+          if (mChildren.size() > 0 || mHasPendingChildren)
             return QVariant();
           else
             return isChecked() ? Qt::Checked : Qt::Unchecked;
@@ -249,6 +252,12 @@ VariablesTreeModel::VariablesTreeModel(VariablesTreeView *pVariablesTreeView)
   mpRootVariablesTreeItem = new VariablesTreeItem(headers, 0, true);
 }
 
+VariablesTreeModel::~VariablesTreeModel()
+{
+  qDeleteAll(mVariablesTables);
+  mVariablesTables.clear();
+}
+
 int VariablesTreeModel::columnCount(const QModelIndex &parent) const
 {
   if (parent.isValid())
@@ -355,9 +364,10 @@ Qt::ItemFlags VariablesTreeModel::flags(const QModelIndex &index) const
 
   Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
   VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(index.internalPointer());
-  if (index.column() == 0 && pVariablesTreeItem && pVariablesTreeItem->getChildren().size() == 0) {
+  bool isLeaf = pVariablesTreeItem && pVariablesTreeItem->getChildren().size() == 0 && !pVariablesTreeItem->hasPendingChildren();
+  if (index.column() == 0 && isLeaf) {
     flags |= Qt::ItemIsUserCheckable;
-  } else if (index.column() == 1 && pVariablesTreeItem && pVariablesTreeItem->getChildren().size() == 0 && pVariablesTreeItem->isEditable()) {
+  } else if (index.column() == 1 && isLeaf && pVariablesTreeItem->isEditable()) {
     flags |= Qt::ItemIsEditable;
   } else if (index.column() == 3) {
     flags |= Qt::ItemIsEditable;
@@ -366,88 +376,192 @@ Qt::ItemFlags VariablesTreeModel::flags(const QModelIndex &index) const
   return flags;
 }
 
-VariablesTreeItem* VariablesTreeModel::findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const
+/*!
+ * \brief VariablesTreeModel::hasChildren
+ * Returns true if the item has children. The children of an item might not be created yet.
+ * \param parent
+ * \return
+ */
+bool VariablesTreeModel::hasChildren(const QModelIndex &parent) const
 {
-  if (root->getVariableName() == name)
-    return root;
-  for (int i = root->getChildren().size(); --i >= 0; )
-    if (VariablesTreeItem *item = findVariablesTreeItem(name, root->getChildren().at(i)))
-      return item;
-  return 0;
+  if (parent.column() > 0) {
+    return false;
+  }
+  VariablesTreeItem *pVariablesTreeItem;
+  if (!parent.isValid()) {
+    pVariablesTreeItem = mpRootVariablesTreeItem;
+  } else {
+    pVariablesTreeItem = static_cast<VariablesTreeItem*>(parent.internalPointer());
+  }
+  return pVariablesTreeItem->getChildren().size() > 0 || pVariablesTreeItem->hasPendingChildren();
 }
 
-QModelIndex VariablesTreeModel::variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const
+/*!
+ * \brief VariablesTreeModel::canFetchMore
+ * Returns true if the children of the item are not created yet.
+ * \param parent
+ * \return
+ */
+bool VariablesTreeModel::canFetchMore(const QModelIndex &parent) const
 {
-  return variablesTreeItemIndexHelper(pVariablesTreeItem, mpRootVariablesTreeItem, QModelIndex());
+  if (!parent.isValid()) {
+    return false;
+  }
+  VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(parent.internalPointer());
+  return pVariablesTreeItem && pVariablesTreeItem->hasPendingChildren();
 }
 
-QModelIndex VariablesTreeModel::variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem,
-                                                             const VariablesTreeItem *pParentVariablesTreeItem,
-                                                             const QModelIndex &parentIndex) const
+/*!
+ * \brief VariablesTreeModel::fetchMore
+ * Creates the children of the item.
+ * \param parent
+ */
+void VariablesTreeModel::fetchMore(const QModelIndex &parent)
 {
-  if (pVariablesTreeItem == pParentVariablesTreeItem)
-    return parentIndex;
-  for (int i = pParentVariablesTreeItem->getChildren().size(); --i >= 0; ) {
-    const VariablesTreeItem *childItem = pParentVariablesTreeItem->getChildren().at(i);
-    QModelIndex childIndex = index(i, 0, parentIndex);
-    QModelIndex index = variablesTreeItemIndexHelper(pVariablesTreeItem, childItem, childIndex);
-    if (index.isValid())
-      return index;
+  if (!parent.isValid()) {
+    return;
   }
-  return QModelIndex();
+  fetchVariablesTreeItems(static_cast<VariablesTreeItem*>(parent.internalPointer()));
 }
 
-void VariablesTreeModel::parseInitXml(QXmlStreamReader &xmlReader)
+/*!
+ * \brief VariablesTreeModel::fetchVariablesTreeItems
+ * Creates the VariablesTreeItems of the pending children of pVariablesTreeItem from its result file table.
+ * \param pVariablesTreeItem
+ * \param recursive - if true then the whole sub tree is created.
+ */
+void VariablesTreeModel::fetchVariablesTreeItems(VariablesTreeItem *pVariablesTreeItem, bool recursive)
 {
-  mScalarVariablesList.clear();
-  /* We'll parse the XML until we reach end of it.*/
-  while(!xmlReader.atEnd() && !xmlReader.hasError())
-  {
-    /* Read next element.*/
-    QXmlStreamReader::TokenType token = xmlReader.readNext();
-    /* If token is just StartDocument, we'll go to next.*/
-    if(token == QXmlStreamReader::StartDocument)
-      continue;
-    /* If token is StartElement, we'll see if we can read it.*/
-    if(token == QXmlStreamReader::StartElement)
-    {
-      /* If it's named ScalarVariable, we'll dig the information from there.*/
-      if(xmlReader.name() == "ScalarVariable")
-      {
-        QHash<QString, QString> scalarVariable = parseScalarVariable(xmlReader);
-        mScalarVariablesList.insert(scalarVariable.value("name"),scalarVariable);
+  if (pVariablesTreeItem->hasPendingChildren()) {
+    pVariablesTreeItem->setHasPendingChildren(false);
+    VariablesTable *pVariablesTable = mVariablesTables.value(pVariablesTreeItem->getFileName(), 0);
+    if (pVariablesTable) {
+      int parentRow = pVariablesTable->mRows.value(pVariablesTreeItem->getVariableName(), -1);
+      const QVector<int> &rows = (parentRow < 0) ? pVariablesTable->mTopChildRows : pVariablesTable->mChildRows.at(parentRow);
+      if (!rows.isEmpty()) {
+        OMCProxy *pOMCProxy = mpVariablesTreeView->getVariablesWidget()->getMainWindow()->getOMCProxy();
+        QString filePath = pVariablesTreeItem->getFilePath();
+        QString fileName = pVariablesTreeItem->getFileName();
+        /* the views must know about the new rows even if the model signals are blocked for plotting. */
+        bool state = blockSignals(false);
+        beginInsertRows(variablesTreeItemIndex(pVariablesTreeItem), 0, rows.size() - 1);
+        foreach (int row, rows) {
+          QVector<QVariant> variableData;
+          QString variableName = pVariablesTable->mVariableNames.at(row);
+          variableData << filePath << fileName << variableName << pVariablesTable->mDisplayVariableNames.at(row);
+          variableData << pVariablesTable->mValues.at(row) << pVariablesTable->mUnits.at(row) << pVariablesTable->mDisplayUnits.at(row);
+          /* set the variable displayUnits. The derived units are fetched once per distinct unit. */
+          QString variableUnit = pVariablesTable->mUnits.at(row);
+          if (!variableUnit.isEmpty()) {
+            QHash<QString, QStringList>::const_iterator displayUnitsIterator = pVariablesTable->mDerivedUnits.constFind(variableUnit);
+            if (displayUnitsIterator == pVariablesTable->mDerivedUnits.constEnd()) {
+              QStringList displayUnits;
+              displayUnits << variableUnit;
+              displayUnits << pOMCProxy->getDerivedUnits(variableUnit);
+              displayUnitsIterator = pVariablesTable->mDerivedUnits.insert(variableUnit, displayUnits);
+            }
+            variableData << displayUnitsIterator.value();
+          } else {
+            variableData << QStringList();
+          }
+          variableData << pVariablesTable->mDescriptions.at(row);
+          /* construct tooltip text */
+          variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableName.mid(fileName.length() + 1));
+          VariablesTreeItem *pChildVariablesTreeItem = new VariablesTreeItem(variableData, pVariablesTreeItem);
+          pChildVariablesTreeItem->setEditable(pVariablesTable->mEditable.at(row));
+          pChildVariablesTreeItem->setHasPendingChildren(!pVariablesTable->mChildRows.at(row).isEmpty());
+          pVariablesTreeItem->insertChild(pVariablesTreeItem->getChildren().size(), pChildVariablesTreeItem);
+          pVariablesTable->mVariablesTreeItems[row] = pChildVariablesTreeItem;
+        }
+        endInsertRows();
+        blockSignals(state);
       }
     }
   }
-  xmlReader.clear();
+  if (recursive) {
+    foreach (VariablesTreeItem *pChildVariablesTreeItem, pVariablesTreeItem->getChildren()) {
+      fetchVariablesTreeItems(pChildVariablesTreeItem, true);
+    }
+  }
 }
 
-QHash<QString, QString> VariablesTreeModel::parseScalarVariable(QXmlStreamReader &xmlReader)
+/*!
+ * \brief VariablesTreeModel::findVariablesTreeItem
+ * Finds the VariablesTreeItem by its variable name under root. Creates the item and its parents if they are not created yet.
+ * \param name
+ * \param root
+ * \return
+ */
+VariablesTreeItem* VariablesTreeModel::findVariablesTreeItem(const QString &name, VariablesTreeItem *root)
 {
-  QHash<QString, QString> scalarVariable;
-  /* Let's check that we're really getting a ScalarVariable. */
-  if(xmlReader.tokenType() != QXmlStreamReader::StartElement && xmlReader.name() == "ScalarVariable")
-    return scalarVariable;
-  /* Let's get the attributes for ScalarVariable */
-  QXmlStreamAttributes attributes = xmlReader.attributes();
-  /* Read the ScalarVariable attributes. */
-  scalarVariable["name"] = attributes.value("name").toString();
-  scalarVariable["description"] = attributes.value("description").toString();
-  scalarVariable["isValueChangeable"] = attributes.value("isValueChangeable").toString();
-  /* Read the next element i.e Real, Integer, Boolean etc. */
-  xmlReader.readNext();
-  while(!(xmlReader.tokenType() == QXmlStreamReader::EndElement && xmlReader.name() == "ScalarVariable"))
-  {
-    if(xmlReader.tokenType() == QXmlStreamReader::StartElement)
-    {
-      QXmlStreamAttributes attributes = xmlReader.attributes();
-      scalarVariable["start"] = attributes.value("start").toString();
-      scalarVariable["unit"] = attributes.value("unit").toString();
-      scalarVariable["displayUnit"] = attributes.value("displayUnit").toString();
+  VariablesTreeItem *pVariablesTreeItem = 0;
+  VariablesTable *pVariablesTable = mVariablesTables.value(name, 0);
+  if (pVariablesTable) {
+    pVariablesTreeItem = pVariablesTable->mpTopVariablesTreeItem;
+  } else if ((pVariablesTable = getVariablesTable(name))) {
+    int row = pVariablesTable->mRows.value(name, -1);
+    if (row >= 0) {
+      pVariablesTreeItem = fetchVariablesTreeItem(pVariablesTable, row);
+    }
+  }
+  if (pVariablesTreeItem) {
+    for (VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem ; pParentVariablesTreeItem ;
+         pParentVariablesTreeItem = pParentVariablesTreeItem->parent()) {
+      if (pParentVariablesTreeItem == root) {
+        return pVariablesTreeItem;
+      }
+    }
+    return 0;
+  }
+  /* every item except the root item is either a result file item or a row of its table. */
+  return (root->getVariableName() == name) ? root : 0;
+}
+
+QModelIndex VariablesTreeModel::variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const
+{
+  if (!pVariablesTreeItem || pVariablesTreeItem == mpRootVariablesTreeItem) {
+    return QModelIndex();
+  }
+  return createIndex(pVariablesTreeItem->row(), 0, const_cast<VariablesTreeItem*>(pVariablesTreeItem));
+}
+
+/*!
+ * \brief VariablesTreeModel::getVariablesTable
+ * Returns the table of the result file that contains the variable.
+ * \param variableName
+ * \return
+ */
+VariablesTreeModel::VariablesTable* VariablesTreeModel::getVariablesTable(const QString &variableName) const
+{
+  QHash<QString, VariablesTable*>::const_iterator iterator;
+  for (iterator = mVariablesTables.constBegin() ; iterator != mVariablesTables.constEnd() ; ++iterator) {
+    if (variableName.startsWith(iterator.key() + ".")) {
+      return iterator.value();
+    }
+  }
+  return 0;
+}
+
+/*!
+ * \brief VariablesTreeModel::fetchVariablesTreeItem
+ * Returns the VariablesTreeItem of the table row. Creates the item and its parents if they are not created yet.
+ * \param pVariablesTable
+ * \param row
+ * \return
+ */
+VariablesTreeItem* VariablesTreeModel::fetchVariablesTreeItem(VariablesTable *pVariablesTable, int row)
+{
+  if (!pVariablesTable->mVariablesTreeItems.at(row)) {
+    int parentRow = pVariablesTable->mParentRows.at(row);
+    VariablesTreeItem *pParentVariablesTreeItem;
+    if (parentRow < 0) {
+      pParentVariablesTreeItem = pVariablesTable->mpTopVariablesTreeItem;
+    } else {
+      pParentVariablesTreeItem = fetchVariablesTreeItem(pVariablesTable, parentRow);
     }
-    xmlReader.readNext();
+    fetchVariablesTreeItems(pParentVariablesTreeItem);
   }
-  return scalarVariable;
+  return pVariablesTable->mVariablesTreeItems.at(row);
 }
 
 void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath, QStringList variablesList,
@@ -462,29 +576,23 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
 
   VariablesTreeItem *pTopVariablesTreeItem = new VariablesTreeItem(Variabledata, mpRootVariablesTreeItem, true);
   pTopVariablesTreeItem->setSimulationOptions(simulationOptions);
-  int row = rowCount();
-  beginInsertRows(index, row, row);
-  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
-  endInsertRows();
   /* open the model_init.xml file for reading */
   if (simulationOptions.isValid()) {
     QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
-    QFile initFile(QString(filePath).append(QDir::separator()).append(initFileName));
-    if (initFile.open(QIODevice::ReadOnly)) {
-      QXmlStreamReader initXmlReader(&initFile);
-      parseInitXml(initXmlReader);
-      initFile.close();
-    } else {
+    QString initFilePath = QString(filePath).append(QDir::separator()).append(initFileName);
+    /* the runs of a parameter sweep share the same model_init.xml file. */
+    if (!mInitXmlIndex.isUpToDate(initFilePath) && !mInitXmlIndex.read(initFilePath)) {
       MessagesWidget *pMessagesWidget = mpVariablesTreeView->getVariablesWidget()->getMainWindow()->getMessagesWidget();
       pMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                 GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName())
-                                                 .arg(initFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
+                                                 GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFilePath)
+                                                 .arg(mInitXmlIndex.getErrorString()), Helper::scriptingKind, Helper::errorLevel));
     }
   }
   /* open the .mat file */
   ModelicaMatReader matReader;
   matReader.file = 0;
   const char *msg[] = {""};
+  QHash<QString, ModelicaMatVariable_t*> matVariables;
   if (fileName.endsWith(".mat"))
   {
     //Read in mat file
@@ -495,9 +603,25 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
                                                  GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName)
                                                  .arg(QString(msg[0])), Helper::scriptingKind, Helper::errorLevel));
     }
+    else
+    {
+      /* Index the variables of the mat file in one pass so that each variable lookup is not a search.
+       * Only the final values are shown so getVariableInformation() reads the last row of the data instead of the trajectories.
+       */
+      matVariables.reserve(matReader.nall);
+      for (uint32_t i = 0 ; i < matReader.nall ; i++) {
+        matVariables.insert(QString(matReader.allInfo[i].name), &matReader.allInfo[i]);
+      }
+    }
   }
   // remove time from variables list
   variablesList.removeOne("time");
+  /* Only the information of the variables is stored in the table while the tree is built. The VariablesTreeItems are created
+   * when their parent is expanded. The rows are indexed by their path so that each path segment is found in constant time.
+   */
+  VariablesTable *pVariablesTable = new VariablesTable;
+  pVariablesTable->mpTopVariablesTreeItem = pTopVariablesTreeItem;
+  QHash<QString, int> rows;
   QStringList variables;
   foreach (QString plotVariable, variablesList)
   {
@@ -513,78 +637,54 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       variables = StringHandler::makeVariableParts(plotVariable);
     }
     int count = 1;
-    VariablesTreeItem *pParentVariablesTreeItem = 0;
+    int parentRow = -1;
+    QString parentVariableName = fileName;
     foreach (QString variable, variables)
     {
-      if (count == 1) /* first loop iteration */
-      {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
       QString findVariable;
       /* if last item */
       if (variables.size() == count && plotVariable.startsWith("der("))
         findVariable = parentVariable.isEmpty() ? fileName + ".der(" + variable + ")" : fileName + "." + parentVariable + ".der(" + variable + ")";
       else
         findVariable = parentVariable.isEmpty() ? fileName + "." + variable : fileName + "." + parentVariable + "." + variable;
-      if ((pParentVariablesTreeItem = findVariablesTreeItem(findVariable, pParentVariablesTreeItem)) != NULL)
-      {
-        if (count == 1)
-          parentVariable = variable;
-        else
-          parentVariable += "." + variable;
-        count++;
-        continue;
-      }
-      /*
-        If pParentVariablesTreeItem is 0 and it is first loop iteration then use pTopVariablesTreeItem as parent.
-        If loop iteration is not first and pParentVariablesTreeItem is 0 then find the parent item.
-        */
-      if (!pParentVariablesTreeItem && count > 1)
+      int row = rows.value(findVariable, -1);
+      if (row < 0)
       {
-        pParentVariablesTreeItem = findVariablesTreeItem(fileName + "." + parentVariable, pTopVariablesTreeItem);
-      }
-      else
-      {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
-      QModelIndex index = variablesTreeItemIndex(pParentVariablesTreeItem);
-      QVector<QVariant> variableData;
-      /* if last item */
-      if (variables.size() == count && plotVariable.startsWith("der("))
-        variableData << filePath << fileName << fileName + "." + plotVariable << "der(" + variable + ")";
-      else
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
-      /* find the variable in the xml file */
-      QString variableToFind = variableData[2].toString();
-      variableToFind.remove(QRegExp(pTopVariablesTreeItem->getVariableName() + "."));
-      /* get the variable information i.e value, unit, displayunit, description */
-      QString value, unit, displayUnit, description;
-      bool changeAble = false;
-      getVariableInformation(&matReader, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
-      variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
-      /* set the variable unit */
-      variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
-      /* set the variable displayUnit */
-      variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
-      /* set the variable displayUnits */
-      if (!variableData[5].toString().isEmpty()) {
-        QStringList displayUnits;
-        displayUnits << variableData[5].toString();
-        displayUnits << mpVariablesTreeView->getVariablesWidget()->getMainWindow()->getOMCProxy()->getDerivedUnits(variableData[5].toString());
-        variableData << displayUnits;
-      } else {
-        variableData << QStringList();
+        QString variableName, displayVariableName;
+        /* if last item */
+        if (variables.size() == count && plotVariable.startsWith("der(")) {
+          variableName = fileName + "." + plotVariable;
+          displayVariableName = "der(" + variable + ")";
+        } else {
+          variableName = parentVariableName + "." + variable;
+          displayVariableName = variable;
+        }
+        /* find the variable in the xml file */
+        QString variableToFind = variableName.mid(fileName.length() + 1);
+        /* get the variable information i.e value, unit, displayunit, description */
+        QString value, unit, displayUnit, description;
+        bool changeAble = false;
+        getVariableInformation(&matReader, matVariables, variableToFind, &value, &changeAble, &unit, &displayUnit, &description);
+        row = pVariablesTable->mVariableNames.size();
+        pVariablesTable->mVariableNames.append(variableName);
+        pVariablesTable->mDisplayVariableNames.append(displayVariableName);
+        pVariablesTable->mValues.append(StringHandler::unparse(QString("\"").append(value).append("\"")));
+        pVariablesTable->mUnits.append(StringHandler::unparse(QString("\"").append(unit).append("\"")));
+        pVariablesTable->mDisplayUnits.append(StringHandler::unparse(QString("\"").append(displayUnit).append("\"")));
+        pVariablesTable->mDescriptions.append(StringHandler::unparse(QString("\"").append(description).append("\"")));
+        pVariablesTable->mEditable.append(changeAble);
+        pVariablesTable->mParentRows.append(parentRow);
+        pVariablesTable->mChildRows.append(QVector<int>());
+        if (parentRow < 0) {
+          pVariablesTable->mTopChildRows.append(row);
+        } else {
+          pVariablesTable->mChildRows[parentRow].append(row);
+        }
+        pVariablesTable->mRows.insert(variableName, row);
+        rows.insert(findVariable, row);
       }
-      /* set the variable description */
-      variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
-      /* construct tooltip text */
-      variableData << tr("File: %1/%2\nVariable: %3").arg(filePath).arg(fileName).arg(variableToFind);
-      VariablesTreeItem *pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
-      pVariablesTreeItem->setEditable(changeAble);
-      int row = rowCount(index);
-      beginInsertRows(index, row, row);
-      pParentVariablesTreeItem->insertChild(row, pVariablesTreeItem);
-      endInsertRows();
+      parentRow = row;
+      parentVariableName = pVariablesTable->mVariableNames.at(row);
       if (count == 1)
         parentVariable = variable;
       else
@@ -592,12 +692,21 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       count++;
     }
   }
+  pVariablesTable->mVariablesTreeItems.fill(0, pVariablesTable->mVariableNames.size());
+  mVariablesTables.insert(fileName, pVariablesTable);
+  pTopVariablesTreeItem->setHasPendingChildren(!pVariablesTable->mTopChildRows.isEmpty());
   /* close the .mat file */
   if (fileName.endsWith(".mat"))
   {
     if (matReader.file)
       omc_free_matlab4_reader(&matReader);
   }
+  /* insert the result file item with one notification and create its first level of variables. */
+  int row = rowCount();
+  beginInsertRows(index, row, row);
+  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
+  endInsertRows();
+  fetchVariablesTreeItems(pTopVariablesTreeItem);
   mpVariablesTreeView->collapseAll();
   QModelIndex idx = variablesTreeItemIndex(pTopVariablesTreeItem);
   idx = mpVariablesTreeView->getVariablesWidget()->getVariableTreeProxyModel()->mapFromSource(idx);
@@ -616,6 +725,10 @@ bool VariablesTreeModel::removeVariableTreeItem(QString variable)
   VariablesTreeItem *pVariablesTreeItem = findVariablesTreeItem(variable, mpRootVariablesTreeItem);
   if (pVariablesTreeItem)
   {
+    /* the table of a result file is removed together with its item. */
+    if (pVariablesTreeItem->parent() == mpRootVariablesTreeItem) {
+      delete mVariablesTables.take(pVariablesTreeItem->getVariableName());
+    }
     beginRemoveRows(variablesTreeItemIndex(pVariablesTreeItem), 0, pVariablesTreeItem->getChildren().size());
     pVariablesTreeItem->removeChildren();
     VariablesTreeItem *pParentVariablesTreeItem = pVariablesTreeItem->parent();
@@ -638,6 +751,7 @@ void VariablesTreeModel::unCheckVariables(VariablesTreeItem *pVariablesTreeItem)
 
 void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem, PlotWindow *pPlotWindow)
 {
+  fetchVariablesTreeItems(pVariablesTreeItem);
   QList<VariablesTreeItem*> variablesTreeItems = pVariablesTreeItem->getChildren();
   if (variablesTreeItems.size() == 0) {
     QModelIndex index = variablesTreeItemIndex(pVariablesTreeItem);
@@ -661,6 +775,7 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
  * \brief VariablesTreeModel::getVariableInformation
  * Returns the variable information like value, unit, displayunit and description.
  * \param pMatReader
+ * \param matVariables - the variables of the mat file indexed by name.
  * \param variableToFind
  * \param value
  * \param changeAble
@@ -668,30 +783,41 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
  * \param displayUnit
  * \param description
  */
-void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble,
-                                                QString *unit, QString *displayUnit, QString *description)
+void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, const QHash<QString, ModelicaMatVariable_t*> &matVariables,
+                                                QString variableToFind, QString *value, bool *changeAble, QString *unit,
+                                                QString *displayUnit, QString *description)
 {
-  QHash<QString, QString> hash = mScalarVariablesList.value(variableToFind);
-  if (hash["name"].compare(variableToFind) == 0) {
-    *changeAble = (hash["isValueChangeable"].compare("true") == 0) ? true : false;
+  const InitXmlIndex::ScalarVariable *pScalarVariable = mInitXmlIndex.getScalarVariable(variableToFind);
+  if (pScalarVariable) {
+    *changeAble = pScalarVariable->isValueChangeable;
     if (*changeAble) {
-      *value = hash["start"];
+      *value = pScalarVariable->start;
     } else { /* if the variable is not a tunable parameter then read the final value of the variable. Only mat result files are supported. */
       if ((pMatReader->file != NULL) && strcmp(pMatReader->fileName, "")) {
         *value = "";
-        ModelicaMatVariable_t *var;
-        if (0 == (var = omc_matlab4_find_var(pMatReader, variableToFind.toStdString().c_str()))) {
+        ModelicaMatVariable_t *var = matVariables.value(variableToFind, 0);
+        // omc_matlab4_find_var also finds the derivatives stored under their alternative der() names.
+        if (!var && (0 == (var = omc_matlab4_find_var(pMatReader, variableToFind.toStdString().c_str())))) {
           qDebug() << QString("%1 not found in %2").arg(variableToFind).arg(pMatReader->fileName);
         }
         double res;
-        if (var && !omc_matlab4_val(&res, pMatReader, var, omc_matlab4_stopTime(pMatReader))) {
-          *value = QString::number(res);
+        if (var) {
+          /* parameters are stored separately from the trajectories. For the other variables only read the value of the last row. */
+          int error;
+          if (var->isParam || pMatReader->nrows == 0) {
+            error = omc_matlab4_val(&res, pMatReader, var, omc_matlab4_stopTime(pMatReader));
+          } else {
+            error = omc_matlab4_read_single_val(&res, pMatReader, var->index, pMatReader->nrows - 1);
+          }
+          if (!error) {
+            *value = QString::number(res);
+          }
         }
       }
     }
-    *unit = hash["unit"];
-    *displayUnit = hash["displayUnit"];
-    *description = hash["description"];
+    *unit = pScalarVariable->unit;
+    *displayUnit = pScalarVariable->displayUnit;
+    *description = pScalarVariable->description;
   }
 }
 
@@ -763,6 +889,8 @@ VariablesTreeView::VariablesTreeView(VariablesWidget *pVariablesWidget)
   setContextMenuPolicy(Qt::CustomContextMenu);
   setExpandsOnDoubleClick(false);
   setEditTriggers(QAbstractItemView::AllEditTriggers);
+  /* several parameters can be selected for a parameter sweep. */
+  setSelectionMode(QAbstractItemView::ExtendedSelection);
   setUniformRowHeights(true);
 }
 
@@ -974,8 +1102,15 @@ void VariablesWidget::updateVariablesTreeHelper(QMdiSubWindow *pSubWindow)
   mpVariableTreeProxyModel->invalidate();
 }
 
+/*!
+ * \brief VariablesWidget::readVariablesAndUpdateXML
+ * Collects the changed values of the editable variables.
+ * \param pVariablesTreeItem
+ * \param outputFileName
+ * \param variables - the changed values indexed by the variable name.
+ */
 void VariablesWidget::readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName,
-                                                QHash<QString, QHash<QString, QString> > *variables)
+                                                QHash<QString, QString> *variables)
 {
   for (int i = 0 ; i < pVariablesTreeItem->getChildren().size() ; i++)
   {
@@ -985,44 +1120,12 @@ void VariablesWidget::readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTre
       QString value = pChildVariablesTreeItem->data(1, Qt::DisplayRole).toString();
       QString variableToFind = pChildVariablesTreeItem->getVariableName();
       variableToFind.remove(QRegExp(outputFileName + "."));
-      QHash<QString, QString> hash;
-      hash["name"] = variableToFind;
-      hash["value"] = value;
-      variables->insert(variableToFind, hash);
+      variables->insert(variableToFind, value);
     }
     readVariablesAndUpdateXML(pChildVariablesTreeItem, outputFileName, variables);
   }
 }
 
-void VariablesWidget::findVariableAndUpdateValue(QDomDocument xmlDocument, QHash<QString, QHash<QString, QString> > variables)
-{
-  /* if no variables are changed. */
-  if (variables.empty())
-    return;
-  /* update the variables */
-  int count = 0;
-  QDomNodeList scalarVariable = xmlDocument.elementsByTagName("ScalarVariable");
-  for (int i = 0; i < scalarVariable.size(); i++)
-  {
-    if (count >= variables.size())
-      break;
-    QDomElement element = scalarVariable.at(i).toElement();
-    if (!element.isNull())
-    {
-      QHash<QString, QString> hash = variables.value(element.attribute("name"));
-      if (element.attribute("name").compare(hash["name"]) == 0)
-      {
-        count++;
-        QDomElement el = scalarVariable.at(i).firstChild().toElement();
-        if (!el.isNull())
-        {
-          el.setAttribute("start", hash["value"]);
-        }
-      }
-    }
-  }
-}
-
 void VariablesWidget::reSimulate(bool showSetup)
 {
   QModelIndexList indexes = mpVariablesTreeView->selectionModel()->selectedIndexes();
@@ -1050,41 +1153,39 @@ void VariablesWidget::reSimulate(bool showSetup)
   }
 }
 
+/*!
+ * \brief VariablesWidget::updateInitXmlFile
+ * Writes the changed start values to the model_init.xml file.
+ * The values are patched at the offsets of the InitXmlIndex so the file is not parsed and written as a document.
+ * \param simulationOptions
+ */
 void VariablesWidget::updateInitXmlFile(SimulationOptions simulationOptions)
 {
-  /* Update the _init.xml file with new values. */
-  /* open the model_init.xml file for writing */
+  VariablesTreeItem *pTopVariableTreeItem = mpVariablesTreeModel->findVariablesTreeItem(simulationOptions.getResultFileName(),
+                                                                                         mpVariablesTreeModel->getRootVariablesTreeItem());
+  if (!pTopVariableTreeItem) {
+    return;
+  }
+  QHash<QString, QString> variables;
+  readVariablesAndUpdateXML(pTopVariableTreeItem, simulationOptions.getResultFileName(), &variables);
+  /* if no variables are changed. */
+  if (variables.isEmpty()) {
+    return;
+  }
   QString initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
-  QFile initFile(QString(simulationOptions.getWorkingDirectory()).append(QDir::separator()).append(initFileName));
-  QDomDocument initXmlDocument;
-  if (initFile.open(QIODevice::ReadOnly)) {
-    if (initXmlDocument.setContent(&initFile)) {
-      VariablesTreeItem *pTopVariableTreeItem;
-      pTopVariableTreeItem = mpVariablesTreeModel->findVariablesTreeItem(simulationOptions.getResultFileName(),
-                                                                         mpVariablesTreeModel->getRootVariablesTreeItem());
-      if (pTopVariableTreeItem) {
-        QHash<QString, QHash<QString, QString> > variables;
-        readVariablesAndUpdateXML(pTopVariableTreeItem, simulationOptions.getResultFileName(), &variables);
-        findVariableAndUpdateValue(initXmlDocument, variables);
-      }
-    } else {
-      MessagesWidget *pMessagesWidget = mpVariablesTreeView->getVariablesWidget()->getMainWindow()->getMessagesWidget();
-      pMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                 tr("Unable to set the content of QDomDocument from file %1")
-                                                 .arg(initFile.fileName()), Helper::scriptingKind, Helper::errorLevel));
-    }
-    initFile.close();
-    initFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
-    QTextStream textStream(&initFile);
-    textStream.setCodec(Helper::utf8.toStdString().data());
-    textStream.setGenerateByteOrderMark(false);
-    textStream << initXmlDocument.toString();
-    initFile.close();
-  } else {
+  QString initFilePath = QString(simulationOptions.getWorkingDirectory()).append(QDir::separator()).append(initFileName);
+  /* reuse the index of the last loaded result file if it is read from the same file. */
+  InitXmlIndex initXmlIndex;
+  InitXmlIndex *pInitXmlIndex = mpVariablesTreeModel->getInitXmlIndex();
+  if (!pInitXmlIndex->isUpToDate(initFilePath)) {
+    pInitXmlIndex = &initXmlIndex;
+    pInitXmlIndex->read(initFilePath);
+  }
+  if (!pInitXmlIndex->updateStartValues(variables)) {
     MessagesWidget *pMessagesWidget = mpVariablesTreeView->getVariablesWidget()->getMainWindow()->getMessagesWidget();
     pMessagesWidget->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                               GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName())
-                                               .arg(initFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
+                                               GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFilePath)
+                                               .arg(pInitXmlIndex->getErrorString()), Helper::scriptingKind, Helper::errorLevel));
   }
 }
 
@@ -1131,15 +1232,13 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
         pPlotWindow->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
         pPlotWindow->plot(pPlotCurve);
         pPlotCurve = pPlotWindow->getPlot()->getPlotCurvesList().last();
+        qreal xOffset = 0, xScaleFactor = 1, yOffset = 0, yScaleFactor = 1;
         if (pPlotCurve && pVariablesTreeItem->getUnit().compare(pVariablesTreeItem->getDisplayUnit()) != 0) {
           OMCInterface::convertUnits_res convertUnit = mpMainWindow->getOMCProxy()->convertUnits(pVariablesTreeItem->getUnit(),
                                                                                                  pVariablesTreeItem->getDisplayUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->getYAxisData().size() ; i++) {
-              pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->getYAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
-            pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
-            pPlotWindow->getPlot()->replot();
+            yOffset = convertUnit.offset;
+            yScaleFactor = convertUnit.scaleFactor;
           } else {
             pPlotCurve->setDisplayUnit(pVariablesTreeItem->getUnit());
             pPlotCurve->setTitleLocal();
@@ -1149,13 +1248,14 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
         if (pPlotWindow->getTimeUnit().compare("s") != 0) {
           OMCInterface::convertUnits_res convertUnit = mpMainWindow->getOMCProxy()->convertUnits("s", pPlotWindow->getTimeUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->getXAxisData().size() ; i++) {
-              pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->getXAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
-            pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
-            pPlotWindow->getPlot()->replot();
+            xOffset = convertUnit.offset;
+            xScaleFactor = convertUnit.scaleFactor;
           }
         }
+        /* convert the units and reduce the curve to the points visible at the current zoom in one pass. */
+        if (pPlotCurve) {
+          PlotCurveDecimator::getPlotCurveDecimator(pPlotWindow)->addPlotCurve(pPlotCurve, xOffset, xScaleFactor, yOffset, yScaleFactor);
+        }
         if (pPlotWindow->getAutoScaleButton()->isChecked()) {
           pPlotWindow->fitInView();
         } else {
@@ -1323,6 +1423,8 @@ void VariablesWidget::unitChanged(const QModelIndex &index)
   if (!pVariablesTreeItem) {
     return;
   }
+  // a running simulation streams its values in the unit of the variable, so the live plot has to convert them again.
+  mpMainWindow->getPlotWindowContainer()->resetLivePlotVariableConversion(pVariablesTreeItem->getVariableName());
   try {
     OMPlot::PlotWindow *pPlotWindow = mpMainWindow->getPlotWindowContainer()->getCurrentWindow();
     // if still pPlotWindow is 0 then return.
@@ -1335,10 +1437,10 @@ void VariablesWidget::unitChanged(const QModelIndex &index)
       foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
         QString curveTitle = pPlotCurve->getNameStructure();
         if (curveTitle.compare(pVariablesTreeItem->getVariableName()) == 0) {
-          for (int i = 0 ; i < pPlotCurve->getYAxisData().size() ; i++) {
-            pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->getYAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-          }
-          pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+          /* the values in each display unit are kept so switching back to a display unit is instant. */
+          PlotCurveDecimator::getPlotCurveDecimator(pPlotWindow)->setPlotCurveDisplayUnit(pPlotCurve, pVariablesTreeItem->getPreviousUnit(),
+                                                                                          pVariablesTreeItem->getDisplayUnit(),
+                                                                                          convertUnit.offset, convertUnit.scaleFactor);
           pPlotCurve->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
           pPlotCurve->setTitleLocal();
           pPlotWindow->getPlot()->replot();
@@ -1367,11 +1469,9 @@ void VariablesWidget::timeUnitChanged(QString unit)
     }
     OMCInterface::convertUnits_res convertUnit = mpMainWindow->getOMCProxy()->convertUnits(pPlotWindow->getTimeUnit(), unit);
     if (convertUnit.unitsCompatible) {
+      PlotCurveDecimator *pPlotCurveDecimator = PlotCurveDecimator::getPlotCurveDecimator(pPlotWindow);
       foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
-        for (int i = 0 ; i < pPlotCurve->getXAxisData().size() ; i++) {
-          pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->getXAxisData().at(i), convertUnit.offset, convertUnit.scaleFactor));
-        }
-        pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+        pPlotCurveDecimator->setPlotCurveData(pPlotCurve, convertUnit.offset, convertUnit.scaleFactor);
       }
       pPlotWindow->setXLabel(QString("time [%1]").arg(unit));
       pPlotWindow->setTimeUnit(unit);
@@ -1414,6 +1514,7 @@ void VariablesWidget::showContextMenu(QPoint point)
     menu.addSeparator();
     menu.addAction(mpMainWindow->getReSimulateModelAction());
     menu.addAction(mpMainWindow->getReSimulateSetupAction());
+    menu.addAction(mpMainWindow->getParameterSweepAction());
     point.setY(point.y() + adjust);
     menu.exec(mpVariablesTreeView->mapToGlobal(point));
   }
@@ -1429,6 +1530,10 @@ void VariablesWidget::findVariables()
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
   Qt::CaseSensitivity caseSensitivity = mpTreeSearchFilters->getCaseSensitiveCheckBox()->isChecked() ? Qt::CaseSensitive: Qt::CaseInsensitive;
   QRegExp regExp(findText, caseSensitivity, syntax);
+  /* the filter can only match the created items so create all of them before searching. */
+  if (!findText.isEmpty()) {
+    mpVariablesTreeModel->fetchVariablesTreeItems(mpVariablesTreeModel->getRootVariablesTreeItem(), true);
+  }
   mpVariableTreeProxyModel->setFilterRegExp(regExp);
   /* expand all so that the filtered items can be seen. */
   if (!findText.isEmpty()) {
@@ -1445,3 +1550,57 @@ void VariablesWidget::showReSimulateSetup()
 {
   reSimulate(true);
 }
+
+/*!
+ * \brief VariablesWidget::showParameterSweepSetup
+ * Shows the ParameterSweepDialog for the parameters selected in the Variables Browser.
+ */
+void VariablesWidget::showParameterSweepSetup()
+{
+  QModelIndexList indexes = mpVariablesTreeView->selectionModel()->selectedRows();
+  if (indexes.isEmpty()) {
+    QMessageBox::information(this, QString(Helper::applicationName).append(" - ").append(Helper::information),
+                             tr("You must select the parameters to sweep."), Helper::ok);
+    return;
+  }
+  VariablesTreeItem *pTopVariablesTreeItem = 0;
+  QStringList parameters, values;
+  foreach (QModelIndex index, indexes) {
+    index = mpVariableTreeProxyModel->mapToSource(index);
+    VariablesTreeItem *pVariablesTreeItem = static_cast<VariablesTreeItem*>(index.internalPointer());
+    if (!pVariablesTreeItem) {
+      continue;
+    }
+    /* only sweep the parameters of one result file. */
+    if (!pTopVariablesTreeItem) {
+      pTopVariablesTreeItem = pVariablesTreeItem->rootParent();
+    } else if (pVariablesTreeItem->rootParent() != pTopVariablesTreeItem) {
+      continue;
+    }
+    if (pVariablesTreeItem->isEditable()) {
+      QString parameter = pVariablesTreeItem->getVariableName();
+      parameter.remove(0, pTopVariablesTreeItem->getVariableName().size() + 1);
+      parameters.append(parameter);
+      values.append(pVariablesTreeItem->data(1, Qt::DisplayRole).toString());
+    }
+  }
+  if (!pTopVariablesTreeItem) {
+    return;
+  }
+  SimulationOptions simulationOptions = pTopVariablesTreeItem->getSimulationOptions();
+  if (!simulationOptions.isValid()) {
+    QMessageBox::information(this, QString(Helper::applicationName).append(" - ").append(Helper::information),
+                             tr("You cannot re-simulate this class.<br />This is just a result file loaded via menu <b>File->Open Result File(s)</b>."), Helper::ok);
+    return;
+  }
+  if (parameters.isEmpty()) {
+    QMessageBox::information(this, QString(Helper::applicationName).append(" - ").append(Helper::information),
+                             tr("You must select the parameters to sweep. Only the parameters with editable values can be swept."), Helper::ok);
+    return;
+  }
+  /* the values of the other changed parameters are used by all the runs. */
+  updateInitXmlFile(simulationOptions);
+  QStringList plotVariables = mpMainWindow->getPlotWindowContainer()->getPlotVariables(simulationOptions.getResultFileName());
+  ParameterSweepDialog *pParameterSweepDialog = new ParameterSweepDialog(simulationOptions, parameters, values, plotVariables, mpMainWindow);
+  pParameterSweepDialog->show();
+}
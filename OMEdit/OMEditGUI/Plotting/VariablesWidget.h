@@ -38,6 +38,7 @@
 #include "MainWindow.h"
 #include "SimulationDialog.h"
 #include "PlotWindow.h"
+#include "InitXmlIndex.h"
 
 class MainWindow;
 class VariablesTreeItem
@@ -60,6 +61,8 @@ public:
   void setChecked(bool set) {mChecked = set;}
   bool isEditable() const {return mEditable;}
   void setEditable(bool set) {mEditable = set;}
+  bool hasPendingChildren() const {return mHasPendingChildren;}
+  void setHasPendingChildren(bool set) {mHasPendingChildren = set;}
   SimulationOptions getSimulationOptions() {return mSimulationOptions;}
   void setSimulationOptions(SimulationOptions simulationOptions) {mSimulationOptions = simulationOptions;}
   QIcon getVariableTreeItemIcon(QString name) const;
@@ -91,6 +94,7 @@ private:
   QString mToolTip;
   bool mChecked;
   bool mEditable;
+  bool mHasPendingChildren;
   SimulationOptions mSimulationOptions;
 };
 
@@ -100,6 +104,7 @@ class VariablesTreeModel : public QAbstractItemModel
   Q_OBJECT
 public:
   VariablesTreeModel(VariablesTreeView *pVariablesTreeView = 0);
+  ~VariablesTreeModel();
   VariablesTreeItem* getRootVariablesTreeItem() {return mpRootVariablesTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const;
   int rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -109,22 +114,46 @@ public:
   bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole);
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   Qt::ItemFlags flags(const QModelIndex &index) const;
-  VariablesTreeItem* findVariablesTreeItem(const QString &name, VariablesTreeItem *root) const;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+  bool canFetchMore(const QModelIndex &parent) const;
+  void fetchMore(const QModelIndex &parent);
+  void fetchVariablesTreeItems(VariablesTreeItem *pVariablesTreeItem, bool recursive = false);
+  VariablesTreeItem* findVariablesTreeItem(const QString &name, VariablesTreeItem *root);
   QModelIndex variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const;
-  QModelIndex variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem, const VariablesTreeItem *pParentVariablesTreeItem,
-                                           const QModelIndex &parentIndex) const;
-  void parseInitXml(QXmlStreamReader &xmlReader);
-  QHash<QString, QString> parseScalarVariable(QXmlStreamReader &xmlReader);
+  InitXmlIndex* getInitXmlIndex() {return &mInitXmlIndex;}
   void insertVariablesItems(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
   bool removeVariableTreeItem(QString variable);
   void unCheckVariables(VariablesTreeItem *pVariablesTreeItem);
   void plotAllVariables(VariablesTreeItem *pVariablesTreeItem, OMPlot::PlotWindow *pPlotWindow);
 private:
+  /* Holds the variables of a result file in columns. The VariablesTreeItems are only created when their parent is expanded. */
+  class VariablesTable
+  {
+  public:
+    VariablesTreeItem *mpTopVariablesTreeItem;
+    QStringList mVariableNames;
+    QStringList mDisplayVariableNames;
+    QStringList mValues;
+    QStringList mUnits;
+    QStringList mDisplayUnits;
+    QStringList mDescriptions;
+    QVector<bool> mEditable;
+    QVector<int> mParentRows;
+    QVector<QVector<int> > mChildRows;
+    QVector<int> mTopChildRows;
+    QVector<VariablesTreeItem*> mVariablesTreeItems;
+    QHash<QString, int> mRows;
+    QHash<QString, QStringList> mDerivedUnits;
+  };
   VariablesTreeView *mpVariablesTreeView;
   VariablesTreeItem *mpRootVariablesTreeItem;
-  QHash<QString, QHash<QString,QString> > mScalarVariablesList;
-  void getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble, QString *unit,
-                              QString *displayUnit, QString *description);
+  InitXmlIndex mInitXmlIndex;
+  QHash<QString, VariablesTable*> mVariablesTables;
+  VariablesTable* getVariablesTable(const QString &variableName) const;
+  VariablesTreeItem* fetchVariablesTreeItem(VariablesTable *pVariablesTable, int row);
+  void getVariableInformation(ModelicaMatReader *pMatReader, const QHash<QString, ModelicaMatVariable_t*> &matVariables,
+                              QString variableToFind, QString *value, bool *changeAble, QString *unit, QString *displayUnit,
+                              QString *description);
 signals:
   void itemChecked(const QModelIndex &index, qreal curveThickness, int curveStyle);
   void unitChanged(const QModelIndex &index);
@@ -169,9 +198,7 @@ public:
   void insertVariablesItemsToTree(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
   void variablesUpdated();
   void updateVariablesTreeHelper(QMdiSubWindow *pSubWindow);
-  void readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName,
-                                 QHash<QString, QHash<QString, QString> > *variables);
-  void findVariableAndUpdateValue(QDomDocument xmlDocument, QHash<QString, QHash<QString, QString> > variables);
+  void readVariablesAndUpdateXML(VariablesTreeItem *pVariablesTreeItem, QString outputFileName, QHash<QString, QString> *variables);
   void reSimulate(bool showSetup);
   void updateInitXmlFile(SimulationOptions simulationOptions);
 private:
@@ -195,6 +222,7 @@ public slots:
   void findVariables();
   void directReSimulate();
   void showReSimulateSetup();
+  void showParameterSweepSetup();
 };
 
 #endif // VARIABLESWIDGET_H
@@ -0,0 +1,693 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QTcpSocket>
+#include "ParameterSweep.h"
+#include "VariablesWidget.h"
+#include "PlotWindowContainer.h"
+
+/* the maximum number of simulations of one sweep. */
+#define PARAMETER_SWEEP_MAX_RUNS 10000
+
+/*!
+ * \class ParameterSweepDialog
+ * \brief Asks for the value ranges of the parameters selected in the Variables Browser and starts the sweep.
+ */
+/*!
+ * \brief ParameterSweepDialog::ParameterSweepDialog
+ * \param simulationOptions - the simulation options of the result file.
+ * \param parameters - the parameters to sweep.
+ * \param values - the current values of the parameters.
+ * \param plotVariables - the variables plotted for each run.
+ * \param pMainWindow
+ */
+ParameterSweepDialog::ParameterSweepDialog(SimulationOptions simulationOptions, QStringList parameters, QStringList values,
+                                           QStringList plotVariables, MainWindow *pMainWindow)
+  : QDialog(pMainWindow), mSimulationOptions(simulationOptions), mpMainWindow(pMainWindow)
+{
+  setAttribute(Qt::WA_DeleteOnClose);
+  setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::parameterSweep).append(" - ")
+                 .append(mSimulationOptions.getClassName()));
+  setMinimumWidth(550);
+  mpHeadingLabel = Utilities::getHeadingLabel(QString(Helper::parameterSweep).append(" - ").append(mSimulationOptions.getClassName()));
+  // parameters
+  mpParametersTreeWidget = new QTreeWidget;
+  mpParametersTreeWidget->setItemDelegate(new ItemDelegate(mpParametersTreeWidget));
+  mpParametersTreeWidget->setIndentation(0);
+  mpParametersTreeWidget->setEditTriggers(QAbstractItemView::AllEditTriggers);
+  QStringList headerLabels;
+  headerLabels << tr("Parameter") << tr("From") << tr("To") << tr("Steps");
+  mpParametersTreeWidget->setColumnCount(headerLabels.size());
+  mpParametersTreeWidget->setHeaderLabels(headerLabels);
+  mpParametersTreeWidget->setColumnWidth(0, 200);
+  for (int i = 0 ; i < parameters.size() ; i++) {
+    QTreeWidgetItem *pTreeWidgetItem = new QTreeWidgetItem(QStringList() << parameters.at(i) << values.value(i) << values.value(i) << "1");
+    pTreeWidgetItem->setFlags(pTreeWidgetItem->flags() | Qt::ItemIsEditable);
+    mpParametersTreeWidget->addTopLevelItem(pTreeWidgetItem);
+  }
+  connect(mpParametersTreeWidget, SIGNAL(itemChanged(QTreeWidgetItem*,int)), SLOT(updateNumberOfRuns()));
+  // plot variables
+  mpPlotVariablesLabel = new Label(tr("Plot Variables:"));
+  mpPlotVariablesTextBox = new QLineEdit(plotVariables.join(" "));
+  mpPlotVariablesTextBox->setToolTip(tr("Space separated list of the variables to plot for every run."));
+  // number of processes
+  mpNumberOfProcessesLabel = new Label(tr("Parallel Simulations:"));
+  mpNumberOfProcessesSpinBox = new QSpinBox;
+  mpNumberOfProcessesSpinBox->setRange(1, qMax(1, mpMainWindow->getOMCProxy()->numProcessors()));
+  mpNumberOfProcessesSpinBox->setValue(mpNumberOfProcessesSpinBox->maximum());
+  mpNumberOfRunsLabel = new Label;
+  updateNumberOfRuns();
+  // buttons
+  mpOkButton = new QPushButton(Helper::ok);
+  mpOkButton->setAutoDefault(true);
+  connect(mpOkButton, SIGNAL(clicked()), SLOT(startParameterSweep()));
+  mpCancelButton = new QPushButton(Helper::cancel);
+  mpCancelButton->setAutoDefault(false);
+  connect(mpCancelButton, SIGNAL(clicked()), SLOT(reject()));
+  mpButtonBox = new QDialogButtonBox(Qt::Horizontal);
+  mpButtonBox->addButton(mpOkButton, QDialogButtonBox::ActionRole);
+  mpButtonBox->addButton(mpCancelButton, QDialogButtonBox::ActionRole);
+  // layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+  pMainLayout->addWidget(mpHeadingLabel, 0, 0, 1, 2);
+  pMainLayout->addWidget(mpParametersTreeWidget, 1, 0, 1, 2);
+  pMainLayout->addWidget(mpPlotVariablesLabel, 2, 0);
+  pMainLayout->addWidget(mpPlotVariablesTextBox, 2, 1);
+  pMainLayout->addWidget(mpNumberOfProcessesLabel, 3, 0);
+  pMainLayout->addWidget(mpNumberOfProcessesSpinBox, 3, 1);
+  pMainLayout->addWidget(mpNumberOfRunsLabel, 4, 0, 1, 2);
+  pMainLayout->addWidget(mpButtonBox, 5, 0, 1, 2, Qt::AlignRight);
+  setLayout(pMainLayout);
+}
+
+/*!
+ * \brief ParameterSweepDialog::createParameters
+ * Creates the values of each parameter from its range.
+ * \param pErrorString - set if a range is invalid.
+ * \return
+ */
+QList<ParameterSweepParameter> ParameterSweepDialog::createParameters(QString *pErrorString)
+{
+  QList<ParameterSweepParameter> parameters;
+  for (int i = 0 ; i < mpParametersTreeWidget->topLevelItemCount() ; i++) {
+    QTreeWidgetItem *pTreeWidgetItem = mpParametersTreeWidget->topLevelItem(i);
+    bool fromOk, toOk, stepsOk;
+    double from = pTreeWidgetItem->text(1).toDouble(&fromOk);
+    double to = pTreeWidgetItem->text(2).toDouble(&toOk);
+    int steps = pTreeWidgetItem->text(3).toInt(&stepsOk);
+    if (!fromOk || !toOk || !stepsOk || steps < 1) {
+      *pErrorString = tr("Invalid range for parameter <b>%1</b>. From and To must be numbers and Steps must be a positive integer.")
+          .arg(pTreeWidgetItem->text(0));
+      return QList<ParameterSweepParameter>();
+    }
+    ParameterSweepParameter parameter;
+    parameter.mName = pTreeWidgetItem->text(0);
+    for (int j = 0 ; j < steps ; j++) {
+      double value = (steps == 1) ? from : from + (to - from) * j / (steps - 1);
+      parameter.mValues.append(QString::number(value, 'g', 15));
+    }
+    parameters.append(parameter);
+  }
+  return parameters;
+}
+
+/*!
+ * \brief ParameterSweepDialog::updateNumberOfRuns
+ * Shows the number of simulations of the sweep.
+ */
+void ParameterSweepDialog::updateNumberOfRuns()
+{
+  QString errorString;
+  QList<ParameterSweepParameter> parameters = createParameters(&errorString);
+  if (!errorString.isEmpty()) {
+    mpNumberOfRunsLabel->setText(errorString);
+  } else if (ParameterSweepWidget::numberOfRuns(parameters) > PARAMETER_SWEEP_MAX_RUNS) {
+    mpNumberOfRunsLabel->setText(tr("Number of simulations: more than %1").arg(PARAMETER_SWEEP_MAX_RUNS));
+  } else {
+    mpNumberOfRunsLabel->setText(tr("Number of simulations: %1").arg(ParameterSweepWidget::numberOfRuns(parameters)));
+  }
+}
+
+/*!
+ * \brief ParameterSweepDialog::startParameterSweep
+ * Validates the ranges and starts the sweep.
+ */
+void ParameterSweepDialog::startParameterSweep()
+{
+  QString errorString;
+  QList<ParameterSweepParameter> parameters = createParameters(&errorString);
+  if (!errorString.isEmpty()) {
+    QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error), errorString, Helper::ok);
+    return;
+  }
+  if (ParameterSweepWidget::numberOfRuns(parameters) > PARAMETER_SWEEP_MAX_RUNS) {
+    QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
+                          tr("The sweep has more than %1 simulations.").arg(PARAMETER_SWEEP_MAX_RUNS), Helper::ok);
+    return;
+  }
+  QStringList plotVariables = mpPlotVariablesTextBox->text().split(" ", QString::SkipEmptyParts);
+  ParameterSweepWidget *pParameterSweepWidget = new ParameterSweepWidget(mSimulationOptions, parameters, plotVariables,
+                                                                         mpNumberOfProcessesSpinBox->value(), mpMainWindow);
+  int xPos = QApplication::desktop()->availableGeometry().width() - pParameterSweepWidget->frameSize().width() - 20;
+  int yPos = QApplication::desktop()->availableGeometry().height() - pParameterSweepWidget->frameSize().height() - 20;
+  pParameterSweepWidget->setGeometry(xPos, yPos, pParameterSweepWidget->width(), pParameterSweepWidget->height());
+  pParameterSweepWidget->show();
+  pParameterSweepWidget->start();
+  accept();
+}
+
+/*!
+ * \class ParameterSweepWidget
+ * \brief Runs the simulation executable once for each combination of the parameter values.
+ * The model is not compiled again. At most mNumberOfProcesses executables run at the same time. Each run gets its own override
+ * file and result file. The progress of each run is read from its -port socket.
+ * When all runs are finished the results are added to the Variables Browser and the plot variables of all runs are plotted
+ * in one plot window.
+ */
+/*!
+ * \brief ParameterSweepWidget::ParameterSweepWidget
+ * \param simulationOptions - the simulation options of the result file.
+ * \param parameters - the swept parameters.
+ * \param plotVariables - the variables plotted for each run.
+ * \param numberOfProcesses - the maximum number of simulations running at the same time.
+ * \param pMainWindow
+ */
+ParameterSweepWidget::ParameterSweepWidget(SimulationOptions simulationOptions, QList<ParameterSweepParameter> parameters,
+                                           QStringList plotVariables, int numberOfProcesses, MainWindow *pMainWindow)
+  : QWidget(pMainWindow, Qt::Window), mSimulationOptions(simulationOptions), mParameters(parameters), mPlotVariables(plotVariables),
+    mNumberOfProcesses(qMax(1, numberOfProcesses)), mpMainWindow(pMainWindow), mNextRun(0), mRunningProcesses(0), mFinishedRuns(0)
+{
+  setAttribute(Qt::WA_DeleteOnClose);
+  setWindowTitle(QString("%1 - %2 %3").arg(Helper::applicationName).arg(mSimulationOptions.getClassName()).arg(Helper::parameterSweep));
+  // progress
+  mpProgressLabel = new Label;
+  mpProgressLabel->setTextFormat(Qt::RichText);
+  mpProgressBar = new QProgressBar;
+  mpProgressBar->setAlignment(Qt::AlignHCenter);
+  mpCancelButton = new QPushButton(tr("Cancel Sweep"));
+  connect(mpCancelButton, SIGNAL(clicked()), SLOT(cancelParameterSweep()));
+  // runs
+  mpRunsTreeWidget = new QTreeWidget;
+  mpRunsTreeWidget->setItemDelegate(new ItemDelegate(mpRunsTreeWidget));
+  mpRunsTreeWidget->setIndentation(0);
+  mpRunsTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  QStringList headerLabels;
+  headerLabels << tr("Result File") << tr("Status") << tr("Progress");
+  foreach (const ParameterSweepParameter &parameter, mParameters) {
+    headerLabels << parameter.mName;
+  }
+  mpRunsTreeWidget->setColumnCount(headerLabels.size());
+  mpRunsTreeWidget->setHeaderLabels(headerLabels);
+  mpRunsTreeWidget->setColumnWidth(0, 200);
+  // layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->setContentsMargins(5, 5, 5, 5);
+  pMainLayout->addWidget(mpProgressLabel, 0, 0, 1, 2);
+  pMainLayout->addWidget(mpProgressBar, 1, 0);
+  pMainLayout->addWidget(mpCancelButton, 1, 1);
+  pMainLayout->addWidget(mpRunsTreeWidget, 2, 0, 1, 2);
+  setLayout(pMainLayout);
+  resize(600, 350);
+}
+
+/*!
+ * \brief ParameterSweepWidget::~ParameterSweepWidget
+ * Kills the running simulations.
+ */
+ParameterSweepWidget::~ParameterSweepWidget()
+{
+  for (int i = 0 ; i < mRuns.size() ; i++) {
+    if (mRuns.at(i).mpProcess) {
+      disconnect(mRuns.at(i).mpProcess, 0, this, 0);
+      mRuns.at(i).mpProcess->kill();
+    }
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::numberOfRuns
+ * Returns the number of combinations of the parameter values.
+ * \param parameters
+ * \return the number of runs or PARAMETER_SWEEP_MAX_RUNS + 1 if there are more.
+ */
+int ParameterSweepWidget::numberOfRuns(const QList<ParameterSweepParameter> &parameters)
+{
+  if (parameters.isEmpty()) {
+    return 0;
+  }
+  qint64 runs = 1;
+  foreach (const ParameterSweepParameter &parameter, parameters) {
+    runs *= parameter.mValues.size();
+    if (runs > PARAMETER_SWEEP_MAX_RUNS) {
+      return PARAMETER_SWEEP_MAX_RUNS + 1;
+    }
+  }
+  return runs;
+}
+
+/*!
+ * \brief ParameterSweepWidget::start
+ * Creates the runs and starts the first mNumberOfProcesses of them.
+ */
+void ParameterSweepWidget::start()
+{
+  /* The simulation flags of the result file already contain -r and -override, and may contain -overrideFile. Each run gets its own
+   * result file, and the -override values and the contents of the user's override file are moved to the override file of the run
+   * since the executable only reads one of them. The -override values win over the values of the user's override file.
+   */
+  QStringList sweptParameters;
+  foreach (const ParameterSweepParameter &parameter, mParameters) {
+    sweptParameters.append(parameter.mName);
+  }
+  QStringList overrides;
+  QStringList fileOverrides;
+  foreach (const QString &simulationFlag, mSimulationOptions.getSimulationFlags()) {
+    if (simulationFlag.startsWith("-r=") || simulationFlag.startsWith("-port=") || simulationFlag.startsWith("-logFormat=")) {
+      continue;
+    } else if (simulationFlag.startsWith("-override=")) {
+      overrides.append(simulationFlag.mid(10).split(",", QString::SkipEmptyParts));
+    } else if (simulationFlag.startsWith("-overrideFile=")) {
+      QString overrideFileName = simulationFlag.mid(14);
+      if (QFileInfo(overrideFileName).isRelative()) {
+        overrideFileName = QString(mSimulationOptions.getWorkingDirectory()).append("/").append(overrideFileName);
+      }
+      QFile overrideFile(overrideFileName);
+      if (overrideFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream textStream(&overrideFile);
+        while (!textStream.atEnd()) {
+          QString override = textStream.readLine().trimmed();
+          if (!override.isEmpty() && !override.startsWith("//")) {
+            fileOverrides.append(override);
+          }
+        }
+        overrideFile.close();
+      } else {
+        mOverrideFileError = GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(overrideFile.fileName())
+            .arg(overrideFile.errorString());
+      }
+    } else {
+      mSimulationFlags.append(simulationFlag);
+    }
+  }
+  QStringList overriddenParameters = sweptParameters;
+  foreach (const QString &override, overrides) {
+    overriddenParameters.append(override.section('=', 0, 0).trimmed());
+  }
+  foreach (const QString &override, fileOverrides) {
+    if (!overriddenParameters.contains(override.section('=', 0, 0).trimmed())) {
+      mOverrides.append(override);
+    }
+  }
+  foreach (const QString &override, overrides) {
+    if (!sweptParameters.contains(override.section('=', 0, 0).trimmed())) {
+      mOverrides.append(override);
+    }
+  }
+  createRuns();
+  mpProgressBar->setRange(0, mRuns.size() * 100);
+  mpProgressBar->setValue(0);
+  updateProgress();
+  startNextRuns();
+}
+
+/*!
+ * \brief ParameterSweepWidget::createRuns
+ * Creates one run for each combination of the parameter values.
+ */
+void ParameterSweepWidget::createRuns()
+{
+  QString outputFileName = mSimulationOptions.getOutputFileName();
+  QString resultFileSuffix = QFileInfo(mSimulationOptions.getResultFileName()).suffix();
+  int runs = numberOfRuns(mParameters);
+  for (int i = 0 ; i < runs ; i++) {
+    ParameterSweepRun run;
+    run.mIndex = i;
+    /* the first parameter changes slowest. */
+    int index = i;
+    for (int j = mParameters.size() - 1 ; j >= 0 ; j--) {
+      const QStringList &values = mParameters.at(j).mValues;
+      run.mValues.prepend(values.at(index % values.size()));
+      index /= values.size();
+    }
+    run.mResultFileName = QString("%1_sweep%2_res.%3").arg(outputFileName).arg(i + 1).arg(resultFileSuffix);
+    run.mOverrideFileName = QString("%1_sweep%2_override.txt").arg(outputFileName).arg(i + 1);
+    run.mStatus = ParameterSweepRun::Queued;
+    run.mProgress = 0;
+    run.mpProcess = 0;
+    run.mpTcpServer = 0;
+    run.mpTreeWidgetItem = new QTreeWidgetItem(QStringList() << run.mResultFileName << tr("Queued") << "" << run.mValues);
+    run.mpTreeWidgetItem->setToolTip(0, run.mResultFileName);
+    mpRunsTreeWidget->addTopLevelItem(run.mpTreeWidgetItem);
+    mRuns.append(run);
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::startNextRuns
+ * Starts the queued runs until mNumberOfProcesses simulations are running.
+ */
+void ParameterSweepWidget::startNextRuns()
+{
+  while (mRunningProcesses < mNumberOfProcesses && mNextRun < mRuns.size()) {
+    ParameterSweepRun *pRun = &mRuns[mNextRun++];
+    if (startRun(pRun)) {
+      mRunningProcesses++;
+    } else {
+      mFinishedRuns++;
+    }
+  }
+  updateProgress();
+  if (mFinishedRuns == mRuns.size()) {
+    mpCancelButton->setEnabled(false);
+    plotResults();
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::startRun
+ * Writes the override file of the run and starts the simulation executable.
+ * \param pRun
+ * \return false if the user's override file can't be read or the override file of the run can't be written.
+ */
+bool ParameterSweepWidget::startRun(ParameterSweepRun *pRun)
+{
+  /* the runs would silently miss the values of the user's override file. */
+  if (!mOverrideFileError.isEmpty()) {
+    setRunStatus(pRun, ParameterSweepRun::Failed, mOverrideFileError);
+    return false;
+  }
+  QString workingDirectory = mSimulationOptions.getWorkingDirectory();
+  QFile overrideFile(QString(workingDirectory).append("/").append(pRun->mOverrideFileName));
+  if (!overrideFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+    setRunStatus(pRun, ParameterSweepRun::Failed, GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(overrideFile.fileName())
+                 .arg(overrideFile.errorString()));
+    return false;
+  }
+  QTextStream textStream(&overrideFile);
+  foreach (const QString &override, mOverrides) {
+    textStream << override << "\n";
+  }
+  for (int i = 0 ; i < mParameters.size() ; i++) {
+    textStream << mParameters.at(i).mName << "=" << pRun->mValues.at(i) << "\n";
+  }
+  overrideFile.close();
+  // progress server
+  pRun->mpTcpServer = new QTcpServer(this);
+  pRun->mpTcpServer->listen(QHostAddress(QHostAddress::LocalHost));
+  connect(pRun->mpTcpServer, SIGNAL(newConnection()), SLOT(createRunProgressSocket()));
+  // simulation process
+  pRun->mpProcess = new QProcess(this);
+  pRun->mpProcess->setWorkingDirectory(workingDirectory);
+  /* the output is only needed if the run fails. Writing it to a file keeps the pipes from filling up. */
+  pRun->mpProcess->setProcessChannelMode(QProcess::MergedChannels);
+  pRun->mpProcess->setStandardOutputFile(QString(workingDirectory).append("/")
+                                         .append(QString("%1_sweep%2.log").arg(mSimulationOptions.getOutputFileName()).arg(pRun->mIndex + 1)));
+  connect(pRun->mpProcess, SIGNAL(finished(int,QProcess::ExitStatus)), SLOT(runFinished(int,QProcess::ExitStatus)));
+  connect(pRun->mpProcess, SIGNAL(error(QProcess::ProcessError)), SLOT(runError(QProcess::ProcessError)));
+  QStringList args;
+  args << QString("-port=").append(QString::number(pRun->mpTcpServer->serverPort()))
+       << QString("-overrideFile=").append(pRun->mOverrideFileName)
+       << QString("-r=").append(pRun->mResultFileName)
+       << mSimulationFlags;
+  QString fileName = QString(workingDirectory).append("/").append(mSimulationOptions.getOutputFileName());
+  fileName = fileName.replace("//", "/");
+#ifdef WIN32
+  fileName = fileName.append(".exe");
+  QFileInfo fileInfo(mSimulationOptions.getFileName());
+  QProcessEnvironment processEnvironment = StringHandler::simulationProcessEnvironment();
+  processEnvironment.insert("PATH", fileInfo.absoluteDir().absolutePath() + ";" + processEnvironment.value("PATH"));
+  pRun->mpProcess->setProcessEnvironment(processEnvironment);
+#endif
+  setRunStatus(pRun, ParameterSweepRun::Running, tr("Running"));
+  pRun->mpProcess->start(fileName, args);
+  return true;
+}
+
+/*!
+ * \brief ParameterSweepWidget::setRunStatus
+ * Sets the status of the run and releases its process when it is done.
+ * \param pRun
+ * \param status
+ * \param statusText
+ */
+void ParameterSweepWidget::setRunStatus(ParameterSweepRun *pRun, ParameterSweepRun::Status status, QString statusText)
+{
+  pRun->mStatus = status;
+  pRun->mpTreeWidgetItem->setText(1, statusText);
+  pRun->mpTreeWidgetItem->setToolTip(1, statusText);
+  if (status == ParameterSweepRun::Finished) {
+    pRun->mProgress = 100;
+  }
+  pRun->mpTreeWidgetItem->setText(2, status == ParameterSweepRun::Queued ? "" : QString("%1%").arg(pRun->mProgress));
+  if (status != ParameterSweepRun::Queued && status != ParameterSweepRun::Running) {
+    if (pRun->mpProcess) {
+      disconnect(pRun->mpProcess, 0, this, 0);
+      pRun->mpProcess->deleteLater();
+      pRun->mpProcess = 0;
+    }
+    if (pRun->mpTcpServer) {
+      pRun->mpTcpServer->deleteLater();
+      pRun->mpTcpServer = 0;
+    }
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::findRun
+ * Finds the run of the process, the progress server or the progress socket.
+ * \param pObject
+ * \return
+ */
+ParameterSweepRun* ParameterSweepWidget::findRun(QObject *pObject)
+{
+  for (int i = 0 ; i < mRuns.size() ; i++) {
+    ParameterSweepRun *pRun = &mRuns[i];
+    if (pObject && (pObject == pRun->mpProcess || (pRun->mpTcpServer && (pObject == pRun->mpTcpServer || pObject->parent() == pRun->mpTcpServer)))) {
+      return pRun;
+    }
+  }
+  return 0;
+}
+
+/*!
+ * \brief ParameterSweepWidget::updateProgress
+ * Updates the progress label and the progress bar from the progress of all the runs.
+ */
+void ParameterSweepWidget::updateProgress()
+{
+  int progress = 0;
+  int failedRuns = 0;
+  for (int i = 0 ; i < mRuns.size() ; i++) {
+    const ParameterSweepRun &run = mRuns.at(i);
+    if (run.mStatus == ParameterSweepRun::Running || run.mStatus == ParameterSweepRun::Finished) {
+      progress += run.mProgress;
+    } else if (run.mStatus != ParameterSweepRun::Queued) {
+      progress += 100;
+      failedRuns++;
+    }
+  }
+  mpProgressBar->setValue(progress);
+  if (mFinishedRuns == mRuns.size()) {
+    mpProgressLabel->setText(tr("Parameter sweep of <b>%1</b> finished. %2 of %3 simulations failed.")
+                             .arg(mSimulationOptions.getClassName()).arg(failedRuns).arg(mRuns.size()));
+  } else {
+    mpProgressLabel->setText(tr("Running parameter sweep of <b>%1</b>. Finished %2 of %3 simulations, %4 running.")
+                             .arg(mSimulationOptions.getClassName()).arg(mFinishedRuns).arg(mRuns.size()).arg(mRunningProcesses));
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::plotResults
+ * Adds the results of the successful runs to the Variables Browser and plots the plot variables of all of them in a new plot window.
+ */
+void ParameterSweepWidget::plotResults()
+{
+  VariablesWidget *pVariablesWidget = mpMainWindow->getVariablesWidget();
+  OMCProxy *pOMCProxy = mpMainWindow->getOMCProxy();
+  QString workingDirectory = mSimulationOptions.getWorkingDirectory();
+  QStringList resultFileNames;
+  foreach (const ParameterSweepRun &run, mRuns) {
+    if (run.mStatus != ParameterSweepRun::Finished) {
+      continue;
+    }
+    QStringList list = pOMCProxy->readSimulationResultVars(QString(workingDirectory).append("/").append(run.mResultFileName));
+    pOMCProxy->closeSimulationResultFile();
+    if (!list.isEmpty()) {
+      SimulationOptions simulationOptions = mSimulationOptions;
+      simulationOptions.setResultFileName(run.mResultFileName);
+      pVariablesWidget->insertVariablesItemsToTree(run.mResultFileName, workingDirectory, list, simulationOptions);
+      resultFileNames.append(run.mResultFileName);
+    }
+  }
+  if (resultFileNames.isEmpty()) {
+    return;
+  }
+  mpMainWindow->getPerspectiveTabBar()->setCurrentIndex(2);
+  if (mPlotVariables.isEmpty()) {
+    return;
+  }
+  PlotWindowContainer *pPlotWindowContainer = mpMainWindow->getPlotWindowContainer();
+  bool state = pPlotWindowContainer->blockSignals(true);
+  pPlotWindowContainer->addPlotWindow();
+  pPlotWindowContainer->blockSignals(state);
+  OMPlot::PlotWindow *pPlotWindow = pPlotWindowContainer->getCurrentWindow();
+  if (!pPlotWindow) {
+    return;
+  }
+  VariablesTreeModel *pVariablesTreeModel = pVariablesWidget->getVariablesTreeModel();
+  PlottingPage *pPlottingPage = mpMainWindow->getOptionsDialog()->getPlottingPage();
+  state = pVariablesTreeModel->blockSignals(true);
+  foreach (const QString &resultFileName, resultFileNames) {
+    foreach (const QString &plotVariable, mPlotVariables) {
+      VariablesTreeItem *pVariablesTreeItem = pVariablesTreeModel->findVariablesTreeItem(QString(resultFileName).append(".").append(plotVariable),
+                                                                                         pVariablesTreeModel->getRootVariablesTreeItem());
+      if (pVariablesTreeItem) {
+        QModelIndex index = pVariablesTreeModel->variablesTreeItemIndex(pVariablesTreeItem);
+        pVariablesTreeModel->setData(index, Qt::Checked, Qt::CheckStateRole);
+        pVariablesWidget->plotVariables(index, pPlottingPage->getCurveThickness(), pPlottingPage->getCurvePattern(), 0, pPlotWindow);
+      }
+    }
+  }
+  pVariablesTreeModel->blockSignals(state);
+  pVariablesWidget->updateVariablesTreeHelper(pPlotWindowContainer->currentSubWindow());
+}
+
+/*!
+ * \brief ParameterSweepWidget::runFinished
+ * Slot activated when the process of a run is finished. Starts the next queued run.
+ * \param exitCode
+ * \param exitStatus
+ */
+void ParameterSweepWidget::runFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+  ParameterSweepRun *pRun = findRun(sender());
+  if (!pRun || pRun->mStatus != ParameterSweepRun::Running) {
+    return;
+  }
+  if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+    setRunStatus(pRun, ParameterSweepRun::Finished, tr("Finished"));
+  } else {
+    setRunStatus(pRun, ParameterSweepRun::Failed, tr("Simulation process failed. Exited with code %1.").arg(exitCode));
+  }
+  mRunningProcesses--;
+  mFinishedRuns++;
+  startNextRuns();
+}
+
+/*!
+ * \brief ParameterSweepWidget::runError
+ * Slot activated when the process of a run can't be started.
+ * \param error
+ */
+void ParameterSweepWidget::runError(QProcess::ProcessError error)
+{
+  /* the other errors are followed by the finished signal. */
+  if (error != QProcess::FailedToStart) {
+    return;
+  }
+  ParameterSweepRun *pRun = findRun(sender());
+  if (!pRun || pRun->mStatus != ParameterSweepRun::Running) {
+    return;
+  }
+  setRunStatus(pRun, ParameterSweepRun::Failed, pRun->mpProcess->errorString());
+  mRunningProcesses--;
+  mFinishedRuns++;
+  startNextRuns();
+}
+
+/*!
+ * \brief ParameterSweepWidget::createRunProgressSocket
+ * Slot activated when the simulation executable of a run connects to its progress server.
+ */
+void ParameterSweepWidget::createRunProgressSocket()
+{
+  QTcpServer *pTcpServer = qobject_cast<QTcpServer*>(sender());
+  if (pTcpServer && pTcpServer->hasPendingConnections()) {
+    QTcpSocket *pTcpSocket = pTcpServer->nextPendingConnection();
+    connect(pTcpSocket, SIGNAL(readyRead()), SLOT(readRunProgress()));
+    disconnect(pTcpServer, SIGNAL(newConnection()), this, SLOT(createRunProgressSocket()));
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::readRunProgress
+ * Slot activated when the simulation executable of a run writes to its progress socket.
+ * Only the "<progress> <message>" lines are read, the progress is in hundredths of a percent.
+ */
+void ParameterSweepWidget::readRunProgress()
+{
+  QTcpSocket *pTcpSocket = qobject_cast<QTcpSocket*>(sender());
+  ParameterSweepRun *pRun = findRun(pTcpSocket);
+  if (!pTcpSocket || !pRun) {
+    return;
+  }
+  bool progressChanged = false;
+  while (pTcpSocket->canReadLine()) {
+    QByteArray line = pTcpSocket->readLine();
+    char *msg = 0;
+    double d = strtod(line.constData(), &msg);
+    if (msg != line.constData() && *msg == ' ') {
+      pRun->mProgress = qBound(0, (int)(d / 100.0), 100);
+      progressChanged = true;
+    }
+  }
+  if (progressChanged && pRun->mStatus == ParameterSweepRun::Running) {
+    pRun->mpTreeWidgetItem->setText(2, QString("%1%").arg(pRun->mProgress));
+    updateProgress();
+  }
+}
+
+/*!
+ * \brief ParameterSweepWidget::cancelParameterSweep
+ * Kills the running simulations and cancels the queued ones.
+ */
+void ParameterSweepWidget::cancelParameterSweep()
+{
+  for (int i = 0 ; i < mRuns.size() ; i++) {
+    ParameterSweepRun *pRun = &mRuns[i];
+    if (pRun->mStatus == ParameterSweepRun::Running) {
+      pRun->mpProcess->kill();
+      setRunStatus(pRun, ParameterSweepRun::Cancelled, tr("Cancelled"));
+      mFinishedRuns++;
+    } else if (pRun->mStatus == ParameterSweepRun::Queued) {
+      setRunStatus(pRun, ParameterSweepRun::Cancelled, tr("Cancelled"));
+      mFinishedRuns++;
+    }
+  }
+  mRunningProcesses = 0;
+  mNextRun = mRuns.size();
+  mpProgressLabel->setText(tr("Parameter sweep of <b>%1</b> is cancelled.").arg(mSimulationOptions.getClassName()));
+  mpProgressBar->setValue(mpProgressBar->maximum());
+  mpCancelButton->setEnabled(false);
+}
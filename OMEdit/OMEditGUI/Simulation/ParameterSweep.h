@@ -0,0 +1,149 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <QTcpServer>
+
+#include "MainWindow.h"
+#include "SimulationOptions.h"
+
+class MainWindow;
+class Label;
+
+/*!
+ * \class ParameterSweepParameter
+ * \brief A swept parameter and its values.
+ */
+class ParameterSweepParameter
+{
+public:
+  QString mName;
+  QStringList mValues;
+};
+
+/*!
+ * \class ParameterSweepRun
+ * \brief One simulation of the sweep.
+ */
+class ParameterSweepRun
+{
+public:
+  enum Status {
+    Queued,
+    Running,
+    Finished,
+    Failed,
+    Cancelled
+  };
+  int mIndex;
+  QStringList mValues;  /* the values of the swept parameters in the order of the parameters. */
+  QString mResultFileName;
+  QString mOverrideFileName;
+  Status mStatus;
+  int mProgress;        /* percent of the simulation time. */
+  QProcess *mpProcess;
+  QTcpServer *mpTcpServer;
+  QTreeWidgetItem *mpTreeWidgetItem;
+};
+
+class ParameterSweepDialog : public QDialog
+{
+  Q_OBJECT
+public:
+  ParameterSweepDialog(SimulationOptions simulationOptions, QStringList parameters, QStringList values, QStringList plotVariables,
+                       MainWindow *pMainWindow);
+private:
+  SimulationOptions mSimulationOptions;
+  MainWindow *mpMainWindow;
+  Label *mpHeadingLabel;
+  QTreeWidget *mpParametersTreeWidget;
+  Label *mpPlotVariablesLabel;
+  QLineEdit *mpPlotVariablesTextBox;
+  Label *mpNumberOfProcessesLabel;
+  QSpinBox *mpNumberOfProcessesSpinBox;
+  Label *mpNumberOfRunsLabel;
+  QPushButton *mpOkButton;
+  QPushButton *mpCancelButton;
+  QDialogButtonBox *mpButtonBox;
+
+  QList<ParameterSweepParameter> createParameters(QString *pErrorString);
+public slots:
+  void updateNumberOfRuns();
+  void startParameterSweep();
+};
+
+class ParameterSweepWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  ParameterSweepWidget(SimulationOptions simulationOptions, QList<ParameterSweepParameter> parameters, QStringList plotVariables,
+                       int numberOfProcesses, MainWindow *pMainWindow);
+  ~ParameterSweepWidget();
+  static int numberOfRuns(const QList<ParameterSweepParameter> &parameters);
+  void start();
+private:
+  SimulationOptions mSimulationOptions;
+  QList<ParameterSweepParameter> mParameters;
+  QStringList mPlotVariables;
+  int mNumberOfProcesses;
+  MainWindow *mpMainWindow;
+  QStringList mOverrides;
+  QString mOverrideFileError;
+  QStringList mSimulationFlags;
+  QList<ParameterSweepRun> mRuns;
+  int mNextRun;
+  int mRunningProcesses;
+  int mFinishedRuns;
+  Label *mpProgressLabel;
+  QProgressBar *mpProgressBar;
+  QTreeWidget *mpRunsTreeWidget;
+  QPushButton *mpCancelButton;
+
+  void createRuns();
+  void startNextRuns();
+  bool startRun(ParameterSweepRun *pRun);
+  void setRunStatus(ParameterSweepRun *pRun, ParameterSweepRun::Status status, QString statusText);
+  ParameterSweepRun* findRun(QObject *pObject);
+  void updateProgress();
+  void plotResults();
+public slots:
+  void runFinished(int exitCode, QProcess::ExitStatus exitStatus);
+  void runError(QProcess::ProcessError error);
+  void createRunProgressSocket();
+  void readRunProgress();
+  void cancelParameterSweep();
+};
+
+#endif // PARAMETERSWEEP_H
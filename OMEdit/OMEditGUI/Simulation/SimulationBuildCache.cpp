@@ -0,0 +1,213 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDirIterator>
+
+#include "SimulationBuildCache.h"
+#include "OMCProxy.h"
+#include "LibraryTreeWidget.h"
+#include "LibraryTreeItemCache.h"
+
+/*!
+ * \brief SimulationBuildCache::createBuildKey
+ * Creates the key of the build from everything the generated code depends on: the OMC version, the OMC flags
+ * (target language, target compiler, +profiling etc.), the compilation options and the loaded classes.
+ * The model is not instantiated for the key since the translation instantiates it again. Instead the text of the loaded classes
+ * is used, which also covers the changes not saved yet. The system libraries can't be changed in OMEdit so their files on the
+ * disk are used. The external C sources and libraries of the Include and Library annotations are covered by the files in the
+ * Resources directory of every loaded library.
+ * \param pOMCProxy
+ * \param pLibraryTreeModel
+ * \param simulationOptions
+ * \return
+ */
+QString SimulationBuildCache::createBuildKey(OMCProxy *pOMCProxy, LibraryTreeModel *pLibraryTreeModel, SimulationOptions simulationOptions)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(pOMCProxy->getVersion().toUtf8());
+  hash.addData("\n");
+  hash.addData(pOMCProxy->getCommandLineOptions().join(" ").toUtf8());
+  hash.addData("\n");
+  hash.addData(simulationOptions.getClassName().toUtf8());
+  hash.addData("\n");
+  hash.addData(simulationOptions.getOutputFileName().toUtf8());
+  hash.addData("\n");
+  hash.addData(simulationOptions.getCflags().toUtf8());
+  hash.addData("\n");
+  hash.addData(simulationOptions.getLaunchAlgorithmicDebugger() ? "gendebugsymbols\n" : "\n");
+  LibraryTreeItem *pRootLibraryTreeItem = pLibraryTreeModel->getRootLibraryTreeItem();
+  for (int i = 0 ; i < pRootLibraryTreeItem->childrenSize() ; i++) {
+    LibraryTreeItem *pLibraryTreeItem = pRootLibraryTreeItem->childAt(i);
+    if (pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
+      continue;
+    }
+    hash.addData(pLibraryTreeItem->getNameStructure().toUtf8());
+    hash.addData("\n");
+    if (pLibraryTreeItem->isSystemLibrary()) {
+      hash.addData(LibraryTreeItemCache::libraryFileKey(pLibraryTreeItem->getFileName()).toUtf8());
+    } else {
+      hash.addData(pOMCProxy->list(pLibraryTreeItem->getNameStructure()).toUtf8());
+    }
+    hash.addData("\n");
+    hash.addData(resourcesKey(pLibraryTreeItem->getFileName()).toUtf8());
+    hash.addData("\n");
+  }
+  return QString(hash.result().toHex());
+}
+
+/*!
+ * \brief SimulationBuildCache::resourcesKey
+ * Computes the state of the external C sources and libraries of the library on the disk,
+ * i.e., the files of the default IncludeDirectory and LibraryDirectory, Resources/Include and Resources/Library.
+ * \param fileName - the file of the top level class.
+ * \return
+ */
+QString SimulationBuildCache::resourcesKey(const QString &fileName)
+{
+  if (fileName.isEmpty()) {
+    return "";
+  }
+  QStringList key;
+  QString resourcesDirectory = QFileInfo(fileName).absolutePath() + "/Resources";
+  foreach (const QString &directory, QStringList() << "Include" << "Library") {
+    QDirIterator files(resourcesDirectory + "/" + directory, QDir::Files, QDirIterator::Subdirectories);
+    while (files.hasNext()) {
+      files.next();
+      QFileInfo file = files.fileInfo();
+      key << file.absoluteFilePath() << QString::number(file.size()) << QString::number(file.lastModified().toTime_t());
+    }
+  }
+  return key.join("|");
+}
+
+/*!
+ * \brief SimulationBuildCache::isBuilt
+ * Returns true if the executable and the copy of the built model_init.xml file exist and were built with the build key of the
+ * simulation options. The model_init.xml file must be restored with SimulationBuildCache::restoreInitFile before it is used.
+ * \param simulationOptions
+ * \return
+ */
+bool SimulationBuildCache::isBuilt(SimulationOptions simulationOptions)
+{
+  if (simulationOptions.getBuildKey().isEmpty()) {
+    return false;
+  }
+  QFileInfo executableFileInfo(getExecutableFileName(simulationOptions));
+  QFileInfo initFileInfo(getBuiltInitFileName(simulationOptions));
+  QFile buildKeyFile(getBuildKeyFileName(simulationOptions));
+  if (!executableFileInfo.exists() || !initFileInfo.exists() || !buildKeyFile.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  /* the executable must not be rebuilt after the key was written. */
+  QFileInfo buildKeyFileInfo(buildKeyFile);
+  bool isBuilt = QString(buildKeyFile.readAll()).trimmed() == simulationOptions.getBuildKey() &&
+      executableFileInfo.lastModified() <= buildKeyFileInfo.lastModified();
+  buildKeyFile.close();
+  return isBuilt;
+}
+
+/*!
+ * \brief SimulationBuildCache::saveBuildKey
+ * Writes the build key of the simulation options once the executable is built.
+ * \param simulationOptions
+ */
+void SimulationBuildCache::saveBuildKey(SimulationOptions simulationOptions)
+{
+  if (simulationOptions.getBuildKey().isEmpty()) {
+    return;
+  }
+  /* keep the model_init.xml file as built, the start values in it are changed when the model is re-simulated. */
+  QFile::remove(getBuiltInitFileName(simulationOptions));
+  if (!QFile::copy(getInitFileName(simulationOptions), getBuiltInitFileName(simulationOptions))) {
+    return;
+  }
+  QFile buildKeyFile(getBuildKeyFileName(simulationOptions));
+  if (buildKeyFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    buildKeyFile.write(simulationOptions.getBuildKey().toUtf8());
+    buildKeyFile.close();
+  }
+}
+
+/*!
+ * \brief SimulationBuildCache::restoreInitFile
+ * Replaces the model_init.xml file with the copy written by SimulationBuildCache::saveBuildKey.
+ * \param simulationOptions
+ * \return false if the file can't be restored.
+ */
+bool SimulationBuildCache::restoreInitFile(SimulationOptions simulationOptions)
+{
+  QString initFileName = getInitFileName(simulationOptions);
+  if (QFile::exists(initFileName) && !QFile::remove(initFileName)) {
+    return false;
+  }
+  return QFile::copy(getBuiltInitFileName(simulationOptions), initFileName);
+}
+
+/*!
+ * \brief SimulationBuildCache::removeBuildKey
+ * Removes the build key before the model is translated again, so a failed build is never reused.
+ * \param simulationOptions
+ */
+void SimulationBuildCache::removeBuildKey(SimulationOptions simulationOptions)
+{
+  QFile::remove(getBuildKeyFileName(simulationOptions));
+  QFile::remove(getBuiltInitFileName(simulationOptions));
+}
+
+QString SimulationBuildCache::getBuildKeyFileName(const SimulationOptions &simulationOptions)
+{
+  return QString("%1/%2.buildkey").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName());
+}
+
+QString SimulationBuildCache::getInitFileName(const SimulationOptions &simulationOptions)
+{
+  return QString("%1/%2_init.xml").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName());
+}
+
+QString SimulationBuildCache::getBuiltInitFileName(const SimulationOptions &simulationOptions)
+{
+  return QString("%1/%2_init.xml.build").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName());
+}
+
+QString SimulationBuildCache::getExecutableFileName(const SimulationOptions &simulationOptions)
+{
+#ifdef WIN32
+  return QString("%1/%2.exe").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName());
+#else
+  return QString("%1/%2").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName());
+#endif
+}
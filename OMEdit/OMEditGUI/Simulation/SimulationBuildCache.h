@@ -0,0 +1,65 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE
+ * OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3, ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef SIMULATIONBUILDCACHE_H
+#define SIMULATIONBUILDCACHE_H
+
+#include "SimulationOptions.h"
+
+class OMCProxy;
+class LibraryTreeModel;
+
+/*!
+ * \class SimulationBuildCache
+ * \brief Remembers which model the simulation executable in the working directory is built from.
+ * The key is written next to the executable once the compilation succeeds. When the key of the next simulation matches,
+ * the translation and the compilation are skipped and the existing executable is run.
+ * A copy of the model_init.xml file is kept with the key since the variables browser changes the start values in that file.
+ */
+class SimulationBuildCache
+{
+public:
+  static QString createBuildKey(OMCProxy *pOMCProxy, LibraryTreeModel *pLibraryTreeModel, SimulationOptions simulationOptions);
+  static bool isBuilt(SimulationOptions simulationOptions);
+  static void saveBuildKey(SimulationOptions simulationOptions);
+  static void removeBuildKey(SimulationOptions simulationOptions);
+  static bool restoreInitFile(SimulationOptions simulationOptions);
+private:
+  static QString resourcesKey(const QString &fileName);
+  static QString getBuildKeyFileName(const SimulationOptions &simulationOptions);
+  static QString getInitFileName(const SimulationOptions &simulationOptions);
+  static QString getBuiltInitFileName(const SimulationOptions &simulationOptions);
+  static QString getExecutableFileName(const SimulationOptions &simulationOptions);
+};
+
+#endif // SIMULATIONBUILDCACHE_H
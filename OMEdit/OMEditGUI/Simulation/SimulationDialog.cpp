@@ -39,6 +39,7 @@
 
 #include "SimulationDialog.h"
 #include "SimulationOutputWidget.h"
+#include "SimulationBuildCache.h"
 #include "VariablesWidget.h"
 #include "Commands.h"
 
@@ -765,14 +766,7 @@ void SimulationDialog::initializeFields(bool isReSimulate, SimulationOptions sim
  */
 bool SimulationDialog::translateModel(QString simulationParameters)
 {
-  // check reset messages number before simulation option
-  if (mpMainWindow->getOptionsDialog()->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
-    mpMainWindow->getMessagesWidget()->resetMessagesNumber();
-  }
-  /* save the model before translating */
-  if (mpMainWindow->getOptionsDialog()->getSimulationPage()->getSaveClassBeforeSimulationCheckBox()->isChecked() &&
-      !mpLibraryTreeItem->isSaved() &&
-      !mpMainWindow->getLibraryWidget()->saveLibraryTreeItem(mpLibraryTreeItem)) {
+  if (!prepareSimulation()) {
     return false;
   }
   /*
@@ -785,6 +779,26 @@ bool SimulationDialog::translateModel(QString simulationParameters)
   return mpMainWindow->getOMCProxy()->translateModel(mClassName, simulationParameters);
 }
 
+/*!
+ * \brief SimulationDialog::prepareSimulation
+ * Resets the messages number and saves the model before the simulation if the options say so.
+ * \return false if the model can't be saved.
+ */
+bool SimulationDialog::prepareSimulation()
+{
+  // check reset messages number before simulation option
+  if (mpMainWindow->getOptionsDialog()->getMessagesPage()->getResetMessagesNumberBeforeSimulationCheckBox()->isChecked()) {
+    mpMainWindow->getMessagesWidget()->resetMessagesNumber();
+  }
+  /* save the model before translating */
+  if (mpMainWindow->getOptionsDialog()->getSimulationPage()->getSaveClassBeforeSimulationCheckBox()->isChecked() &&
+      !mpLibraryTreeItem->isSaved() &&
+      !mpMainWindow->getLibraryWidget()->saveLibraryTreeItem(mpLibraryTreeItem)) {
+    return false;
+  }
+  return true;
+}
+
 SimulationOptions SimulationDialog::createSimulationOptions()
 {
   SimulationOptions simulationOptions;
@@ -1184,12 +1198,30 @@ void SimulationDialog::performSimulation()
   mpMainWindow->getStatusBar()->showMessage(tr("Translating %1.").arg(mClassName));
   mpMainWindow->getProgressBar()->setRange(0, 0);
   mpMainWindow->showProgressBar();
-  bool isTranslationSuccessful = mIsReSimulate ? true : translateModel(simulationParameters);
+  bool isTranslationSuccessful = true;
+  if (!mIsReSimulate) {
+    /* if the executable is already built from the same model and flags then run it without translating and compiling the model. */
+    simulationOptions.setBuildKey(SimulationBuildCache::createBuildKey(mpMainWindow->getOMCProxy(),
+                                                                      mpMainWindow->getLibraryWidget()->getLibraryTreeModel(),
+                                                                      simulationOptions));
+    if (SimulationBuildCache::isBuilt(simulationOptions) && SimulationBuildCache::restoreInitFile(simulationOptions)) {
+      isTranslationSuccessful = prepareSimulation();
+      simulationOptions.setReSimulate(true);
+      mpMainWindow->getMessagesWidget()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                                   tr("The model <b>%1</b> is not changed since the last build. Using the existing executable.")
+                                                                   .arg(mClassName), Helper::scriptingKind, Helper::notificationLevel));
+    } else {
+      SimulationBuildCache::removeBuildKey(simulationOptions);
+      isTranslationSuccessful = translateModel(simulationParameters);
+    }
+  }
   // hide the progress bar
   mpMainWindow->hideProgressBar();
   mpMainWindow->getStatusBar()->clearMessage();
   mIsReSimulate = false;
-  if (isTranslationSuccessful) {
+  if (isTranslationSuccessful && simulationOptions.isReSimulate() && simulationOptions.getBuildOnly()) {
+    return;
+  } else if (isTranslationSuccessful) {
     // check if we can compile using the target compiler
     SimulationPage *pSimulationPage = mpMainWindow->getOptionsDialog()->getSimulationPage();
     QString targetCompiler = pSimulationPage->getTargetCompilerComboBox()->currentText();
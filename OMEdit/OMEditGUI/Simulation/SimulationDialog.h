@@ -186,6 +186,7 @@ private:
   bool validate();
   void initializeFields(bool isReSimulate, SimulationOptions simulationOptions);
   bool translateModel(QString simulationParameters);
+  bool prepareSimulation();
   SimulationOptions createSimulationOptions();
   void createAndShowSimulationOutputWidget(SimulationOptions simulationOptions);
   void showSimulationOutputWidget(SimulationOutputWidget *pSimulationOutputWidget);
@@ -86,6 +86,7 @@ public:
     setReSimulate(false);
     setWorkingDirectory("");
     setFileName("");
+    setBuildKey("");
   }
 
   void setClassName(QString className) {mClassName = className;}
@@ -180,6 +181,8 @@ public:
   QString getWorkingDirectory() const {return mWorkingDirectory;}
   void setFileName(QString fileName) {mFileName = fileName;}
   QString getFileName() const {return mFileName;}
+  void setBuildKey(QString buildKey) {mBuildKey = buildKey;}
+  QString getBuildKey() const {return mBuildKey;}
 private:
   QString mClassName;
   QString mStartTime;
@@ -227,6 +230,7 @@ private:
   bool mReSimulate;
   QString mWorkingDirectory;
   QString mFileName;
+  QString mBuildKey;
 };
 
 #endif // SIMULATIONOPTIONS_H
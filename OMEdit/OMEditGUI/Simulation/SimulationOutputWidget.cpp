@@ -33,6 +33,8 @@
 
 #include "SimulationOutputWidget.h"
 #include "VariablesWidget.h"
+#include "SimulationBuildCache.h"
+#include "PlotWindowContainer.h"
 #include "CEditor.h"
 
 /*!
@@ -299,6 +301,10 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
   connect(mpSimulationProcessThread, SIGNAL(sendSimulationFinished(int,QProcess::ExitStatus)),
           SLOT(simulationProcessFinished(int,QProcess::ExitStatus)));
   connect(mpSimulationProcessThread, SIGNAL(sendSimulationProgress(int)), mpProgressBar, SLOT(setValue(int)));
+  connect(mpSimulationProcessThread, SIGNAL(sendLivePlotVariables(QString,QStringList)), mpMainWindow->getPlotWindowContainer(),
+          SLOT(startLivePlot(QString,QStringList)));
+  connect(mpSimulationProcessThread, SIGNAL(sendLivePlotValues(QString,QVector<double>)), mpMainWindow->getPlotWindowContainer(),
+          SLOT(appendLivePlotValues(QString,QVector<double>)));
   mpSimulationProcessThread->start();
 }
 
@@ -418,6 +424,7 @@ void SimulationOutputWidget::compilationProcessFinished(int exitCode, QProcess::
   mpProgressBar->setValue(1);
   mpCancelButton->setEnabled(false);
   if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+    SimulationBuildCache::saveBuildKey(mSimulationOptions);
     if (mpMainWindow->getOptionsDialog()->getDebuggerPage()->getAlwaysShowTransformationsCheckBox()->isChecked() ||
         mSimulationOptions.getLaunchTransformationalDebugger() || mSimulationOptions.getProfiling() != "none") {
       mpMainWindow->showTransformationsWidget(mSimulationOptions.getWorkingDirectory() + "/" + mSimulationOptions.getOutputFileName() + "_info.json");
@@ -507,6 +514,8 @@ void SimulationOutputWidget::simulationProcessFinished(int exitCode, QProcess::E
   mpProgressLabel->setText(tr("Simulation of <b>%1</b> is finished.").arg(mSimulationOptions.getClassName()));
   mpProgressBar->setValue(mpProgressBar->maximum());
   mpCancelButton->setEnabled(false);
+  // the curves are read from the result file now.
+  mpMainWindow->getPlotWindowContainer()->stopLivePlot(mSimulationOptions.getResultFileName());
   mpMainWindow->getSimulationDialog()->simulationProcessFinished(mSimulationOptions, mResultFileLastModifiedDateTime);
   mpArchivedSimulationItem->setStatus(Helper::finished);
 }
@@ -561,12 +570,7 @@ void SimulationOutputWidget::openTransformationBrowser(QUrl url)
 #else /* Qt4 */
     int equationIndex = url.queryItemValue("index").toInt();
 #endif
-    QTreeWidgetItem *pTreeWidgetItem = pTransformationsWidget->findEquationTreeItem(equationIndex);
-    if (pTreeWidgetItem) {
-      pTransformationsWidget->getEquationsTreeWidget()->clearSelection();
-      pTransformationsWidget->getEquationsTreeWidget()->setCurrentItem(pTreeWidgetItem);
-    }
-    pTransformationsWidget->fetchEquationData(equationIndex);
+    pTransformationsWidget->selectEquation(equationIndex);
   } else {
     /* TODO: Display error-message */
   }
@@ -34,6 +34,7 @@
 #include <QTcpSocket>
 #include <QTcpServer>
 #include "SimulationProcessThread.h"
+#include "PlotWindowContainer.h"
 
 SimulationProcessThread::SimulationProcessThread(SimulationOutputWidget *pSimulationOutputWidget)
   : QThread(pSimulationOutputWidget), mpSimulationOutputWidget(pSimulationOutputWidget)
@@ -99,6 +100,7 @@ void SimulationProcessThread::runSimulationExecutable()
   SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
   mpSimulationProcess->setWorkingDirectory(simulationOptions.getWorkingDirectory());
   qRegisterMetaType<StringHandler::SimulationMessageType>("StringHandler::SimulationMessageType");
+  qRegisterMetaType<QVector<double> >("QVector<double>");
   connect(mpSimulationProcess, SIGNAL(started()), SLOT(simulationProcessStarted()));
   connect(mpSimulationProcess, SIGNAL(readyReadStandardOutput()), SLOT(readSimulationStandardOutput()));
   connect(mpSimulationProcess, SIGNAL(readyReadStandardError()), SLOT(readSimulationStandardError()));
@@ -233,6 +235,10 @@ void SimulationProcessThread::simulationProcessFinished(int exitCode, QProcess::
   emit sendSimulationFinished(exitCode, exitStatus);
 }
 
+/*!
+  Slot activated when the simulation executable connects to the progress server.\n
+  Requests the values of the variables plotted from the result file so that they can be plotted while the simulation runs.
+  */
 void SimulationProcessThread::createSimulationProgressSocket()
 {
   if (sender()) {
@@ -241,26 +247,52 @@ void SimulationProcessThread::createSimulationProgressSocket()
       QTcpSocket *pTcpSocket = pTcpServer->nextPendingConnection();
       connect(pTcpSocket, SIGNAL(readyRead()), SLOT(readSimulationProgress()));
       disconnect(pTcpServer, SIGNAL(newConnection()), this, SLOT(createSimulationProgressSocket()));
+      QString resultFileName = mpSimulationOutputWidget->getSimulationOptions().getResultFileName();
+      QStringList variables = mpSimulationOutputWidget->getMainWindow()->getPlotWindowContainer()->getPlotVariables(resultFileName);
+      if (!variables.isEmpty()) {
+        pTcpSocket->write(QString("variables %1\n").arg(variables.join(" ")).toUtf8());
+      }
     }
   }
 }
 
+/*!
+  Slot activated when the simulation executable writes to the progress socket.\n
+  Each line is one of,\n
+  "<progress> <message>" - the progress of the simulation in hundredths of a percent.\n
+  "variables <name1> <name2> ..." - the variables whose values are streamed.\n
+  "values <time> <value1> <value2> ..." - the values of the streamed variables at time.
+  */
 void SimulationProcessThread::readSimulationProgress()
 {
   if (sender()) {
     QTcpSocket *pTcpSocket = qobject_cast<QTcpSocket*>(const_cast<QObject*>(sender()));
     if (pTcpSocket) {
-      const int SOCKMAXLEN = 4096;
-      char buf[SOCKMAXLEN];
-      if (pTcpSocket->readLine(buf,SOCKMAXLEN) > 0) {
-        char *msg = 0;
-        double d = strtod(buf, &msg);
-        if (msg == buf || *msg != ' ') {
-          // do we really need to take care of this communication error?????
-          //fprintf(stderr, "TODO: OMEdit GUI: COMM ERROR '%s'", buf);
+      QString resultFileName = mpSimulationOutputWidget->getSimulationOptions().getResultFileName();
+      while (pTcpSocket->canReadLine()) {
+        QByteArray line = pTcpSocket->readLine();
+        if (line.startsWith("values ")) {
+          QList<QByteArray> words = line.mid(7).simplified().split(' ');
+          QVector<double> values(words.size());
+          bool ok = true;
+          for (int i = 0 ; i < words.size() && ok ; i++) {
+            values[i] = words.at(i).toDouble(&ok);
+          }
+          if (ok) {
+            emit sendLivePlotValues(resultFileName, values);
+          }
+        } else if (line.startsWith("variables ")) {
+          emit sendLivePlotVariables(resultFileName, QString::fromUtf8(line.mid(10)).simplified().split(" ", QString::SkipEmptyParts));
         } else {
-          emit sendSimulationProgress(d/100.0);
-          //fprintf(stderr, "TODO: OMEdit GUI: Display progress (%g%%) and message: %s", d/100.0, msg+1);
+          char *msg = 0;
+          double d = strtod(line.constData(), &msg);
+          if (msg == line.constData() || *msg != ' ') {
+            // do we really need to take care of this communication error?????
+            //fprintf(stderr, "TODO: OMEdit GUI: COMM ERROR '%s'", buf);
+          } else {
+            emit sendSimulationProgress(d/100.0);
+            //fprintf(stderr, "TODO: OMEdit GUI: Display progress (%g%%) and message: %s", d/100.0, msg+1);
+          }
         }
       }
     }
@@ -77,6 +77,8 @@ signals:
   void sendSimulationOutput(QString, StringHandler::SimulationMessageType type, bool);
   void sendSimulationFinished(int, QProcess::ExitStatus);
   void sendSimulationProgress(int);
+  void sendLivePlotVariables(QString, QStringList);
+  void sendLivePlotValues(QString, QVector<double>);
 };
 
 #endif // SIMULATIONPROCESSTHREAD_H
@@ -0,0 +1,284 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "EquationDependencyGraph.h"
+
+EquationDependencyGraph::EquationDependencyGraph()
+{
+  clear();
+}
+
+/*!
+ * \brief EquationDependencyGraph::clear
+ * Removes all the equations and variables.
+ */
+void EquationDependencyGraph::clear()
+{
+  mVariableIds.clear();
+  mSections.clear();
+  mDefinesOffsets.clear();
+  mDefines.clear();
+  mUsesOffsets.clear();
+  mUses.clear();
+  mDefinedInOffsets.clear();
+  mDefinedIn.clear();
+  mUsedInOffsets.clear();
+  mUsedIn.clear();
+  mComponents.clear();
+  mComponentOffsets.clear();
+  mComponentEquations.clear();
+}
+
+/*!
+ * \brief EquationDependencyGraph::build
+ * Builds the graph from the defined in and used in equations of the variables.
+ * \param variables
+ * \param sections - the section of each equation.
+ */
+void EquationDependencyGraph::build(const QHash<QString, OMVariable> &variables, const QStringList &sections)
+{
+  clear();
+  QHash<QString, int> sectionIds;
+  mSections.reserve(sections.size());
+  foreach (const QString &section, sections) {
+    QHash<QString, int>::const_iterator iterator = sectionIds.constFind(section);
+    if (iterator == sectionIds.constEnd()) {
+      iterator = sectionIds.insert(section, sectionIds.size());
+    }
+    mSections.append(iterator.value());
+  }
+  mVariableIds.reserve(variables.size());
+  mDefinedInOffsets.append(0);
+  mUsedInOffsets.append(0);
+  QHash<QString, OMVariable>::const_iterator iterator;
+  for (iterator = variables.constBegin() ; iterator != variables.constEnd() ; ++iterator) {
+    mVariableIds.insert(iterator.key(), mVariableIds.size());
+    foreach (int equation, iterator.value().definedIn) {
+      if (equation >= 0 && equation < mSections.size()) {
+        mDefinedIn.append(equation);
+      }
+    }
+    mDefinedInOffsets.append(mDefinedIn.size());
+    foreach (int equation, iterator.value().usedIn) {
+      if (equation >= 0 && equation < mSections.size()) {
+        mUsedIn.append(equation);
+      }
+    }
+    mUsedInOffsets.append(mUsedIn.size());
+  }
+  invert(mDefinedInOffsets, mDefinedIn, mSections.size(), mDefinesOffsets, mDefines);
+  invert(mUsedInOffsets, mUsedIn, mSections.size(), mUsesOffsets, mUses);
+}
+
+/*!
+ * \brief EquationDependencyGraph::getAffectedEquations
+ * Returns the equations which are transitively affected by the variable,
+ * i.e., the equations using it and the equations using the variables defined by them.
+ * \param variable
+ * \return
+ */
+QList<int> EquationDependencyGraph::getAffectedEquations(const QString &variable) const
+{
+  QList<int> equations;
+  int id = getVariableId(variable);
+  if (id < 0) {
+    return equations;
+  }
+  QVector<bool> visitedEquations(mSections.size(), false);
+  QVector<bool> visitedVariables(mVariableIds.size(), false);
+  QVector<int> variables;
+  variables.append(id);
+  visitedVariables[id] = true;
+  for (int i = 0 ; i < variables.size() ; i++) {
+    int v = variables.at(i);
+    for (int j = mUsedInOffsets.at(v) ; j < mUsedInOffsets.at(v + 1) ; j++) {
+      int equation = mUsedIn.at(j);
+      if (visitedEquations.at(equation)) {
+        continue;
+      }
+      visitedEquations[equation] = true;
+      equations.append(equation);
+      for (int k = mDefinesOffsets.at(equation) ; k < mDefinesOffsets.at(equation + 1) ; k++) {
+        int definedVariable = mDefines.at(k);
+        if (!visitedVariables.at(definedVariable)) {
+          visitedVariables[definedVariable] = true;
+          variables.append(definedVariable);
+        }
+      }
+    }
+  }
+  return equations;
+}
+
+/*!
+ * \brief EquationDependencyGraph::getStronglyConnectedEquations
+ * Returns the equations of the strongly connected block containing the equation.
+ * An equation depends on the equations of the same section which define the variables it uses.
+ * \param equationIndex
+ * \return
+ */
+QList<int> EquationDependencyGraph::getStronglyConnectedEquations(int equationIndex)
+{
+  QList<int> equations;
+  if (equationIndex < 0 || equationIndex >= mSections.size()) {
+    return equations;
+  }
+  if (mComponents.isEmpty()) {
+    computeStronglyConnectedComponents();
+  }
+  int component = mComponents.at(equationIndex);
+  for (int i = mComponentOffsets.at(component) ; i < mComponentOffsets.at(component + 1) ; i++) {
+    equations.append(mComponentEquations.at(i));
+  }
+  return equations;
+}
+
+/*!
+ * \brief EquationDependencyGraph::invert
+ * Creates the equation to variable lists from the variable to equation lists.
+ * \param offsets
+ * \param adjacency
+ * \param count - the number of equations.
+ * \param invertedOffsets
+ * \param invertedAdjacency
+ */
+void EquationDependencyGraph::invert(const QVector<int> &offsets, const QVector<int> &adjacency, int count, QVector<int> &invertedOffsets,
+                                     QVector<int> &invertedAdjacency)
+{
+  invertedOffsets.fill(0, count + 1);
+  for (int i = 0 ; i < adjacency.size() ; i++) {
+    invertedOffsets[adjacency.at(i) + 1]++;
+  }
+  for (int j = 0 ; j < count ; j++) {
+    invertedOffsets[j + 1] += invertedOffsets.at(j);
+  }
+  invertedAdjacency.resize(adjacency.size());
+  QVector<int> positions = invertedOffsets;
+  for (int v = 0 ; v < offsets.size() - 1 ; v++) {
+    for (int i = offsets.at(v) ; i < offsets.at(v + 1) ; i++) {
+      invertedAdjacency[positions[adjacency.at(i)]++] = v;
+    }
+  }
+}
+
+/*!
+ * \brief EquationDependencyGraph::computeStronglyConnectedComponents
+ * Iterative Tarjan's algorithm over the equations. The successors of an equation are the equations of the same section
+ * using the variables it defines.
+ */
+void EquationDependencyGraph::computeStronglyConnectedComponents()
+{
+  int equationsCount = mSections.size();
+  QVector<int> indexes(equationsCount, -1);
+  QVector<int> lowLinks(equationsCount, 0);
+  QVector<bool> onStack(equationsCount, false);
+  QVector<int> stack;
+  QVector<Frame> frames;
+  int index = 0;
+  int componentsCount = 0;
+  mComponents.fill(-1, equationsCount);
+  for (int root = 0 ; root < equationsCount ; root++) {
+    if (indexes.at(root) >= 0) {
+      continue;
+    }
+    Frame rootFrame = {root, mDefinesOffsets.at(root), -1};
+    frames.append(rootFrame);
+    indexes[root] = lowLinks[root] = index++;
+    stack.append(root);
+    onStack[root] = true;
+    while (!frames.isEmpty()) {
+      Frame &frame = frames.last();
+      int equation = frame.equation;
+      int successor = -1;
+      /* find the next successor of the equation */
+      while (frame.define < mDefinesOffsets.at(equation + 1)) {
+        int v = mDefines.at(frame.define);
+        if (frame.use < 0) {
+          frame.use = mUsedInOffsets.at(v);
+        }
+        if (frame.use < mUsedInOffsets.at(v + 1)) {
+          int candidate = mUsedIn.at(frame.use++);
+          if (mSections.at(candidate) == mSections.at(equation)) {
+            successor = candidate;
+            break;
+          }
+        } else {
+          frame.define++;
+          frame.use = -1;
+        }
+      }
+      if (successor >= 0) {
+        if (indexes.at(successor) < 0) {
+          indexes[successor] = lowLinks[successor] = index++;
+          stack.append(successor);
+          onStack[successor] = true;
+          Frame successorFrame = {successor, mDefinesOffsets.at(successor), -1};
+          frames.append(successorFrame);
+        } else if (onStack.at(successor)) {
+          lowLinks[equation] = qMin(lowLinks.at(equation), indexes.at(successor));
+        }
+        continue;
+      }
+      /* all the successors are visited */
+      if (lowLinks.at(equation) == indexes.at(equation)) {
+        int member;
+        do {
+          member = stack.last();
+          stack.pop_back();
+          onStack[member] = false;
+          mComponents[member] = componentsCount;
+        } while (member != equation);
+        componentsCount++;
+      }
+      frames.pop_back();
+      if (!frames.isEmpty()) {
+        int parent = frames.last().equation;
+        lowLinks[parent] = qMin(lowLinks.at(parent), lowLinks.at(equation));
+      }
+    }
+  }
+  /* group the equations by their component */
+  mComponentOffsets.fill(0, componentsCount + 1);
+  for (int equation = 0 ; equation < equationsCount ; equation++) {
+    mComponentOffsets[mComponents.at(equation) + 1]++;
+  }
+  for (int component = 0 ; component < componentsCount ; component++) {
+    mComponentOffsets[component + 1] += mComponentOffsets.at(component);
+  }
+  mComponentEquations.resize(equationsCount);
+  QVector<int> positions = mComponentOffsets;
+  for (int equation = 0 ; equation < equationsCount ; equation++) {
+    mComponentEquations[positions[mComponents.at(equation)]++] = equation;
+  }
+}
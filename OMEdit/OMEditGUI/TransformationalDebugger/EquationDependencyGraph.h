@@ -0,0 +1,90 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef EQUATIONDEPENDENCYGRAPH_H
+#define EQUATIONDEPENDENCYGRAPH_H
+
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+#include "OMDumpXML.h"
+
+/*!
+ * \class EquationDependencyGraph
+ * \brief Bipartite graph between the equations and the variables they define and use.
+ * The variables are numbered once and all the adjacency lists are stored as offsets into flat integer arrays,
+ * so the queries only walk integer arrays.
+ */
+class EquationDependencyGraph
+{
+public:
+  EquationDependencyGraph();
+  void clear();
+  void build(const QHash<QString, OMVariable> &variables, const QStringList &sections);
+  bool isEmpty() const {return mSections.isEmpty();}
+  int getEquationsCount() const {return mSections.size();}
+  int getVariableId(const QString &name) const {return mVariableIds.value(name, -1);}
+  QList<int> getAffectedEquations(const QString &variable) const;
+  QList<int> getStronglyConnectedEquations(int equationIndex);
+private:
+  /* depth first search state of an equation, used by computeStronglyConnectedComponents() */
+  struct Frame {
+    int equation;
+    int define;   /* position in mDefines */
+    int use;      /* position in mUsedIn of the current define */
+  };
+  QHash<QString, int> mVariableIds;
+  QVector<int> mSections;
+  /* equation -> variables */
+  QVector<int> mDefinesOffsets;
+  QVector<int> mDefines;
+  QVector<int> mUsesOffsets;
+  QVector<int> mUses;
+  /* variable -> equations */
+  QVector<int> mDefinedInOffsets;
+  QVector<int> mDefinedIn;
+  QVector<int> mUsedInOffsets;
+  QVector<int> mUsedIn;
+  /* strongly connected components, computed on the first query. */
+  QVector<int> mComponents;
+  QVector<int> mComponentOffsets;
+  QVector<int> mComponentEquations;
+
+  void invert(const QVector<int> &offsets, const QVector<int> &adjacency, int count, QVector<int> &invertedOffsets,
+              QVector<int> &invertedAdjacency);
+  void computeStronglyConnectedComponents();
+};
+
+#endif // EQUATIONDEPENDENCYGRAPH_H
@@ -0,0 +1,346 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "InfoJSONReader.h"
+#include "Helper.h"
+
+#include <QFile>
+#include <QTime>
+#include <qjson/streamreader.h>
+
+/*!
+ * \brief readStringList
+ * Reads the array the current token starts into strings. Any other value is skipped.
+ * \param pReader
+ * \param strings
+ */
+static void readStringList(QJson::StreamReader *pReader, QStringList &strings)
+{
+  if (pReader->tokenType() != QJson::StreamReader::StartArray) {
+    pReader->skipCurrentValue();
+    return;
+  }
+  forever {
+    QJson::StreamReader::TokenType tokenType = pReader->readNext();
+    if (tokenType == QJson::StreamReader::String || tokenType == QJson::StreamReader::Number || tokenType == QJson::StreamReader::Bool) {
+      strings << pReader->value().toString().trimmed();
+    } else if (tokenType == QJson::StreamReader::StartObject || tokenType == QJson::StreamReader::StartArray) {
+      pReader->skipCurrentValue();
+    } else if (tokenType != QJson::StreamReader::Null) {
+      return;
+    }
+  }
+}
+
+/*!
+ * \brief readOperation
+ * Reads the operation object the current token starts.
+ * \param pReader
+ * \return the operation or NULL if the operation is not shown.
+ */
+static OMOperation* readOperation(QJson::StreamReader *pReader)
+{
+  QString op, display;
+  QStringList dataStrings;
+  while (pReader->readNext() == QJson::StreamReader::Key) {
+    QString key = pReader->stringValue();
+    pReader->readNext();
+    if (key == "op") {
+      op = pReader->value().toString();
+    } else if (key == "display") {
+      display = pReader->value().toString();
+    } else if (key == "data") {
+      readStringList(pReader, dataStrings);
+    } else {
+      pReader->skipCurrentValue();
+    }
+  }
+  if (op == "before-after") {
+    return new OMOperationBeforeAfter(display != "" ? display : op, dataStrings);
+  } else if (op == "before-after-assert") {
+    return new OMOperationBeforeAfter(display != "" ? display : op, dataStrings);
+  } else if (op == "chain" && !dataStrings.isEmpty()) {
+    QStringList firstLast;
+    firstLast << dataStrings.first() << dataStrings.last();
+    return new OMOperationBeforeAfter(display != "" ? display : op, firstLast);
+  } else if (op == "info") {
+    return new OMOperationInfo(display != "" ? display : op, dataStrings.join(", "));
+  }
+  return NULL;
+}
+
+/*!
+ * \brief readSource
+ * Reads the source object the current token starts.
+ * \param pReader
+ * \param info
+ * \param types
+ * \param ops
+ */
+static void readSource(QJson::StreamReader *pReader, OMInfo &info, QStringList &types, QList<OMOperation*> &ops)
+{
+  Q_UNUSED(types);
+  if (pReader->tokenType() != QJson::StreamReader::StartObject) {
+    pReader->skipCurrentValue();
+    return;
+  }
+  while (pReader->readNext() == QJson::StreamReader::Key) {
+    QString key = pReader->stringValue();
+    QJson::StreamReader::TokenType tokenType = pReader->readNext();
+    if (key == "info" && tokenType == QJson::StreamReader::StartObject) {
+      while (pReader->readNext() == QJson::StreamReader::Key) {
+        QString infoKey = pReader->stringValue();
+        pReader->readNext();
+        if (infoKey == "file") {
+          info.file = pReader->value().toString();
+        } else if (infoKey == "lineStart") {
+          info.lineStart = pReader->value().toInt();
+        } else if (infoKey == "lineEnd") {
+          info.lineEnd = pReader->value().toInt();
+        } else if (infoKey == "colStart") {
+          info.colStart = pReader->value().toInt();
+        } else if (infoKey == "colEnd") {
+          info.colEnd = pReader->value().toInt();
+        } else {
+          pReader->skipCurrentValue();
+        }
+      }
+    } else if (key == "operations" && tokenType == QJson::StreamReader::StartArray) {
+      forever {
+        tokenType = pReader->readNext();
+        if (tokenType == QJson::StreamReader::StartObject) {
+          OMOperation *op = readOperation(pReader);
+          if (op) {
+            ops += op;
+          }
+        } else if (tokenType == QJson::StreamReader::StartArray) {
+          pReader->skipCurrentValue();
+        } else if (tokenType == QJson::StreamReader::EndArray || tokenType == QJson::StreamReader::Invalid
+                   || tokenType == QJson::StreamReader::EndDocument) {
+          break;
+        }
+      }
+    } else {
+      pReader->skipCurrentValue();
+    }
+  }
+  info.isValid = true;
+}
+
+/*!
+ * \brief InfoJSONReader::InfoJSONReader
+ * \param fileName - the model_info.json file.
+ * \param pParent
+ */
+InfoJSONReader::InfoJSONReader(const QString &fileName, QObject *pParent)
+  : QThread(pParent), mFileName(fileName)
+{
+  mCancelled = false;
+  mEquationIndex = 0;
+  mpVariables = 0;
+  qRegisterMetaType<OMVariableHash*>("OMVariableHash*");
+  qRegisterMetaType<QList<OMEquation*> >("QList<OMEquation*>");
+}
+
+/*!
+ * \brief InfoJSONReader::run
+ * Reads the top level "variables" object and "equations" array token by token with QJson::StreamReader.
+ * The variables are sent once the "variables" object is read. The equations are sent in batches every 100 ms.
+ */
+void InfoJSONReader::run()
+{
+  QFile file(mFileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    emit sendFinished(false, file.errorString());
+    return;
+  }
+  QJson::StreamReader reader(&file);
+  qint64 fileSize = qMax(file.size(), (qint64)1);
+  mpVariables = new OMVariableHash;
+  bool success = reader.readNext() == QJson::StreamReader::StartObject;
+  QTime time;
+  time.start();
+  while (success && !mCancelled && reader.readNext() == QJson::StreamReader::Key) {
+    QString key = reader.stringValue();
+    QJson::StreamReader::TokenType tokenType = reader.readNext();
+    if (key == "variables" && tokenType == QJson::StreamReader::StartObject) {
+      while (!mCancelled && reader.readNext() == QJson::StreamReader::Key) {
+        QString name = reader.stringValue();
+        if (reader.readNext() == QJson::StreamReader::StartObject) {
+          readVariable(&reader, name);
+        } else {
+          reader.skipCurrentValue();
+        }
+      }
+      if (!mpVariables->isEmpty()) {
+        emit sendVariables(mpVariables);
+        mpVariables = new OMVariableHash;
+      }
+    } else if (key == "equations" && tokenType == QJson::StreamReader::StartArray) {
+      while (success && !mCancelled) {
+        tokenType = reader.readNext();
+        if (tokenType == QJson::StreamReader::StartObject) {
+          success = readEquation(&reader);
+        } else if (tokenType == QJson::StreamReader::StartArray) {
+          reader.skipCurrentValue();
+        } else if (tokenType == QJson::StreamReader::EndArray || tokenType == QJson::StreamReader::Invalid
+                   || tokenType == QJson::StreamReader::EndDocument) {
+          break;
+        }
+        if (time.elapsed() > 100) {
+          if (!mEquations.isEmpty()) {
+            emit sendEquations(mEquations);
+            mEquations.clear();
+          }
+          emit sendProgress((int)(file.pos() * 100 / fileSize));
+          time.restart();
+        }
+      }
+    } else {
+      reader.skipCurrentValue();
+    }
+  }
+  if (success && !mCancelled && (reader.hasError() || reader.tokenType() != QJson::StreamReader::EndObject)) {
+    success = false;
+    mErrorString = Helper::parsingFailedJson + ": " + mFileName;
+    if (reader.hasError()) {
+      mErrorString += QString(": %1 (line %2)").arg(reader.errorString()).arg(reader.errorLine());
+    }
+  }
+  file.close();
+  if (mCancelled) {
+    delete mpVariables;
+    mpVariables = 0;
+    qDeleteAll(mEquations);
+    mEquations.clear();
+    return;
+  }
+  if (!mpVariables->isEmpty()) {
+    emit sendVariables(mpVariables);
+  } else {
+    delete mpVariables;
+  }
+  mpVariables = 0;
+  if (!mEquations.isEmpty()) {
+    emit sendEquations(mEquations);
+    mEquations.clear();
+  }
+  emit sendProgress(100);
+  emit sendFinished(success, mErrorString);
+}
+
+/*!
+ * \brief InfoJSONReader::readVariable
+ * Reads the variable object the current token starts into the variables hash.
+ * \param pReader
+ * \param name - the variable name.
+ */
+void InfoJSONReader::readVariable(QJson::StreamReader *pReader, const QString &name)
+{
+  OMVariable &variable = (*mpVariables)[name];
+  variable.name = name;
+  while (pReader->readNext() == QJson::StreamReader::Key) {
+    QString key = pReader->stringValue();
+    pReader->readNext();
+    if (key == "comment") {
+      variable.comment = pReader->value().toString();
+    } else if (key == "source") {
+      readSource(pReader, variable.info, variable.types, variable.ops);
+    } else {
+      pReader->skipCurrentValue();
+    }
+  }
+}
+
+/*!
+ * \brief InfoJSONReader::readEquation
+ * Reads the equation object the current token starts. The equations must be in the order of their index.
+ * \param pReader
+ * \return
+ */
+bool InfoJSONReader::readEquation(QJson::StreamReader *pReader)
+{
+  OMEquation *eq = new OMEquation();
+  eq->index = mEquationIndex;
+  eq->profileBlock = -1;
+  // the parent equations list of nested equations is filled by the receiver.
+  eq->parent = 0;
+  QString eqIndex;
+  bool hasDisplay = false;
+  while (pReader->readNext() == QJson::StreamReader::Key) {
+    QString key = pReader->stringValue();
+    pReader->readNext();
+    if (key == "eqIndex") {
+      eqIndex = pReader->value().toString();
+    } else if (key == "section") {
+      eq->section = pReader->value().toString();
+    } else if (key == "parent") {
+      eq->parent = pReader->value().toInt();
+    } else if (key == "defines") {
+      readStringList(pReader, eq->defines);
+    } else if (key == "uses") {
+      readStringList(pReader, eq->depends);
+    } else if (key == "equation") {
+      readStringList(pReader, eq->text);
+    } else if (key == "tag") {
+      eq->tag = pReader->value().toString();
+    } else if (key == "display") {
+      eq->display = pReader->value().toString();
+      hasDisplay = true;
+    } else if (key == "source") {
+      readSource(pReader, eq->info, eq->types, eq->ops);
+    } else {
+      pReader->skipCurrentValue();
+    }
+  }
+  if (pReader->tokenType() != QJson::StreamReader::EndObject) {
+    delete eq;
+    mErrorString = Helper::parsingFailedJson + ": " + mFileName;
+    if (pReader->hasError()) {
+      mErrorString += QString(": %1 (line %2)").arg(pReader->errorString()).arg(pReader->errorLine());
+    }
+    return false;
+  }
+  if (eqIndex.toInt() != mEquationIndex) {
+    delete eq;
+    mErrorString = Helper::parsingFailedJson + QString(": got index ") + eqIndex + QString(" expected ") + QString::number(mEquationIndex);
+    return false;
+  }
+  if (!hasDisplay) {
+    eq->display = eq->tag;
+  }
+  mEquationIndex++;
+  mEquations.append(eq);
+  return true;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef INFOJSONREADER_H
+#define INFOJSONREADER_H
+
+#include <QThread>
+#include <QStringList>
+#include <QHash>
+
+#include "OMDumpXML.h"
+
+namespace QJson {
+  class StreamReader;
+}
+
+typedef QHash<QString, OMVariable> OMVariableHash;
+
+/*!
+ * \class InfoJSONReader
+ * \brief Reads the model_info.json file in a separate thread.
+ * The file is read token by token with QJson::StreamReader and the variables and equations are filled directly from the tokens.
+ * So the whole file is never held in memory as one document. The equations are sent in batches so that they can be shown
+ * before the whole file is read. The receiver takes the ownership of the sent variables hash and equations.
+ */
+class InfoJSONReader : public QThread
+{
+  Q_OBJECT
+public:
+  InfoJSONReader(const QString &fileName, QObject *pParent = 0);
+  void cancel() {mCancelled = true;}
+protected:
+  virtual void run();
+private:
+  QString mFileName;
+  volatile bool mCancelled;
+  QString mErrorString;
+  int mEquationIndex;
+  OMVariableHash *mpVariables;
+  QList<OMEquation*> mEquations;
+
+  void readVariable(QJson::StreamReader *pReader, const QString &name);
+  bool readEquation(QJson::StreamReader *pReader);
+signals:
+  void sendVariables(OMVariableHash *pVariables);
+  void sendEquations(QList<OMEquation*> equations);
+  void sendProgress(int progress);
+  void sendFinished(bool success, QString errorString);
+};
+
+#endif // INFOJSONREADER_H
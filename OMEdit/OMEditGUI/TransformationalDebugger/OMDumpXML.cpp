@@ -44,7 +44,7 @@
 #include <QDebug>
 #include <QXmlStreamReader>
 #include "OMDumpXML.h"
-#include "diff_match_patch.h"
+#include "TokenDiff.h"
 
 QString OMOperation::toString()
 {
@@ -62,11 +62,7 @@ QString OMOperation::toHtml()
 
 QString OMOperation::diffHtml(QString &before, QString &after)
 {
-  diff_match_patch dmp;
-  dmp.Diff_EditCost = 6;
-  QList<Diff> diffs = dmp.diff_main(before,after);
-  dmp.diff_cleanupSemanticLossless(diffs);
-  return dmp.diff_prettyHtml(diffs);
+  return TokenDiff::diffHtml(before,after);
 }
 
 OMOperationInfo::OMOperationInfo(QString name, QString info) : name(name), info(info)
@@ -96,7 +92,11 @@ QString OMOperationBeforeAfter::toString()
 
 QString OMOperationBeforeAfter::toHtml()
 {
-  return name + ": " + diffHtml(before,after);
+  /* the operations are shown every time the equation is selected, compute the diff once. */
+  if (html.isNull()) {
+    html = name + ": " + diffHtml(before,after);
+  }
+  return html;
 }
 
 OMOperationScalarize::OMOperationScalarize(int _index, QStringList ops)
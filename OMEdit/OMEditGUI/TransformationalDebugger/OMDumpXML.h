@@ -66,6 +66,8 @@ public:
   OMOperationBeforeAfter(QString name, QStringList ops);
   QString toString();
   QString toHtml();
+private:
+  QString html;
 };
 
 class OMOperationSimplify : public OMOperationBeforeAfter
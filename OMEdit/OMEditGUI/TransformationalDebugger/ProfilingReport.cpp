@@ -0,0 +1,242 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "ProfilingReport.h"
+#include "TransformationsWidget.h"
+
+/* relative change of the time after which an entry is marked as regression or improvement. */
+#define PROFILING_REPORT_CHANGE_THRESHOLD 0.1
+
+/*!
+ * \brief ProfilingRecord::kindFromTag
+ * Returns the kind of the profile block from the equation tag.
+ * \param tag
+ * \return
+ */
+ProfilingRecord::Kind ProfilingRecord::kindFromTag(const QString &tag)
+{
+  if (tag.contains("nonlinear")) {
+    return NonlinearSystem;
+  } else if (tag.contains("linear")) {
+    return LinearSystem;
+  } else {
+    return Equation;
+  }
+}
+
+QString ProfilingRecord::kindToString(Kind kind)
+{
+  switch (kind) {
+    case LinearSystem:
+      return QObject::tr("Linear system");
+    case NonlinearSystem:
+      return QObject::tr("Nonlinear system");
+    case Function:
+      return QObject::tr("Function");
+    case Equation:
+    default:
+      return Helper::equation;
+  }
+}
+
+/*!
+ * \class ProfilingReportDialog
+ * \brief Ranks the functions, equations and systems of a simulation run by their execution time,
+ * and compares them with another run of the same model.
+ */
+/*!
+ * \brief ProfilingReportDialog::ProfilingReportDialog
+ * \param name - the model name.
+ * \param runs - the runs, the oldest first.
+ * \param pParent
+ */
+ProfilingReportDialog::ProfilingReportDialog(const QString &name, const QList<ProfilingRun> &runs, QWidget *pParent)
+  : QDialog(pParent), mRuns(runs)
+{
+  setAttribute(Qt::WA_DeleteOnClose);
+  setWindowTitle(QString(Helper::applicationName).append(" - ").append(tr("Profiling Report")).append(" - ").append(name));
+  setMinimumSize(800, 500);
+  // runs
+  mpRunComboBox = new QComboBox;
+  mpBaselineRunComboBox = new QComboBox;
+  mpBaselineRunComboBox->addItem(tr("None"), -1);
+  for (int i = 0 ; i < mRuns.size() ; i++) {
+    mpRunComboBox->addItem(mRuns.at(i).mDateTime.toString(), i);
+    mpBaselineRunComboBox->addItem(mRuns.at(i).mDateTime.toString(), i);
+  }
+  mpRunComboBox->setCurrentIndex(mRuns.size() - 1);
+  // compare the latest run with the one before it.
+  mpBaselineRunComboBox->setCurrentIndex(mRuns.size() > 1 ? mRuns.size() - 1 : 0);
+  connect(mpRunComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateReport()));
+  connect(mpBaselineRunComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateReport()));
+  // filters
+  mpKindComboBox = new QComboBox;
+  mpKindComboBox->addItem(tr("All"), -1);
+  mpKindComboBox->addItem(ProfilingRecord::kindToString(ProfilingRecord::Equation), ProfilingRecord::Equation);
+  mpKindComboBox->addItem(ProfilingRecord::kindToString(ProfilingRecord::LinearSystem), ProfilingRecord::LinearSystem);
+  mpKindComboBox->addItem(ProfilingRecord::kindToString(ProfilingRecord::NonlinearSystem), ProfilingRecord::NonlinearSystem);
+  mpKindComboBox->addItem(ProfilingRecord::kindToString(ProfilingRecord::Function), ProfilingRecord::Function);
+  connect(mpKindComboBox, SIGNAL(currentIndexChanged(int)), SLOT(updateReport()));
+  mpRegressionsOnlyCheckBox = new QCheckBox(tr("Show only regressions"));
+  connect(mpRegressionsOnlyCheckBox, SIGNAL(toggled(bool)), SLOT(updateReport()));
+  mpSummaryLabel = new Label;
+  // report
+  mpReportTreeWidget = new QTreeWidget;
+  mpReportTreeWidget->setItemDelegate(new ItemDelegate(mpReportTreeWidget));
+  mpReportTreeWidget->setIndentation(0);
+  mpReportTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  QStringList headerLabels;
+  headerLabels << Helper::index << Helper::type << tr("Name") << Helper::executionCount << Helper::executionTime << tr("Time per call")
+               << Helper::executionMaxTime << Helper::executionFraction << tr("Compared time") << tr("Change");
+  mpReportTreeWidget->setColumnCount(headerLabels.size());
+  mpReportTreeWidget->setHeaderLabels(headerLabels);
+  mpReportTreeWidget->setColumnWidth(0, 55);
+  mpReportTreeWidget->setColumnWidth(1, 100);
+  mpReportTreeWidget->setColumnWidth(2, 250);
+  mpReportTreeWidget->setSortingEnabled(true);
+  // buttons
+  mpCloseButton = new QPushButton(Helper::close);
+  mpCloseButton->setAutoDefault(true);
+  connect(mpCloseButton, SIGNAL(clicked()), SLOT(reject()));
+  mpButtonBox = new QDialogButtonBox(Qt::Horizontal);
+  mpButtonBox->addButton(mpCloseButton, QDialogButtonBox::ActionRole);
+  // layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->addWidget(new Label(tr("Run:")), 0, 0);
+  pMainLayout->addWidget(mpRunComboBox, 0, 1);
+  pMainLayout->addWidget(new Label(tr("Compare with:")), 0, 2);
+  pMainLayout->addWidget(mpBaselineRunComboBox, 0, 3);
+  pMainLayout->addWidget(new Label(tr("Show:")), 1, 0);
+  pMainLayout->addWidget(mpKindComboBox, 1, 1);
+  pMainLayout->addWidget(mpRegressionsOnlyCheckBox, 1, 2, 1, 2);
+  pMainLayout->addWidget(mpSummaryLabel, 2, 0, 1, 4);
+  pMainLayout->addWidget(mpReportTreeWidget, 3, 0, 1, 4);
+  pMainLayout->addWidget(mpButtonBox, 4, 0, 1, 4, Qt::AlignRight);
+  pMainLayout->setColumnStretch(1, 1);
+  pMainLayout->setColumnStretch(3, 1);
+  setLayout(pMainLayout);
+  updateReport();
+  mpReportTreeWidget->sortByColumn(4, Qt::DescendingOrder);
+}
+
+/*!
+ * \brief ProfilingReportDialog::updateReport
+ * Fills the report for the selected runs and filters.
+ */
+void ProfilingReportDialog::updateReport()
+{
+  mpReportTreeWidget->clear();
+  int run = mpRunComboBox->itemData(mpRunComboBox->currentIndex()).toInt();
+  int baselineRun = mpBaselineRunComboBox->itemData(mpBaselineRunComboBox->currentIndex()).toInt();
+  int kind = mpKindComboBox->itemData(mpKindComboBox->currentIndex()).toInt();
+  if (run < 0 || run >= mRuns.size()) {
+    mpSummaryLabel->clear();
+    return;
+  }
+  const ProfilingRun &profilingRun = mRuns.at(run);
+  /* the records are matched by their kind and text since the equation indexes change with the model.
+   * Several records may have the same text, e.g., systems of the same size, so the n-th of them is matched with the n-th in the baseline.
+   */
+  QHash<QString, double> baselineTimes;
+  bool hasBaseline = baselineRun >= 0 && baselineRun < mRuns.size() && baselineRun != run;
+  if (hasBaseline) {
+    QHash<QString, int> baselineOccurrences;
+    foreach (const ProfilingRecord &record, mRuns.at(baselineRun).mRecords) {
+      QString key = record.getKey();
+      baselineTimes.insert(key + "#" + QString::number(baselineOccurrences[key]++), record.mTime);
+    }
+  }
+  QHash<QString, int> occurrences;
+  QString summary = tr("Total time: %1 s").arg(profilingRun.mTotalTime, 0, 'g', 4);
+  if (hasBaseline) {
+    double baselineTotalTime = mRuns.at(baselineRun).mTotalTime;
+    summary.append(tr(", compared: %1 s").arg(baselineTotalTime, 0, 'g', 4));
+    if (baselineTotalTime > 0) {
+      summary.append(QString(" (%1%2%)").arg(profilingRun.mTotalTime >= baselineTotalTime ? "+" : "")
+                     .arg(100 * (profilingRun.mTotalTime - baselineTotalTime) / baselineTotalTime, 0, 'g', 3));
+    }
+  }
+  mpSummaryLabel->setText(summary);
+  QList<QTreeWidgetItem*> items;
+  int regressions = 0;
+  foreach (const ProfilingRecord &record, profilingRun.mRecords) {
+    QString key = record.getKey();
+    key += "#" + QString::number(occurrences[key]++);
+    if (kind >= 0 && record.mKind != kind) {
+      continue;
+    }
+    QStringList values;
+    values << (record.mIndex >= 0 ? QString::number(record.mIndex) : QString())
+           << ProfilingRecord::kindToString(record.mKind)
+           << record.mName
+           << QString::number(record.mNumCalls)
+           << QString::number(record.mTime, 'g', 4)
+           << (record.mNumCalls > 0 ? QString::number(record.mTime / record.mNumCalls, 'g', 4) : QString())
+           << QString::number(record.mMaxTime, 'g', 4)
+           << (profilingRun.mTotalTimeProfileBlocks > 0 && record.mKind != ProfilingRecord::Function ?
+                 QString::number(100 * record.mTime / profilingRun.mTotalTimeProfileBlocks, 'g', 3) + "%" : QString());
+    double change = 0;
+    bool hasChange = false;
+    if (hasBaseline) {
+      QHash<QString, double>::const_iterator iterator = baselineTimes.constFind(key);
+      if (iterator != baselineTimes.constEnd()) {
+        values << QString::number(iterator.value(), 'g', 4);
+        if (iterator.value() > 0) {
+          change = (record.mTime - iterator.value()) / iterator.value();
+          hasChange = true;
+          values << QString("%1%2%").arg(change >= 0 ? "+" : "").arg(100 * change, 0, 'g', 3);
+        }
+      } else {
+        values << QString() << tr("new");
+      }
+    }
+    bool isRegression = hasChange && change > PROFILING_REPORT_CHANGE_THRESHOLD;
+    if (mpRegressionsOnlyCheckBox->isChecked() && !isRegression) {
+      continue;
+    }
+    QTreeWidgetItem *pItem = new IntegerTreeWidgetItem(values, mpReportTreeWidget);
+    pItem->setToolTip(2, record.mName);
+    if (isRegression) {
+      pItem->setForeground(9, Qt::red);
+      regressions++;
+    } else if (hasChange && change < -PROFILING_REPORT_CHANGE_THRESHOLD) {
+      pItem->setForeground(9, Qt::darkGreen);
+    }
+    items.append(pItem);
+  }
+  mpReportTreeWidget->addTopLevelItems(items);
+  if (hasBaseline) {
+    mpSummaryLabel->setText(summary + tr(", regressions: %1").arg(regressions));
+  }
+}
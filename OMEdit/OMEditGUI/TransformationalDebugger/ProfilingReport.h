@@ -0,0 +1,106 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PROFILINGREPORT_H
+#define PROFILINGREPORT_H
+
+#include <QDialog>
+#include <QDateTime>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QDialogButtonBox>
+
+class Label;
+
+/*!
+ * \class ProfilingRecord
+ * \brief The profiling summary of a function or profile block in one simulation run.
+ */
+class ProfilingRecord
+{
+public:
+  enum Kind {
+    Equation,
+    LinearSystem,
+    NonlinearSystem,
+    Function
+  };
+  Kind mKind;
+  int mIndex;           /* equation index, -1 for functions. */
+  QString mSection;
+  QString mName;
+  int mNumCalls;
+  double mTime;
+  double mMaxTime;
+  QString getKey() const {return QString::number(mKind) + ":" + mSection + ":" + mName;}
+  static Kind kindFromTag(const QString &tag);
+  static QString kindToString(Kind kind);
+};
+
+/*!
+ * \class ProfilingRun
+ * \brief The profiling summary of one simulation run.
+ */
+class ProfilingRun
+{
+public:
+  ProfilingRun() : mTotalTime(0), mTotalTimeProfileBlocks(0) {}
+  QDateTime mDateTime;
+  double mTotalTime;
+  double mTotalTimeProfileBlocks;
+  QList<ProfilingRecord> mRecords;
+};
+
+class ProfilingReportDialog : public QDialog
+{
+  Q_OBJECT
+public:
+  ProfilingReportDialog(const QString &name, const QList<ProfilingRun> &runs, QWidget *pParent = 0);
+private:
+  QList<ProfilingRun> mRuns;
+  QComboBox *mpRunComboBox;
+  QComboBox *mpBaselineRunComboBox;
+  QComboBox *mpKindComboBox;
+  QCheckBox *mpRegressionsOnlyCheckBox;
+  Label *mpSummaryLabel;
+  QTreeWidget *mpReportTreeWidget;
+  QPushButton *mpCloseButton;
+  QDialogButtonBox *mpButtonBox;
+public slots:
+  void updateReport();
+};
+
+#endif // PROFILINGREPORT_H
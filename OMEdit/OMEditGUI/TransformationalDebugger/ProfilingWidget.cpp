@@ -0,0 +1,393 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "ProfilingWidget.h"
+#include "Helper.h"
+#include "Utilities.h"
+
+#include <QGridLayout>
+#include <qwt_plot_curve.h>
+#include <qwt_legend.h>
+
+/* rows of model_prof.realdata before the functions and profile blocks, i.e., time and step time. */
+#define PROFILING_REAL_DATA_HEADER_ROWS 2
+/* rows of model_prof.intdata before the functions and profile blocks, i.e., step count. */
+#define PROFILING_INT_DATA_HEADER_ROWS 1
+
+ProfilingData::ProfilingData()
+{
+  mpRealData = 0;
+  mpIntData = 0;
+  mNumSteps = 0;
+  mNumFunctionsAndBlocks = 0;
+}
+
+ProfilingData::~ProfilingData()
+{
+  close();
+}
+
+/*!
+ * \brief ProfilingData::open
+ * Maps the profiling data files. The model_prof.intdata file is optional.
+ * \param realDataFileName
+ * \param intDataFileName
+ * \param numSteps - the number of output steps including the initialization.
+ * \param numFunctionsAndBlocks - the number of functions and profile blocks.
+ * \return
+ */
+bool ProfilingData::open(const QString &realDataFileName, const QString &intDataFileName, int numSteps, int numFunctionsAndBlocks)
+{
+  close();
+  if (numSteps <= 0) {
+    return false;
+  }
+  qint64 realDataSize = (qint64)(PROFILING_REAL_DATA_HEADER_ROWS + numFunctionsAndBlocks) * numSteps * sizeof(double);
+  mRealDataFile.setFileName(realDataFileName);
+  if (!mRealDataFile.open(QIODevice::ReadOnly) || mRealDataFile.size() < realDataSize) {
+    close();
+    return false;
+  }
+  mpRealData = mRealDataFile.map(0, realDataSize);
+  if (!mpRealData) {
+    close();
+    return false;
+  }
+  qint64 intDataSize = (qint64)(PROFILING_INT_DATA_HEADER_ROWS + numFunctionsAndBlocks) * numSteps * sizeof(quint32);
+  mIntDataFile.setFileName(intDataFileName);
+  if (mIntDataFile.open(QIODevice::ReadOnly) && mIntDataFile.size() >= intDataSize) {
+    mpIntData = mIntDataFile.map(0, intDataSize);
+  }
+  mNumSteps = numSteps;
+  mNumFunctionsAndBlocks = numFunctionsAndBlocks;
+  return true;
+}
+
+/*!
+ * \brief ProfilingData::close
+ * Unmaps the profiling data files.
+ */
+void ProfilingData::close()
+{
+  if (mpRealData) {
+    mRealDataFile.unmap(mpRealData);
+    mpRealData = 0;
+  }
+  if (mpIntData) {
+    mIntDataFile.unmap(mpIntData);
+    mpIntData = 0;
+  }
+  mRealDataFile.close();
+  mIntDataFile.close();
+  mNumSteps = 0;
+  mNumFunctionsAndBlocks = 0;
+}
+
+const double* ProfilingData::getTime() const
+{
+  return mpRealData ? (const double*)mpRealData : 0;
+}
+
+/*!
+ * \brief ProfilingData::getExecutionTimes
+ * Returns the execution times of the profile block for all the steps.
+ * \param profileBlock - the index of the function or profile block.
+ * \return
+ */
+const double* ProfilingData::getExecutionTimes(int profileBlock) const
+{
+  if (!mpRealData || profileBlock < 0 || profileBlock >= mNumFunctionsAndBlocks) {
+    return 0;
+  }
+  return (const double*)mpRealData + (qint64)(PROFILING_REAL_DATA_HEADER_ROWS + profileBlock) * mNumSteps;
+}
+
+/*!
+ * \brief ProfilingData::getNumCalls
+ * Returns the number of calls of the profile block for all the steps.
+ * \param profileBlock - the index of the function or profile block.
+ * \return
+ */
+const quint32* ProfilingData::getNumCalls(int profileBlock) const
+{
+  if (!mpIntData || profileBlock < 0 || profileBlock >= mNumFunctionsAndBlocks) {
+    return 0;
+  }
+  return (const quint32*)mpIntData + (qint64)(PROFILING_INT_DATA_HEADER_ROWS + profileBlock) * mNumSteps;
+}
+
+/*!
+ * \brief ProfilingData::getHottestProfileBlocks
+ * Returns the profile blocks with the largest total execution time, the largest first.
+ * \param firstProfileBlock - the profile blocks before this are not considered, e.g., the functions.
+ * \param count
+ * \return
+ */
+QList<int> ProfilingData::getHottestProfileBlocks(int firstProfileBlock, int count) const
+{
+  QList<QPair<double, int> > totalTimes;
+  for (int profileBlock = qMax(firstProfileBlock, 0) ; profileBlock < mNumFunctionsAndBlocks ; profileBlock++) {
+    const double *pExecutionTimes = getExecutionTimes(profileBlock);
+    double totalTime = 0;
+    for (int i = 0 ; i < mNumSteps ; i++) {
+      totalTime += pExecutionTimes[i];
+    }
+    totalTimes.append(qMakePair(-totalTime, profileBlock));
+  }
+  qSort(totalTimes);
+  QList<int> profileBlocks;
+  for (int i = 0 ; i < totalTimes.size() && i < count ; i++) {
+    profileBlocks.append(totalTimes.at(i).second);
+  }
+  return profileBlocks;
+}
+
+ProfilingNumCallsData::ProfilingNumCallsData(const double *pTime, const quint32 *pNumCalls, int size)
+  : mpTime(pTime), mpNumCalls(pNumCalls), mSize(size)
+{
+}
+
+size_t ProfilingNumCallsData::size() const
+{
+  return mSize;
+}
+
+QPointF ProfilingNumCallsData::sample(size_t i) const
+{
+  return QPointF(mpTime[i], mpNumCalls[i]);
+}
+
+QRectF ProfilingNumCallsData::boundingRect() const
+{
+  if (d_boundingRect.width() < 0) {
+    d_boundingRect = qwtBoundingRect(*this);
+  }
+  return d_boundingRect;
+}
+
+/*!
+ * \class ProfilingWidget
+ * \brief Plots the execution time and the number of calls of the selected equation over the simulation time,
+ * and the execution times of the hottest equations.
+ */
+/*!
+ * \brief ProfilingWidget::ProfilingWidget
+ * \param pParent
+ */
+ProfilingWidget::ProfilingWidget(QWidget *pParent)
+  : QWidget(pParent)
+{
+  mNumFunctions = 0;
+  mShownEquationIndex = -1;
+  mShowHottestEquations = false;
+  /* the simulation rewrites the profiling data files, the curves must not read them while they are written. */
+  connect(&mProfilingDataWatcher, SIGNAL(fileChanged(QString)), SLOT(profilingDataChanged()));
+  Label *pProfilingLabel = new Label(tr("Profiling"));
+  pProfilingLabel->setObjectName("LabelWithBorder");
+  mpProfilingPlot = new QwtPlot;
+  mpProfilingPlot->setAxisTitle(QwtPlot::xBottom, tr("Simulation time"));
+  mpProfilingPlot->setAxisTitle(QwtPlot::yLeft, Helper::executionTime);
+  mpProfilingPlot->setAxisTitle(QwtPlot::yRight, Helper::executionCount);
+  mpProfilingPlot->insertLegend(new QwtLegend, QwtPlot::BottomLegend);
+  mpProfilingPlot->setMinimumHeight(150);
+  Label *pHottestEquationsLabel = new Label(tr("Hottest equations:"));
+  mpHottestEquationsSpinBox = new QSpinBox;
+  mpHottestEquationsSpinBox->setRange(1, 20);
+  mpHottestEquationsSpinBox->setValue(5);
+  mpHottestEquationsButton = new QPushButton(tr("Show"));
+  mpHottestEquationsButton->setAutoDefault(false);
+  connect(mpHottestEquationsButton, SIGNAL(clicked()), SLOT(showHottestEquations()));
+  mpProfilingReportButton = new QPushButton(tr("Profiling Report"));
+  mpProfilingReportButton->setToolTip(tr("Ranks the equations by their execution time and compares the simulation runs"));
+  mpProfilingReportButton->setAutoDefault(false);
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->setSpacing(1);
+  pMainLayout->setContentsMargins(0, 0, 0, 0);
+  pMainLayout->addWidget(pProfilingLabel, 0, 0, 1, 5);
+  pMainLayout->addWidget(mpProfilingPlot, 1, 0, 1, 5);
+  pMainLayout->addWidget(pHottestEquationsLabel, 2, 0);
+  pMainLayout->addWidget(mpHottestEquationsSpinBox, 2, 1);
+  pMainLayout->addWidget(mpHottestEquationsButton, 2, 2);
+  pMainLayout->addWidget(mpProfilingReportButton, 2, 4);
+  pMainLayout->setColumnStretch(3, 1);
+  setLayout(pMainLayout);
+  setVisible(false);
+}
+
+/*!
+ * \brief ProfilingWidget::openProfilingData
+ * Opens the profiling data of a simulation. The widget is only shown if the data is available.
+ * The curves shown before the data is reloaded are plotted again from the new data, or removed if the new data does not have them.
+ * \param realDataFileName
+ * \param intDataFileName
+ * \param numSteps - the number of output steps including the initialization.
+ * \param numFunctions
+ * \param profileBlockEquations - the equation index of every profile block after the functions.
+ */
+void ProfilingWidget::openProfilingData(const QString &realDataFileName, const QString &intDataFileName, int numSteps, int numFunctions,
+                                        const QList<int> &profileBlockEquations)
+{
+  clearProfilingData();
+  mNumFunctions = numFunctions;
+  mProfileBlockEquations = profileBlockEquations;
+  setVisible(mProfilingData.open(realDataFileName, intDataFileName, numSteps, numFunctions + profileBlockEquations.size()));
+  if (mProfilingData.isOpen()) {
+    mProfilingDataWatcher.addPath(realDataFileName);
+    if (QFile::exists(intDataFileName)) {
+      mProfilingDataWatcher.addPath(intDataFileName);
+    }
+    refreshPlot();
+  }
+}
+
+/*!
+ * \brief ProfilingWidget::clearProfilingData
+ * Removes the curves and unmaps the profiling data files.
+ * Which curves are shown is kept so that openProfilingData can plot them again.
+ */
+void ProfilingWidget::clearProfilingData()
+{
+  clearPlot();
+  if (!mProfilingDataWatcher.files().isEmpty()) {
+    mProfilingDataWatcher.removePaths(mProfilingDataWatcher.files());
+  }
+  mProfilingData.close();
+  mNumFunctions = 0;
+  mProfileBlockEquations.clear();
+  setVisible(false);
+}
+
+/*!
+ * \brief ProfilingWidget::showEquationProfiling
+ * Plots the execution time and the number of calls of the equation.
+ * The plot is cleared if the equation has no profiling data.
+ * \param pEquation
+ */
+void ProfilingWidget::showEquationProfiling(OMEquation *pEquation)
+{
+  mShowHottestEquations = false;
+  mShownEquationIndex = pEquation ? pEquation->index : -1;
+  plotEquationProfiling(mShownEquationIndex, pEquation ? pEquation->profileBlock : -1);
+}
+
+/*!
+ * \brief ProfilingWidget::plotEquationProfiling
+ * Plots the execution time and the number of calls of the profile block of the equation.
+ * \param equationIndex
+ * \param profileBlock
+ */
+void ProfilingWidget::plotEquationProfiling(int equationIndex, int profileBlock)
+{
+  clearPlot();
+  const double *pExecutionTimes = mProfilingData.getExecutionTimes(profileBlock);
+  if (!pExecutionTimes) {
+    return;
+  }
+  QwtPlotCurve *pExecutionTimeCurve = new QwtPlotCurve(QString("%1 %2").arg(Helper::executionTime).arg(equationIndex));
+  pExecutionTimeCurve->setRawSamples(mProfilingData.getTime(), pExecutionTimes, mProfilingData.getNumSteps());
+  pExecutionTimeCurve->setPen(QPen(Qt::blue));
+  pExecutionTimeCurve->attach(mpProfilingPlot);
+  const quint32 *pNumCalls = mProfilingData.getNumCalls(profileBlock);
+  mpProfilingPlot->enableAxis(QwtPlot::yRight, pNumCalls != 0);
+  if (pNumCalls) {
+    QwtPlotCurve *pNumCallsCurve = new QwtPlotCurve(QString("%1 %2").arg(Helper::executionCount).arg(equationIndex));
+    pNumCallsCurve->setData(new ProfilingNumCallsData(mProfilingData.getTime(), pNumCalls, mProfilingData.getNumSteps()));
+    pNumCallsCurve->setPen(QPen(Qt::red));
+    pNumCallsCurve->setYAxis(QwtPlot::yRight);
+    pNumCallsCurve->attach(mpProfilingPlot);
+  }
+  mpProfilingPlot->replot();
+}
+
+/*!
+ * \brief ProfilingWidget::refreshPlot
+ * Plots the curves that were shown before the profiling data is reloaded.
+ * The profile block of the shown equation is looked up again since it may have changed or been removed.
+ */
+void ProfilingWidget::refreshPlot()
+{
+  if (mShowHottestEquations) {
+    showHottestEquations();
+  } else if (mShownEquationIndex >= 0) {
+    int profileBlock = mProfileBlockEquations.indexOf(mShownEquationIndex);
+    plotEquationProfiling(mShownEquationIndex, profileBlock < 0 ? -1 : profileBlock + mNumFunctions);
+  }
+}
+
+/*!
+ * \brief ProfilingWidget::profilingDataChanged
+ * Slot activated when the mapped profiling data files are changed, e.g., by a new simulation.
+ * Removes the curves and unmaps the files. The new data is shown when the transformations are reloaded.
+ */
+void ProfilingWidget::profilingDataChanged()
+{
+  clearProfilingData();
+}
+
+/*!
+ * \brief ProfilingWidget::showHottestEquations
+ * Plots the execution times of the equations with the largest total execution time.
+ */
+void ProfilingWidget::showHottestEquations()
+{
+  if (!mProfilingData.isOpen()) {
+    return;
+  }
+  mShowHottestEquations = true;
+  clearPlot();
+  mpProfilingPlot->enableAxis(QwtPlot::yRight, false);
+  static const Qt::GlobalColor colors[] = {Qt::blue, Qt::red, Qt::darkGreen, Qt::magenta, Qt::darkYellow, Qt::cyan, Qt::darkBlue,
+                                           Qt::darkRed, Qt::green, Qt::darkMagenta, Qt::darkCyan, Qt::gray};
+  static const int numColors = sizeof(colors) / sizeof(colors[0]);
+  QList<int> profileBlocks = mProfilingData.getHottestProfileBlocks(mNumFunctions, mpHottestEquationsSpinBox->value());
+  for (int i = 0 ; i < profileBlocks.size() ; i++) {
+    int equationIndex = mProfileBlockEquations.value(profileBlocks.at(i) - mNumFunctions, -1);
+    QwtPlotCurve *pExecutionTimeCurve = new QwtPlotCurve(QString("%1 %2").arg(Helper::equation).arg(equationIndex));
+    pExecutionTimeCurve->setRawSamples(mProfilingData.getTime(), mProfilingData.getExecutionTimes(profileBlocks.at(i)),
+                                       mProfilingData.getNumSteps());
+    pExecutionTimeCurve->setPen(QPen(colors[i % numColors]));
+    pExecutionTimeCurve->attach(mpProfilingPlot);
+  }
+  mpProfilingPlot->replot();
+}
+
+/*!
+ * \brief ProfilingWidget::clearPlot
+ * Deletes the curves. The curves refer to the mapped files so they must be deleted before the files are unmapped.
+ */
+void ProfilingWidget::clearPlot()
+{
+  mpProfilingPlot->detachItems(QwtPlotItem::Rtti_PlotCurve, true);
+  mpProfilingPlot->replot();
+}
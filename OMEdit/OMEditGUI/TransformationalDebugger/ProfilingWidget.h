@@ -0,0 +1,128 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PROFILINGWIDGET_H
+#define PROFILINGWIDGET_H
+
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QWidget>
+#include <QSpinBox>
+#include <QPushButton>
+
+#include <qwt_plot.h>
+#include <qwt_series_data.h>
+
+#include "OMDumpXML.h"
+
+/*!
+ * \class ProfilingData
+ * \brief Memory maps the model_prof.realdata and model_prof.intdata files.
+ * Both files store one row per measurement with one value for every output step. The first rows of model_prof.realdata are the
+ * time and the time of the whole step, followed by the execution times of the functions and profile blocks. The first row of
+ * model_prof.intdata is the step count, followed by the number of calls of the functions and profile blocks.
+ * The rows are returned as pointers into the mapped files, so no data is copied.
+ */
+class ProfilingData
+{
+public:
+  ProfilingData();
+  ~ProfilingData();
+  bool open(const QString &realDataFileName, const QString &intDataFileName, int numSteps, int numFunctionsAndBlocks);
+  void close();
+  bool isOpen() const {return mpRealData != 0;}
+  int getNumSteps() const {return mNumSteps;}
+  int getNumFunctionsAndBlocks() const {return mNumFunctionsAndBlocks;}
+  const double* getTime() const;
+  const double* getExecutionTimes(int profileBlock) const;
+  const quint32* getNumCalls(int profileBlock) const;
+  QList<int> getHottestProfileBlocks(int firstProfileBlock, int count) const;
+private:
+  QFile mRealDataFile;
+  QFile mIntDataFile;
+  uchar *mpRealData;
+  uchar *mpIntData;
+  int mNumSteps;
+  int mNumFunctionsAndBlocks;
+};
+
+/*!
+ * \class ProfilingNumCallsData
+ * \brief Series of the number of calls of a profile block, read directly from the mapped model_prof.intdata file.
+ */
+class ProfilingNumCallsData : public QwtSeriesData<QPointF>
+{
+public:
+  ProfilingNumCallsData(const double *pTime, const quint32 *pNumCalls, int size);
+  virtual size_t size() const;
+  virtual QPointF sample(size_t i) const;
+  virtual QRectF boundingRect() const;
+private:
+  const double *mpTime;
+  const quint32 *mpNumCalls;
+  int mSize;
+};
+
+class ProfilingWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  ProfilingWidget(QWidget *pParent = 0);
+  void openProfilingData(const QString &realDataFileName, const QString &intDataFileName, int numSteps, int numFunctions,
+                         const QList<int> &profileBlockEquations);
+  void clearProfilingData();
+  void showEquationProfiling(OMEquation *pEquation);
+  QPushButton* getProfilingReportButton() {return mpProfilingReportButton;}
+private:
+  ProfilingData mProfilingData;
+  QFileSystemWatcher mProfilingDataWatcher;
+  int mNumFunctions;
+  QList<int> mProfileBlockEquations;
+  int mShownEquationIndex;
+  bool mShowHottestEquations;
+  QwtPlot *mpProfilingPlot;
+  QSpinBox *mpHottestEquationsSpinBox;
+  QPushButton *mpHottestEquationsButton;
+  QPushButton *mpProfilingReportButton;
+
+  void clearPlot();
+  void plotEquationProfiling(int equationIndex, int profileBlock);
+  void refreshPlot();
+public slots:
+  void showHottestEquations();
+private slots:
+  void profilingDataChanged();
+};
+
+#endif // PROFILINGWIDGET_H
@@ -0,0 +1,315 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "TokenDiff.h"
+
+#include <QHash>
+
+/*!
+ * \brief TokenDiff::TokenDiff
+ * Computes the shortest edit script from before to after.
+ * \param before
+ * \param after
+ */
+TokenDiff::TokenDiff(const QString &before, const QString &after)
+  : mBefore(before), mAfter(after)
+{
+  tokenize();
+  int size = mBeforeTokens.size() + mAfterTokens.size() + 2;
+  /* the diagonals of both directions, shared by all the middle snake searches. */
+  mForward.resize(2 * size + 1);
+  mBackward.resize(2 * size + 1);
+  compare(0, mBeforeTokens.size(), 0, mAfterTokens.size());
+}
+
+/*!
+ * \brief TokenDiff::toHtml
+ * Returns the edits as html. The insertions and deletions are highlighted.
+ * \return
+ */
+QString TokenDiff::toHtml() const
+{
+  QString html;
+  html.reserve(mBefore.size() + mAfter.size() + 64 * mEdits.size());
+  foreach (const Edit &edit, mEdits) {
+    switch (edit.operation) {
+      case Insert:
+        html.append("<ins style=\"background:#e6ffe6;\">");
+        appendEscaped(html, mAfter, mAfterOffsets.at(edit.start), mAfterOffsets.at(edit.start + edit.count));
+        html.append("</ins>");
+        break;
+      case Delete:
+        html.append("<del style=\"background:#ffe6e6;\">");
+        appendEscaped(html, mBefore, mBeforeOffsets.at(edit.start), mBeforeOffsets.at(edit.start + edit.count));
+        html.append("</del>");
+        break;
+      case Equal:
+      default:
+        html.append("<span>");
+        appendEscaped(html, mBefore, mBeforeOffsets.at(edit.start), mBeforeOffsets.at(edit.start + edit.count));
+        html.append("</span>");
+        break;
+    }
+  }
+  return html;
+}
+
+/*!
+ * \brief TokenDiff::diffHtml
+ * Returns the html of the differences between before and after.
+ * \param before
+ * \param after
+ * \return
+ */
+QString TokenDiff::diffHtml(const QString &before, const QString &after)
+{
+  return TokenDiff(before, after).toHtml();
+}
+
+/*!
+ * \brief TokenDiff::tokenize
+ * Splits both texts into tokens. Equal tokens get the same id.
+ */
+void TokenDiff::tokenize()
+{
+  QHash<QString, int> ids;
+  const QString *texts[2] = {&mBefore, &mAfter};
+  QVector<int> *tokens[2] = {&mBeforeTokens, &mAfterTokens};
+  QVector<int> *offsets[2] = {&mBeforeOffsets, &mAfterOffsets};
+  for (int t = 0 ; t < 2 ; t++) {
+    const QChar *data = texts[t]->constData();
+    int size = texts[t]->size();
+    int i = 0;
+    while (i < size) {
+      int start = i;
+      QChar c = data[i++];
+      if (c.isLetterOrNumber() || c == '_' || c == '.' || c == '$') {
+        while (i < size && (data[i].isLetterOrNumber() || data[i] == '_' || data[i] == '.' || data[i] == '$')) {
+          i++;
+        }
+      } else if (c.isSpace()) {
+        while (i < size && data[i].isSpace()) {
+          i++;
+        }
+      }
+      /* the key refers to the text, it is not copied. */
+      QString token = QString::fromRawData(data + start, i - start);
+      QHash<QString, int>::const_iterator iterator = ids.constFind(token);
+      if (iterator == ids.constEnd()) {
+        iterator = ids.insert(token, ids.size());
+      }
+      tokens[t]->append(iterator.value());
+      offsets[t]->append(start);
+    }
+    offsets[t]->append(size);
+  }
+}
+
+/*!
+ * \brief TokenDiff::compare
+ * Adds the edits of the token ranges. The common prefix and suffix are skipped,
+ * the rest is split at the middle snake and compared recursively.
+ * \param beforeStart
+ * \param beforeEnd
+ * \param afterStart
+ * \param afterEnd
+ */
+void TokenDiff::compare(int beforeStart, int beforeEnd, int afterStart, int afterEnd)
+{
+  int prefix = 0;
+  while (beforeStart + prefix < beforeEnd && afterStart + prefix < afterEnd
+         && mBeforeTokens.at(beforeStart + prefix) == mAfterTokens.at(afterStart + prefix)) {
+    prefix++;
+  }
+  addEdit(Equal, beforeStart, prefix);
+  beforeStart += prefix;
+  afterStart += prefix;
+  int suffix = 0;
+  while (beforeStart < beforeEnd - suffix && afterStart < afterEnd - suffix
+         && mBeforeTokens.at(beforeEnd - suffix - 1) == mAfterTokens.at(afterEnd - suffix - 1)) {
+    suffix++;
+  }
+  beforeEnd -= suffix;
+  afterEnd -= suffix;
+  if (beforeStart == beforeEnd) {
+    addEdit(Insert, afterStart, afterEnd - afterStart);
+  } else if (afterStart == afterEnd) {
+    addEdit(Delete, beforeStart, beforeEnd - beforeStart);
+  } else {
+    int snakeBefore, snakeAfter, snakeLength;
+    if (findMiddleSnake(beforeStart, beforeEnd, afterStart, afterEnd, snakeBefore, snakeAfter, snakeLength)) {
+      compare(beforeStart, snakeBefore, afterStart, snakeAfter);
+      addEdit(Equal, snakeBefore, snakeLength);
+      compare(snakeBefore + snakeLength, beforeEnd, snakeAfter + snakeLength, afterEnd);
+    } else {
+      /* the ranges are too different, replace them. */
+      addEdit(Delete, beforeStart, beforeEnd - beforeStart);
+      addEdit(Insert, afterStart, afterEnd - afterStart);
+    }
+  }
+  addEdit(Equal, beforeEnd, suffix);
+}
+
+/*!
+ * \brief TokenDiff::findMiddleSnake
+ * Searches the shortest edit path from both ends at the same time until the paths overlap.
+ * Returns false if the ranges differ in too many tokens.
+ * \param beforeStart
+ * \param beforeEnd
+ * \param afterStart
+ * \param afterEnd
+ * \param snakeBefore - the start of the snake in the before tokens.
+ * \param snakeAfter - the start of the snake in the after tokens.
+ * \param snakeLength - the number of equal tokens of the snake.
+ * \return
+ */
+bool TokenDiff::findMiddleSnake(int beforeStart, int beforeEnd, int afterStart, int afterEnd, int &snakeBefore, int &snakeAfter,
+                                int &snakeLength)
+{
+  /* the edit cost after which the ranges are replaced instead of compared. */
+  const int maximumCost = 1000;
+  const int *before = mBeforeTokens.constData() + beforeStart;
+  const int *after = mAfterTokens.constData() + afterStart;
+  int n = beforeEnd - beforeStart;
+  int m = afterEnd - afterStart;
+  int delta = n - m;
+  bool odd = (delta & 1) != 0;
+  /* the diagonal k of the forward search is the diagonal delta - k of the backward search. */
+  int *forward = mForward.data() + (mForward.size() / 2);
+  int *backward = mBackward.data() + (mBackward.size() / 2);
+  forward[1] = 0;
+  backward[1] = 0;
+  int maximumD = (n + m + 1) / 2;
+  for (int d = 0 ; d <= maximumD && d <= maximumCost ; d++) {
+    /* forward search */
+    for (int k = -d ; k <= d ; k += 2) {
+      int x;
+      if (k == -d || (k != d && forward[k - 1] < forward[k + 1])) {
+        x = forward[k + 1];
+      } else {
+        x = forward[k - 1] + 1;
+      }
+      int y = x - k;
+      int startX = x;
+      while (x < n && y < m && before[x] == after[y]) {
+        x++;
+        y++;
+      }
+      forward[k] = x;
+      int c = delta - k;
+      if (odd && c >= -(d - 1) && c <= d - 1 && x + backward[c] >= n) {
+        snakeBefore = beforeStart + startX;
+        snakeAfter = afterStart + startX - k;
+        snakeLength = x - startX;
+        return true;
+      }
+    }
+    /* backward search, x counts the tokens from the end */
+    for (int c = -d ; c <= d ; c += 2) {
+      int x;
+      if (c == -d || (c != d && backward[c - 1] < backward[c + 1])) {
+        x = backward[c + 1];
+      } else {
+        x = backward[c - 1] + 1;
+      }
+      int y = x - c;
+      int startX = x;
+      while (x < n && y < m && before[n - x - 1] == after[m - y - 1]) {
+        x++;
+        y++;
+      }
+      backward[c] = x;
+      int k = delta - c;
+      if (!odd && k >= -d && k <= d && x + forward[k] >= n) {
+        snakeBefore = beforeStart + n - x;
+        snakeAfter = afterStart + m - (x - c);
+        snakeLength = x - startX;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief TokenDiff::addEdit
+ * Adds the edit or extends the last edit if it has the same operation.
+ * \param operation
+ * \param start
+ * \param count
+ */
+void TokenDiff::addEdit(Operation operation, int start, int count)
+{
+  if (count <= 0) {
+    return;
+  }
+  if (!mEdits.isEmpty() && mEdits.last().operation == operation && mEdits.last().start + mEdits.last().count == start) {
+    mEdits.last().count += count;
+    return;
+  }
+  Edit edit = {operation, start, count};
+  mEdits.append(edit);
+}
+
+/*!
+ * \brief TokenDiff::appendEscaped
+ * Appends the html escaped characters of the text between start and end.
+ * \param html
+ * \param text
+ * \param start
+ * \param end
+ */
+void TokenDiff::appendEscaped(QString &html, const QString &text, int start, int end) const
+{
+  const QChar *data = text.constData();
+  for (int i = start ; i < end ; i++) {
+    switch (data[i].unicode()) {
+      case '&':
+        html.append("&amp;");
+        break;
+      case '<':
+        html.append("&lt;");
+        break;
+      case '>':
+        html.append("&gt;");
+        break;
+      case '\n':
+        html.append("&para;<br>");
+        break;
+      default:
+        html.append(data[i]);
+        break;
+    }
+  }
+}
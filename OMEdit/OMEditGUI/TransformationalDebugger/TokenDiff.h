@@ -0,0 +1,79 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef TOKENDIFF_H
+#define TOKENDIFF_H
+
+#include <QString>
+#include <QVector>
+
+/*!
+ * \class TokenDiff
+ * \brief Linear space Myers diff of two expressions.
+ * The texts are split into identifiers, numbers, white space runs and single characters,
+ * the tokens are replaced by integer ids and the ids are compared. The texts are never copied.
+ */
+class TokenDiff
+{
+public:
+  enum Operation {Equal, Delete, Insert};
+  /* a run of tokens, in the before text for Equal and Delete and in the after text for Insert. */
+  struct Edit {
+    Operation operation;
+    int start;
+    int count;
+  };
+  TokenDiff(const QString &before, const QString &after);
+  const QVector<Edit>& getEdits() const {return mEdits;}
+  QString toHtml() const;
+  static QString diffHtml(const QString &before, const QString &after);
+private:
+  QString mBefore;
+  QString mAfter;
+  QVector<int> mBeforeTokens;
+  QVector<int> mAfterTokens;
+  QVector<int> mBeforeOffsets;
+  QVector<int> mAfterOffsets;
+  QVector<int> mForward;
+  QVector<int> mBackward;
+  QVector<Edit> mEdits;
+
+  void tokenize();
+  void compare(int beforeStart, int beforeEnd, int afterStart, int afterEnd);
+  bool findMiddleSnake(int beforeStart, int beforeEnd, int afterStart, int afterEnd, int &snakeBefore, int &snakeAfter, int &snakeLength);
+  void addEdit(Operation operation, int start, int count);
+  void appendEscaped(QString &html, const QString &text, int start, int end) const;
+};
+
+#endif // TOKENDIFF_H
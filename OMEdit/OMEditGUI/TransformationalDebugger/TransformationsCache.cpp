@@ -0,0 +1,559 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "TransformationsCache.h"
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QVector>
+#include <string.h>
+#include <limits.h>
+
+#define TRANSFORMATIONS_CACHE_MAGIC 0x4F4D5444 /* OMTD */
+#define TRANSFORMATIONS_CACHE_VERSION 2
+#define TRANSFORMATIONS_CACHE_OPERATIONS_ENABLED 0x1
+/* all the offsets are stored as 32-bit words. */
+#define TRANSFORMATIONS_CACHE_MAXIMUM_SIZE Q_INT64_C(0xFFFFFFFF)
+
+enum OperationKind {
+  OperationInfo = 0,
+  OperationBeforeAfter = 1
+};
+
+/*!
+ * \class StringTable
+ * \brief Interns the strings written to the TransformationsCache.
+ */
+class StringTable
+{
+public:
+  StringTable() : mOverflow(false) {}
+  quint32 id(const QString &string)
+  {
+    QHash<QString, quint32>::const_iterator iterator = mIds.constFind(string);
+    if (iterator != mIds.constEnd()) {
+      return iterator.value();
+    }
+    quint32 length = string.size();
+    // the string data is kept in one QByteArray.
+    if ((qint64)mData.size() + sizeof(quint32) + (length + 1) * sizeof(QChar) > INT_MAX) {
+      mOverflow = true;
+      return 0;
+    }
+    quint32 id = mOffsets.size();
+    mIds.insert(string, id);
+    mOffsets.append(mData.size());
+    mData.append((const char*)&length, sizeof(quint32));
+    mData.append((const char*)string.constData(), length * sizeof(QChar));
+    // keep the strings aligned to 32-bit words.
+    if (length % 2) {
+      mData.append(QByteArray(sizeof(QChar), '\0'));
+    }
+    return id;
+  }
+  const QVector<quint32>& offsets() const {return mOffsets;}
+  const QByteArray& data() const {return mData;}
+  bool hasOverflow() const {return mOverflow;}
+private:
+  bool mOverflow;
+  QHash<QString, quint32> mIds;
+  QVector<quint32> mOffsets;
+  QByteArray mData;
+};
+
+static void writeStringList(QVector<quint32> &records, StringTable &strings, const QStringList &list)
+{
+  records.append(list.size());
+  foreach (const QString &string, list) {
+    records.append(strings.id(string));
+  }
+}
+
+static void writeIntegerList(QVector<quint32> &records, const QList<int> &list)
+{
+  records.append(list.size());
+  foreach (int value, list) {
+    records.append(value);
+  }
+}
+
+static void writeInfo(QVector<quint32> &records, StringTable &strings, const OMInfo &info)
+{
+  records << strings.id(info.file) << info.lineStart << info.lineEnd << info.colStart << info.colEnd << info.isValid;
+}
+
+static bool writeOperations(QVector<quint32> &records, StringTable &strings, const QList<OMOperation*> &operations)
+{
+  records.append(operations.size());
+  foreach (OMOperation *pOperation, operations) {
+    if (OMOperationBeforeAfter *pBeforeAfter = dynamic_cast<OMOperationBeforeAfter*>(pOperation)) {
+      records << OperationBeforeAfter << strings.id(pBeforeAfter->name) << strings.id(pBeforeAfter->before) << strings.id(pBeforeAfter->after);
+    } else if (OMOperationInfo *pInfo = dynamic_cast<OMOperationInfo*>(pOperation)) {
+      records << OperationInfo << strings.id(pInfo->name) << strings.id(pInfo->info);
+    } else {
+      // the model_info.json file only has the above operations.
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief TransformationsCache::TransformationsCache
+ * \param infoFileName - the model_info.json file.
+ */
+TransformationsCache::TransformationsCache(const QString &infoFileName)
+  : mInfoFileName(infoFileName)
+{
+  mpData = 0;
+  mSize = 0;
+  memset(&mHeader, 0, sizeof(Header));
+}
+
+TransformationsCache::~TransformationsCache()
+{
+  close();
+}
+
+/*!
+ * \brief TransformationsCache::open
+ * Maps the cache file. Fails if the cache file is missing, broken or out of date.
+ * \return
+ */
+bool TransformationsCache::open()
+{
+  close();
+  QFileInfo infoFileInfo(mInfoFileName);
+  mFile.setFileName(cacheFileName(mInfoFileName));
+  if (!infoFileInfo.exists() || !mFile.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  mSize = mFile.size();
+  if (mSize >= (qint64)sizeof(Header)) {
+    mpData = mFile.map(0, mSize);
+  }
+  if (!mpData) {
+    close();
+    return false;
+  }
+  memcpy(&mHeader, mpData, sizeof(Header));
+  if (mHeader.magic != TRANSFORMATIONS_CACHE_MAGIC || mHeader.version != TRANSFORMATIONS_CACHE_VERSION
+      || mHeader.sourceSize != infoFileInfo.size() || mHeader.sourceModified != infoFileInfo.lastModified().toMSecsSinceEpoch()
+      || !validateLayout()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+/*!
+ * \brief TransformationsCache::close
+ * Unmaps the cache file.
+ */
+void TransformationsCache::close()
+{
+  if (mpData) {
+    mFile.unmap(mpData);
+    mpData = 0;
+  }
+  mFile.close();
+  mSize = 0;
+  memset(&mHeader, 0, sizeof(Header));
+}
+
+/*!
+ * \brief TransformationsCache::validateLayout
+ * Checks that the sections, the string offsets and the record offsets read from the header are inside the mapped file.
+ * The file may be truncated or written by someone else, so nothing is dereferenced before it is checked here.
+ * \return
+ */
+bool TransformationsCache::validateLayout() const
+{
+  const qint64 word = sizeof(quint32);
+  if ((qint64)mHeader.stringOffsetsOffset < (qint64)sizeof(Header)
+      || (qint64)mHeader.stringOffsetsOffset + mHeader.stringsCount * word > mHeader.stringDataOffset
+      || mHeader.stringDataOffset > mHeader.variableOffsetsOffset
+      || (qint64)mHeader.variableOffsetsOffset + mHeader.variablesCount * word > mHeader.equationOffsetsOffset
+      || (qint64)mHeader.equationOffsetsOffset + mHeader.equationsCount * word > mHeader.recordsOffset
+      || mHeader.recordsOffset > mHeader.topLevelEquationsOffset
+      || (qint64)mHeader.topLevelEquationsOffset + mHeader.topLevelEquationsCount * word > mSize
+      || (mHeader.stringOffsetsOffset | mHeader.stringDataOffset | mHeader.variableOffsetsOffset | mHeader.equationOffsetsOffset
+          | mHeader.recordsOffset | mHeader.topLevelEquationsOffset) % word) {
+    return false;
+  }
+  // each string is its length followed by the characters and must end before the variable offsets.
+  const quint32 *pStringOffsets = (const quint32*)(mpData + mHeader.stringOffsetsOffset);
+  const qint64 stringDataSize = mHeader.variableOffsetsOffset - mHeader.stringDataOffset;
+  for (quint32 i = 0 ; i < mHeader.stringsCount ; i++) {
+    if (pStringOffsets[i] % word || (qint64)pStringOffsets[i] + word > stringDataSize) {
+      return false;
+    }
+    const quint32 length = *(const quint32*)(mpData + mHeader.stringDataOffset + pStringOffsets[i]);
+    if ((qint64)pStringOffsets[i] + word + (qint64)length * sizeof(QChar) > stringDataSize) {
+      return false;
+    }
+  }
+  // the records themselves are checked while they are decoded, here only their start offsets.
+  const qint64 recordsSize = mHeader.topLevelEquationsOffset - mHeader.recordsOffset;
+  const quint32 *pVariableOffsets = (const quint32*)(mpData + mHeader.variableOffsetsOffset);
+  for (quint32 i = 0 ; i < mHeader.variablesCount ; i++) {
+    if (pVariableOffsets[i] % word || pVariableOffsets[i] >= recordsSize) {
+      return false;
+    }
+  }
+  const quint32 *pEquationOffsets = (const quint32*)(mpData + mHeader.equationOffsetsOffset);
+  for (quint32 i = 0 ; i < mHeader.equationsCount ; i++) {
+    if (pEquationOffsets[i] % word || pEquationOffsets[i] >= recordsSize) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TransformationsCache::hasOperationsEnabled() const
+{
+  return mHeader.flags & TRANSFORMATIONS_CACHE_OPERATIONS_ENABLED;
+}
+
+int TransformationsCache::variablesCount() const
+{
+  return mHeader.variablesCount;
+}
+
+int TransformationsCache::equationsCount() const
+{
+  return mHeader.equationsCount;
+}
+
+/*!
+ * \brief TransformationsCache::readVariables
+ * Decodes all the variables.
+ * \param variables
+ * \return false if a variable record does not fit in the file.
+ */
+bool TransformationsCache::readVariables(QHash<QString, OMVariable> &variables) const
+{
+  for (int i = 0 ; i < variablesCount() ; i++) {
+    const quint32 *pRecord = record(mHeader.variableOffsetsOffset, i);
+    if (!hasWords(pRecord, 3)) {
+      return false;
+    }
+    /* fill the hash item directly since the OMVariable copy constructor copies the operations. */
+    OMVariable &variable = variables[readString(*pRecord++)];
+    variable.name = readString(*pRecord++);
+    variable.comment = readString(*pRecord++);
+    pRecord = readInfo(pRecord, variable.info);
+    pRecord = readStringList(pRecord, variable.types);
+    pRecord = readIntegerList(pRecord, variable.definedIn);
+    pRecord = readIntegerList(pRecord, variable.usedIn);
+    if (!readOperations(pRecord, variable.ops)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief TransformationsCache::readEquation
+ * Decodes the equation. The caller takes the ownership of the returned equation.
+ * \param index
+ * \return 0 if the index is out of range or the equation record does not fit in the file.
+ */
+OMEquation* TransformationsCache::readEquation(int index) const
+{
+  if (index < 0 || index >= equationsCount()) {
+    return 0;
+  }
+  const quint32 *pRecord = record(mHeader.equationOffsetsOffset, index);
+  if (!hasWords(pRecord, 5)) {
+    return 0;
+  }
+  OMEquation *pEquation = new OMEquation();
+  pEquation->section = readString(*pRecord++);
+  pEquation->index = *pRecord++;
+  pEquation->parent = *pRecord++;
+  pEquation->tag = readString(*pRecord++);
+  pEquation->display = readString(*pRecord++);
+  pRecord = readStringList(pRecord, pEquation->text);
+  pRecord = readInfo(pRecord, pEquation->info);
+  pRecord = readStringList(pRecord, pEquation->types);
+  pRecord = readStringList(pRecord, pEquation->defines);
+  pRecord = readStringList(pRecord, pEquation->depends);
+  pRecord = readIntegerList(pRecord, pEquation->eqs);
+  if (!readOperations(pRecord, pEquation->ops)) {
+    delete pEquation;
+    return 0;
+  }
+  return pEquation;
+}
+
+/*!
+ * \brief TransformationsCache::readEquationSection
+ * Returns the section of the equation without decoding the rest of it.
+ * \param index
+ * \return
+ */
+QString TransformationsCache::readEquationSection(int index) const
+{
+  if (index < 0 || index >= equationsCount()) {
+    return QString();
+  }
+  // open() has checked that every record offset is inside the records section.
+  return readString(*record(mHeader.equationOffsetsOffset, index));
+}
+
+/*!
+ * \brief TransformationsCache::readTopLevelEquations
+ * Returns the indexes of the equations which are not nested in other equations.
+ * \return
+ */
+QList<int> TransformationsCache::readTopLevelEquations() const
+{
+  QList<int> equations;
+  const quint32 *pEquations = (const quint32*)(mpData + mHeader.topLevelEquationsOffset);
+  equations.reserve(mHeader.topLevelEquationsCount);
+  for (quint32 i = 0 ; i < mHeader.topLevelEquationsCount ; i++) {
+    equations.append(pEquations[i]);
+  }
+  return equations;
+}
+
+/*!
+ * \brief TransformationsCache::write
+ * Writes the cache file for the current state of the info file.
+ * Nothing is written if the data does not fit in the 32-bit offsets of the cache file.
+ * \param variables
+ * \param equations
+ * \param hasOperationsEnabled
+ * \return
+ */
+bool TransformationsCache::write(const QHash<QString, OMVariable> &variables, const QList<OMEquation*> &equations, bool hasOperationsEnabled)
+{
+  close();
+  QFileInfo infoFileInfo(mInfoFileName);
+  if (!infoFileInfo.exists()) {
+    return false;
+  }
+  StringTable strings;
+  QVector<quint32> records;
+  QVector<quint32> variableOffsets;
+  QVector<quint32> equationOffsets;
+  QVector<quint32> topLevelEquations;
+  variableOffsets.reserve(variables.size());
+  equationOffsets.reserve(equations.size());
+  QHash<QString, OMVariable>::const_iterator iterator;
+  for (iterator = variables.constBegin() ; iterator != variables.constEnd() ; ++iterator) {
+    const OMVariable &variable = iterator.value();
+    if (strings.hasOverflow() || (qint64)records.size() * sizeof(quint32) > TRANSFORMATIONS_CACHE_MAXIMUM_SIZE) {
+      return false;
+    }
+    variableOffsets.append(records.size() * sizeof(quint32));
+    records << strings.id(iterator.key()) << strings.id(variable.name) << strings.id(variable.comment);
+    writeInfo(records, strings, variable.info);
+    writeStringList(records, strings, variable.types);
+    writeIntegerList(records, variable.definedIn);
+    writeIntegerList(records, variable.usedIn);
+    if (!writeOperations(records, strings, variable.ops)) {
+      return false;
+    }
+  }
+  foreach (OMEquation *pEquation, equations) {
+    // the first equation is a placeholder for index 0.
+    if (pEquation->index > 0 && !pEquation->parent) {
+      topLevelEquations.append(pEquation->index);
+    }
+    if (strings.hasOverflow() || (qint64)records.size() * sizeof(quint32) > TRANSFORMATIONS_CACHE_MAXIMUM_SIZE) {
+      return false;
+    }
+    equationOffsets.append(records.size() * sizeof(quint32));
+    records << strings.id(pEquation->section) << pEquation->index << pEquation->parent << strings.id(pEquation->tag)
+            << strings.id(pEquation->display);
+    writeStringList(records, strings, pEquation->text);
+    writeInfo(records, strings, pEquation->info);
+    writeStringList(records, strings, pEquation->types);
+    writeStringList(records, strings, pEquation->defines);
+    writeStringList(records, strings, pEquation->depends);
+    writeIntegerList(records, pEquation->eqs);
+    if (!writeOperations(records, strings, pEquation->ops)) {
+      return false;
+    }
+  }
+  /* reject the data if any offset of the layout does not fit in 32 bits. */
+  qint64 size = sizeof(Header) + (qint64)strings.offsets().size() * sizeof(quint32) + strings.data().size()
+      + ((qint64)variableOffsets.size() + equationOffsets.size() + records.size() + topLevelEquations.size()) * sizeof(quint32);
+  if (strings.hasOverflow() || size > TRANSFORMATIONS_CACHE_MAXIMUM_SIZE) {
+    return false;
+  }
+  Header header;
+  memset(&header, 0, sizeof(Header));
+  header.magic = TRANSFORMATIONS_CACHE_MAGIC;
+  header.version = TRANSFORMATIONS_CACHE_VERSION;
+  header.sourceSize = infoFileInfo.size();
+  header.sourceModified = infoFileInfo.lastModified().toMSecsSinceEpoch();
+  header.flags = hasOperationsEnabled ? TRANSFORMATIONS_CACHE_OPERATIONS_ENABLED : 0;
+  header.stringsCount = strings.offsets().size();
+  header.stringOffsetsOffset = sizeof(Header);
+  header.stringDataOffset = header.stringOffsetsOffset + header.stringsCount * sizeof(quint32);
+  header.variablesCount = variableOffsets.size();
+  header.variableOffsetsOffset = header.stringDataOffset + strings.data().size();
+  header.equationsCount = equationOffsets.size();
+  header.equationOffsetsOffset = header.variableOffsetsOffset + header.variablesCount * sizeof(quint32);
+  header.recordsOffset = header.equationOffsetsOffset + header.equationsCount * sizeof(quint32);
+  header.topLevelEquationsCount = topLevelEquations.size();
+  header.topLevelEquationsOffset = header.recordsOffset + records.size() * sizeof(quint32);
+  QFile file(cacheFileName(mInfoFileName));
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+  /* write an empty header first so that a partially written file is never valid. */
+  Header emptyHeader;
+  memset(&emptyHeader, 0, sizeof(Header));
+  bool success = file.write((const char*)&emptyHeader, sizeof(Header)) == sizeof(Header);
+  success = success && file.write((const char*)strings.offsets().constData(), header.stringsCount * sizeof(quint32)) >= 0;
+  success = success && file.write(strings.data()) >= 0;
+  success = success && file.write((const char*)variableOffsets.constData(), header.variablesCount * sizeof(quint32)) >= 0;
+  success = success && file.write((const char*)equationOffsets.constData(), header.equationsCount * sizeof(quint32)) >= 0;
+  success = success && file.write((const char*)records.constData(), records.size() * sizeof(quint32)) >= 0;
+  success = success && file.write((const char*)topLevelEquations.constData(), header.topLevelEquationsCount * sizeof(quint32)) >= 0;
+  success = success && file.seek(0) && file.write((const char*)&header, sizeof(Header)) == sizeof(Header);
+  file.close();
+  if (!success) {
+    file.remove();
+  }
+  return success;
+}
+
+QString TransformationsCache::readString(quint32 id) const
+{
+  if (id >= mHeader.stringsCount) {
+    return QString();
+  }
+  // open() has checked that every string is inside the string data.
+  const quint32 *pOffsets = (const quint32*)(mpData + mHeader.stringOffsetsOffset);
+  const quint32 *pString = (const quint32*)(mpData + mHeader.stringDataOffset + pOffsets[id]);
+  return QString((const QChar*)(pString + 1), *pString);
+}
+
+/*!
+ * \brief TransformationsCache::hasWords
+ * Checks that count words starting at pRecord are inside the records section.
+ * The record decoders return 0 when their record does not fit, which the following decoders pass on.
+ * \param pRecord
+ * \param count
+ * \return
+ */
+bool TransformationsCache::hasWords(const quint32 *pRecord, qint64 count) const
+{
+  if (!pRecord) {
+    return false;
+  }
+  const qint64 offset = (const uchar*)pRecord - mpData;
+  return offset >= mHeader.recordsOffset && offset + count * (qint64)sizeof(quint32) <= mHeader.topLevelEquationsOffset;
+}
+
+const quint32* TransformationsCache::readStringList(const quint32 *pRecord, QStringList &strings) const
+{
+  if (!hasWords(pRecord, 1) || !hasWords(pRecord + 1, *pRecord)) {
+    return 0;
+  }
+  quint32 size = *pRecord++;
+  for (quint32 i = 0 ; i < size ; i++) {
+    strings.append(readString(*pRecord++));
+  }
+  return pRecord;
+}
+
+const quint32* TransformationsCache::readIntegerList(const quint32 *pRecord, QList<int> &integers) const
+{
+  if (!hasWords(pRecord, 1) || !hasWords(pRecord + 1, *pRecord)) {
+    return 0;
+  }
+  quint32 size = *pRecord++;
+  integers.reserve(size);
+  for (quint32 i = 0 ; i < size ; i++) {
+    integers.append((int)*pRecord++);
+  }
+  return pRecord;
+}
+
+const quint32* TransformationsCache::readInfo(const quint32 *pRecord, OMInfo &info) const
+{
+  if (!hasWords(pRecord, 6)) {
+    return 0;
+  }
+  info.file = readString(*pRecord++);
+  info.lineStart = *pRecord++;
+  info.lineEnd = *pRecord++;
+  info.colStart = *pRecord++;
+  info.colEnd = *pRecord++;
+  info.isValid = *pRecord++;
+  return pRecord;
+}
+
+const quint32* TransformationsCache::readOperations(const quint32 *pRecord, QList<OMOperation*> &operations) const
+{
+  if (!hasWords(pRecord, 1)) {
+    return 0;
+  }
+  quint32 size = *pRecord++;
+  for (quint32 i = 0 ; i < size ; i++) {
+    if (!hasWords(pRecord, 1)) {
+      return 0;
+    }
+    quint32 kind = *pRecord++;
+    if (kind == OperationBeforeAfter) {
+      if (!hasWords(pRecord, 3)) {
+        return 0;
+      }
+      QString name = readString(*pRecord++);
+      QStringList beforeAfter;
+      beforeAfter << readString(pRecord[0]) << readString(pRecord[1]);
+      pRecord += 2;
+      operations.append(new OMOperationBeforeAfter(name, beforeAfter));
+    } else {
+      if (!hasWords(pRecord, 2)) {
+        return 0;
+      }
+      QString name = readString(*pRecord++);
+      operations.append(new OMOperationInfo(name, readString(*pRecord++)));
+    }
+  }
+  return pRecord;
+}
+
+const quint32* TransformationsCache::record(quint32 offsetsOffset, int index) const
+{
+  const quint32 *pOffsets = (const quint32*)(mpData + offsetsOffset);
+  return (const quint32*)(mpData + mHeader.recordsOffset + pOffsets[index]);
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef TRANSFORMATIONSCACHE_H
+#define TRANSFORMATIONSCACHE_H
+
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+
+#include "OMDumpXML.h"
+
+/*!
+ * \class TransformationsCache
+ * \brief Binary index of the transformational debugger data, stored next to the model_info.json file.
+ * All strings are interned in a string table and the variables and equations are stored as records of 32-bit words
+ * which refer to the strings by their ids. The file is memory mapped and the records are decoded on demand.
+ * The cache is only valid for the size and modification time of the info file it is written for.
+ * All the offsets and sizes read from the file are checked against the mapped size before they are used.
+ */
+class TransformationsCache
+{
+public:
+  TransformationsCache(const QString &infoFileName);
+  ~TransformationsCache();
+  static QString cacheFileName(const QString &infoFileName) {return infoFileName + ".cache";}
+  bool open();
+  void close();
+  bool isOpen() const {return mpData != 0;}
+  bool hasOperationsEnabled() const;
+  int variablesCount() const;
+  int equationsCount() const;
+  bool readVariables(QHash<QString, OMVariable> &variables) const;
+  OMEquation* readEquation(int index) const;
+  QString readEquationSection(int index) const;
+  QList<int> readTopLevelEquations() const;
+  bool write(const QHash<QString, OMVariable> &variables, const QList<OMEquation*> &equations, bool hasOperationsEnabled);
+private:
+  struct Header {
+    quint32 magic;
+    quint32 version;
+    qint64 sourceSize;
+    qint64 sourceModified;
+    quint32 flags;
+    quint32 stringsCount;
+    quint32 stringOffsetsOffset;
+    quint32 stringDataOffset;
+    quint32 variablesCount;
+    quint32 variableOffsetsOffset;
+    quint32 equationsCount;
+    quint32 equationOffsetsOffset;
+    quint32 recordsOffset;
+    quint32 topLevelEquationsCount;
+    quint32 topLevelEquationsOffset;
+    quint32 padding;
+  };
+  QString mInfoFileName;
+  QFile mFile;
+  uchar *mpData;
+  qint64 mSize;
+  Header mHeader;
+
+  bool validateLayout() const;
+  bool hasWords(const quint32 *pRecord, qint64 count) const;
+  QString readString(quint32 id) const;
+  const quint32* readStringList(const quint32 *pRecord, QStringList &strings) const;
+  const quint32* readIntegerList(const quint32 *pRecord, QList<int> &integers) const;
+  const quint32* readInfo(const quint32 *pRecord, OMInfo &info) const;
+  const quint32* readOperations(const quint32 *pRecord, QList<OMOperation*> &operations) const;
+  const quint32* record(quint32 offsetsOffset, int index) const;
+};
+
+#endif // TRANSFORMATIONSCACHE_H
@@ -33,7 +33,8 @@
  */
 
 #include "TransformationsWidget.h"
-#include <qjson/parser.h>
+#include <qjson/streamreader.h>
+#include <QtConcurrentRun>
 
 /*!
   \class TVariablesTreeItem
@@ -408,6 +409,38 @@ TVariablesTreeView::TVariablesTreeView(TransformationsWidget *pTransformationsWi
   sortByColumn(0, Qt::AscendingOrder);
   setExpandsOnDoubleClick(false);
   setUniformRowHeights(true);
+  setContextMenuPolicy(Qt::CustomContextMenu);
+  mpShowAffectedEquationsAction = new QAction(tr("Show Affected Equations"), this);
+  mpShowAffectedEquationsAction->setStatusTip(tr("Shows the equations which are transitively affected by the variable"));
+  connect(mpShowAffectedEquationsAction, SIGNAL(triggered()), SLOT(showAffectedEquations()));
+  connect(this, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
+}
+
+/*!
+ * \brief TVariablesTreeView::showContextMenu
+ * Shows a context menu when user right click on the variables browser.
+ * \param point
+ */
+void TVariablesTreeView::showContextMenu(QPoint point)
+{
+  QModelIndex index = indexAt(point);
+  if (!index.isValid()) {
+    return;
+  }
+  setCurrentIndex(index);
+  mpShowAffectedEquationsAction->setEnabled(!mpTransformationsWidget->isLoading());
+  QMenu menu(this);
+  menu.addAction(mpShowAffectedEquationsAction);
+  menu.exec(viewport()->mapToGlobal(point));
+}
+
+/*!
+ * \brief TVariablesTreeView::showAffectedEquations
+ * Slot activated when mpShowAffectedEquationsAction triggered signal is raised.
+ */
+void TVariablesTreeView::showAffectedEquations()
+{
+  mpTransformationsWidget->showAffectedEquations(currentIndex());
 }
 
 EquationTreeWidget::EquationTreeWidget(TransformationsWidget *pTransformationWidget)
@@ -433,15 +466,493 @@ EquationTreeWidget::EquationTreeWidget(TransformationsWidget *pTransformationWid
   connect(this, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)), mpTransformationWidget, SLOT(fetchEquationData(QTreeWidgetItem*,int)));
 }
 
+/*!
+ * \class EquationLessThan
+ * \brief Compares the equations by a column of the EquationTreeModel.
+ * The equation text column is sorted on precomputed keys instead, see EquationTreeModel::sort.
+ */
+class EquationLessThan
+{
+public:
+  EquationLessThan(TransformationsWidget *pTransformationsWidget, int column, Qt::SortOrder order)
+    : mpTransformationsWidget(pTransformationsWidget), mColumn(column), mOrder(order) {}
+  bool operator()(int equationIndex1, int equationIndex2) const
+  {
+    return mOrder == Qt::AscendingOrder ? lessThan(equationIndex1, equationIndex2) : lessThan(equationIndex2, equationIndex1);
+  }
+private:
+  TransformationsWidget *mpTransformationsWidget;
+  int mColumn;
+  Qt::SortOrder mOrder;
+
+  bool lessThan(int equationIndex1, int equationIndex2) const
+  {
+    if (mColumn == 0) {
+      return equationIndex1 < equationIndex2;
+    }
+    OMEquation *pEquation1 = mpTransformationsWidget->getEquation(equationIndex1);
+    OMEquation *pEquation2 = mpTransformationsWidget->getEquation(equationIndex2);
+    // equations that can't be read come first.
+    if (!pEquation1 || !pEquation2) {
+      return !pEquation1 && pEquation2;
+    }
+    if (mColumn == 1) {
+      return pEquation1->section < pEquation2->section;
+    }
+    // equations without profiling information come first.
+    if (pEquation1->profileBlock < 0 || pEquation2->profileBlock < 0) {
+      return pEquation1->profileBlock < 0 && pEquation2->profileBlock >= 0;
+    }
+    switch (mColumn) {
+      case 3:
+        return pEquation1->ncall < pEquation2->ncall;
+      case 4:
+        return pEquation1->maxTime < pEquation2->maxTime;
+      case 5:
+        return pEquation1->time < pEquation2->time;
+      default:
+        return pEquation1->fraction < pEquation2->fraction;
+    }
+  }
+};
+
+/*!
+ * \brief equationTextLessThan
+ * Compares the equation texts of the sort keys built by EquationTreeModel::sort.
+ */
+static bool equationTextLessThan(const QPair<QString, int> &equation1, const QPair<QString, int> &equation2)
+{
+  return equation1.first < equation2.first;
+}
+
+static bool equationTextGreaterThan(const QPair<QString, int> &equation1, const QPair<QString, int> &equation2)
+{
+  return equation2.first < equation1.first;
+}
+
+/*!
+ * \class EquationTreeModel
+ * \brief Model of the equations browser.
+ * The rows refer to the equations by their index and the row data is formatted only when it is requested.
+ * The row of an equation within its parent is stored so that the equations can be found in constant time.
+ */
+/*!
+ * \brief EquationTreeModel::EquationTreeModel
+ * \param pTransformationsWidget
+ */
+EquationTreeModel::EquationTreeModel(TransformationsWidget *pTransformationsWidget)
+  : QAbstractItemModel(pTransformationsWidget), mpTransformationsWidget(pTransformationsWidget)
+{
+}
+
+int EquationTreeModel::columnCount(const QModelIndex &parent) const
+{
+  Q_UNUSED(parent);
+  return 7;
+}
+
+int EquationTreeModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.column() > 0) {
+    return 0;
+  }
+  if (!parent.isValid()) {
+    return mTopLevelEquations.size();
+  }
+  OMEquation *pEquation = mpTransformationsWidget->getEquation(equationIndex(parent));
+  return pEquation ? pEquation->eqs.size() : 0;
+}
+
+QVariant EquationTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+  switch (section) {
+    case 0:
+      return Helper::index;
+    case 1:
+      return Helper::type;
+    case 2:
+      return Helper::equation;
+    case 3:
+      return Helper::executionCount;
+    case 4:
+      return Helper::executionMaxTime;
+    case 5:
+      return Helper::executionTime;
+    case 6:
+      return Helper::executionFraction;
+    default:
+      return QVariant();
+  }
+}
+
+QModelIndex EquationTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+  if (!hasIndex(row, column, parent)) {
+    return QModelIndex();
+  }
+  int equation;
+  if (!parent.isValid()) {
+    equation = mTopLevelEquations.at(row);
+  } else {
+    OMEquation *pParentEquation = mpTransformationsWidget->getEquation(equationIndex(parent));
+    if (!pParentEquation || row >= pParentEquation->eqs.size()) {
+      return QModelIndex();
+    }
+    equation = pParentEquation->eqs.at(row);
+    if (equation >= 0 && equation < mRows.size()) {
+      mRows[equation] = row;
+    }
+  }
+  return createIndex(row, column, equation);
+}
+
+QModelIndex EquationTreeModel::parent(const QModelIndex &index) const
+{
+  if (!index.isValid()) {
+    return QModelIndex();
+  }
+  OMEquation *pEquation = mpTransformationsWidget->getEquation(equationIndex(index));
+  if (!pEquation || pEquation->parent <= 0) {
+    return QModelIndex();
+  }
+  return createIndex(equationRow(pEquation->parent), 0, pEquation->parent);
+}
+
+QVariant EquationTreeModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid()) {
+    return QVariant();
+  }
+  OMEquation *pEquation = mpTransformationsWidget->getEquation(equationIndex(index));
+  if (!pEquation) {
+    return QVariant();
+  }
+  switch (role) {
+    case Qt::DisplayRole:
+      switch (index.column()) {
+        case 0:
+          return QString::number(pEquation->index);
+        case 1:
+          return pEquation->section;
+        case 2:
+          return pEquation->toString();
+        case 3:
+          return pEquation->profileBlock >= 0 ? QString::number(pEquation->ncall) : QVariant();
+        case 4:
+          return pEquation->profileBlock >= 0 ? QString::number(pEquation->maxTime, 'g', 3) : QVariant();
+        case 5:
+          return pEquation->profileBlock >= 0 ? QString::number(pEquation->time, 'g', 3) : QVariant();
+        case 6:
+          return pEquation->profileBlock >= 0 ? QString::number(100 * pEquation->fraction, 'g', 3) + "%" : QVariant();
+        default:
+          return QVariant();
+      }
+    case Qt::ToolTipRole:
+      switch (index.column()) {
+        case 0:
+          return QString::number(pEquation->index);
+        case 1:
+          return pEquation->section;
+        case 2:
+          return "<html><div style=\"margin:3px;\">" +
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+              pEquation->toString().toHtmlEscaped()
+#else /* Qt4 */
+              Qt::escape(pEquation->toString())
+#endif
+              + "</div></html>";
+        case 4:
+          return tr("Maximum execution time in a single step");
+        case 5:
+          return tr("Total time excluding the overhead of measuring.");
+        case 6:
+          return tr("Fraction of time, 100% is the total time of all non-child equations.");
+        default:
+          return QVariant();
+      }
+    default:
+      return QVariant();
+  }
+}
+
+Qt::ItemFlags EquationTreeModel::flags(const QModelIndex &index) const
+{
+  if (!index.isValid()) {
+    return 0;
+  }
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+/*!
+ * \brief EquationTreeModel::sort
+ * Sorts the top level equations. The nested equations are kept in their order.
+ * The equation texts are formatted once per sort instead of in every comparison.
+ * \param column
+ * \param order
+ */
+void EquationTreeModel::sort(int column, Qt::SortOrder order)
+{
+  emit layoutAboutToBeChanged();
+  if (column == 2) {
+    QVector<QPair<QString, int> > keys;
+    keys.reserve(mTopLevelEquations.size());
+    foreach (int equation, mTopLevelEquations) {
+      OMEquation *pEquation = mpTransformationsWidget->getEquation(equation);
+      keys.append(qMakePair(pEquation ? pEquation->toString() : QString(), equation));
+    }
+    qStableSort(keys.begin(), keys.end(), order == Qt::AscendingOrder ? equationTextLessThan : equationTextGreaterThan);
+    for (int row = 0 ; row < keys.size() ; row++) {
+      mTopLevelEquations[row] = keys.at(row).second;
+    }
+  } else {
+    qStableSort(mTopLevelEquations.begin(), mTopLevelEquations.end(), EquationLessThan(mpTransformationsWidget, column, order));
+  }
+  for (int row = 0 ; row < mTopLevelEquations.size() ; row++) {
+    mRows[mTopLevelEquations.at(row)] = row;
+  }
+  QModelIndexList fromIndexes = persistentIndexList();
+  QModelIndexList toIndexes;
+  foreach (QModelIndex index, fromIndexes) {
+    toIndexes.append(createIndex(equationRow(equationIndex(index)), index.column(), equationIndex(index)));
+  }
+  changePersistentIndexList(fromIndexes, toIndexes);
+  emit layoutChanged();
+}
+
+/*!
+ * \brief EquationTreeModel::equationIndex
+ * Returns the equation index of the model index.
+ * \param index
+ * \return
+ */
+int EquationTreeModel::equationIndex(const QModelIndex &index) const
+{
+  return index.isValid() ? (int)index.internalId() : -1;
+}
+
+/*!
+ * \brief EquationTreeModel::equationModelIndex
+ * Returns the model index of the equation.
+ * \param equationIndex
+ * \return
+ */
+QModelIndex EquationTreeModel::equationModelIndex(int equationIndex) const
+{
+  if (equationIndex <= 0 || equationIndex >= mRows.size()) {
+    return QModelIndex();
+  }
+  int row = equationRow(equationIndex);
+  return row < 0 ? QModelIndex() : createIndex(row, 0, equationIndex);
+}
+
+/*!
+ * \brief EquationTreeModel::insertEquations
+ * Appends the top level equations.
+ * \param equations
+ */
+void EquationTreeModel::insertEquations(const QList<int> &equations)
+{
+  /* resize even for an empty batch, the nested equations read so far need their rows too. */
+  mRows.resize(mpTransformationsWidget->getEquationsCount());
+  if (equations.isEmpty()) {
+    return;
+  }
+  int row = mTopLevelEquations.size();
+  beginInsertRows(QModelIndex(), row, row + equations.size() - 1);
+  foreach (int equation, equations) {
+    if (equation >= 0 && equation < mRows.size()) {
+      mRows[equation] = mTopLevelEquations.size();
+    }
+    mTopLevelEquations.append(equation);
+  }
+  endInsertRows();
+}
+
+/*!
+ * \brief EquationTreeModel::insertNestedEquations
+ * Adds the nested equations to their parents once all the equations are read.
+ * The model is reset since the parents of any level may get their nested equations at once.
+ */
+void EquationTreeModel::insertNestedEquations()
+{
+  beginResetModel();
+  mRows.resize(mpTransformationsWidget->getEquationsCount());
+  for (int i = 1 ; i < mRows.size() ; i++) {
+    OMEquation *pEquation = mpTransformationsWidget->getEquation(i);
+    int parent = pEquation ? pEquation->parent : 0;
+    if (parent > 0 && parent < mRows.size()) {
+      OMEquation *pParentEquation = mpTransformationsWidget->getEquation(parent);
+      if (pParentEquation) {
+        mRows[i] = pParentEquation->eqs.size();
+        pParentEquation->eqs << i;
+      }
+    }
+  }
+  endResetModel();
+}
+
+/*!
+ * \brief EquationTreeModel::clearEquations
+ * Removes all the equations.
+ */
+void EquationTreeModel::clearEquations()
+{
+  beginResetModel();
+  mTopLevelEquations.clear();
+  mRows.clear();
+  endResetModel();
+}
+
+/*!
+ * \brief EquationTreeModel::equationRow
+ * Returns the row of the equation within its parent.
+ * The row of a nested equation is looked up once in the equations of its parent and stored.
+ * \param equationIndex
+ * \return
+ */
+int EquationTreeModel::equationRow(int equationIndex) const
+{
+  if (equationIndex < 0 || equationIndex >= mRows.size()) {
+    return -1;
+  }
+  OMEquation *pEquation = mpTransformationsWidget->getEquation(equationIndex);
+  if (!pEquation || pEquation->parent <= 0) {
+    return mRows[equationIndex];
+  }
+  OMEquation *pParentEquation = mpTransformationsWidget->getEquation(pEquation->parent);
+  int row = mRows[equationIndex];
+  if (!pParentEquation || row < 0 || row >= pParentEquation->eqs.size() || pParentEquation->eqs.at(row) != equationIndex) {
+    row = pParentEquation ? pParentEquation->eqs.indexOf(equationIndex) : -1;
+    mRows[equationIndex] = row;
+  }
+  return row;
+}
+
+/*!
+ * \class EquationTreeView
+ * \brief View of the equations browser.
+ */
+/*!
+ * \brief EquationTreeView::EquationTreeView
+ * \param pTransformationsWidget
+ */
+EquationTreeView::EquationTreeView(TransformationsWidget *pTransformationsWidget)
+  : QTreeView(pTransformationsWidget), mpTransformationsWidget(pTransformationsWidget)
+{
+  setItemDelegate(new ItemDelegate(this));
+  setIndentation(Helper::treeIndentation);
+  setTextElideMode(Qt::ElideMiddle);
+  setUniformRowHeights(true);
+  setExpandsOnDoubleClick(false);
+  setSortingEnabled(true);
+  sortByColumn(0, Qt::AscendingOrder);
+  setContextMenuPolicy(Qt::CustomContextMenu);
+  mpShowStronglyConnectedEquationsAction = new QAction(tr("Show Strongly Connected Equations"), this);
+  mpShowStronglyConnectedEquationsAction->setStatusTip(tr("Shows the equations of the strongly connected block containing the equation"));
+  connect(mpShowStronglyConnectedEquationsAction, SIGNAL(triggered()), SLOT(showStronglyConnectedEquations()));
+  connect(this, SIGNAL(customContextMenuRequested(QPoint)), SLOT(showContextMenu(QPoint)));
+  connect(this, SIGNAL(doubleClicked(QModelIndex)), mpTransformationsWidget, SLOT(fetchEquationData(QModelIndex)));
+}
+
+/*!
+ * \brief EquationTreeView::showContextMenu
+ * Shows a context menu when user right click on the equations browser.
+ * \param point
+ */
+void EquationTreeView::showContextMenu(QPoint point)
+{
+  QModelIndex index = indexAt(point);
+  if (!index.isValid()) {
+    return;
+  }
+  setCurrentIndex(index);
+  mpShowStronglyConnectedEquationsAction->setEnabled(!mpTransformationsWidget->isLoading());
+  QMenu menu(this);
+  menu.addAction(mpShowStronglyConnectedEquationsAction);
+  menu.exec(viewport()->mapToGlobal(point));
+}
+
+/*!
+ * \brief EquationTreeView::showStronglyConnectedEquations
+ * Slot activated when mpShowStronglyConnectedEquationsAction triggered signal is raised.
+ */
+void EquationTreeView::showStronglyConnectedEquations()
+{
+  mpTransformationsWidget->showStronglyConnectedEquations(currentIndex());
+}
+
+/*!
+ * \class DependentEquationsDialog
+ * \brief Lists the equations found by an EquationDependencyGraph query.
+ * Double clicking an equation selects it in the equations browser.
+ */
+/*!
+ * \brief DependentEquationsDialog::DependentEquationsDialog
+ * \param title
+ * \param description
+ * \param equations
+ * \param pTransformationsWidget
+ */
+DependentEquationsDialog::DependentEquationsDialog(QString title, QString description, QList<int> equations,
+                                                   TransformationsWidget *pTransformationsWidget)
+  : QDialog(pTransformationsWidget, Qt::WindowTitleHint), mpTransformationsWidget(pTransformationsWidget)
+{
+  setAttribute(Qt::WA_DeleteOnClose);
+  setWindowTitle(QString(Helper::applicationName).append(" - ").append(title));
+  setMinimumSize(600, 400);
+  /* only list the first equations. The large models have hundreds of thousands of them. */
+  const int maximumEquations = 10000;
+  if (equations.size() > maximumEquations) {
+    description.append(" ").append(tr("Showing the first %1 equations.").arg(maximumEquations));
+  }
+  mpDescriptionLabel = new Label(description);
+  mpDescriptionLabel->setWordWrap(true);
+  mpEquationsTreeWidget = new EquationTreeWidget(mpTransformationsWidget);
+  mpEquationsTreeWidget->setSortingEnabled(false);
+  QList<QTreeWidgetItem*> items;
+  for (int i = 0 ; i < equations.size() && i < maximumEquations ; i++) {
+    OMEquation *pEquation = mpTransformationsWidget->getEquation(equations.at(i));
+    if (!pEquation) {
+      continue;
+    }
+    QStringList values;
+    values << QString::number(equations.at(i)) << pEquation->section << pEquation->toString();
+    QTreeWidgetItem *pEquationTreeItem = new IntegerTreeWidgetItem(values, mpEquationsTreeWidget);
+    pEquationTreeItem->setToolTip(0, values[0]);
+    pEquationTreeItem->setToolTip(1, values[1]);
+    pEquationTreeItem->setToolTip(2, values[2]);
+    items.append(pEquationTreeItem);
+  }
+  mpEquationsTreeWidget->addTopLevelItems(items);
+  mpEquationsTreeWidget->setSortingEnabled(true);
+  // buttons
+  mpCloseButton = new QPushButton(Helper::close);
+  mpCloseButton->setAutoDefault(true);
+  connect(mpCloseButton, SIGNAL(clicked()), SLOT(reject()));
+  mpButtonBox = new QDialogButtonBox(Qt::Horizontal);
+  mpButtonBox->addButton(mpCloseButton, QDialogButtonBox::ActionRole);
+  // layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->addWidget(mpDescriptionLabel, 0, 0);
+  pMainLayout->addWidget(mpEquationsTreeWidget, 1, 0);
+  pMainLayout->addWidget(mpButtonBox, 2, 0, Qt::AlignRight);
+  setLayout(pMainLayout);
+}
+
 TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainWindow *pMainWindow)
   : mpMainWindow(pMainWindow), mInfoJSONFullFileName(infoJSONFullFileName)
 {
   if (!mInfoJSONFullFileName.endsWith("_info.json")) {
     mProfJSONFullFileName = "";
     mProfilingDataRealFileName = "";
+    mProfilingDataIntFileName = "";
   } else {
     mProfJSONFullFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.json";
     mProfilingDataRealFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.realdata";
+    mProfilingDataIntFileName = infoJSONFullFileName.left(infoJSONFullFileName.size() - 9) + "prof.intdata";
   }
   setWindowIcon(QIcon(":/Resources/icons/equational-debugger.svg"));
   setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::transformationalDebugger));
@@ -450,6 +961,16 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   pReloadToolButton->setAutoRaise(true);
   pReloadToolButton->setIcon(QIcon(":/Resources/icons/refresh.svg"));
   connect(pReloadToolButton, SIGNAL(clicked()), SLOT(reloadTransformations()));
+  mpInfoXMLFileHandler = 0;
+  mpInfoJSONReader = 0;
+  mpTransformationsCache = 0;
+  mPendingEquationIndex = -1;
+  /* info json reading progress bar */
+  mpInfoJSONProgressBar = new QProgressBar;
+  mpInfoJSONProgressBar->setRange(0, 100);
+  mpInfoJSONProgressBar->setMaximumWidth(150);
+  mpInfoJSONProgressBar->setTextVisible(false);
+  mpInfoJSONProgressBar->hide();
   /* info xml file path label */
   Label *pInfoXMLFilePathLabel = new Label(mInfoJSONFullFileName, this);
   pInfoXMLFilePathLabel->setElideMode(Qt::ElideMiddle);
@@ -459,6 +980,7 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   pStatusBar->setSizeGripEnabled(false);
   pStatusBar->addPermanentWidget(pReloadToolButton, 0);
   pStatusBar->addPermanentWidget(pInfoXMLFilePathLabel, 1);
+  pStatusBar->addPermanentWidget(mpInfoJSONProgressBar, 0);
   /* Variables Heading */
   Label *pVariablesBrowserLabel = new Label(Helper::variablesBrowser);
   pVariablesBrowserLabel->setObjectName("LabelWithBorder");
@@ -530,13 +1052,21 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   Label *pEquationsBrowserLabel = new Label(tr("Equations Browser"));
   pEquationsBrowserLabel->setObjectName("LabelWithBorder");
   /* Equations tree widget */
-  mpEquationsTreeWidget = new EquationTreeWidget(this);
-  mpEquationsTreeWidget->setIndentation(Helper::treeIndentation);
+  mpEquationsTreeView = new EquationTreeView(this);
+  mpEquationTreeModel = new EquationTreeModel(this);
+  mpEquationsTreeView->setModel(mpEquationTreeModel);
+  mpEquationsTreeView->setColumnWidth(0, 55);
+  mpEquationsTreeView->setColumnWidth(1, 60);
+  mpEquationsTreeView->setColumnWidth(2, 200);
+  mpEquationsTreeView->setColumnWidth(3, 55);
+  mpEquationsTreeView->setColumnWidth(4, 80);
+  mpEquationsTreeView->setColumnWidth(5, 80);
+  mpEquationsTreeView->setColumnWidth(6, 60);
   QGridLayout *pEquationsGridLayout = new QGridLayout;
   pEquationsGridLayout->setSpacing(1);
   pEquationsGridLayout->setContentsMargins(0, 0, 0, 0);
   pEquationsGridLayout->addWidget(pEquationsBrowserLabel, 0, 0);
-  pEquationsGridLayout->addWidget(mpEquationsTreeWidget, 1, 0);
+  pEquationsGridLayout->addWidget(mpEquationsTreeView, 1, 0);
   QFrame *pEquationsFrame = new QFrame;
   pEquationsFrame->setLayout(pEquationsGridLayout);
   /* defines tree widget */
@@ -649,6 +1179,9 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   pVariablesMainLayout->addWidget(mpVariablesHorizontalSplitter);
   QFrame *pVariablesMainFrame = new QFrame;
   pVariablesMainFrame->setLayout(pVariablesMainLayout);
+  /* profiling widget */
+  mpProfilingWidget = new ProfilingWidget;
+  connect(mpProfilingWidget->getProfilingReportButton(), SIGNAL(clicked()), SLOT(showProfilingReport()));
   /* Equations nested horizontal splitter */
   mpEquationsNestedHorizontalSplitter = new QSplitter;
   mpEquationsNestedHorizontalSplitter->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -666,6 +1199,7 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   mpEquationsNestedVerticalSplitter->setContentsMargins(0, 0, 0, 0);
   mpEquationsNestedVerticalSplitter->addWidget(mpEquationsNestedHorizontalSplitter);
   mpEquationsNestedVerticalSplitter->addWidget(pEquationOperationsFrame);
+  mpEquationsNestedVerticalSplitter->addWidget(mpProfilingWidget);
   /* equations horizontal splitter */
   mpEquationsHorizontalSplitter = new QSplitter;
   mpEquationsHorizontalSplitter->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -728,141 +1262,64 @@ TransformationsWidget::TransformationsWidget(QString infoJSONFullFileName, MainW
   }
 }
 
-static QStringList variantListToStringList(const QVariantList lst)
-{
-  QStringList strs;
-  foreach(QVariant v, lst){
-    QString s = v.toString();
-    strs << v.toString().trimmed();
-  }
-  return strs;
-}
-
-static OMOperation* variantToOperationPtr(QVariantMap var)
-{
-  QString op = var["op"].toString();
-  QString display = var["display"].toString();
-  QStringList dataStrings = variantListToStringList(var["data"].toList());
-
-  if (op == "before-after") {
-    return new OMOperationBeforeAfter(display != "" ? display : op, dataStrings);
-  } else if (op == "before-after-assert") {
-    return new OMOperationBeforeAfter(display != "" ? display : op, dataStrings);
-  } else if (op == "chain") {
-    QStringList firstLast;
-    firstLast << dataStrings.first() << dataStrings.last();
-    return new OMOperationBeforeAfter(display != "" ? display : op, firstLast);
-  } else if (op == "info") {
-    return new OMOperationInfo(display != "" ? display : op, dataStrings.join(", "));
-  }
-  // "chain"
-  return NULL;
-}
-
-
-static void variantToSource(QVariantMap var, OMInfo &info, QStringList &types, QList<OMOperation*> &ops)
-{
-  Q_UNUSED(types);
-  QVariantMap vinfo = var["info"].toMap();
-  info.file = vinfo["file"].toString();
-  info.lineStart = vinfo["lineStart"].toInt();
-  info.lineEnd = vinfo["lineEnd"].toInt();
-  info.colStart = vinfo["colStart"].toInt();
-  info.colEnd = vinfo["colEnd"].toInt();
-  info.isValid = true;
-  QVariantList vops = var["operations"].toList();
-  foreach (QVariant vop, vops) {
-    OMOperation *op = variantToOperationPtr(vop.toMap());
-    if (op) {
-      ops += op;
-    }
-  }
-}
-
-static OMEquation* getOMEquation(QList<OMEquation*> equations, int index)
+/*!
+ * \brief TransformationsWidget::~TransformationsWidget
+ * Stops the InfoJSONReader threads before they are deleted.
+ */
+TransformationsWidget::~TransformationsWidget()
 {
-  for (int i = 1 ; i < equations.size() ; i++) {
-    if (equations[i]->index == index) {
-      return equations[i];
-    }
+  foreach (InfoJSONReader *pInfoJSONReader, findChildren<InfoJSONReader*>()) {
+    pInfoJSONReader->disconnect(this);
+    pInfoJSONReader->cancel();
+    pInfoJSONReader->wait();
   }
-  return NULL;
+  mTransformationsCacheFuture.waitForFinished();
+  qDeleteAll(mEquations);
+  mEquations.clear();
+  delete mpTransformationsCache;
 }
 
 void TransformationsWidget::loadTransformations()
 {
   QFile file(mInfoJSONFullFileName);
+  cancelInfoJSONReader();
+  /* the cache writer reads the variables and equations. */
+  mTransformationsCacheFuture.waitForFinished();
+  mpEquationTreeModel->clearEquations();
+  mpProfilingWidget->clearProfilingData();
+  qDeleteAll(mEquations);
   mEquations.clear();
   mVariables.clear();
+  mEquationDependencyGraph.clear();
   hasOperationsEnabled = false;
+  delete mpTransformationsCache;
+  mpTransformationsCache = 0;
   if (mInfoJSONFullFileName.endsWith(".json")) {
-    QJson::Parser parser;
-    bool ok;
-    QVariantMap result;
-    result = parser.parse(&file, &ok).toMap();
-    if (!ok) {
-      QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + ": " + mInfoJSONFullFileName, Helper::ok);
-      return;
-    }
-    QVariantMap vars = result["variables"].toMap();
-    QVariantList eqs = result["equations"].toList();
-    for(QVariantMap::const_iterator iter = vars.begin(); iter != vars.end(); ++iter) {
-      QVariantMap value = iter.value().toMap();
-      OMVariable *var = new OMVariable();
-      var->name = iter.key();
-      var->comment = value["comment"].toString();
-      variantToSource(value["source"].toMap(), var->info, var->types, var->ops);
-      if (!hasOperationsEnabled && var->ops.size() > 0) {
-        hasOperationsEnabled = true;
-      }
-      mVariables[iter.key()] = *var;
-    }
-    mpTVariablesTreeModel->insertTVariablesItems(mVariables);
-    for (int i=0; i<eqs.size(); i++) {
-      mEquations << new OMEquation();
-    }
-    for (int i=0; i<eqs.size(); i++) {
-      QVariantMap veq = eqs[i].toMap();
-      OMEquation *eq = mEquations[i];
-      eq->section = veq["section"].toString();
-      if (veq["eqIndex"].toInt() != i) {
-        QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), Helper::parsingFailedJson + QString(": got index ") + veq["eqIndex"].toString() + QString(" expected ") + QString::number(i), Helper::ok);
-        return;
-      }
-      eq->index = i;
-      eq->profileBlock = -1;
-      if (veq.find("parent") != veq.end()) {
-        eq->parent = veq["parent"].toInt();
-        mEquations[eq->parent]->eqs << eq->index;
-      } else {
-        eq->parent = 0;
-      }
-      if (veq.find("defines") != veq.end()) {
-        eq->defines = variantListToStringList(veq["defines"].toList());
-        foreach (QString v, eq->defines) {
-          mVariables[v].definedIn << eq->index;
-        }
-      }
-      if (veq.find("uses") != veq.end()) {
-        eq->depends = variantListToStringList(veq["uses"].toList());
-        foreach (QString v, eq->depends) {
-          mVariables[v].usedIn << eq->index;
-        }
-      }
-      eq->text = variantListToStringList(veq["equation"].toList());
-      eq->tag = veq["tag"].toString();
-      if (veq.find("display") != veq.end()) {
-        eq->display = veq["display"].toString();
-      } else {
-        eq->display = eq->tag;
-      }
-      variantToSource(veq["source"].toMap(), eq->info, eq->types, eq->ops);
-      if (!hasOperationsEnabled && eq->ops.size() > 0) {
-        hasOperationsEnabled = true;
+    /* use the cache file if it is written for this json file. The equations are decoded when they are needed. */
+    mpTransformationsCache = new TransformationsCache(mInfoJSONFullFileName);
+    if (mpTransformationsCache->open() && mpTransformationsCache->readVariables(mVariables)) {
+      hasOperationsEnabled = mpTransformationsCache->hasOperationsEnabled();
+      mpTVariablesTreeModel->insertTVariablesItems(mVariables);
+      for (int i = 0 ; i < mpTransformationsCache->equationsCount() ; i++) {
+        mEquations.append(0);
       }
+      parseProfiling(mProfJSONFullFileName);
+      fetchEquations();
+      return;
     }
-    parseProfiling(mProfJSONFullFileName);
-    fetchEquations();
+    /* the cache file is missing, out of date or broken. Drop whatever was decoded from it and read the json file. */
+    mVariables.clear();
+    mpTransformationsCache->close();
+    /* The json file is read in a separate thread. The variables and equations are added as they are read. */
+    mpInfoJSONReader = new InfoJSONReader(mInfoJSONFullFileName, this);
+    connect(mpInfoJSONReader, SIGNAL(sendVariables(OMVariableHash*)), SLOT(readVariables(OMVariableHash*)));
+    connect(mpInfoJSONReader, SIGNAL(sendEquations(QList<OMEquation*>)), SLOT(readEquations(QList<OMEquation*>)));
+    connect(mpInfoJSONReader, SIGNAL(sendProgress(int)), SLOT(readProgress(int)));
+    connect(mpInfoJSONReader, SIGNAL(sendFinished(bool,QString)), SLOT(readFinished(bool,QString)));
+    connect(mpInfoJSONReader, SIGNAL(finished()), mpInfoJSONReader, SLOT(deleteLater()));
+    mpInfoJSONProgressBar->setValue(0);
+    mpInfoJSONProgressBar->show();
+    mpInfoJSONReader->start();
   } else {
     mpInfoXMLFileHandler = new MyHandler(file,mVariables,mEquations);
     mpTVariablesTreeModel->insertTVariablesItems(mVariables);
@@ -873,6 +1330,103 @@ void TransformationsWidget::loadTransformations()
   }
 }
 
+/*!
+ * \brief TransformationsWidget::getEquation
+ * Returns the equation. Decodes the equation from the cache file if it is not decoded yet.
+ * \param equationIndex
+ * \return
+ */
+OMEquation* TransformationsWidget::getEquation(int equationIndex)
+{
+  if (equationIndex < 0 || equationIndex >= mEquations.size()) {
+    return 0;
+  }
+  if (!mEquations[equationIndex] && mpTransformationsCache && mpTransformationsCache->isOpen()) {
+    mEquations[equationIndex] = mpTransformationsCache->readEquation(equationIndex);
+  }
+  return mEquations[equationIndex];
+}
+
+/*!
+ * \brief TransformationsWidget::getEquationDependencyGraph
+ * Returns the dependency graph of the equations. The graph is built on the first query,
+ * so loading the transformations does not pay for it.
+ * \return
+ */
+EquationDependencyGraph* TransformationsWidget::getEquationDependencyGraph()
+{
+  if (mEquationDependencyGraph.isEmpty() && !isLoading()) {
+    QStringList sections;
+    sections.reserve(mEquations.size());
+    for (int i = 0 ; i < mEquations.size() ; i++) {
+      if (mEquations[i]) {
+        sections.append(mEquations[i]->section);
+      } else if (mpTransformationsCache && mpTransformationsCache->isOpen()) {
+        sections.append(mpTransformationsCache->readEquationSection(i));
+      } else {
+        sections.append(QString());
+      }
+    }
+    mEquationDependencyGraph.build(mVariables, sections);
+  }
+  return &mEquationDependencyGraph;
+}
+
+/*!
+ * \brief TransformationsWidget::showAffectedEquations
+ * Shows the equations which are transitively affected by the variable of the variables browser index.
+ * \param index
+ */
+void TransformationsWidget::showAffectedEquations(const QModelIndex &index)
+{
+  if (!index.isValid() || isLoading())
+    return;
+  QModelIndex modelIndex = mpTVariableTreeProxyModel->mapToSource(index);
+  TVariablesTreeItem *pTVariableTreeItem = static_cast<TVariablesTreeItem*>(modelIndex.internalPointer());
+  if (!pTVariableTreeItem)
+    return;
+  QString variableName = pTVariableTreeItem->getVariableName();
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  QList<int> equations = getEquationDependencyGraph()->getAffectedEquations(variableName);
+  QString description = tr("%1 equations are affected by the variable <b>%2</b>.").arg(equations.size()).arg(variableName);
+  DependentEquationsDialog *pDependentEquationsDialog = new DependentEquationsDialog(tr("Affected Equations"), description, equations, this);
+  QApplication::restoreOverrideCursor();
+  pDependentEquationsDialog->show();
+}
+
+/*!
+ * \brief TransformationsWidget::showStronglyConnectedEquations
+ * Shows the equations of the strongly connected block containing the equation of the equations browser index.
+ * \param index
+ */
+void TransformationsWidget::showStronglyConnectedEquations(const QModelIndex &index)
+{
+  int equationIndex = mpEquationTreeModel->equationIndex(index);
+  if (equationIndex < 0 || isLoading())
+    return;
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  QList<int> equations = getEquationDependencyGraph()->getStronglyConnectedEquations(equationIndex);
+  QString description = tr("The strongly connected block of the equation <b>%1</b> contains %2 equations.").arg(equationIndex).arg(equations.size());
+  DependentEquationsDialog *pDependentEquationsDialog = new DependentEquationsDialog(tr("Strongly Connected Equations"), description, equations,
+                                                                                     this);
+  QApplication::restoreOverrideCursor();
+  pDependentEquationsDialog->show();
+}
+
+/*!
+ * \brief TransformationsWidget::cancelInfoJSONReader
+ * Cancels the running InfoJSONReader. The reader deletes itself once its thread is finished.
+ */
+void TransformationsWidget::cancelInfoJSONReader()
+{
+  if (mpInfoJSONReader) {
+    mpInfoJSONReader->disconnect(this);
+    mpInfoJSONReader->cancel();
+    mpInfoJSONReader = 0;
+  }
+  mpInfoJSONProgressBar->hide();
+}
+
 void TransformationsWidget::fetchDefinedInEquations(const OMVariable &variable)
 {
   /* Clear the defined in tree. */
@@ -880,7 +1434,10 @@ void TransformationsWidget::fetchDefinedInEquations(const OMVariable &variable)
   /* add defined in equations */
   for (int i=0; i<variable.definedIn.size(); i++)
   {
-    OMEquation *equation = getOMEquation(mEquations, variable.definedIn[i]);
+    OMEquation *equation = getEquation(variable.definedIn[i]);
+    if (!equation) {
+      continue;
+    }
     QStringList values;
     values << QString::number(variable.definedIn[i]) << equation->section << equation->toString();
     QTreeWidgetItem *pDefinedInTreeItem = new IntegerTreeWidgetItem(values, mpDefinedInEquationsTreeWidget);
@@ -898,7 +1455,10 @@ void TransformationsWidget::fetchUsedInEquations(const OMVariable &variable)
   /* add used in equations */
   foreach (int index, variable.usedIn)
   {
-    OMEquation *equation = getOMEquation(mEquations, index);
+    OMEquation *equation = getEquation(index);
+    if (!equation) {
+      continue;
+    }
     QStringList values;
     values << QString::number(index) << equation->section << equation->toString();
     QTreeWidgetItem *pUsedInTreeItem = new IntegerTreeWidgetItem(values, mpUsedInEquationsTreeWidget);
@@ -939,82 +1499,31 @@ void TransformationsWidget::fetchOperations(const OMVariable &variable)
   mpVariableOperationsTreeWidget->resizeColumnToContents(0);
 }
 
-QTreeWidgetItem* TransformationsWidget::makeEquationTreeWidgetItem(int equationIndex, int allowChild)
-{
-  OMEquation *equation = mEquations[equationIndex];
-  if (!allowChild && equation->parent) {
-    return NULL; // Only output equations in one position
-  }
-  QStringList values;
-  values << QString::number(equation->index)
-         << equation->section
-         << equation->toString();
-  if (equation->profileBlock >= 0) {
-    values << QString::number(equation->ncall)
-         << QString::number(equation->maxTime, 'g', 3)
-         << QString::number(equation->time, 'g', 3)
-         << QString::number(100 * equation->fraction, 'g', 3) + "%";
-  }
-
-  QTreeWidgetItem *pEquationTreeItem = new IntegerTreeWidgetItem(values, mpEquationsTreeWidget);
-  pEquationTreeItem->setToolTip(0, values[0]);
-  pEquationTreeItem->setToolTip(1, values[1]);
-  pEquationTreeItem->setToolTip(2, "<html><div style=\"margin:3px;\">" +
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-  QString(values[2]).toHtmlEscaped()
-#else /* Qt4 */
-  Qt::escape(values[2])
-#endif
-  + "</div></html>");
-  pEquationTreeItem->setToolTip(4, "Maximum execution time in a single step");
-  pEquationTreeItem->setToolTip(5, "Total time excluding the overhead of measuring.");
-  pEquationTreeItem->setToolTip(6, "Fraction of time, 100% is the total time of all non-child equations.");
-  return pEquationTreeItem;
-}
-
+/*!
+ * \brief TransformationsWidget::fetchEquations
+ * Adds the top level equations to the equations browser.
+ */
 void TransformationsWidget::fetchEquations()
 {
-  for (int i = 1 ; i < mEquations.size() ; i++)
-  {
-    QTreeWidgetItem *pEquationTreeItem = makeEquationTreeWidgetItem(i,0);
-    if (pEquationTreeItem) {
-      mpEquationsTreeWidget->addTopLevelItem(pEquationTreeItem);
-      fetchNestedEquations(pEquationTreeItem, i);
-    }
-  }
-}
-
-void TransformationsWidget::fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index)
-{
-  foreach (int nestedIndex, mEquations[index]->eqs)
-  {
-    // OMEquation *nestedEquation = mpInfoXMLFileHandler->equations[nestedIndex];
-    QTreeWidgetItem *pNestedEquationTreeItem = makeEquationTreeWidgetItem(nestedIndex,1);
-    if (pNestedEquationTreeItem) {
-      pParentTreeWidgetItem->addChild(pNestedEquationTreeItem);
-      fetchNestedEquations(pNestedEquationTreeItem, nestedIndex);
+  QList<int> equations;
+  if (mpTransformationsCache && mpTransformationsCache->isOpen()) {
+    equations = mpTransformationsCache->readTopLevelEquations();
+  } else {
+    for (int i = 1 ; i < mEquations.size() ; i++) {
+      if (!mEquations[i]->parent) {
+        equations.append(i);
+      }
     }
   }
+  mpEquationTreeModel->insertEquations(equations);
 }
 
-QTreeWidgetItem* TransformationsWidget::findEquationTreeItem(int equationIndex)
-{
-  QTreeWidgetItemIterator it(mpEquationsTreeWidget);
-  while (*it)
-  {
-    QTreeWidgetItem *pEquationTreeItem = dynamic_cast<QTreeWidgetItem*>(*it);
-    if (pEquationTreeItem->text(0).toInt() == equationIndex)
-      return pEquationTreeItem;
-    ++it;
-  }
-  return 0;
-}
-
-#include <qwt_plot.h>
-
 void TransformationsWidget::fetchEquationData(int equationIndex)
 {
-  OMEquation *equation = getOMEquation(mEquations, equationIndex);
+  OMEquation *equation = getEquation(equationIndex);
+  if (!equation) {
+    return;
+  }
   /* fetch defines */
   fetchDefines(equation);
   /* fetch depends */
@@ -1022,38 +1531,8 @@ void TransformationsWidget::fetchEquationData(int equationIndex)
   /* fetch operations */
   fetchOperations(equation);
 
-  /* TODO: This data is correct. Add this to some widget thingy somewhere.
-   * Maybe a small one that you can click to enlarge.
-   * Also add the count one (Model_prof.intdata)
-   */
-#if 0
-  if (equation->profileBlock >= 0) {
-    QFile file(mProfilingDataRealFileName);
-    if (file.open(QIODevice::ReadOnly)) {
-
-      QwtPlot *w;
-      long c1;
-      w = new QwtPlot();
-
-      size_t rowSize = sizeof(double) * profilingNumSteps;
-      file.seek(0);
-      QByteArray datax = file.read(rowSize);
-      file.seek((equation->profileBlock+2) * rowSize);
-      QByteArray datay = file.read(rowSize);
-      double *x = (double*)datax.data();
-      double *y = (double*)datay.data();
-
-      QwtPlotCurve *curve = new QwtPlotCurve("Curve 1");
-
-      curve->setData(x, y, profilingNumSteps);
-      curve->attach(w);
-      w->replot();
-      w->show();
-    }
-  } else {
-    qDebug() << equation->profileBlock;
-  }
-#endif
+  /* plot the profiling data */
+  mpProfilingWidget->showEquationProfiling(equation);
 
   if (!equation->info.isValid)
     return;
@@ -1072,6 +1551,27 @@ void TransformationsWidget::fetchEquationData(int equationIndex)
 
 }
 
+/*!
+ * \brief TransformationsWidget::selectEquation
+ * Selects the equation in the equations browser and shows its data.
+ * If the transformations are still being read then the equation is selected once they are read.
+ * \param equationIndex
+ */
+void TransformationsWidget::selectEquation(int equationIndex)
+{
+  if (mpInfoJSONReader) {
+    mPendingEquationIndex = equationIndex;
+    return;
+  }
+  QModelIndex index = mpEquationTreeModel->equationModelIndex(equationIndex);
+  if (index.isValid()) {
+    mpEquationsTreeView->clearSelection();
+    mpEquationsTreeView->setCurrentIndex(index);
+    mpEquationsTreeView->scrollTo(index);
+  }
+  fetchEquationData(equationIndex);
+}
+
 void TransformationsWidget::fetchDefines(OMEquation *equation)
 {
   /* Clear the defines tree. */
@@ -1168,8 +1668,6 @@ void TransformationsWidget::reloadTransformations()
   mpTreeSearchFilters->getCaseSensitiveCheckBox()->setChecked(false);
   mpTreeSearchFilters->getCaseSensitiveCheckBox()->blockSignals(signalsState);
   mpTVariableTreeProxyModel->setFilterRegExp(QRegExp());
-  /* clear equations tree */
-  clearTreeWidgetItems(mpEquationsTreeWidget);
   /* clear defines in tree */
   clearTreeWidgetItems(mpDefinesVariableTreeWidget);
   /* clear depends tree */
@@ -1181,8 +1679,6 @@ void TransformationsWidget::reloadTransformations()
   mpTSourceEditorFileLabel->hide();
   mpTransformationsEditor->getPlainTextEdit()->clear();
   mpTSourceEditorInfoBar->hide();
-  /* Clear the equations tree. */
-  clearTreeWidgetItems(mpEquationsTreeWidget);
   /* initialize all fields again */
   loadTransformations();
 }
@@ -1213,7 +1709,11 @@ void TransformationsWidget::fetchVariableData(const QModelIndex &index)
   if (!pTVariableTreeItem)
     return;
 
-  const OMVariable &variable = mVariables[pTVariableTreeItem->getVariableName()];
+  /* don't insert into mVariables here, the cache writer might be reading it. */
+  QHash<QString, OMVariable>::const_iterator variableIterator = mVariables.constFind(pTVariableTreeItem->getVariableName());
+  if (variableIterator == mVariables.constEnd())
+    return;
+  const OMVariable &variable = variableIterator.value();
   /* fetch defined in equations */
   fetchDefinedInEquations(variable);
   /* fetch used in equations */
@@ -1243,43 +1743,277 @@ void TransformationsWidget::fetchEquationData(QTreeWidgetItem *pEquationTreeItem
     return;
 
   int equationIndex = pEquationTreeItem->text(0).toInt();
-  /* if the sender is mpEquationsTreeWidget then there is no need to select the item. */
-  EquationTreeWidget *pSender = qobject_cast<EquationTreeWidget*>(sender());
-  if (pSender != mpEquationsTreeWidget)
-  {
-    QTreeWidgetItem *pTreeWidgetItem = findEquationTreeItem(equationIndex);
-    if (pTreeWidgetItem)
-    {
-      mpEquationsTreeWidget->clearSelection();
-      mpEquationsTreeWidget->setCurrentItem(pTreeWidgetItem);
-    }
+  /* select the equation in the equations browser. */
+  QModelIndex index = mpEquationTreeModel->equationModelIndex(equationIndex);
+  if (index.isValid()) {
+    mpEquationsTreeView->clearSelection();
+    mpEquationsTreeView->setCurrentIndex(index);
+    mpEquationsTreeView->scrollTo(index);
   }
   fetchEquationData(equationIndex);
 }
 
+/*!
+ * \brief TransformationsWidget::fetchEquationData
+ * Slot activated when the equations browser item is double clicked.
+ * \param index
+ */
+void TransformationsWidget::fetchEquationData(const QModelIndex &index)
+{
+  int equationIndex = mpEquationTreeModel->equationIndex(index);
+  if (equationIndex >= 0) {
+    fetchEquationData(equationIndex);
+  }
+}
+
+/*!
+ * \brief TransformationsWidget::showProfilingReport
+ * Slot activated when the profiling report button of the ProfilingWidget is clicked.\n
+ * Shows the profiling report of the simulation runs of this model.
+ */
+void TransformationsWidget::showProfilingReport()
+{
+  QList<ProfilingRun> profilingRuns = mpMainWindow->getProfilingRuns(mInfoJSONFullFileName);
+  if (profilingRuns.isEmpty()) {
+    return;
+  }
+  ProfilingReportDialog *pProfilingReportDialog = new ProfilingReportDialog(QFileInfo(mInfoJSONFullFileName).fileName(), profilingRuns, this);
+  pProfilingReportDialog->show();
+}
+
+/*!
+ * \brief TransformationsWidget::readVariables
+ * Slot activated when InfoJSONReader sendVariables signal is raised.\n
+ * Takes the ownership of the variables and adds them to the variables browser.
+ * \param pVariables
+ */
+void TransformationsWidget::readVariables(OMVariableHash *pVariables)
+{
+  if (sender() != mpInfoJSONReader) {
+    delete pVariables;
+    return;
+  }
+  if (!hasOperationsEnabled) {
+    foreach (const OMVariable &variable, *pVariables) {
+      if (variable.ops.size() > 0) {
+        hasOperationsEnabled = true;
+        break;
+      }
+    }
+  }
+  if (mVariables.isEmpty()) {
+    mVariables.swap(*pVariables);
+  } else {
+    QMutableHashIterator<QString, OMVariable> iterator(*pVariables);
+    while (iterator.hasNext()) {
+      iterator.next();
+      OMVariable &fromVariable = iterator.value();
+      /* move the data instead of copying the OMVariable since the copy constructor copies the operations. */
+      OMVariable &variable = mVariables[iterator.key()];
+      variable.name = fromVariable.name;
+      variable.comment = fromVariable.comment;
+      variable.info = fromVariable.info;
+      variable.types = fromVariable.types;
+      variable.ops = fromVariable.ops;
+      fromVariable.ops.clear();
+    }
+  }
+  delete pVariables;
+  mpTVariablesTreeModel->insertTVariablesItems(mVariables);
+}
+
+/*!
+ * \brief TransformationsWidget::readEquations
+ * Slot activated when InfoJSONReader sendEquations signal is raised.\n
+ * Takes the ownership of the equations and adds the top level equations to the equations browser.
+ * \param equations
+ */
+void TransformationsWidget::readEquations(QList<OMEquation*> equations)
+{
+  if (sender() != mpInfoJSONReader) {
+    qDeleteAll(equations);
+    return;
+  }
+  QList<int> topLevelEquations;
+  foreach (OMEquation *pEquation, equations) {
+    mEquations.append(pEquation);
+    foreach (QString v, pEquation->defines) {
+      mVariables[v].definedIn << pEquation->index;
+    }
+    foreach (QString v, pEquation->depends) {
+      mVariables[v].usedIn << pEquation->index;
+    }
+    if (!hasOperationsEnabled && pEquation->ops.size() > 0) {
+      hasOperationsEnabled = true;
+    }
+    if (pEquation->index > 0 && !pEquation->parent) {
+      topLevelEquations.append(pEquation->index);
+    }
+  }
+  mpEquationTreeModel->insertEquations(topLevelEquations);
+}
+
+/*!
+ * \brief TransformationsWidget::readProgress
+ * Slot activated when InfoJSONReader sendProgress signal is raised.
+ * \param progress
+ */
+void TransformationsWidget::readProgress(int progress)
+{
+  if (sender() == mpInfoJSONReader) {
+    mpInfoJSONProgressBar->setValue(progress);
+  }
+}
+
+/*!
+ * \brief writeTransformationsCache
+ * Writes the TransformationsCache of the info file. Runs in a QtConcurrent task.
+ * \param infoFileName
+ * \param pVariables
+ * \param equations
+ * \param hasOperationsEnabled
+ * \return
+ */
+static bool writeTransformationsCache(QString infoFileName, const QHash<QString, OMVariable> *pVariables, QList<OMEquation*> equations,
+                                      bool hasOperationsEnabled)
+{
+  TransformationsCache transformationsCache(infoFileName);
+  return transformationsCache.write(*pVariables, equations, hasOperationsEnabled);
+}
+
+/*!
+ * \brief TransformationsWidget::readFinished
+ * Slot activated when InfoJSONReader sendFinished signal is raised.\n
+ * Adds the nested equations and the profiling information to the equations browser.
+ * \param success
+ * \param errorString
+ */
+void TransformationsWidget::readFinished(bool success, QString errorString)
+{
+  if (sender() != mpInfoJSONReader) {
+    return;
+  }
+  mpInfoJSONReader = 0;
+  mpInfoJSONProgressBar->hide();
+  if (!success) {
+    QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::parsingFailedJson), errorString, Helper::ok);
+    mPendingEquationIndex = -1;
+    return;
+  }
+  /* the model is reset when the nested equations are added, so keep the equation the user has selected meanwhile. */
+  if (mPendingEquationIndex < 0) {
+    mPendingEquationIndex = mpEquationTreeModel->equationIndex(mpEquationsTreeView->currentIndex());
+  }
+  mpEquationTreeModel->insertNestedEquations();
+  /* write the cache file in the background so that the next load of the same json file can skip parsing.
+   * The variables and equations are not changed or deleted until the write is finished.
+   */
+  mTransformationsCacheFuture = QtConcurrent::run(writeTransformationsCache, mInfoJSONFullFileName, &mVariables, mEquations,
+                                                  hasOperationsEnabled);
+  parseProfiling(mProfJSONFullFileName);
+  /* sort again to show the nested equations, the profiling information and the equations added while sorted by another column. */
+  mpEquationsTreeView->sortByColumn(mpEquationsTreeView->header()->sortIndicatorSection(), mpEquationsTreeView->header()->sortIndicatorOrder());
+  if (mPendingEquationIndex >= 0) {
+    selectEquation(mPendingEquationIndex);
+    mPendingEquationIndex = -1;
+  }
+}
+
+/*!
+  \struct ProfileBlock
+  \brief The fields of a profile block entry of prof.json that are shown in the equations view.
+  */
+struct ProfileBlock
+{
+  long mId;
+  int mNumCalls;
+  double mTime;
+  double mMaxTime;
+};
+
+/*!
+  \brief TransformationsWidget::parseProfiling
+  Reads the profiling summary in one pass with QJson::StreamReader. Only the fields used here are kept, the profile blocks
+  are applied to the equations once the whole file is read since their fractions need totalTimeProfileBlocks.
+  \param fileName
+  */
 void TransformationsWidget::parseProfiling(QString fileName)
 {
-  QFile *file = new QFile(fileName);
-  if (!file->exists()) {
-    delete file;
+  QFile file(fileName);
+  if (!file.exists()) {
     return;
   }
-  QJson::Parser parser;
-  bool ok;
-  QVariantMap result = parser.parse(file, &ok).toMap();
-  double totalStepsTime = result["totalTimeProfileBlocks"].toDouble();
-  QVariantList functions = result["functions"].toList();
-  QVariantList list = result["profileBlocks"].toList();
-  profilingNumSteps = result["numStep"].toInt() + 1; // Initialization is not a step, but part of the file
-  for (int i=0; i<list.size(); i++) {
-    QVariantMap eq = list[i].toMap();
-    long id = eq["id"].toInt();
-    double time = eq["time"].toDouble();
-    mEquations[id]->ncall = eq["ncall"].toInt();
-    mEquations[id]->maxTime = eq["maxTime"].toDouble();
-    mEquations[id]->time = time;
-    mEquations[id]->fraction = time / totalStepsTime;
-    mEquations[id]->profileBlock = i + functions.size();
-  }
-  delete file;
+  QJson::StreamReader reader(&file);
+  double totalStepsTime = 0;
+  int numFunctions = 0;
+  QList<ProfileBlock> profileBlocks;
+  profilingNumSteps = 1; // Initialization is not a step, but part of the file
+  QList<int> profileBlockEquations;
+  /* keep the summary of this run for the profiling report. */
+  ProfilingRun profilingRun;
+  profilingRun.mDateTime = QFileInfo(fileName).lastModified();
+  if (reader.readNext() == QJson::StreamReader::StartObject) {
+    while (reader.readNext() == QJson::StreamReader::Key) {
+      QString key = reader.stringValue();
+      QJson::StreamReader::TokenType tokenType = reader.readNext();
+      if (key == "totalTimeProfileBlocks") {
+        totalStepsTime = reader.value().toDouble();
+      } else if (key == "totalTime") {
+        profilingRun.mTotalTime = reader.value().toDouble();
+      } else if (key == "numStep") {
+        profilingNumSteps = reader.value().toInt() + 1;
+      } else if (key == "functions" && tokenType == QJson::StreamReader::StartArray) {
+        while (reader.readNext() == QJson::StreamReader::StartObject) {
+          QVariantMap functionMap = reader.readValue().toMap();
+          ProfilingRecord record;
+          record.mKind = ProfilingRecord::Function;
+          record.mIndex = -1;
+          record.mName = functionMap["name"].toString();
+          record.mNumCalls = functionMap["ncall"].toInt();
+          record.mTime = functionMap["time"].toDouble();
+          record.mMaxTime = functionMap["maxTime"].toDouble();
+          profilingRun.mRecords.append(record);
+          numFunctions++;
+        }
+      } else if (key == "profileBlocks" && tokenType == QJson::StreamReader::StartArray) {
+        while (reader.readNext() == QJson::StreamReader::StartObject) {
+          QVariantMap eq = reader.readValue().toMap();
+          ProfileBlock profileBlock;
+          profileBlock.mId = eq["id"].toInt();
+          profileBlock.mNumCalls = eq["ncall"].toInt();
+          profileBlock.mTime = eq["time"].toDouble();
+          profileBlock.mMaxTime = eq["maxTime"].toDouble();
+          profileBlocks.append(profileBlock);
+        }
+      } else {
+        reader.skipCurrentValue();
+      }
+    }
+  }
+  profilingRun.mTotalTimeProfileBlocks = totalStepsTime;
+  for (int i = 0; i < profileBlocks.size(); i++) {
+    const ProfileBlock &profileBlock = profileBlocks.at(i);
+    profileBlockEquations.append(profileBlock.mId);
+    OMEquation *pEquation = getEquation(profileBlock.mId);
+    if (!pEquation) {
+      continue;
+    }
+    pEquation->ncall = profileBlock.mNumCalls;
+    pEquation->maxTime = profileBlock.mMaxTime;
+    pEquation->time = profileBlock.mTime;
+    pEquation->fraction = profileBlock.mTime / totalStepsTime;
+    pEquation->profileBlock = i + numFunctions;
+    ProfilingRecord record;
+    record.mKind = ProfilingRecord::kindFromTag(pEquation->tag);
+    record.mIndex = pEquation->index;
+    record.mSection = pEquation->section;
+    record.mName = pEquation->toString();
+    record.mNumCalls = pEquation->ncall;
+    record.mTime = pEquation->time;
+    record.mMaxTime = pEquation->maxTime;
+    profilingRun.mRecords.append(record);
+  }
+  mpMainWindow->addProfilingRun(mInfoJSONFullFileName, profilingRun);
+  mpProfilingWidget->openProfilingData(mProfilingDataRealFileName, mProfilingDataIntFileName, profilingNumSteps, numFunctions,
+                                       profileBlockEquations);
 }
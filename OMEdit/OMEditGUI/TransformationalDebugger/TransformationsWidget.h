@@ -38,6 +38,13 @@
 #include "MainWindow.h"
 #include "OMDumpXML.h"
 #include "TransformationsEditor.h"
+#include "InfoJSONReader.h"
+#include "TransformationsCache.h"
+#include "ProfilingWidget.h"
+#include "ProfilingReport.h"
+#include "EquationDependencyGraph.h"
+
+#include <QFuture>
 
 class MainWindow;
 class TransformationsWidget;
@@ -137,6 +144,49 @@ public:
   TransformationsWidget* getTransformationsWidget() {return mpTransformationsWidget;}
 private:
   TransformationsWidget *mpTransformationsWidget;
+  QAction *mpShowAffectedEquationsAction;
+private slots:
+  void showContextMenu(QPoint point);
+  void showAffectedEquations();
+};
+
+class EquationTreeModel : public QAbstractItemModel
+{
+  Q_OBJECT
+public:
+  EquationTreeModel(TransformationsWidget *pTransformationsWidget);
+  int columnCount(const QModelIndex &parent = QModelIndex()) const;
+  int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+  QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+  QModelIndex parent(const QModelIndex &index) const;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+  Qt::ItemFlags flags(const QModelIndex &index) const;
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+  int equationIndex(const QModelIndex &index) const;
+  QModelIndex equationModelIndex(int equationIndex) const;
+  void insertEquations(const QList<int> &equations);
+  void insertNestedEquations();
+  void clearEquations();
+private:
+  TransformationsWidget *mpTransformationsWidget;
+  QVector<int> mTopLevelEquations;
+  mutable QVector<int> mRows;
+
+  int equationRow(int equationIndex) const;
+};
+
+class EquationTreeView : public QTreeView
+{
+  Q_OBJECT
+public:
+  EquationTreeView(TransformationsWidget *pTransformationsWidget);
+private:
+  TransformationsWidget *mpTransformationsWidget;
+  QAction *mpShowStronglyConnectedEquationsAction;
+private slots:
+  void showContextMenu(QPoint point);
+  void showStronglyConnectedEquations();
 };
 
 class EquationTreeWidget : public QTreeWidget
@@ -148,6 +198,19 @@ private:
   TransformationsWidget *mpTransformationWidget;
 };
 
+class DependentEquationsDialog : public QDialog
+{
+  Q_OBJECT
+public:
+  DependentEquationsDialog(QString title, QString description, QList<int> equations, TransformationsWidget *pTransformationsWidget);
+private:
+  TransformationsWidget *mpTransformationsWidget;
+  Label *mpDescriptionLabel;
+  EquationTreeWidget *mpEquationsTreeWidget;
+  QPushButton *mpCloseButton;
+  QDialogButtonBox *mpButtonBox;
+};
+
 class InfoBar;
 class TransformationsEditor;
 class TransformationsWidget : public QWidget
@@ -155,9 +218,11 @@ class TransformationsWidget : public QWidget
   Q_OBJECT
 public:
   TransformationsWidget(QString infoJSONFullFileName, MainWindow *pMainWindow);
+  ~TransformationsWidget();
   MainWindow* getMainWindow() {return mpMainWindow;}
   MyHandler* getInfoXMLFileHandler() {return mpInfoXMLFileHandler;}
-  QTreeWidget* getEquationsTreeWidget() {return mpEquationsTreeWidget;}
+  EquationTreeView* getEquationsTreeView() {return mpEquationsTreeView;}
+  int getEquationsCount() {return mEquations.size();}
   InfoBar* getTSourceEditorInfoBar() {return mpTSourceEditorInfoBar;}
   QSplitter* getVariablesNestedHorizontalSplitter() {return mpVariablesNestedHorizontalSplitter;}
   QSplitter* getVariablesNestedVerticalSplitter() {return mpVariablesNestedVerticalSplitter;}
@@ -172,18 +237,27 @@ public:
   void fetchUsedInEquations(const OMVariable &variable);
   void fetchOperations(const OMVariable &variable);
   void fetchEquations();
-  void fetchNestedEquations(QTreeWidgetItem *pParentTreeWidgetItem, int index);
-  QTreeWidgetItem* findEquationTreeItem(int equationIndex);
+  OMEquation* getEquation(int equationIndex);
   void fetchEquationData(int equationIndex);
+  void selectEquation(int equationIndex);
   void fetchDefines(OMEquation *equation);
   void fetchDepends(OMEquation *equation);
   void fetchOperations(OMEquation *equation);
   void clearTreeWidgetItems(QTreeWidget *pTreeWidget);
+  bool isLoading() {return mpInfoJSONReader != 0;}
+  EquationDependencyGraph* getEquationDependencyGraph();
+  void showAffectedEquations(const QModelIndex &index);
+  void showStronglyConnectedEquations(const QModelIndex &index);
 private:
   MainWindow *mpMainWindow;
-  QString mInfoJSONFullFileName, mProfJSONFullFileName, mProfilingDataRealFileName;
+  QString mInfoJSONFullFileName, mProfJSONFullFileName, mProfilingDataRealFileName, mProfilingDataIntFileName;
   int profilingNumSteps;
   MyHandler *mpInfoXMLFileHandler;
+  InfoJSONReader *mpInfoJSONReader;
+  TransformationsCache *mpTransformationsCache;
+  QFuture<bool> mTransformationsCacheFuture;
+  QProgressBar *mpInfoJSONProgressBar;
+  int mPendingEquationIndex;
   TreeSearchFilters *mpTreeSearchFilters;
   TVariablesTreeView *mpTVariablesTreeView;
   TVariablesTreeModel *mpTVariablesTreeModel;
@@ -191,10 +265,12 @@ private:
   EquationTreeWidget *mpDefinedInEquationsTreeWidget;
   EquationTreeWidget *mpUsedInEquationsTreeWidget;
   QTreeWidget *mpVariableOperationsTreeWidget;
-  EquationTreeWidget *mpEquationsTreeWidget;
+  EquationTreeView *mpEquationsTreeView;
+  EquationTreeModel *mpEquationTreeModel;
   QTreeWidget *mpDefinesVariableTreeWidget;
   QTreeWidget *mpDependsVariableTreeWidget;
   QTreeWidget *mpEquationOperationsTreeWidget;
+  ProfilingWidget *mpProfilingWidget;
   Label *mpTSourceEditorFileLabel;
   InfoBar *mpTSourceEditorInfoBar;
   TransformationsEditor *mpTransformationsEditor;
@@ -208,15 +284,23 @@ private:
   QSplitter *mpTransformationsHorizontalSplitter;
   QHash<QString,OMVariable> mVariables;
   QList<OMEquation*> mEquations;
+  EquationDependencyGraph mEquationDependencyGraph;
   bool hasOperationsEnabled;
 
   void parseProfiling(QString fileName);
-  QTreeWidgetItem* makeEquationTreeWidgetItem(int equationIndex, int allowChild);
+  void cancelInfoJSONReader();
+private slots:
+  void readVariables(OMVariableHash *pVariables);
+  void readEquations(QList<OMEquation*> equations);
+  void readProgress(int progress);
+  void readFinished(bool success, QString errorString);
 public slots:
   void reloadTransformations();
   void findVariables();
   void fetchVariableData(const QModelIndex &index);
   void fetchEquationData(QTreeWidgetItem *pEquationTreeItem, int column);
+  void fetchEquationData(const QModelIndex &index);
+  void showProfilingReport();
 };
 
 #endif // TRANSFORMATIONSWIDGET_H
@@ -190,6 +190,8 @@ QString Helper::reSimulate;
 QString Helper::reSimulateTip;
 QString Helper::reSimulateSetup;
 QString Helper::reSimulateSetupTip;
+QString Helper::parameterSweep;
+QString Helper::parameterSweepTip;
 QString Helper::exportVariables;
 QString Helper::simulateWithTransformationalDebugger;
 QString Helper::simulateWithTransformationalDebuggerTip;
@@ -401,6 +403,8 @@ void Helper::initHelperVariables()
   Helper::reSimulateTip = tr("Re-simulates the Modelica class");
   Helper::reSimulateSetup = tr("Re-simulate Setup");
   Helper::reSimulateSetupTip = tr("Setup re-simulation settings");
+  Helper::parameterSweep = tr("Parameter Sweep");
+  Helper::parameterSweepTip = tr("Re-simulates the Modelica class for a range of values of the selected parameters");
   Helper::exportVariables = tr("Export Variables");
   Helper::simulateWithTransformationalDebugger = tr("Simulate with Transformational Debugger");
   Helper::simulateWithTransformationalDebuggerTip = tr("Simulates the Modelica class with Transformational Debugger");
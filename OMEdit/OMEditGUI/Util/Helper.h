@@ -196,6 +196,8 @@ public:
   static QString reSimulateTip;
   static QString reSimulateSetup;
   static QString reSimulateSetupTip;
+  static QString parameterSweep;
+  static QString parameterSweepTip;
   static QString exportVariables;
   static QString simulateWithTransformationalDebugger;
   static QString simulateWithTransformationalDebuggerTip;
@@ -0,0 +1,616 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "OMCValue.h"
+
+/* nesting deeper than this is reported as an error instead of overflowing the stack. */
+static const int MaxDepth = 512;
+
+/*!
+ * \brief OMCValue::getType
+ * Returns the type of the value, Invalid for a default constructed value or a value out of range.
+ * \return
+ */
+OMCValue::Type OMCValue::getType() const
+{
+  if (!mpTree || mIndex < 0) {
+    return Invalid;
+  }
+  return mpTree->mNodes.at(mIndex).mType;
+}
+
+/*!
+ * \brief OMCValue::size
+ * Returns the number of elements of an array, tuple, call or record, 0 otherwise.
+ * \return
+ */
+int OMCValue::size() const
+{
+  if (!mpTree || mIndex < 0) {
+    return 0;
+  }
+  return mpTree->mNodes.at(mIndex).mChildCount;
+}
+
+/*!
+ * \brief OMCValue::at
+ * Returns the element i, an Invalid value if i is out of range.
+ * \param i
+ * \return
+ */
+OMCValue OMCValue::at(int i) const
+{
+  if (i < 0 || i >= size()) {
+    return OMCValue();
+  }
+  return OMCValue(mpTree, mpTree->mChildren.at(mpTree->mNodes.at(mIndex).mFirstChild + i));
+}
+
+/*!
+ * \brief OMCValue::value
+ * Returns the element passed as a named argument, e.g. the value of textString in Text(textString="x").
+ * \param argumentName
+ * \return
+ */
+OMCValue OMCValue::value(const QString &argumentName) const
+{
+  for (int i = 0 ; i < size() ; i++) {
+    OMCValue element = at(i);
+    if (element.getArgumentName() == argumentName) {
+      return element;
+    }
+  }
+  return OMCValue();
+}
+
+/*!
+ * \brief OMCValue::getText
+ * Returns the text of the value in the result.
+ * For strings the text between the quotes with the escape sequences, for arrays, tuples and calls the text between the brackets.
+ * \return
+ */
+QStringRef OMCValue::getText() const
+{
+  if (!mpTree || mIndex < 0) {
+    return QStringRef();
+  }
+  const OMCValueTree::Node &node = mpTree->mNodes.at(mIndex);
+  return QStringRef(&mpTree->mResult, node.mTextStart, node.mTextLength);
+}
+
+/*!
+ * \brief OMCValue::getSource
+ * Returns the complete text of the value in the result, e.g. "a" for a string or Line(..) for a call.
+ * \return
+ */
+QStringRef OMCValue::getSource() const
+{
+  if (!mpTree || mIndex < 0) {
+    return QStringRef();
+  }
+  const OMCValueTree::Node &node = mpTree->mNodes.at(mIndex);
+  return QStringRef(&mpTree->mResult, node.mSourceStart, node.mSourceLength);
+}
+
+/*!
+ * \brief OMCValue::getName
+ * Returns the name of a call or a record, e.g. Line for Line(..).
+ * \return
+ */
+QStringRef OMCValue::getName() const
+{
+  if (!mpTree || mIndex < 0) {
+    return QStringRef();
+  }
+  const OMCValueTree::Node &node = mpTree->mNodes.at(mIndex);
+  return QStringRef(&mpTree->mResult, node.mNameStart, node.mNameLength);
+}
+
+/*!
+ * \brief OMCValue::getArgumentName
+ * Returns the name of a named argument or record element, e.g. x for x = 1.
+ * \return
+ */
+QStringRef OMCValue::getArgumentName() const
+{
+  if (!mpTree || mIndex < 0) {
+    return QStringRef();
+  }
+  const OMCValueTree::Node &node = mpTree->mNodes.at(mIndex);
+  return QStringRef(&mpTree->mResult, node.mArgumentNameStart, node.mArgumentNameLength);
+}
+
+/*!
+ * \brief OMCValue::toString
+ * Returns the unescaped contents of a string, the text of any other value.
+ * \return
+ */
+QString OMCValue::toString() const
+{
+  QStringRef text = getText();
+  if (getType() != String || !text.contains('\\')) {
+    return text.toString();
+  }
+  QString result;
+  result.reserve(text.size());
+  const QChar *pData = text.unicode();
+  int length = text.size();
+  for (int i = 0 ; i < length ; i++) {
+    if (pData[i] != '\\') {
+      result.append(pData[i]);
+    } else if (++i < length) {
+      switch (pData[i].toLatin1()) {
+        case '\'': result.append('\''); break;
+        case '"':  result.append('\"'); break;
+        case '?':  result.append('\?'); break;
+        case '\\': result.append('\\'); break;
+        case 'a':  result.append('\a'); break;
+        case 'b':  result.append('\b'); break;
+        case 'f':  result.append('\f'); break;
+        case 'n':  result.append('\n'); break;
+        case 'r':  result.append('\r'); break;
+        case 't':  result.append('\t'); break;
+        case 'v':  result.append('\v'); break;
+        default: break;
+      }
+    }
+  }
+  return result;
+}
+
+/*!
+ * \brief OMCValue::toStringList
+ * Returns the elements converted with toString().
+ * \return
+ */
+QStringList OMCValue::toStringList() const
+{
+  QStringList list;
+  int count = size();
+  list.reserve(count);
+  for (int i = 0 ; i < count ; i++) {
+    list.append(at(i).toString());
+  }
+  return list;
+}
+
+bool OMCValue::toBool() const
+{
+  return getText() == QLatin1String("true");
+}
+
+/* the numbers are converted from QString::fromRawData, which refers to the result instead of copying the text. */
+int OMCValue::toInt() const
+{
+  QStringRef text = getText();
+  return QString::fromRawData(text.unicode(), text.size()).toInt();
+}
+
+qreal OMCValue::toReal() const
+{
+  QStringRef text = getText();
+  return QString::fromRawData(text.unicode(), text.size()).toDouble();
+}
+
+/*!
+ * \brief OMCValueTree::OMCValueTree
+ * Parses the result. On a syntax error the tree is invalid and getErrorString() describes the error.
+ * \param result
+ * \param mode
+ */
+OMCValueTree::OMCValueTree(const QString &result, Mode mode)
+  : mResult(result), mpData(mResult.constData()), mLength(mResult.length()), mPosition(0), mDepth(0)
+{
+  mNodes.reserve(mLength / 8 + 1);
+  mChildren.reserve(mLength / 8 + 1);
+  mPendingChildren.reserve(64);
+  if (mode == ArgumentList) {
+    int index = addNode(OMCValue::Tuple, 0, mLength);
+    if (parseElements(QChar(), false)) {
+      finishContainer(index, 0);
+    }
+  } else if (parseValue() >= 0) {
+    skipSpaces();
+    if (mPosition < mLength) {
+      setError(QString("Unexpected text after the value at position %1").arg(mPosition));
+    }
+  }
+  if (!isValid()) {
+    mNodes.clear();
+  }
+  mPendingChildren.clear();
+}
+
+/*!
+ * \brief OMCValueTree::parseValue
+ * Parses the value at the current position and returns its node index, -1 on error.
+ * \return
+ */
+int OMCValueTree::parseValue()
+{
+  skipSpaces();
+  if (mPosition >= mLength) {
+    setError("Unexpected end of the result");
+    return -1;
+  }
+  if (++mDepth > MaxDepth) {
+    setError(QString("Values nested deeper than %1 levels").arg(MaxDepth));
+    return -1;
+  }
+  int start = mPosition;
+  int index;
+  switch (mpData[mPosition].unicode()) {
+    case '"':
+      index = parseString();
+      break;
+    case '{':
+      mPosition++;
+      index = parseList(OMCValue::Array, '}', 0, 0);
+      break;
+    case '(':
+      mPosition++;
+      index = parseList(OMCValue::Tuple, ')', 0, 0);
+      break;
+    default:
+      index = atKeyword(mPosition, "record") ? parseRecord() : parseLiteral();
+      break;
+  }
+  if (index >= 0) {
+    mNodes[index].mSourceStart = start;
+    mNodes[index].mSourceLength = mPosition - start;
+  }
+  mDepth--;
+  return index;
+}
+
+/*!
+ * \brief OMCValueTree::parseString
+ * Parses a string. A quote that is not followed by a space or a separator is taken as a part of the string,
+ * OMC does not always escape the quotes inside strings.
+ * \return
+ */
+int OMCValueTree::parseString()
+{
+  int start = mPosition + 1;
+  for (int i = start ; i < mLength ; i++) {
+    if (mpData[i] == '\\') {
+      i++;
+    } else if (mpData[i] == '"') {
+      if (i + 1 < mLength) {
+        QChar next = mpData[i + 1];
+        if (!next.isSpace() && next != ',' && next != '}' && next != ')' && next != ']' && next != ';' && next != '=') {
+          continue;
+        }
+      }
+      mPosition = i + 1;
+      return addNode(OMCValue::String, start, i - start);
+    }
+  }
+  setError(QString("Unterminated string at position %1").arg(start - 1));
+  return -1;
+}
+
+/*!
+ * \brief OMCValueTree::parseLiteral
+ * Parses a call like Line(..) or a literal. A literal ends at a separator outside of brackets,
+ * spaces are a part of the literal unless they are followed by a separator or the end keyword of a record.
+ * \return
+ */
+int OMCValueTree::parseLiteral()
+{
+  int start = mPosition;
+  int identifierEnd = scanIdentifier(start);
+  if (identifierEnd > start && identifierEnd < mLength && mpData[identifierEnd] == '(') {
+    mPosition = identifierEnd + 1;
+    return parseList(OMCValue::Call, ')', start, identifierEnd - start);
+  }
+  int depth = 0;
+  int i = start;
+  while (i < mLength) {
+    ushort c = mpData[i].unicode();
+    if (c == '"' || c == '\'') {
+      i = skipQuoted(i);
+      continue;
+    } else if (c == '(' || c == '[' || c == '{') {
+      depth++;
+    } else if (c == ')' || c == ']' || c == '}') {
+      if (depth == 0) {
+        break;
+      }
+      depth--;
+    } else if (depth == 0 && (c == ',' || c == ';')) {
+      break;
+    } else if (depth == 0 && mpData[i].isSpace()) {
+      int next = skipSpaces(i);
+      if (next >= mLength || mpData[next] == ',' || mpData[next] == ';' || mpData[next] == ')' || mpData[next] == ']'
+          || mpData[next] == '}' || atKeyword(next, "end")) {
+        break;
+      }
+      i = next;
+      continue;
+    }
+    i++;
+  }
+  if (i == start) {
+    setError(QString("Unexpected character '%1' at position %2").arg(mpData[start]).arg(start));
+    return -1;
+  }
+  mPosition = i;
+  return addNode(OMCValue::Literal, start, i - start);
+}
+
+/*!
+ * \brief OMCValueTree::parseList
+ * Parses the elements of an array, tuple or call. The current position is behind the opening bracket.
+ * \param type
+ * \param end - the closing bracket.
+ * \param nameStart - the name of a call.
+ * \param nameLength
+ * \return
+ */
+int OMCValueTree::parseList(OMCValue::Type type, QChar end, int nameStart, int nameLength)
+{
+  int index = addNode(type, mPosition, 0);
+  mNodes[index].mNameStart = nameStart;
+  mNodes[index].mNameLength = nameLength;
+  int pendingStart = mPendingChildren.size();
+  if (!parseElements(end, false)) {
+    return -1;
+  }
+  mNodes[index].mTextLength = mPosition - mNodes[index].mTextStart;
+  mPosition++;
+  finishContainer(index, pendingStart);
+  return index;
+}
+
+/*!
+ * \brief OMCValueTree::parseRecord
+ * Parses a record like record SimulationResult resultFile = "..", .. end SimulationResult;
+ * \return
+ */
+int OMCValueTree::parseRecord()
+{
+  int nameStart = skipSpaces(mPosition + 6);
+  int nameEnd = scanIdentifier(nameStart);
+  if (nameEnd == nameStart) {
+    setError(QString("Missing record name at position %1").arg(nameStart));
+    return -1;
+  }
+  mPosition = nameEnd;
+  int index = addNode(OMCValue::Record, nameEnd, 0);
+  mNodes[index].mNameStart = nameStart;
+  mNodes[index].mNameLength = nameEnd - nameStart;
+  int pendingStart = mPendingChildren.size();
+  if (!parseElements(QChar(), true)) {
+    return -1;
+  }
+  mNodes[index].mTextLength = mPosition - nameEnd;
+  /* skip end Name; */
+  mPosition = skipSpaces(mPosition + 3);
+  mPosition = skipSpaces(scanIdentifier(mPosition));
+  if (mPosition < mLength && mpData[mPosition] == ';') {
+    mPosition++;
+  }
+  finishContainer(index, pendingStart);
+  return index;
+}
+
+/*!
+ * \brief OMCValueTree::parseElements
+ * Parses comma separated elements up to the end bracket, the end keyword of a record or the end of the result.
+ * The end is not consumed.
+ * \param end - the closing bracket, a null QChar for the end of the result.
+ * \param record
+ * \return
+ */
+bool OMCValueTree::parseElements(QChar end, bool record)
+{
+  skipSpaces();
+  if (atListEnd(end, record)) {
+    return true;
+  }
+  forever {
+    skipSpaces();
+    /* named argument, = but not == */
+    int argumentNameStart = mPosition;
+    int argumentNameEnd = scanIdentifier(mPosition);
+    int equal = skipSpaces(argumentNameEnd);
+    bool named = argumentNameEnd > argumentNameStart && equal < mLength && mpData[equal] == '='
+                 && (equal + 1 >= mLength || mpData[equal + 1] != '=');
+    if (named) {
+      mPosition = equal + 1;
+    }
+    skipSpaces();
+    int child;
+    if ((mPosition < mLength && mpData[mPosition] == ',') || atListEnd(end, record)) {
+      child = addNode(OMCValue::Literal, mPosition, 0);
+    } else {
+      child = parseValue();
+    }
+    if (child < 0) {
+      return false;
+    }
+    if (named) {
+      mNodes[child].mArgumentNameStart = argumentNameStart;
+      mNodes[child].mArgumentNameLength = argumentNameEnd - argumentNameStart;
+    }
+    mPendingChildren.append(child);
+    skipSpaces();
+    if (mPosition < mLength && mpData[mPosition] == ',') {
+      mPosition++;
+      continue;
+    }
+    if (atListEnd(end, record)) {
+      return true;
+    }
+    if (mPosition >= mLength) {
+      setError("Unexpected end of the result");
+    } else {
+      setError(QString("Unexpected character '%1' at position %2").arg(mpData[mPosition]).arg(mPosition));
+    }
+    return false;
+  }
+}
+
+bool OMCValueTree::atListEnd(QChar end, bool record) const
+{
+  if (record) {
+    return atKeyword(mPosition, "end");
+  } else if (end.isNull()) {
+    return mPosition >= mLength;
+  } else {
+    return mPosition < mLength && mpData[mPosition] == end;
+  }
+}
+
+/*!
+ * \brief OMCValueTree::finishContainer
+ * Moves the children of the container from the pending list to mChildren, so that they are stored next to each other.
+ * \param index
+ * \param pendingStart
+ */
+void OMCValueTree::finishContainer(int index, int pendingStart)
+{
+  Node &node = mNodes[index];
+  node.mFirstChild = mChildren.size();
+  node.mChildCount = mPendingChildren.size() - pendingStart;
+  for (int i = pendingStart ; i < mPendingChildren.size() ; i++) {
+    mChildren.append(mPendingChildren.at(i));
+  }
+  mPendingChildren.resize(pendingStart);
+}
+
+int OMCValueTree::addNode(OMCValue::Type type, int textStart, int textLength)
+{
+  Node node;
+  node.mType = type;
+  node.mSourceStart = textStart;
+  node.mSourceLength = textLength;
+  node.mTextStart = textStart;
+  node.mTextLength = textLength;
+  node.mNameStart = 0;
+  node.mNameLength = 0;
+  node.mArgumentNameStart = 0;
+  node.mArgumentNameLength = 0;
+  node.mFirstChild = 0;
+  node.mChildCount = 0;
+  mNodes.append(node);
+  return mNodes.size() - 1;
+}
+
+void OMCValueTree::skipSpaces()
+{
+  mPosition = skipSpaces(mPosition);
+}
+
+int OMCValueTree::skipSpaces(int position) const
+{
+  while (position < mLength && mpData[position].isSpace()) {
+    position++;
+  }
+  return position;
+}
+
+/*!
+ * \brief OMCValueTree::scanIdentifier
+ * Returns the end of the possibly qualified Modelica name at position, position if there is none.
+ * \param position
+ * \return
+ */
+int OMCValueTree::scanIdentifier(int position) const
+{
+  int end = position;
+  int i = position;
+  forever {
+    if (i < mLength && mpData[i] == '\'') {
+      i = skipQuoted(i);
+    } else if (i < mLength && (mpData[i].isLetter() || mpData[i] == '_' || mpData[i] == '$')) {
+      while (i < mLength && (mpData[i].isLetterOrNumber() || mpData[i] == '_' || mpData[i] == '$')) {
+        i++;
+      }
+    } else {
+      return end;
+    }
+    end = i;
+    if (i < mLength && mpData[i] == '.') {
+      i++;
+    } else {
+      return end;
+    }
+  }
+}
+
+/*!
+ * \brief OMCValueTree::skipQuoted
+ * Returns the position behind the string or quoted identifier starting at position.
+ * \param position
+ * \return
+ */
+int OMCValueTree::skipQuoted(int position) const
+{
+  QChar quote = mpData[position];
+  for (int i = position + 1 ; i < mLength ; i++) {
+    if (mpData[i] == '\\') {
+      i++;
+    } else if (mpData[i] == quote) {
+      return i + 1;
+    }
+  }
+  return mLength;
+}
+
+/*!
+ * \brief OMCValueTree::atKeyword
+ * Returns true if the keyword is at position and is not a part of a longer name.
+ * \param position
+ * \param keyword
+ * \return
+ */
+bool OMCValueTree::atKeyword(int position, const char *keyword) const
+{
+  int i = position;
+  for (; *keyword ; keyword++, i++) {
+    if (i >= mLength || mpData[i] != QLatin1Char(*keyword)) {
+      return false;
+    }
+  }
+  return i >= mLength || !(mpData[i].isLetterOrNumber() || mpData[i] == '_');
+}
+
+void OMCValueTree::setError(const QString &message)
+{
+  if (mErrorString.isEmpty()) {
+    mErrorString = message;
+  }
+}
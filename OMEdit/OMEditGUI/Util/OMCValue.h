@@ -0,0 +1,145 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCVALUE_H
+#define OMCVALUE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class OMCValueTree;
+
+/*!
+ * \class OMCValue
+ * \brief Read only handle to a value of a parsed OMC scripting result.
+ * A value is only valid as long as the OMCValueTree it was taken from exists.
+ */
+class OMCValue
+{
+public:
+  enum Type {Invalid, Literal, String, Array, Tuple, Call, Record};
+  OMCValue() : mpTree(0), mIndex(-1) {}
+  Type getType() const;
+  bool isValid() const {return getType() != Invalid;}
+  bool isString() const {return getType() == String;}
+  bool isArray() const {return getType() == Array;}
+  bool isCall() const {return getType() == Call;}
+  int size() const;
+  OMCValue at(int i) const;
+  OMCValue operator[](int i) const {return at(i);}
+  OMCValue value(const QString &argumentName) const;
+  QStringRef getText() const;
+  QStringRef getSource() const;
+  QStringRef getName() const;
+  QStringRef getArgumentName() const;
+  QString toString() const;
+  QStringList toStringList() const;
+  bool toBool() const;
+  int toInt() const;
+  qreal toReal() const;
+private:
+  OMCValue(const OMCValueTree *pTree, int index) : mpTree(pTree), mIndex(index) {}
+
+  const OMCValueTree *mpTree;
+  int mIndex;
+
+  friend class OMCValueTree;
+};
+
+/*!
+ * \class OMCValueTree
+ * \brief Parses an OMC scripting result in a single pass.
+ * The values are stored in one node array and refer to the result by offset, the text is never copied.
+ * Handles arrays {..}, tuples (..), calls like Line(..), records, strings, named arguments and literals.
+ * Literals are everything else up to the next separator, e.g. numbers, booleans, enumeration literals
+ * and expressions. A missing element, like the last one in Placement(true,-,-,), is an empty literal.
+ */
+class OMCValueTree
+{
+public:
+  /* SingleValue parses one value, ArgumentList parses comma separated values like "true, {0, 0}, 0" into a Tuple. */
+  enum Mode {SingleValue, ArgumentList};
+  OMCValueTree(const QString &result, Mode mode = SingleValue);
+  bool isValid() const {return mErrorString.isEmpty();}
+  const QString& getErrorString() const {return mErrorString;}
+  const QString& getResult() const {return mResult;}
+  OMCValue getRoot() const {return OMCValue(this, mNodes.isEmpty() ? -1 : 0);}
+private:
+  struct Node {
+    OMCValue::Type mType;
+    int mSourceStart;
+    int mSourceLength;
+    int mTextStart;
+    int mTextLength;
+    int mNameStart;
+    int mNameLength;
+    int mArgumentNameStart;
+    int mArgumentNameLength;
+    int mFirstChild;
+    int mChildCount;
+  };
+  QString mResult;
+  const QChar *mpData;
+  int mLength;
+  int mPosition;
+  int mDepth;
+  QVector<Node> mNodes;
+  /* the node indexes of the children of all containers, the children of a container are stored next to each other. */
+  QVector<int> mChildren;
+  /* the children of the containers that are being parsed. */
+  QVector<int> mPendingChildren;
+  QString mErrorString;
+
+  int parseValue();
+  int parseString();
+  int parseLiteral();
+  int parseList(OMCValue::Type type, QChar end, int nameStart, int nameLength);
+  int parseRecord();
+  bool parseElements(QChar end, bool record);
+  bool atListEnd(QChar end, bool record) const;
+  void finishContainer(int index, int pendingStart);
+  int addNode(OMCValue::Type type, int textStart, int textLength);
+  void skipSpaces();
+  int skipSpaces(int position) const;
+  int scanIdentifier(int position) const;
+  int skipQuoted(int position) const;
+  bool atKeyword(int position, const char *keyword) const;
+  void setError(const QString &message);
+
+  Q_DISABLE_COPY(OMCValueTree)
+  friend class OMCValue;
+};
+
+#endif // OMCVALUE_H
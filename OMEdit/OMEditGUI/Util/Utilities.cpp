@@ -496,6 +496,28 @@ qreal Utilities::convertUnit(qreal value, qreal offset, qreal scaleFactor)
   return (value - offset) / scaleFactor;
 }
 
+/*!
+ * \brief Utilities::convertUnit
+ * Converts all the values using the unit offset and scale factor.\n
+ * The values are converted in one contiguous loop without any function call per value so that the compiler can vectorize it.
+ * \param pValues
+ * \param size
+ * \param offset
+ * \param scaleFactor
+ * \return the converted values.
+ */
+QVector<double> Utilities::convertUnit(const double *pValues, int size, qreal offset, qreal scaleFactor)
+{
+  QVector<double> values(size);
+  double *pConvertedValues = values.data();
+  const double valueOffset = offset;
+  const double valueScaleFactor = scaleFactor;
+  for (int i = 0 ; i < size ; i++) {
+    pConvertedValues[i] = (pValues[i] - valueOffset) / valueScaleFactor;
+  }
+  return values;
+}
+
 Label* Utilities::getHeadingLabel(QString heading)
 {
   Label *pHeadingLabel = new Label(heading);
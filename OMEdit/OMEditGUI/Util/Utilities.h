@@ -42,6 +42,7 @@
 #include <QDoubleSpinBox>
 #include <QCheckBox>
 #include <QVariant>
+#include <QVector>
 #include <QAbstractMessageHandler>
 #include <QDebug>
 #include <QPlainTextEdit>
@@ -398,6 +399,7 @@ namespace Utilities {
   QSettings* getApplicationSettings();
   void parseMetaModelText(MessageHandler *pMessageHandler, QString contents);
   qreal convertUnit(qreal value, qreal offset, qreal scaleFactor);
+  QVector<double> convertUnit(const double *pValues, int size, qreal offset, qreal scaleFactor);
   Label* getHeadingLabel(QString heading);
   QFrame* getHeadingLine();
   bool detectBOM(QString fileName);
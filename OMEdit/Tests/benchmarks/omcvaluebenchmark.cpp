@@ -0,0 +1,239 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2014, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "OMCValue.h"
+#include "StringHandler.h"
+#include "Utilities.h"
+
+#include <QtTest/QTest>
+#include <QDir>
+#include <QFile>
+
+/* StringHandler.cpp uses Utilities::tempDirectory() for its file dialogs. They are not used here, so don't link Utilities.cpp. */
+QString& Utilities::tempDirectory()
+{
+  static QString tempDirectory = QDir::tempPath();
+  return tempDirectory;
+}
+
+/*!
+ * \brief readReplies
+ * Reads the OMC replies of the file, one reply per line.
+ * Set environmentVariable to run the benchmark on other replies, e.g. written by OMCProxy::logResponse of a real session.
+ * \param environmentVariable
+ * \param defaultFileName
+ * \return
+ */
+static QStringList readReplies(const char *environmentVariable, const QString &defaultFileName)
+{
+  QString fileName = QString::fromLocal8Bit(qgetenv(environmentVariable));
+  if (fileName.isEmpty()) {
+    fileName = defaultFileName;
+  }
+  QStringList replies;
+  QFile file(fileName);
+  if (file.open(QIODevice::ReadOnly)) {
+    foreach (const QString &reply, QString::fromUtf8(file.readAll()).split('\n')) {
+      if (!reply.trimmed().isEmpty()) {
+        replies.append(reply.trimmed());
+      }
+    }
+  }
+  return replies;
+}
+
+/*!
+ * \brief sumStringHandlerValues
+ * Splits the value the way the shapes did before OMCValueTree, every array is split again with
+ * StringHandler::removeFirstLastCurlBrackets and StringHandler::getStrings, and converts the other values to numbers.
+ * \param value
+ * \return the sum of the numbers so the work is not optimized away.
+ */
+static qreal sumStringHandlerValues(const QString &value)
+{
+  if (!value.startsWith('{')) {
+    return value.toDouble();
+  }
+  qreal sum = 0;
+  foreach (const QString &element, StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(value))) {
+    sum += sumStringHandlerValues(element);
+  }
+  return sum;
+}
+
+/*!
+ * \brief sumOMCValues
+ * Walks the parsed value and converts the literals to numbers.
+ * \param value
+ * \return the sum of the numbers so the work is not optimized away.
+ */
+static qreal sumOMCValues(const OMCValue &value)
+{
+  if (value.getType() == OMCValue::Literal) {
+    return value.toReal();
+  }
+  qreal sum = 0;
+  for (int i = 0 ; i < value.size() ; i++) {
+    sum += sumOMCValues(value.at(i));
+  }
+  return sum;
+}
+
+/*!
+ * \class OMCValueBenchmark
+ * \brief Compares OMCValueTree with the StringHandler functions on getIconAnnotation and getComponents replies.
+ */
+class OMCValueBenchmark : public QObject
+{
+  Q_OBJECT
+private slots:
+  void initTestCase();
+  void iconAnnotationStringHandler();
+  void iconAnnotationOMCValueTree();
+  void componentsStringHandler();
+  void componentsOMCValueTree();
+private:
+  QStringList mIconAnnotations;
+  QStringList mComponents;
+};
+
+void OMCValueBenchmark::initTestCase()
+{
+  mIconAnnotations = readReplies("OMEDIT_BENCHMARK_ICON_ANNOTATIONS", QFINDTESTDATA("data/getIconAnnotation.txt"));
+  mComponents = readReplies("OMEDIT_BENCHMARK_COMPONENTS", QFINDTESTDATA("data/getComponents.txt"));
+  QVERIFY(!mIconAnnotations.isEmpty());
+  QVERIFY(!mComponents.isEmpty());
+  foreach (const QString &reply, mIconAnnotations + mComponents) {
+    OMCValueTree tree(reply);
+    QVERIFY2(tree.isValid(), qPrintable(tree.getErrorString()));
+  }
+}
+
+/*!
+ * \brief OMCValueBenchmark::iconAnnotationStringHandler
+ * The coordinate system and the graphic items as ModelWidget::getModelIconDiagramShapes and the shapes parsed them before
+ * OMCValueTree. Each shape split its arguments once in GraphicItem::parseShapeAnnotation and once in its own parseShapeAnnotation.
+ */
+void OMCValueBenchmark::iconAnnotationStringHandler()
+{
+  qreal sum = 0;
+  QBENCHMARK {
+    foreach (const QString &reply, mIconAnnotations) {
+      QStringList list = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(reply));
+      if (list.size() < 9) {
+        continue;
+      }
+      for (int i = 0 ; i < 8 ; i++) {
+        sum += list.at(i).toDouble();
+      }
+      QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)), '(', ')');
+      foreach (QString shape, shapesList) {
+        shape = StringHandler::removeFirstLastBrackets(shape.mid(shape.indexOf('(')));
+        sum += StringHandler::getStrings(shape).size();
+        foreach (const QString &argument, StringHandler::getStrings(shape)) {
+          sum += sumStringHandlerValues(argument);
+        }
+      }
+    }
+  }
+  Q_UNUSED(sum);
+}
+
+/*!
+ * \brief OMCValueBenchmark::iconAnnotationOMCValueTree
+ * The coordinate system and the graphic items as OMCProxy::parseGraphicsAnnotation and the shapes parse them now.
+ */
+void OMCValueBenchmark::iconAnnotationOMCValueTree()
+{
+  qreal sum = 0;
+  QBENCHMARK {
+    foreach (const QString &reply, mIconAnnotations) {
+      OMCValueTree tree(reply);
+      OMCValue list = tree.getRoot();
+      if (list.size() < 9) {
+        continue;
+      }
+      for (int i = 0 ; i < 8 ; i++) {
+        sum += list.at(i).toReal();
+      }
+      OMCValue shapes = list.at(8);
+      for (int i = 0 ; i < shapes.size() ; i++) {
+        sum += sumOMCValues(shapes.at(i));
+      }
+    }
+  }
+  Q_UNUSED(sum);
+}
+
+/*!
+ * \brief OMCValueBenchmark::componentsStringHandler
+ * The components as OMCProxy::getComponents split them with StringHandler::unparseArrays before OMCValueTree.
+ */
+void OMCValueBenchmark::componentsStringHandler()
+{
+  int count = 0;
+  QBENCHMARK {
+    foreach (const QString &reply, mComponents) {
+      foreach (const QString &component, StringHandler::unparseArrays(reply)) {
+        count += StringHandler::getStrings(component).size();
+      }
+    }
+  }
+  Q_UNUSED(count);
+}
+
+/*!
+ * \brief OMCValueBenchmark::componentsOMCValueTree
+ * The components as OMCProxy::getComponents reads them now.
+ */
+void OMCValueBenchmark::componentsOMCValueTree()
+{
+  int count = 0;
+  QBENCHMARK {
+    foreach (const QString &reply, mComponents) {
+      OMCValueTree tree(reply);
+      OMCValue components = tree.getRoot();
+      for (int i = 0 ; i < components.size() ; i++) {
+        OMCValue component = components.at(i);
+        for (int j = 0 ; j < component.size() ; j++) {
+          count += component.at(j).toString().size();
+        }
+      }
+    }
+  }
+  Q_UNUSED(count);
+}
+
+QTEST_MAIN(OMCValueBenchmark)
+#include "omcvaluebenchmark.moc"
@@ -0,0 +1,865 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "document.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSharedData>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include <algorithm>
+#include <cstring>
+
+namespace QJson {
+
+  struct DocumentNode
+  {
+    enum Kind {
+      Null,
+      False,
+      True,
+      UnsignedInteger,
+      Integer,
+      Double,
+      SourceString,
+      ArenaString,
+      Array,
+      Object
+    };
+
+    qint32 kind;
+    // number of bytes of a string or number of children of a container
+    qint32 size;
+    union {
+      // strings: offset into the input or the arena, containers: offset into the children
+      qint64 offset;
+      qlonglong integer;
+      qulonglong unsignedInteger;
+      double real;
+    };
+  };
+}
+
+Q_DECLARE_TYPEINFO(QJson::DocumentNode, Q_PRIMITIVE_TYPE);
+
+using namespace QJson;
+
+namespace QJson {
+
+  /*
+   * The nodes are stored in the order their values start in the input, so
+   * the top level value is node 0. Arrays refer to a run of child node
+   * indexes in m_children, objects to a run of (key, value) index pairs
+   * sorted by the UTF-8 bytes of the keys.
+   */
+  class DocumentPrivate : public QSharedData
+  {
+    public:
+      DocumentPrivate() : m_file(0), m_valid(false), m_errorLine(0) {}
+      ~DocumentPrivate() { delete m_file; }
+
+      const char* stringData(const DocumentNode& node) const
+      {
+        return (node.kind == DocumentNode::ArenaString ? m_arena.constData() : m_source.constData()) + node.offset;
+      }
+
+      int compareKeys(int a, int b) const;
+      int findMember(const DocumentNode& object, const char* key, int keySize) const;
+      QVariant toVariant(int index) const;
+
+      QByteArray m_source;
+      QFile* m_file;
+      QVector<DocumentNode> m_nodes;
+      QVector<int> m_children;
+      QByteArray m_arena;
+      bool m_valid;
+      QString m_errorMsg;
+      int m_errorLine;
+  };
+
+  /*
+   * Builds the nodes of a document in one pass over the input. Containers
+   * are kept on an explicit stack, their children are collected in
+   * m_scratch and moved to the children array once the container is closed,
+   * which keeps the children of every container contiguous.
+   */
+  class DocumentBuilder
+  {
+    public:
+      explicit DocumentBuilder(DocumentPrivate* document);
+
+      bool parse();
+
+      struct Frame {
+        int node;
+        int scratchStart;
+      };
+
+      struct Entry {
+        int key;
+        int value;
+      };
+
+      struct EntryLessThan {
+        const DocumentPrivate* d;
+        bool operator()(const Entry& a, const Entry& b) const { return d->compareKeys(a.key, b.key) < 0; }
+      };
+
+    private:
+      bool setError(const QString& errorMsg);
+      void skipWhitespace();
+      int addNode(DocumentNode::Kind kind);
+      bool parseKey();
+      bool parseScalar(int* node);
+      bool parseString(int* node);
+      bool parseNumber(int* node);
+      bool parseLiteral(const char* literal, DocumentNode::Kind kind, int* node);
+      bool parseHex(int pos, uint* code) const;
+      void appendUtf8(uint code);
+      int closeContainer();
+
+      DocumentPrivate* d;
+      const char* m_data;
+      int m_size;
+      int m_pos;
+      QVector<int> m_scratch;
+      QVector<Frame> m_frames;
+      QVector<Entry> m_entries;
+  };
+}
+
+Q_DECLARE_TYPEINFO(QJson::DocumentBuilder::Frame, Q_PRIMITIVE_TYPE);
+Q_DECLARE_TYPEINFO(QJson::DocumentBuilder::Entry, Q_PRIMITIVE_TYPE);
+
+int DocumentPrivate::compareKeys(int a, int b) const
+{
+  const DocumentNode& keyA = m_nodes.at(a);
+  const DocumentNode& keyB = m_nodes.at(b);
+  int result = memcmp(stringData(keyA), stringData(keyB), qMin(keyA.size, keyB.size));
+  return result != 0 ? result : keyA.size - keyB.size;
+}
+
+int DocumentPrivate::findMember(const DocumentNode& object, const char* key, int keySize) const
+{
+  int low = 0;
+  int high = object.size - 1;
+  while (low <= high) {
+    int middle = (low + high) / 2;
+    const DocumentNode& middleKey = m_nodes.at(m_children.at(object.offset + 2 * middle));
+    int result = memcmp(stringData(middleKey), key, qMin(middleKey.size, keySize));
+    if (result == 0)
+      result = middleKey.size - keySize;
+    if (result < 0)
+      low = middle + 1;
+    else if (result > 0)
+      high = middle - 1;
+    else
+      return m_children.at(object.offset + 2 * middle + 1);
+  }
+  return -1;
+}
+
+QVariant DocumentPrivate::toVariant(int index) const
+{
+  const DocumentNode& node = m_nodes.at(index);
+  switch (node.kind) {
+    case DocumentNode::False:
+      return QVariant(false);
+    case DocumentNode::True:
+      return QVariant(true);
+    case DocumentNode::UnsignedInteger:
+      return QVariant(node.unsignedInteger);
+    case DocumentNode::Integer:
+      return QVariant(node.integer);
+    case DocumentNode::Double:
+      return QVariant(node.real);
+    case DocumentNode::SourceString:
+    case DocumentNode::ArenaString:
+      return QVariant(QString::fromUtf8(stringData(node), node.size));
+    case DocumentNode::Array: {
+      QVariantList list;
+      list.reserve(node.size);
+      for (int i = 0; i < node.size; ++i)
+        list.append(toVariant(m_children.at(node.offset + i)));
+      return list;
+    }
+    case DocumentNode::Object: {
+      QVariantMap map;
+      for (int i = 0; i < node.size; ++i) {
+        const DocumentNode& key = m_nodes.at(m_children.at(node.offset + 2 * i));
+        map.insert(QString::fromUtf8(stringData(key), key.size), toVariant(m_children.at(node.offset + 2 * i + 1)));
+      }
+      return map;
+    }
+    default:
+      return QVariant();
+  }
+}
+
+DocumentBuilder::DocumentBuilder(DocumentPrivate* document) :
+  d(document),
+  m_data(document->m_source.constData()),
+  m_size(document->m_source.size()),
+  m_pos(0)
+{
+}
+
+bool DocumentBuilder::setError(const QString& errorMsg)
+{
+  d->m_valid = false;
+  d->m_errorMsg = errorMsg;
+  // the line is only needed on errors, so it is not tracked while parsing
+  d->m_errorLine = 1 + int(std::count(m_data, m_data + m_pos, '\n'));
+  d->m_nodes.clear();
+  d->m_children.clear();
+  d->m_arena.clear();
+  return false;
+}
+
+void DocumentBuilder::skipWhitespace()
+{
+  while (m_pos < m_size) {
+    const char c = m_data[m_pos];
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+      break;
+    ++m_pos;
+  }
+}
+
+int DocumentBuilder::addNode(DocumentNode::Kind kind)
+{
+  DocumentNode node;
+  node.kind = kind;
+  node.size = 0;
+  node.offset = 0;
+  d->m_nodes.append(node);
+  return d->m_nodes.size() - 1;
+}
+
+bool DocumentBuilder::parse()
+{
+  skipWhitespace();
+  if (m_pos == m_size)
+    return setError(QLatin1String("No data"));
+
+  forever {
+    // a value starts at m_pos
+    if (m_pos == m_size)
+      return setError(QLatin1String("Unexpected end of data"));
+
+    int node;
+    const char c = m_data[m_pos];
+    if (c == '{' || c == '[') {
+      Frame frame;
+      frame.node = addNode(c == '{' ? DocumentNode::Object : DocumentNode::Array);
+      frame.scratchStart = m_scratch.size();
+      m_frames.append(frame);
+      ++m_pos;
+      skipWhitespace();
+      if (m_pos < m_size && m_data[m_pos] == (c == '{' ? '}' : ']')) {
+        ++m_pos;
+        node = closeContainer();
+      } else if (c == '{') {
+        if (!parseKey())
+          return false;
+        continue;
+      } else {
+        continue;
+      }
+    } else if (!parseScalar(&node)) {
+      return false;
+    }
+
+    // the value is complete, close all containers it completes
+    forever {
+      if (m_frames.isEmpty()) {
+        skipWhitespace();
+        if (m_pos != m_size)
+          return setError(QLatin1String("Unexpected data after the end of the document"));
+        return true;
+      }
+      m_scratch.append(node);
+      skipWhitespace();
+      if (m_pos == m_size)
+        return setError(QLatin1String("Unexpected end of data"));
+      const bool isObject = d->m_nodes.at(m_frames.last().node).kind == DocumentNode::Object;
+      const char next = m_data[m_pos];
+      if (next == ',') {
+        ++m_pos;
+        skipWhitespace();
+        if (isObject && !parseKey())
+          return false;
+        break;
+      }
+      if (next != (isObject ? '}' : ']'))
+        return setError(QLatin1String(isObject ? "Expected ',' or '}'" : "Expected ',' or ']'"));
+      ++m_pos;
+      node = closeContainer();
+    }
+  }
+}
+
+bool DocumentBuilder::parseKey()
+{
+  if (m_pos == m_size || m_data[m_pos] != '"')
+    return setError(QLatin1String("Expected a key"));
+  int key;
+  if (!parseString(&key))
+    return false;
+  m_scratch.append(key);
+  skipWhitespace();
+  if (m_pos == m_size || m_data[m_pos] != ':')
+    return setError(QLatin1String("Expected ':'"));
+  ++m_pos;
+  skipWhitespace();
+  return true;
+}
+
+bool DocumentBuilder::parseScalar(int* node)
+{
+  switch (m_data[m_pos]) {
+    case '"':
+      return parseString(node);
+    case 't':
+      return parseLiteral("true", DocumentNode::True, node);
+    case 'f':
+      return parseLiteral("false", DocumentNode::False, node);
+    case 'n':
+      return parseLiteral("null", DocumentNode::Null, node);
+    default:
+      return parseNumber(node);
+  }
+}
+
+bool DocumentBuilder::parseLiteral(const char* literal, DocumentNode::Kind kind, int* node)
+{
+  const int length = qstrlen(literal);
+  if (m_size - m_pos < length || memcmp(m_data + m_pos, literal, length) != 0)
+    return setError(QLatin1String("Invalid literal"));
+  m_pos += length;
+  *node = addNode(kind);
+  return true;
+}
+
+/*
+ * Strings without escape sequences are the common case and stay in the
+ * input. Otherwise the unescaped UTF-8 bytes are appended to the arena.
+ */
+bool DocumentBuilder::parseString(int* node)
+{
+  const int start = ++m_pos;
+  int i = start;
+  while (i < m_size && m_data[i] != '"' && m_data[i] != '\\')
+    ++i;
+  if (i == m_size)
+    return setError(QLatin1String("Unterminated string"));
+
+  if (m_data[i] == '"') {
+    *node = addNode(DocumentNode::SourceString);
+    d->m_nodes[*node].offset = start;
+    d->m_nodes[*node].size = i - start;
+    m_pos = i + 1;
+    return true;
+  }
+
+  const int arenaStart = d->m_arena.size();
+  int segment = start;
+  forever {
+    while (i < m_size && m_data[i] != '"' && m_data[i] != '\\')
+      ++i;
+    if (i == m_size)
+      return setError(QLatin1String("Unterminated string"));
+    d->m_arena.append(m_data + segment, i - segment);
+    if (m_data[i] == '"')
+      break;
+
+    if (i + 1 == m_size)
+      return setError(QLatin1String("Unterminated string"));
+    switch (m_data[i + 1]) {
+      case '"': d->m_arena.append('"'); break;
+      case '\\': d->m_arena.append('\\'); break;
+      case '/': d->m_arena.append('/'); break;
+      case 'b': d->m_arena.append('\b'); break;
+      case 'f': d->m_arena.append('\f'); break;
+      case 'n': d->m_arena.append('\n'); break;
+      case 'r': d->m_arena.append('\r'); break;
+      case 't': d->m_arena.append('\t'); break;
+      case 'u': {
+        uint code;
+        if (!parseHex(i + 2, &code))
+          return setError(QLatin1String("Invalid hex string"));
+        i += 4;
+        // a high surrogate is combined with the low surrogate following it
+        uint low;
+        if (code >= 0xd800 && code < 0xdc00 && i + 7 < m_size && m_data[i + 2] == '\\' && m_data[i + 3] == 'u'
+            && parseHex(i + 4, &low) && low >= 0xdc00 && low < 0xe000) {
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+          i += 6;
+        } else if (code >= 0xd800 && code < 0xe000) {
+          code = 0xfffd;
+        }
+        appendUtf8(code);
+        break;
+      }
+      default:
+        // like the scanner, an unknown escape drops the backslash only
+        ++i;
+        segment = i;
+        continue;
+    }
+    i += 2;
+    segment = i;
+  }
+
+  *node = addNode(DocumentNode::ArenaString);
+  d->m_nodes[*node].offset = arenaStart;
+  d->m_nodes[*node].size = d->m_arena.size() - arenaStart;
+  m_pos = i + 1;
+  return true;
+}
+
+bool DocumentBuilder::parseHex(int pos, uint* code) const
+{
+  if (m_size - pos < 4)
+    return false;
+  *code = 0;
+  for (int i = pos; i < pos + 4; ++i) {
+    const char hex = m_data[i];
+    *code <<= 4;
+    if (hex >= '0' && hex <= '9')
+      *code |= hex - '0';
+    else if (hex >= 'a' && hex <= 'f')
+      *code |= hex - 'a' + 10;
+    else if (hex >= 'A' && hex <= 'F')
+      *code |= hex - 'A' + 10;
+    else
+      return false;
+  }
+  return true;
+}
+
+void DocumentBuilder::appendUtf8(uint code)
+{
+  QByteArray& arena = d->m_arena;
+  if (code < 0x80) {
+    arena.append(char(code));
+  } else if (code < 0x800) {
+    arena.append(char(0xc0 | (code >> 6)));
+    arena.append(char(0x80 | (code & 0x3f)));
+  } else if (code < 0x10000) {
+    arena.append(char(0xe0 | (code >> 12)));
+    arena.append(char(0x80 | ((code >> 6) & 0x3f)));
+    arena.append(char(0x80 | (code & 0x3f)));
+  } else {
+    arena.append(char(0xf0 | (code >> 18)));
+    arena.append(char(0x80 | ((code >> 12) & 0x3f)));
+    arena.append(char(0x80 | ((code >> 6) & 0x3f)));
+    arena.append(char(0x80 | (code & 0x3f)));
+  }
+}
+
+bool DocumentBuilder::parseNumber(int* node)
+{
+  const int start = m_pos;
+  int i = m_pos;
+  bool isNegative = false;
+  bool isDouble = false;
+
+  if (i < m_size && m_data[i] == '-') {
+    isNegative = true;
+    ++i;
+  }
+  if (i == m_size || m_data[i] < '0' || m_data[i] > '9')
+    return setError(QLatin1String("Unexpected character '") + QLatin1Char(m_data[start]) + QLatin1Char('\''));
+
+  // integers are accumulated directly, the input need not be null terminated
+  qulonglong magnitude = 0;
+  bool overflow = false;
+  if (m_data[i] == '0') {
+    ++i;
+  } else {
+    while (i < m_size && m_data[i] >= '0' && m_data[i] <= '9') {
+      const uint digit = m_data[i] - '0';
+      if (magnitude > (Q_UINT64_C(18446744073709551615) - digit) / 10)
+        overflow = true;
+      magnitude = magnitude * 10 + digit;
+      ++i;
+    }
+  }
+
+  if (i < m_size && m_data[i] == '.') {
+    isDouble = true;
+    ++i;
+    if (i == m_size || m_data[i] < '0' || m_data[i] > '9')
+      return setError(QLatin1String("Invalid number"));
+    while (i < m_size && m_data[i] >= '0' && m_data[i] <= '9')
+      ++i;
+  }
+
+  if (i < m_size && (m_data[i] == 'e' || m_data[i] == 'E')) {
+    isDouble = true;
+    ++i;
+    if (i < m_size && (m_data[i] == '+' || m_data[i] == '-'))
+      ++i;
+    if (i == m_size || m_data[i] < '0' || m_data[i] > '9')
+      return setError(QLatin1String("Invalid number"));
+    while (i < m_size && m_data[i] >= '0' && m_data[i] <= '9')
+      ++i;
+  }
+
+  m_pos = i;
+  if (isDouble) {
+    bool ok;
+    // QByteArray::toDouble does not depend on the locale
+    const double value = QByteArray(m_data + start, i - start).toDouble(&ok);
+    if (!ok)
+      return setError(QLatin1String("Number is out of range: ") + QString::fromLatin1(m_data + start, i - start));
+    *node = addNode(DocumentNode::Double);
+    d->m_nodes[*node].real = value;
+  } else if (isNegative) {
+    if (overflow || magnitude > Q_UINT64_C(9223372036854775808))
+      return setError(QLatin1String("Number is out of range: ") + QString::fromLatin1(m_data + start, i - start));
+    *node = addNode(DocumentNode::Integer);
+    d->m_nodes[*node].integer = qlonglong(0 - magnitude);
+  } else {
+    if (overflow)
+      return setError(QLatin1String("Number is out of range: ") + QString::fromLatin1(m_data + start, i - start));
+    *node = addNode(DocumentNode::UnsignedInteger);
+    d->m_nodes[*node].unsignedInteger = magnitude;
+  }
+  return true;
+}
+
+/*
+ * Moves the children of the innermost container from the scratch stack to
+ * the children array. Object members are sorted by key; of duplicate keys
+ * the last one wins, like in Parser.
+ */
+int DocumentBuilder::closeContainer()
+{
+  const Frame frame = m_frames.last();
+  m_frames.removeLast();
+  const int count = m_scratch.size() - frame.scratchStart;
+  const int* children = m_scratch.constData() + frame.scratchStart;
+  const int offset = d->m_children.size();
+
+  if (d->m_nodes.at(frame.node).kind == DocumentNode::Array) {
+    d->m_children.resize(offset + count);
+    memcpy(d->m_children.data() + offset, children, count * sizeof(int));
+    d->m_nodes[frame.node].offset = offset;
+    d->m_nodes[frame.node].size = count;
+  } else {
+    m_entries.resize(count / 2);
+    for (int i = 0; i < m_entries.size(); ++i) {
+      m_entries[i].key = children[2 * i];
+      m_entries[i].value = children[2 * i + 1];
+    }
+    EntryLessThan lessThan;
+    lessThan.d = d;
+    std::stable_sort(m_entries.begin(), m_entries.end(), lessThan);
+    int size = 0;
+    for (int i = 0; i < m_entries.size(); ++i) {
+      if (i + 1 < m_entries.size() && d->compareKeys(m_entries.at(i).key, m_entries.at(i + 1).key) == 0)
+        continue;
+      d->m_children.append(m_entries.at(i).key);
+      d->m_children.append(m_entries.at(i).value);
+      ++size;
+    }
+    d->m_nodes[frame.node].offset = offset;
+    d->m_nodes[frame.node].size = size;
+  }
+
+  m_scratch.resize(frame.scratchStart);
+  return frame.node;
+}
+
+Value::Value() :
+  m_document(0),
+  m_index(-1)
+{
+}
+
+Value::Value(const DocumentPrivate* document, int index) :
+  m_document(index >= 0 ? document : 0),
+  m_index(index)
+{
+}
+
+Value::Type Value::type() const
+{
+  if (!m_document)
+    return Undefined;
+  switch (m_document->m_nodes.at(m_index).kind) {
+    case DocumentNode::Null:
+      return Null;
+    case DocumentNode::False:
+    case DocumentNode::True:
+      return Bool;
+    case DocumentNode::UnsignedInteger:
+    case DocumentNode::Integer:
+    case DocumentNode::Double:
+      return Number;
+    case DocumentNode::SourceString:
+    case DocumentNode::ArenaString:
+      return String;
+    case DocumentNode::Array:
+      return Array;
+    default:
+      return Object;
+  }
+}
+
+bool Value::isInteger() const
+{
+  if (!m_document)
+    return false;
+  const int kind = m_document->m_nodes.at(m_index).kind;
+  return kind == DocumentNode::UnsignedInteger || kind == DocumentNode::Integer;
+}
+
+bool Value::toBool(bool defaultValue) const
+{
+  if (!isBool())
+    return defaultValue;
+  return m_document->m_nodes.at(m_index).kind == DocumentNode::True;
+}
+
+int Value::toInt(int defaultValue) const
+{
+  return int(toLongLong(defaultValue));
+}
+
+qlonglong Value::toLongLong(qlonglong defaultValue) const
+{
+  if (!m_document)
+    return defaultValue;
+  const DocumentNode& node = m_document->m_nodes.at(m_index);
+  switch (node.kind) {
+    case DocumentNode::UnsignedInteger:
+      return qlonglong(node.unsignedInteger);
+    case DocumentNode::Integer:
+      return node.integer;
+    case DocumentNode::Double:
+      return qlonglong(node.real);
+    default:
+      return defaultValue;
+  }
+}
+
+qulonglong Value::toULongLong(qulonglong defaultValue) const
+{
+  if (!m_document)
+    return defaultValue;
+  const DocumentNode& node = m_document->m_nodes.at(m_index);
+  switch (node.kind) {
+    case DocumentNode::UnsignedInteger:
+      return node.unsignedInteger;
+    case DocumentNode::Integer:
+      return qulonglong(node.integer);
+    case DocumentNode::Double:
+      return qulonglong(node.real);
+    default:
+      return defaultValue;
+  }
+}
+
+double Value::toDouble(double defaultValue) const
+{
+  if (!m_document)
+    return defaultValue;
+  const DocumentNode& node = m_document->m_nodes.at(m_index);
+  switch (node.kind) {
+    case DocumentNode::UnsignedInteger:
+      return double(node.unsignedInteger);
+    case DocumentNode::Integer:
+      return double(node.integer);
+    case DocumentNode::Double:
+      return node.real;
+    default:
+      return defaultValue;
+  }
+}
+
+QString Value::toString() const
+{
+  if (!isString())
+    return QString();
+  return QString::fromUtf8(stringData(), stringSize());
+}
+
+QByteArray Value::toUtf8() const
+{
+  if (!isString())
+    return QByteArray();
+  return QByteArray(stringData(), stringSize());
+}
+
+const char* Value::stringData() const
+{
+  if (!isString())
+    return 0;
+  return m_document->stringData(m_document->m_nodes.at(m_index));
+}
+
+int Value::stringSize() const
+{
+  if (!isString())
+    return 0;
+  return m_document->m_nodes.at(m_index).size;
+}
+
+int Value::size() const
+{
+  if (!isArray() && !isObject())
+    return 0;
+  return m_document->m_nodes.at(m_index).size;
+}
+
+Value Value::at(int i) const
+{
+  if (i < 0 || i >= size())
+    return Value();
+  const DocumentNode& node = m_document->m_nodes.at(m_index);
+  if (node.kind == DocumentNode::Array)
+    return Value(m_document, m_document->m_children.at(node.offset + i));
+  return Value(m_document, m_document->m_children.at(node.offset + 2 * i + 1));
+}
+
+QString Value::keyAt(int i) const
+{
+  if (!isObject() || i < 0 || i >= size())
+    return QString();
+  const DocumentNode& node = m_document->m_nodes.at(m_index);
+  return Value(m_document, m_document->m_children.at(node.offset + 2 * i)).toString();
+}
+
+Value Value::value(const QString& key) const
+{
+  if (!isObject())
+    return Value();
+  const QByteArray utf8 = key.toUtf8();
+  return Value(m_document, m_document->findMember(m_document->m_nodes.at(m_index), utf8.constData(), utf8.size()));
+}
+
+Value Value::value(const char* key) const
+{
+  if (!isObject())
+    return Value();
+  return Value(m_document, m_document->findMember(m_document->m_nodes.at(m_index), key, qstrlen(key)));
+}
+
+QVariant Value::toVariant() const
+{
+  if (!m_document)
+    return QVariant();
+  return m_document->toVariant(m_index);
+}
+
+Document::Document()
+{
+}
+
+Document::Document(const Document& other) :
+  d(other.d)
+{
+}
+
+Document::~Document()
+{
+}
+
+Document& Document::operator=(const Document& other)
+{
+  d = other.d;
+  return *this;
+}
+
+Document Document::fromJson(const QByteArray& json, bool* ok)
+{
+  Document document;
+  document.d = new DocumentPrivate;
+  document.d->m_source = json;
+  DocumentBuilder builder(document.d.data());
+  document.d->m_valid = builder.parse();
+  // release the growth reserve, the document does not change anymore
+  document.d->m_nodes.squeeze();
+  document.d->m_children.squeeze();
+  document.d->m_arena.squeeze();
+  if (ok != 0)
+    *ok = document.d->m_valid;
+  return document;
+}
+
+Document Document::fromFile(const QString& fileName, bool* ok)
+{
+  QFile* file = new QFile(fileName);
+  if (!file->open(QIODevice::ReadOnly)) {
+    Document document;
+    document.d = new DocumentPrivate;
+    document.d->m_errorMsg = file->errorString();
+    delete file;
+    if (ok != 0)
+      *ok = false;
+    return document;
+  }
+  QByteArray json;
+  uchar* data = file->size() > 0 && file->size() < 0x7fffffff ? file->map(0, file->size()) : 0;
+  if (data) {
+    json = QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(file->size()));
+  } else {
+    json = file->readAll();
+  }
+  Document document = fromJson(json, ok);
+  // the mapping lives as long as the file object
+  document.d->m_file = file;
+  return document;
+}
+
+bool Document::isValid() const
+{
+  return d && d->m_valid;
+}
+
+Value Document::root() const
+{
+  if (!isValid())
+    return Value();
+  return Value(d.data(), 0);
+}
+
+QString Document::errorString() const
+{
+  return d ? d->m_errorMsg : QString();
+}
+
+int Document::errorLine() const
+{
+  return d ? d->m_errorLine : 0;
+}
+
+qint64 Document::memoryUsage() const
+{
+  if (!d)
+    return 0;
+  return qint64(d->m_nodes.capacity()) * sizeof(DocumentNode) + qint64(d->m_children.capacity()) * sizeof(int)
+      + d->m_arena.capacity();
+}
@@ -0,0 +1,219 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef QJSON_DOCUMENT_H
+#define QJSON_DOCUMENT_H
+
+#include "qjson_export.h"
+
+#include <QtCore/QExplicitlySharedDataPointer>
+#include <QtCore/QMetaType>
+
+QT_BEGIN_NAMESPACE
+class QByteArray;
+class QString;
+class QVariant;
+QT_END_NAMESPACE
+
+namespace QJson {
+
+  class DocumentPrivate;
+
+  /**
+   * @brief Read only handle to a value inside a Document
+   *
+   * A Value is two words large and cheap to copy. It is only valid as long
+   * as the Document it was taken from, or a copy of it, exists.
+   */
+  class QJSON_EXPORT Value
+  {
+    public:
+      enum Type {
+        Undefined,
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+      };
+
+      /**
+       * Creates an Undefined value
+       */
+      Value();
+
+      Type type() const;
+      bool isUndefined() const { return type() == Undefined; }
+      bool isNull() const { return type() == Null; }
+      bool isBool() const { return type() == Bool; }
+      bool isNumber() const { return type() == Number; }
+      bool isString() const { return type() == String; }
+      bool isArray() const { return type() == Array; }
+      bool isObject() const { return type() == Object; }
+
+      /**
+       * @returns true if the value is a number without fraction and exponent
+       */
+      bool isInteger() const;
+
+      bool toBool(bool defaultValue = false) const;
+      int toInt(int defaultValue = 0) const;
+      qlonglong toLongLong(qlonglong defaultValue = 0) const;
+      qulonglong toULongLong(qulonglong defaultValue = 0) const;
+      double toDouble(double defaultValue = 0) const;
+      QString toString() const;
+      QByteArray toUtf8() const;
+
+      /**
+       * @returns the UTF-8 bytes of a string without copying them. For
+       * strings without escape sequences this points into the input data.
+       * The data is not null terminated.
+       * @sa stringSize
+       */
+      const char* stringData() const;
+
+      /**
+       * @returns the number of UTF-8 bytes of a string
+       * @sa stringData
+       */
+      int stringSize() const;
+
+      /**
+       * @returns the number of elements of an array or members of an object, 0 otherwise
+       */
+      int size() const;
+
+      /**
+       * @returns the element @a i of an array or the value of the member
+       * @a i of an object in key order, Undefined if @a i is out of range
+       */
+      Value at(int i) const;
+
+      /**
+       * @returns the key of the member @a i of an object in key order
+       */
+      QString keyAt(int i) const;
+
+      /**
+       * Looks up the member @a key of an object with a binary search.
+       * @returns the value of the member or Undefined if there is none
+       */
+      Value value(const QString& key) const;
+
+      /**
+       * @overload
+       * @param key UTF-8 encoded, null terminated key
+       */
+      Value value(const char* key) const;
+
+      Value operator[](int i) const { return at(i); }
+      Value operator[](const QString& key) const { return value(key); }
+      Value operator[](const char* key) const { return value(key); }
+
+      /**
+       * Converts the value and its children to the QVariant Parser would return
+       */
+      QVariant toVariant() const;
+
+    private:
+      Value(const DocumentPrivate* document, int index);
+
+      const DocumentPrivate* m_document;
+      int m_index;
+
+      friend class Document;
+  };
+
+  /**
+   * @brief Immutable JSON document stored without QVariant
+   *
+   * All values live in one contiguous node array; the elements and members
+   * of a container are stored next to each other, so indexing an array is
+   * O(1) and object members, sorted by key, are found with a binary search.
+   * Strings that contain no escape sequences are not copied but refer to the
+   * input data; only unescaped strings are written to a separate arena.
+   *
+   * Like Parser, duplicate keys keep the last value and numbers without
+   * fraction and exponent are stored as (unsigned) 64 bit integers.
+   *
+   * Document is implicitly shared and can be passed between threads.
+   */
+  class QJSON_EXPORT Document
+  {
+    public:
+      /**
+       * Creates an invalid document
+       */
+      Document();
+      Document(const Document& other);
+      ~Document();
+      Document& operator=(const Document& other);
+
+      /**
+       * Parses @a json. The document keeps a shallow copy of @a json, so
+       * data created with QByteArray::fromRawData() must outlive it.
+       * @param ok if a parsing error occurs, *ok is set to false; otherwise *ok is set to true.
+       * @sa errorString
+       * @sa errorLine
+       */
+      static Document fromJson(const QByteArray& json, bool* ok = 0);
+
+      /**
+       * Memory maps the file @a fileName and parses it. The mapping is kept
+       * for the life time of the document, so the file is never copied.
+       * @param ok if the file can not be read or a parsing error occurs, *ok is set to false; otherwise *ok is set to true.
+       */
+      static Document fromFile(const QString& fileName, bool* ok = 0);
+
+      /**
+       * @returns true if the document was parsed successfully
+       */
+      bool isValid() const;
+
+      /**
+       * @returns the top level value, Undefined for an invalid document
+       */
+      Value root() const;
+
+      /**
+       * @returns the error message of the parse operation
+       */
+      QString errorString() const;
+
+      /**
+       * @returns the line number where the error occurred
+       */
+      int errorLine() const;
+
+      /**
+       * @returns the number of bytes allocated for nodes and unescaped
+       * strings, not counting the input data
+       */
+      qint64 memoryUsage() const;
+
+    private:
+      QExplicitlySharedDataPointer<DocumentPrivate> d;
+  };
+}
+
+Q_DECLARE_METATYPE(QJson::Document)
+
+#endif // QJSON_DOCUMENT_H
@@ -23,6 +23,7 @@
 #include "parser.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 #include <QtCore/QVariant>
 
 using namespace QJson;
@@ -30,7 +31,11 @@ using namespace QJson;
 class QJson::ParserRunnable::Private
 {
   public:
+    Private() : m_documentOutput(false) {}
+
     QByteArray m_data;
+    QString m_fileName;
+    bool m_documentOutput;
 };
 
 ParserRunnable::ParserRunnable(QObject* parent)
@@ -39,6 +44,7 @@ ParserRunnable::ParserRunnable(QObject* parent)
       d(new Private)
 {
   qRegisterMetaType<QVariant>("QVariant");
+  qRegisterMetaType<QJson::Document>("QJson::Document");
 }
 
 ParserRunnable::~ParserRunnable()
@@ -50,13 +56,40 @@ void ParserRunnable::setData( const QByteArray& data ) {
   d->m_data = data;
 }
 
+void ParserRunnable::setFileName( const QString& fileName ) {
+  d->m_fileName = fileName;
+}
+
+void ParserRunnable::setDocumentOutput( bool documentOutput ) {
+  d->m_documentOutput = documentOutput;
+}
+
 void ParserRunnable::run()
 {
   qDebug() << Q_FUNC_INFO;
 
   bool ok;
+  if (d->m_documentOutput) {
+    Document document = d->m_fileName.isEmpty() ? Document::fromJson(d->m_data, &ok) : Document::fromFile(d->m_fileName, &ok);
+    if (ok) {
+      qDebug() << "successfully converted json item to Document";
+      emit documentParsingFinished(document, true, QString());
+    } else {
+      const QString errorText = tr("An error occurred while parsing json: %1").arg(document.errorString());
+      qCritical() << errorText;
+      emit documentParsingFinished(Document(), false, errorText);
+    }
+    return;
+  }
+
   Parser parser;
-  QVariant result = parser.parse (d->m_data, &ok);
+  QVariant result;
+  if (d->m_fileName.isEmpty()) {
+    result = parser.parse (d->m_data, &ok);
+  } else {
+    QFile file(d->m_fileName);
+    result = parser.parse (&file, &ok);
+  }
   if (ok) {
     qDebug() << "successfully converted json item to QVariant object";
     emit parsingFinished(result, true, QString());
@@ -22,6 +22,7 @@
 #define PARSERRUNNABLE_H
 
 #include "qjson_export.h"
+#include "document.h"
 
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
@@ -43,6 +44,18 @@ namespace QJson {
 
       void setData( const QByteArray& data );
 
+      /**
+      * Parses the file @a fileName instead of the data set with setData().
+      * With document output the file is memory mapped.
+      */
+      void setFileName( const QString& fileName );
+
+      /**
+      * Sets whether run() builds a Document and emits documentParsingFinished()
+      * instead of converting the data to a QVariant.
+      */
+      void setDocumentOutput( bool documentOutput );
+
       void run();
 
     Q_SIGNALS:
@@ -54,6 +67,14 @@ namespace QJson {
       **/
       void parsingFinished(const QVariant& json, bool ok, const QString& error_msg);
 
+      /**
+      * This signal is emitted instead of parsingFinished() when document output is enabled
+      * @param document contains the result of the parsing
+      * @param ok if a parsing error occurs ok is set to false, otherwise it's set to true.
+      * @param error_msg contains a string explaining the failure reason
+      **/
+      void documentParsingFinished(const QJson::Document& document, bool ok, const QString& error_msg);
+
     private:
       Q_DISABLE_COPY(ParserRunnable)
       class Private;
@@ -21,9 +21,12 @@
 #include "serializer.h"
 
 #include <QtCore/QDataStream>
+#include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QVariant>
 
+#include <cstring>
+
 // cmath does #undef for isnan and isinf macroses what can be defined in math.h
 #if defined(Q_OS_SYMBIAN) || defined(Q_OS_ANDROID) || defined(Q_OS_BLACKBERRY) || defined(Q_OS_SOLARIS)
 # include <math.h>
@@ -44,267 +47,191 @@
 
 using namespace QJson;
 
+// the output written to a device is flushed whenever this many bytes are buffered
+static const int FlushSize = 64 * 1024;
+// a buffer grown beyond this size by a large document is not kept for the next call
+static const int MaxKeptBufferSize = 4 * FlushSize;
+
 class Serializer::SerializerPrivate {
   public:
     SerializerPrivate() :
       specialNumbersAllowed(false),
       indentMode(QJson::IndentNone),
-      doublePrecision(6) {
+      doublePrecision(6),
+      size(0),
+      device(0) {
         errorMessage.clear();
     }
     QString errorMessage;
     bool specialNumbersAllowed;
     IndentMode indentMode;
     int doublePrecision;
-
-    QByteArray serialize( const QVariant &v, bool *ok, int indentLevel = 0);
-
-    static QByteArray buildIndent(int spaces);
-    static QByteArray escapeString( const QString& str );
-    static QByteArray join( const QList<QByteArray>& list, const QByteArray& sep );
+    // output buffer reused between calls unless it grew beyond MaxKeptBufferSize,
+    // only the first size bytes are used
+    QByteArray buffer;
+    int size;
+    QIODevice* device;
+
+    void serialize( const QVariant &v, bool *ok, int indentLevel = 0, bool leadingIndent = true);
+    template <typename List>
+    void serializeArray( const List& list, bool *ok, int indentLevel, bool leadingIndent);
+    template <typename Map>
+    void serializeObject( const Map& map, bool *ok, int indentLevel, bool leadingIndent);
+    void serializeElement( const QVariant& v, bool *ok, int indentLevel);
+    void serializeElement( const QString& str, bool *ok, int indentLevel);
+
+    bool isIndented() const;
+    char* reserve(int length);
+    void append(const char* str, int length);
+    void append(const char* str) { append(str, qstrlen(str)); }
+    void append(char c) { *reserve(1) = c; ++size; }
+    void appendIndent(int spaces);
+    void appendNumber(qulonglong value, bool negative = false);
+    void appendString( const QString& str );
+    void flush(bool *ok);
 };
 
-QByteArray Serializer::SerializerPrivate::join( const QList<QByteArray>& list, const QByteArray& sep ) {
-  QByteArray res;
-  Q_FOREACH( const QByteArray& i, list ) {
-    if ( !res.isEmpty() )
-      res += sep;
-    res += i;
-  }
-  return res;
+bool Serializer::SerializerPrivate::isIndented() const
+{
+  return indentMode == QJson::IndentFull || indentMode == QJson::IndentMedium || indentMode == QJson::IndentMinimum;
 }
 
-QByteArray Serializer::SerializerPrivate::serialize( const QVariant &v, bool *ok, int indentLevel)
+/*
+ * Makes room for length more bytes behind the used part of the buffer and
+ * returns where they start. The caller advances size by the bytes written.
+ */
+char* Serializer::SerializerPrivate::reserve(int length)
 {
-  QByteArray str;
-
-  if ( ! v.isValid() ) { // invalid or null?
-    str = "null";
-  } else if (( v.type() == QVariant::List ) || ( v.type() == QVariant::StringList )){ // an array or a stringlist?
-    const QVariantList list = v.toList();
-    QList<QByteArray> values;
-    Q_FOREACH( const QVariant& var, list )
-    {
-      QByteArray serializedValue;
-
-      serializedValue = serialize( var, ok, indentLevel+1);
-
-      if ( !*ok ) {
-        break;
-      }
-      switch(indentMode) {
-        case QJson::IndentFull :
-        case QJson::IndentMedium :
-        case QJson::IndentMinimum :
-          values << serializedValue;
-          break;
-        case QJson::IndentCompact :
-        case QJson::IndentNone :
-        default:
-          values << serializedValue.trimmed();
-          break;
-      }
-    }
-
-    if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull ) {
-      QByteArray indent = buildIndent(indentLevel);
-      str = indent + "[\n" + join( values, ",\n" ) + "\n" + indent + "]";
-    }
-    else if (indentMode == QJson::IndentMinimum) {
-      QByteArray indent = buildIndent(indentLevel);
-      str = indent + "[\n" + join( values, ",\n" ) + "\n" + indent + "]";
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str = "[" + join( values, "," ) + "]";
-    }
-    else {
-      str = "[ " + join( values, ", " ) + " ]";
-    }
+  if (size + length > buffer.size()) {
+    buffer.resize(qMax(size + length, 2 * buffer.size() + 256));
+  }
+  return buffer.data() + size;
+}
 
-  } else if ( v.type() == QVariant::Map ) { // variant is a map?
-    const QVariantMap vmap = v.toMap();
-    QMapIterator<QString, QVariant> it( vmap );
+void Serializer::SerializerPrivate::append(const char* str, int length)
+{
+  memcpy(reserve(length), str, length);
+  size += length;
+}
 
-    if (indentMode == QJson::IndentMinimum) {
-      QByteArray indent = buildIndent(indentLevel);
-      str = indent + "{ ";
-    }
-    else if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel);
-      QByteArray nextindent = buildIndent(indentLevel + 1);
-      str = indent + "{\n" + nextindent;
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str = "{";
-    }
-    else {
-      str = "{ ";
-    }
+void Serializer::SerializerPrivate::appendIndent(int spaces)
+{
+  if (spaces > 0) {
+    memset(reserve(spaces), ' ', spaces);
+    size += spaces;
+  }
+}
 
-    QList<QByteArray> pairs;
-    while ( it.hasNext() ) {
-      it.next();
-      indentLevel++;
-      QByteArray serializedValue = serialize( it.value(), ok, indentLevel);
-      indentLevel--;
-      if ( !*ok ) {
-        break;
-      }
-      QByteArray key   = escapeString( it.key() );
-      QByteArray value = serializedValue.trimmed();
-      if (indentMode == QJson::IndentCompact) {
-        pairs << key + ":" + value;
-      } else {
-        pairs << key + " : " + value;
-      }
-    }
+void Serializer::SerializerPrivate::appendNumber(qulonglong value, bool negative)
+{
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* begin = end;
+  do {
+    *--begin = char('0' + value % 10);
+    value /= 10;
+  } while (value);
+  if (negative) {
+    *--begin = '-';
+  }
+  append(begin, end - begin);
+}
 
-    if (indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel + 1);
-      str += join( pairs, ",\n" + indent);
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str += join( pairs, "," );
-    }
-    else {
-      str += join( pairs, ", " );
+void Serializer::SerializerPrivate::flush(bool *ok)
+{
+  if (device && size > 0) {
+    if (device->write(buffer.constData(), size) != size) {
+      *ok = false;
+      errorMessage = QLatin1String("Something went wrong while writing to IO device");
     }
+    size = 0;
+  }
+}
 
-    if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel);
-      str += "\n" + indent + "}";
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str += "}";
-    }
-    else {
-      str += " }";
-    }
+/*
+ * Writes the value at the end of the buffer. leadingIndent is false where the
+ * old concatenating implementation trimmed the value, i.e. for object members.
+ */
+void Serializer::SerializerPrivate::serialize( const QVariant &v, bool *ok, int indentLevel, bool leadingIndent)
+{
+  // values which are not containers are indented, except null and finite doubles
+  const bool indent = leadingIndent && isIndented();
 
+  if ( ! v.isValid() ) { // invalid or null?
+    append("null");
+  } else if ( v.type() == QVariant::List ) { // an array?
+    serializeArray( *static_cast<const QVariantList*>(v.constData()), ok, indentLevel, leadingIndent);
+  } else if ( v.type() == QVariant::StringList ) { // a stringlist?
+    serializeArray( *static_cast<const QStringList*>(v.constData()), ok, indentLevel, leadingIndent);
+  } else if ( v.type() == QVariant::Map ) { // variant is a map?
+    serializeObject( *static_cast<const QVariantMap*>(v.constData()), ok, indentLevel, leadingIndent);
   } else if ( v.type() == QVariant::Hash ) { // variant is a hash?
-    const QVariantHash vhash = v.toHash();
-    QHashIterator<QString, QVariant> it( vhash );
-
-    if (indentMode == QJson::IndentMinimum) {
-      QByteArray indent = buildIndent(indentLevel);
-      str = indent + "{ ";
-    }
-    else if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel);
-      QByteArray nextindent = buildIndent(indentLevel + 1);
-      str = indent + "{\n" + nextindent;
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str = "{";
-    }
-    else {
-      str = "{ ";
-    }
-
-    QList<QByteArray> pairs;
-    while ( it.hasNext() ) {
-      it.next();
-
-      QByteArray serializedValue = serialize( it.value(), ok, indentLevel + 1);
-
-      if ( !*ok ) {
-        break;
-      }
-      QByteArray key   = escapeString( it.key() );
-      QByteArray value = serializedValue.trimmed();
-      if (indentMode == QJson::IndentCompact) {
-        pairs << key + ":" + value;
+    serializeObject( *static_cast<const QVariantHash*>(v.constData()), ok, indentLevel, leadingIndent);
+  } else if ( v.type() == QVariant::String ) { // a string?
+    if (indent) {
+      appendIndent(indentLevel);
+    }
+    appendString( *static_cast<const QString*>(v.constData()) );
+  } else if (( v.type() == QVariant::Double) || ((QMetaType::Type)v.type() == QMetaType::Float)) { // a double or a float?
+    const double value = v.toDouble();
+#if defined _WIN32 && !defined(Q_OS_SYMBIAN)
+    const bool special = _isnan(value) || !_finite(value);
+#elif defined(Q_OS_SYMBIAN) || defined(Q_OS_ANDROID) || defined(Q_OS_BLACKBERRY) || defined(Q_OS_SOLARIS)
+    const bool special = isnan(value) || isinf(value);
+#else
+    const bool special = std::isnan(value) || std::isinf(value);
+#endif
+    if (special) {
+      if (specialNumbersAllowed) {
+        if (indent) {
+          appendIndent(indentLevel);
+        }
+#if defined _WIN32 && !defined(Q_OS_SYMBIAN)
+        if (_isnan(value)) {
+#elif defined(Q_OS_SYMBIAN) || defined(Q_OS_ANDROID) || defined(Q_OS_BLACKBERRY) || defined(Q_OS_SOLARIS)
+        if (isnan(value)) {
+#else
+        if (std::isnan(value)) {
+#endif
+          append("NaN");
+        } else {
+          if (value<0) {
+            append('-');
+          }
+          append("Infinity");
+        }
       } else {
-        pairs << key + " : " + value;
+        errorMessage += QLatin1String("Attempt to write NaN or infinity, which is not supported by json\n");
+        *ok = false;
+      }
+    } else {
+      const QByteArray str = QByteArray::number( value , 'g', doublePrecision);
+      append(str.constData(), str.size());
+      if( ! str.contains( '.' ) && ! str.contains( 'e' ) ) {
+        append(".0");
       }
     }
-
-    if (indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel + 1);
-      str += join( pairs, ",\n" + indent);
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str += join( pairs, "," );
-    }
-    else {
-      str += join( pairs, ", " );
-    }
-
-    if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
-      QByteArray indent = buildIndent(indentLevel);
-      str += "\n" + indent + "}";
-    }
-    else if (indentMode == QJson::IndentCompact) {
-      str += "}";
-    }
-    else {
-      str += " }";
-    }
-
   } else {
-    // Add indent, we may need to remove it later for some layouts
-    switch(indentMode) {
-      case QJson::IndentFull :
-      case QJson::IndentMedium :
-      case QJson::IndentMinimum :
-        str += buildIndent(indentLevel);
-        break;
-      case QJson::IndentCompact :
-      case QJson::IndentNone :
-      default:
-        break;
+    if (indent) {
+      appendIndent(indentLevel);
     }
-
-    if (( v.type() == QVariant::String ) ||  ( v.type() == QVariant::ByteArray )) { // a string or a byte array?
-      str += escapeString( v.toString() );
-    } else if (( v.type() == QVariant::Double) || ((QMetaType::Type)v.type() == QMetaType::Float)) { // a double or a float?
-      const double value = v.toDouble();
-  #if defined _WIN32 && !defined(Q_OS_SYMBIAN)
-      const bool special = _isnan(value) || !_finite(value);
-  #elif defined(Q_OS_SYMBIAN) || defined(Q_OS_ANDROID) || defined(Q_OS_BLACKBERRY) || defined(Q_OS_SOLARIS)
-      const bool special = isnan(value) || isinf(value);
-  #else
-      const bool special = std::isnan(value) || std::isinf(value);
-  #endif
-      if (special) {
-        if (specialNumbersAllowed) {
-  #if defined _WIN32 && !defined(Q_OS_SYMBIAN)
-          if (_isnan(value)) {
-  #elif defined(Q_OS_SYMBIAN) || defined(Q_OS_ANDROID) || defined(Q_OS_BLACKBERRY) || defined(Q_OS_SOLARIS)
-          if (isnan(value)) {
-  #else
-          if (std::isnan(value)) {
-  #endif
-            str += "NaN";
-          } else {
-            if (value<0) {
-              str += '-';
-            }
-            str += "Infinity";
-          }
-        } else {
-          errorMessage += QLatin1String("Attempt to write NaN or infinity, which is not supported by json\n");
-          *ok = false;
-      }
-      } else {
-        str = QByteArray::number( value , 'g', doublePrecision);
-        if( ! str.contains( "." ) && ! str.contains( "e" ) ) {
-          str += ".0";
-        }
-      }
+    if ( v.type() == QVariant::ByteArray ) { // a byte array?
+      appendString( v.toString() );
     } else if ( v.type() == QVariant::Bool ) { // boolean value?
-      str += ( v.toBool() ? "true" : "false" );
+      append( v.toBool() ? "true" : "false" );
     } else if ( v.type() == QVariant::ULongLong ) { // large unsigned number?
-      str += QByteArray::number( v.value<qulonglong>() );
+      appendNumber( v.value<qulonglong>() );
     } else if ( v.type() == QVariant::UInt ) { // unsigned int number?
-      str += QByteArray::number( v.value<quint32>() );
+      appendNumber( v.value<quint32>() );
     } else if ( v.canConvert<qlonglong>() ) { // any signed number?
-      str += QByteArray::number( v.value<qlonglong>() );
+      const qlonglong value = v.value<qlonglong>();
+      appendNumber( value < 0 ? 0 - qulonglong(value) : qulonglong(value), value < 0 );
     } else if ( v.canConvert<int>() ) { // unsigned short number?
-      str += QByteArray::number( v.value<int>() );
+      const int value = v.value<int>();
+      appendNumber( value < 0 ? 0 - qulonglong(value) : qulonglong(value), value < 0 );
     } else if ( v.canConvert<QString>() ){ // can value be converted to string?
       // this will catch QDate, QDateTime, QUrl, ...
-      str += escapeString( v.toString() );
+      appendString( v.toString() );
       //TODO: catch other values like QImage, QRect, ...
     } else {
       *ok = false;
@@ -315,67 +242,198 @@ QByteArray Serializer::SerializerPrivate::serialize( const QVariant &v, bool *ok
       errorMessage += QLatin1String(" is not supported by QJson\n");
     }
   }
-  if ( *ok )
-  {
-    return str;
+}
+
+void Serializer::SerializerPrivate::serializeElement( const QVariant& v, bool *ok, int indentLevel)
+{
+  serialize(v, ok, indentLevel);
+}
+
+void Serializer::SerializerPrivate::serializeElement( const QString& str, bool *ok, int indentLevel)
+{
+  Q_UNUSED(ok);
+  if (isIndented()) {
+    appendIndent(indentLevel);
   }
-  else
-    return QByteArray();
+  appendString(str);
 }
 
-QByteArray Serializer::SerializerPrivate::buildIndent(int spaces)
+template <typename List>
+void Serializer::SerializerPrivate::serializeArray( const List& list, bool *ok, int indentLevel, bool leadingIndent)
 {
-   QByteArray indent;
-   if (spaces < 0) {
-     spaces = 0;
-   }
-   for (int i = 0; i < spaces; i++ ) {
-     indent += " ";
-   }
-   return indent;
+  const bool indented = isIndented();
+  if (indented) {
+    if (leadingIndent) {
+      appendIndent(indentLevel);
+    }
+    append("[\n");
+  } else if (indentMode == QJson::IndentCompact) {
+    append('[');
+  } else {
+    append("[ ");
+  }
+
+  for (typename List::const_iterator it = list.constBegin(); it != list.constEnd(); ++it) {
+    if (it != list.constBegin()) {
+      if (indented) {
+        append(",\n");
+      } else if (indentMode == QJson::IndentCompact) {
+        append(',');
+      } else {
+        append(", ");
+      }
+    }
+    serializeElement(*it, ok, indentLevel + 1);
+    if (device && size >= FlushSize) {
+      flush(ok);
+    }
+    if ( !*ok ) {
+      return;
+    }
+  }
+
+  if (indented) {
+    append('\n');
+    appendIndent(indentLevel);
+    append(']');
+  } else if (indentMode == QJson::IndentCompact) {
+    append(']');
+  } else {
+    append(" ]");
+  }
 }
 
-QByteArray Serializer::SerializerPrivate::escapeString( const QString& str )
+template <typename Map>
+void Serializer::SerializerPrivate::serializeObject( const Map& map, bool *ok, int indentLevel, bool leadingIndent)
 {
-  QByteArray result;
-  result.reserve(str.size() + 2);
-  result.append('\"');
-  for (QString::const_iterator it = str.begin(); it != str.end(); it++) {
-    ushort unicode = it->unicode();
-    switch ( unicode ) {
-      case '\"':
-        result.append("\\\"");
-        break;
-      case '\\':
-        result.append("\\\\");
-        break;
-      case '\b':
-        result.append("\\b");
-        break;
-      case '\f':
-        result.append("\\f");
-        break;
-      case '\n':
-        result.append("\\n");
-        break;
-      case '\r':
-        result.append("\\r");
-        break;
-      case '\t':
-        result.append("\\t");
-        break;
-      default:
-        if ( unicode > 0x1F && unicode < 128 ) {
-          result.append(static_cast<char>(unicode));
-        } else {
-          char escaped[7];
-          qsnprintf(escaped, sizeof(escaped)/sizeof(char), "\\u%04x", unicode);
-          result.append(escaped);
-        }
+  if (indentMode == QJson::IndentMinimum) {
+    if (leadingIndent) {
+      appendIndent(indentLevel);
+    }
+    append("{ ");
+  } else if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
+    if (leadingIndent) {
+      appendIndent(indentLevel);
+    }
+    append("{\n");
+    appendIndent(indentLevel + 1);
+  } else if (indentMode == QJson::IndentCompact) {
+    append('{');
+  } else {
+    append("{ ");
+  }
+
+  for (typename Map::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+    if (it != map.constBegin()) {
+      if (indentMode == QJson::IndentFull) {
+        append(",\n");
+        appendIndent(indentLevel + 1);
+      } else if (indentMode == QJson::IndentCompact) {
+        append(',');
+      } else {
+        append(", ");
+      }
+    }
+    appendString( it.key() );
+    if (indentMode == QJson::IndentCompact) {
+      append(':');
+    } else {
+      append(" : ");
+    }
+    serialize( it.value(), ok, indentLevel + 1, false);
+    if (device && size >= FlushSize) {
+      flush(ok);
+    }
+    if ( !*ok ) {
+      return;
     }
   }
-  result.append('\"');
-  return result;
+
+  if (indentMode == QJson::IndentMedium || indentMode == QJson::IndentFull) {
+    append('\n');
+    appendIndent(indentLevel);
+    append('}');
+  } else if (indentMode == QJson::IndentCompact) {
+    append('}');
+  } else {
+    append(" }");
+  }
+}
+
+/*
+ * Strings of printable ASCII characters are copied in one pass; the rest of
+ * a string is escaped once the first character needing it is found.
+ */
+void Serializer::SerializerPrivate::appendString( const QString& str )
+{
+  static const char hexDigits[] = "0123456789abcdef";
+  const ushort* in = str.utf16();
+  const int length = str.size();
+
+  char* out = reserve(length + 2);
+  char* begin = out;
+  *out++ = '\"';
+  int i = 0;
+  for (; i < length; ++i) {
+    const ushort unicode = in[i];
+    if ( unicode < 0x20 || unicode >= 128 || unicode == '\"' || unicode == '\\' ) {
+      break;
+    }
+    *out++ = static_cast<char>(unicode);
+  }
+
+  if (i < length) {
+    size += out - begin;
+    // every remaining character takes at most six bytes
+    out = reserve(6 * (length - i) + 1);
+    begin = out;
+    for (; i < length; ++i) {
+      const ushort unicode = in[i];
+      switch ( unicode ) {
+        case '\"':
+          *out++ = '\\';
+          *out++ = '\"';
+          break;
+        case '\\':
+          *out++ = '\\';
+          *out++ = '\\';
+          break;
+        case '\b':
+          *out++ = '\\';
+          *out++ = 'b';
+          break;
+        case '\f':
+          *out++ = '\\';
+          *out++ = 'f';
+          break;
+        case '\n':
+          *out++ = '\\';
+          *out++ = 'n';
+          break;
+        case '\r':
+          *out++ = '\\';
+          *out++ = 'r';
+          break;
+        case '\t':
+          *out++ = '\\';
+          *out++ = 't';
+          break;
+        default:
+          if ( unicode > 0x1F && unicode < 128 ) {
+            *out++ = static_cast<char>(unicode);
+          } else {
+            *out++ = '\\';
+            *out++ = 'u';
+            *out++ = hexDigits[(unicode >> 12) & 0xf];
+            *out++ = hexDigits[(unicode >> 8) & 0xf];
+            *out++ = hexDigits[(unicode >> 4) & 0xf];
+            *out++ = hexDigits[unicode & 0xf];
+          }
+      }
+    }
+  }
+  *out++ = '\"';
+  size += out - begin;
 }
 
 Serializer::Serializer()
@@ -407,10 +465,18 @@ void Serializer::serialize( const QVariant& v, QIODevice* io, bool* ok)
     return;
   }
 
-  const QByteArray str = serialize( v, ok);
-  if (*ok && (io->write(str) != str.count())) {
-    *ok = false;
-    d->errorMessage = QLatin1String("Something went wrong while writing to IO device");
+  d->errorMessage.clear();
+  d->device = io;
+  d->size = 0;
+  d->serialize(v, ok);
+  if (*ok) {
+    d->flush(ok);
+  }
+  d->device = 0;
+  d->size = 0;
+  // keep the buffer for the next call unless a huge string made it grow
+  if (d->buffer.size() > MaxKeptBufferSize) {
+    d->buffer.clear();
   }
 }
 
@@ -432,7 +498,24 @@ QByteArray Serializer::serialize( const QVariant &v, bool *ok)
     ok = &_ok;
   }
 
-  return d->serialize(v, ok);
+  d->size = 0;
+  d->serialize(v, ok);
+  if (!*ok) {
+    d->size = 0;
+    return QByteArray();
+  }
+
+  // copy the output and keep the buffer for the next call, a buffer which is
+  // too large to be kept is handed over instead of copying it
+  QByteArray result;
+  if (d->buffer.size() > MaxKeptBufferSize) {
+    result.swap(d->buffer);
+    result.resize(d->size);
+  } else {
+    result = QByteArray(d->buffer.constData(), d->size);
+  }
+  d->size = 0;
+  return result;
 }
 
 void QJson::Serializer::allowSpecialNumbers(bool allow) {
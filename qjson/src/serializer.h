@@ -156,6 +156,9 @@ namespace QJson {
      /**
       * This method generates a textual JSON representation and outputs it to the
       * passed in I/O Device.
+      * The output is written in chunks while the document is serialized, so
+      * on a conversion error part of it may already have been written.
+      *
       * @param variant The JSON document in its in-memory representation as generated by the
       * parser.
       * @param out Input output device
@@ -0,0 +1,702 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "streamreader.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QLocale>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+using namespace QJson;
+
+// number of bytes read from the device at once
+static const int ChunkSize = 64 * 1024;
+
+namespace QJson {
+
+  class StreamReaderPrivate
+  {
+    public:
+      enum State {
+        ExpectDocument,
+        ExpectValue,
+        ExpectValueOrEndArray,
+        ExpectKey,
+        ExpectKeyOrEndObject,
+        ExpectColon,
+        ExpectCommaOrEnd,
+        ExpectEndOfData,
+        Finished
+      };
+
+      StreamReaderPrivate();
+
+      void reset();
+      bool fetch();
+      bool isFinal() const;
+      int peek(int index);
+      void compact();
+
+      StreamReader::TokenType setError(const QString& errorMsg);
+      StreamReader::TokenType outOfData(const QString& errorMsg);
+      StreamReader::TokenType startContainer(char bracket);
+      StreamReader::TokenType endContainer();
+      StreamReader::TokenType valueRead(StreamReader::TokenType type);
+      StreamReader::TokenType readNext();
+      StreamReader::TokenType readValueToken(int c);
+      StreamReader::TokenType readString(StreamReader::TokenType type);
+      StreamReader::TokenType readNumber();
+      StreamReader::TokenType readLiteral(const char* literal, int caseInsensitiveChars, StreamReader::TokenType type, const QVariant& value);
+      int matchLiteral(const char* literal, int caseInsensitiveChars);
+      QVariant buildValue(bool* ok);
+
+      QIODevice* m_device;
+      QByteArray m_buffer;
+      int m_pos;
+      int m_line;
+      bool m_dataFinished;
+      State m_state;
+      QVector<char> m_stack;
+      StreamReader::TokenType m_tokenType;
+      QString m_string;
+      QVariant m_value;
+      bool m_error;
+      int m_errorLine;
+      QString m_errorMsg;
+      bool m_specialNumbersAllowed;
+      QLocale m_C_locale;
+  };
+}
+
+StreamReaderPrivate::StreamReaderPrivate() :
+  m_device(0),
+  m_specialNumbersAllowed(false),
+  m_C_locale(QLocale::C)
+{
+  reset();
+}
+
+void StreamReaderPrivate::reset()
+{
+  m_buffer.clear();
+  m_pos = 0;
+  m_line = 1;
+  m_dataFinished = false;
+  m_state = ExpectDocument;
+  m_stack.clear();
+  m_tokenType = StreamReader::NoToken;
+  m_string.clear();
+  m_value = QVariant();
+  m_error = false;
+  m_errorLine = 0;
+  m_errorMsg.clear();
+}
+
+/*
+ * Appends the next chunk of the device to the buffer. Positions inside the
+ * buffer stay valid, the buffer is only compacted between two tokens.
+ */
+bool StreamReaderPrivate::fetch()
+{
+  if (!m_device || !m_device->isReadable())
+    return false;
+  QByteArray chunk = m_device->read(ChunkSize);
+  if (chunk.isEmpty())
+    return false;
+  m_buffer.append(chunk);
+  return true;
+}
+
+bool StreamReaderPrivate::isFinal() const
+{
+  if (m_dataFinished)
+    return true;
+  if (m_device)
+    return !m_device->isOpen() || (!m_device->isSequential() && m_device->atEnd());
+  return false;
+}
+
+int StreamReaderPrivate::peek(int index)
+{
+  while (index >= m_buffer.size()) {
+    if (!fetch())
+      return -1;
+  }
+  return static_cast<unsigned char>(m_buffer.at(index));
+}
+
+/*
+ * Drops the consumed part of the buffer once it makes up more than half of
+ * it, which keeps the cost of moving the remaining bytes linear overall.
+ */
+void StreamReaderPrivate::compact()
+{
+  if (m_pos == m_buffer.size()) {
+    m_buffer.clear();
+    m_pos = 0;
+  } else if (m_pos >= ChunkSize && m_pos > m_buffer.size() / 2) {
+    m_buffer.remove(0, m_pos);
+    m_pos = 0;
+  }
+}
+
+StreamReader::TokenType StreamReaderPrivate::setError(const QString& errorMsg)
+{
+  m_error = true;
+  m_errorMsg = errorMsg;
+  m_errorLine = m_line;
+  m_tokenType = StreamReader::Invalid;
+  return m_tokenType;
+}
+
+/*
+ * Called when a token runs past the available data. Once no more data can
+ * arrive this is an error, otherwise nothing is consumed and the token is
+ * read again by the next call to readNext().
+ */
+StreamReader::TokenType StreamReaderPrivate::outOfData(const QString& errorMsg)
+{
+  if (isFinal())
+    return setError(errorMsg);
+  m_tokenType = StreamReader::Incomplete;
+  return m_tokenType;
+}
+
+StreamReader::TokenType StreamReaderPrivate::startContainer(char bracket)
+{
+  ++m_pos;
+  m_stack.append(bracket);
+  if (bracket == '{') {
+    m_state = ExpectKeyOrEndObject;
+    m_tokenType = StreamReader::StartObject;
+  } else {
+    m_state = ExpectValueOrEndArray;
+    m_tokenType = StreamReader::StartArray;
+  }
+  return m_tokenType;
+}
+
+StreamReader::TokenType StreamReaderPrivate::endContainer()
+{
+  ++m_pos;
+  char bracket = m_stack.last();
+  m_stack.removeLast();
+  return valueRead(bracket == '{' ? StreamReader::EndObject : StreamReader::EndArray);
+}
+
+StreamReader::TokenType StreamReaderPrivate::valueRead(StreamReader::TokenType type)
+{
+  m_state = m_stack.isEmpty() ? ExpectEndOfData : ExpectCommaOrEnd;
+  m_tokenType = type;
+  return m_tokenType;
+}
+
+StreamReader::TokenType StreamReaderPrivate::readNext()
+{
+  if (m_error)
+    return StreamReader::Invalid;
+  if (m_state == Finished)
+    return m_tokenType;
+
+  compact();
+
+  forever {
+    int c = peek(m_pos);
+    while (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+      if (c == '\n')
+        ++m_line;
+      c = peek(++m_pos);
+    }
+
+    if (c == -1) {
+      if (!isFinal()) {
+        m_tokenType = StreamReader::Incomplete;
+        return m_tokenType;
+      }
+      switch (m_state) {
+        case ExpectEndOfData:
+          m_state = Finished;
+          m_tokenType = StreamReader::EndDocument;
+          return m_tokenType;
+        case ExpectDocument:
+          return setError(QLatin1String("No data"));
+        default:
+          return setError(QLatin1String("Unexpected end of data"));
+      }
+    }
+
+    switch (m_state) {
+      case ExpectColon:
+        if (c != ':')
+          return setError(QLatin1String("Expected ':'"));
+        ++m_pos;
+        m_state = ExpectValue;
+        continue;
+
+      case ExpectCommaOrEnd:
+        if (c == ',') {
+          ++m_pos;
+          m_state = m_stack.last() == '{' ? ExpectKey : ExpectValue;
+          continue;
+        }
+        if ((c == '}' && m_stack.last() == '{') || (c == ']' && m_stack.last() == '['))
+          return endContainer();
+        return setError(QLatin1String("Expected ',' or the end of the ")
+                        + QLatin1String(m_stack.last() == '{' ? "object" : "array"));
+
+      case ExpectKeyOrEndObject:
+        if (c == '}')
+          return endContainer();
+        // fall through
+      case ExpectKey:
+        if (c != '"')
+          return setError(QLatin1String("Expected a key"));
+        return readString(StreamReader::Key);
+
+      case ExpectValueOrEndArray:
+        if (c == ']')
+          return endContainer();
+        // fall through
+      case ExpectDocument:
+      case ExpectValue:
+        return readValueToken(c);
+
+      case ExpectEndOfData:
+      case Finished:
+        return setError(QLatin1String("Unexpected data after the end of the document"));
+    }
+  }
+}
+
+StreamReader::TokenType StreamReaderPrivate::readValueToken(int c)
+{
+  switch (c) {
+    case '{':
+    case '[':
+      return startContainer(c);
+    case '"':
+      return readString(StreamReader::String);
+    case 't':
+      return readLiteral("true", 0, StreamReader::Bool, QVariant(true));
+    case 'f':
+      return readLiteral("false", 0, StreamReader::Bool, QVariant(false));
+    case 'n':
+      if (!m_specialNumbersAllowed || matchLiteral("null", 0) != 0)
+        return readLiteral("null", 0, StreamReader::Null, QVariant());
+      // fall through
+    case 'N':
+      if (m_specialNumbersAllowed)
+        return readLiteral("nan", 3, StreamReader::Number, QVariant(std::numeric_limits<double>::quiet_NaN()));
+      break;
+    case 'I':
+    case 'i':
+      if (m_specialNumbersAllowed)
+        return readLiteral("infinity", 1, StreamReader::Number, QVariant(std::numeric_limits<double>::infinity()));
+      break;
+    default:
+      if (c == '-' || (c >= '0' && c <= '9'))
+        return readNumber();
+      break;
+  }
+  return setError(QLatin1String("Unexpected character '") + QLatin1Char(char(c)) + QLatin1Char('\''));
+}
+
+/*
+ * Reads a string starting at the opening quotation mark. Runs without
+ * escape sequences are converted in one go, which is the common case.
+ */
+StreamReader::TokenType StreamReaderPrivate::readString(StreamReader::TokenType type)
+{
+  QString result;
+  int i = m_pos + 1;
+  int segment = i;
+
+  forever {
+    const char* data = m_buffer.constData();
+    const int size = m_buffer.size();
+    while (i < size && data[i] != '"' && data[i] != '\\')
+      ++i;
+    if (i == size) {
+      if (fetch())
+        continue;
+      return outOfData(QLatin1String("Unterminated string"));
+    }
+
+    if (data[i] == '"') {
+      if (segment == m_pos + 1)
+        m_string = QString::fromUtf8(data + segment, i - segment);
+      else
+        m_string = result + QString::fromUtf8(data + segment, i - segment);
+      m_pos = i + 1;
+      if (type == StreamReader::Key) {
+        m_state = ExpectColon;
+        m_tokenType = type;
+        return m_tokenType;
+      }
+      return valueRead(type);
+    }
+
+    // escape sequence, the \u form needs four more characters
+    int escape = peek(i + 1);
+    if (escape == 'u' && peek(i + 5) == -1)
+      escape = -1;
+    if (escape == -1)
+      return outOfData(QLatin1String("Unterminated string"));
+    data = m_buffer.constData();
+
+    result.append(QString::fromUtf8(data + segment, i - segment));
+    switch (escape) {
+      case '"': result.append(QLatin1Char('"')); break;
+      case '\\': result.append(QLatin1Char('\\')); break;
+      case '/': result.append(QLatin1Char('/')); break;
+      case 'b': result.append(QLatin1Char('\b')); break;
+      case 'f': result.append(QLatin1Char('\f')); break;
+      case 'n': result.append(QLatin1Char('\n')); break;
+      case 'r': result.append(QLatin1Char('\r')); break;
+      case 't': result.append(QLatin1Char('\t')); break;
+      case 'u': {
+        ushort code = 0;
+        for (int j = i + 2; j < i + 6; ++j) {
+          const char hex = data[j];
+          code <<= 4;
+          if (hex >= '0' && hex <= '9')
+            code |= hex - '0';
+          else if (hex >= 'a' && hex <= 'f')
+            code |= hex - 'a' + 10;
+          else if (hex >= 'A' && hex <= 'F')
+            code |= hex - 'A' + 10;
+          else
+            return setError(QLatin1String("Invalid hex string"));
+        }
+        result.append(QChar(code));
+        i += 4;
+        break;
+      }
+      default:
+        // like the scanner, an unknown escape drops the backslash only
+        ++i;
+        segment = i;
+        continue;
+    }
+    i += 2;
+    segment = i;
+  }
+}
+
+StreamReader::TokenType StreamReaderPrivate::readNumber()
+{
+  int i = m_pos;
+  bool isDouble = false;
+  bool isNegative = false;
+  int c = peek(i);
+
+  if (c == '-') {
+    isNegative = true;
+    c = peek(++i);
+    if (m_specialNumbersAllowed && (c == 'I' || c == 'i')) {
+      ++m_pos;
+      StreamReader::TokenType type = readLiteral("infinity", 1, StreamReader::Number,
+                                                 QVariant(-std::numeric_limits<double>::infinity()));
+      if (type != StreamReader::Number)
+        --m_pos;
+      return type;
+    }
+  }
+
+  if (c == '0') {
+    c = peek(++i);
+  } else if (c >= '1' && c <= '9') {
+    do {
+      c = peek(++i);
+    } while (c >= '0' && c <= '9');
+  } else {
+    return c == -1 ? outOfData(QLatin1String("Invalid number")) : setError(QLatin1String("Invalid number"));
+  }
+
+  if (c == '.') {
+    isDouble = true;
+    c = peek(++i);
+    if (c < '0' || c > '9')
+      return c == -1 ? outOfData(QLatin1String("Invalid number")) : setError(QLatin1String("Invalid number"));
+    do {
+      c = peek(++i);
+    } while (c >= '0' && c <= '9');
+  }
+
+  if (c == 'e' || c == 'E') {
+    isDouble = true;
+    c = peek(++i);
+    if (c == '+' || c == '-')
+      c = peek(++i);
+    if (c < '0' || c > '9')
+      return c == -1 ? outOfData(QLatin1String("Invalid number")) : setError(QLatin1String("Invalid number"));
+    do {
+      c = peek(++i);
+    } while (c >= '0' && c <= '9');
+  }
+
+  // more digits may still arrive
+  if (c == -1 && !isFinal()) {
+    m_tokenType = StreamReader::Incomplete;
+    return m_tokenType;
+  }
+
+  const QByteArray text = m_buffer.mid(m_pos, i - m_pos);
+  if (isDouble) {
+    bool ok;
+    m_value = QVariant(m_C_locale.toDouble(QString::fromLatin1(text.constData(), text.size()), &ok));
+    if (!ok)
+      return setError(QLatin1String("Number is out of range: ") + QString::fromLatin1(text.constData(), text.size()));
+  } else {
+    errno = 0;
+    if (isNegative)
+      m_value = QVariant(qlonglong(strtoll(text.constData(), NULL, 10)));
+    else
+      m_value = QVariant(qulonglong(strtoull(text.constData(), NULL, 10)));
+    if (errno == ERANGE)
+      return setError(QLatin1String("Number is out of range: ") + QString::fromLatin1(text.constData(), text.size()));
+  }
+  m_pos = i;
+  return valueRead(StreamReader::Number);
+}
+
+/*
+ * Returns 1 if the data at the current position starts with literal, 0 if it
+ * does not and -1 if the available data ends before it could be decided.
+ */
+int StreamReaderPrivate::matchLiteral(const char* literal, int caseInsensitiveChars)
+{
+  for (int i = 0; literal[i]; ++i) {
+    int c = peek(m_pos + i);
+    if (c == -1)
+      return -1;
+    if (i < caseInsensitiveChars && c >= 'A' && c <= 'Z')
+      c += 'a' - 'A';
+    if (c != literal[i])
+      return 0;
+  }
+  return 1;
+}
+
+StreamReader::TokenType StreamReaderPrivate::readLiteral(const char* literal, int caseInsensitiveChars,
+                                                         StreamReader::TokenType type, const QVariant& value)
+{
+  switch (matchLiteral(literal, caseInsensitiveChars)) {
+    case 1:
+      m_pos += qstrlen(literal);
+      m_value = value;
+      return valueRead(type);
+    case 0:
+      return setError(QLatin1String("Invalid literal"));
+    default:
+      return outOfData(QLatin1String("Invalid literal"));
+  }
+}
+
+QVariant StreamReaderPrivate::buildValue(bool* ok)
+{
+  switch (m_tokenType) {
+    case StreamReader::String:
+      return QVariant(m_string);
+    case StreamReader::Number:
+    case StreamReader::Bool:
+    case StreamReader::Null:
+      return m_value;
+    case StreamReader::StartObject: {
+      QVariantMap map;
+      forever {
+        StreamReader::TokenType type = readNext();
+        if (type == StreamReader::EndObject)
+          return map;
+        if (type != StreamReader::Key)
+          break;
+        const QString key = m_string;
+        readNext();
+        QVariant value = buildValue(ok);
+        if (!*ok)
+          return QVariant();
+        map.insert(key, value);
+      }
+      break;
+    }
+    case StreamReader::StartArray: {
+      QVariantList list;
+      forever {
+        StreamReader::TokenType type = readNext();
+        if (type == StreamReader::EndArray)
+          return list;
+        QVariant value = buildValue(ok);
+        if (!*ok)
+          return QVariant();
+        list.append(value);
+      }
+    }
+    default:
+      break;
+  }
+  *ok = false;
+  return QVariant();
+}
+
+StreamReader::StreamReader() :
+    d(new StreamReaderPrivate)
+{
+}
+
+StreamReader::StreamReader(QIODevice* device) :
+    d(new StreamReaderPrivate)
+{
+  setDevice(device);
+}
+
+StreamReader::StreamReader(const QByteArray& data) :
+    d(new StreamReaderPrivate)
+{
+  d->m_buffer = data;
+  d->m_dataFinished = true;
+}
+
+StreamReader::~StreamReader()
+{
+  delete d;
+}
+
+void StreamReader::setDevice(QIODevice* device)
+{
+  clear();
+  d->m_device = device;
+  if (device && !device->isOpen() && !device->open(QIODevice::ReadOnly))
+    d->setError(QLatin1String("Error opening device"));
+}
+
+QIODevice* StreamReader::device() const
+{
+  return d->m_device;
+}
+
+void StreamReader::addData(const QByteArray& data)
+{
+  d->m_buffer.append(data);
+}
+
+void StreamReader::finishData()
+{
+  d->m_dataFinished = true;
+}
+
+void StreamReader::clear()
+{
+  d->reset();
+  d->m_device = 0;
+}
+
+StreamReader::TokenType StreamReader::readNext()
+{
+  return d->readNext();
+}
+
+StreamReader::TokenType StreamReader::tokenType() const
+{
+  return d->m_tokenType;
+}
+
+bool StreamReader::atEnd() const
+{
+  return d->m_tokenType == EndDocument || d->m_tokenType == Incomplete || d->m_error;
+}
+
+bool StreamReader::hasError() const
+{
+  return d->m_error;
+}
+
+QString StreamReader::errorString() const
+{
+  return d->m_errorMsg;
+}
+
+int StreamReader::errorLine() const
+{
+  return d->m_errorLine;
+}
+
+QString StreamReader::stringValue() const
+{
+  if (d->m_tokenType == Key || d->m_tokenType == String)
+    return d->m_string;
+  return QString();
+}
+
+QVariant StreamReader::value() const
+{
+  switch (d->m_tokenType) {
+    case String:
+      return QVariant(d->m_string);
+    case Number:
+    case Bool:
+      return d->m_value;
+    default:
+      return QVariant();
+  }
+}
+
+int StreamReader::depth() const
+{
+  return d->m_stack.size();
+}
+
+bool StreamReader::skipCurrentValue()
+{
+  if (d->m_tokenType != StartObject && d->m_tokenType != StartArray)
+    return d->m_tokenType != Invalid && d->m_tokenType != Incomplete;
+
+  const int targetDepth = depth() - 1;
+  forever {
+    TokenType type = d->readNext();
+    if (type == Invalid || type == Incomplete || type == EndDocument)
+      return false;
+    if ((type == EndObject || type == EndArray) && depth() == targetDepth)
+      return true;
+  }
+}
+
+QVariant StreamReader::readValue(bool* ok)
+{
+  bool success = true;
+  QVariant result = d->buildValue(&success);
+  if (ok != 0)
+    *ok = success;
+  return result;
+}
+
+void StreamReader::allowSpecialNumbers(bool allowSpecialNumbers)
+{
+  d->m_specialNumbersAllowed = allowSpecialNumbers;
+}
+
+bool StreamReader::specialNumbersAllowed() const
+{
+  return d->m_specialNumbersAllowed;
+}
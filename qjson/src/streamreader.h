@@ -0,0 +1,212 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef QJSON_STREAMREADER_H
+#define QJSON_STREAMREADER_H
+
+#include "qjson_export.h"
+
+QT_BEGIN_NAMESPACE
+class QByteArray;
+class QIODevice;
+class QString;
+class QVariant;
+QT_END_NAMESPACE
+
+namespace QJson {
+
+  class StreamReaderPrivate;
+
+  /**
+   * @brief Pull parser reporting JSON data as a stream of tokens
+   *
+   * Unlike Parser, StreamReader never builds a QVariant tree for the whole
+   * document. Every call to readNext() advances to the next token and the
+   * caller decides what to keep, which makes it possible to build compact
+   * application structures from large documents in a single pass.
+   *
+   * The data is either read in chunks from a QIODevice or added with
+   * addData(). When the available data ends in the middle of a token,
+   * readNext() returns Incomplete without consuming anything; reading can
+   * continue once more data is available.
+   *
+   * @code
+   * QJson::StreamReader reader(&file);
+   * while (!reader.atEnd()) {
+   *   if (reader.readNext() == QJson::StreamReader::Key && reader.stringValue() == QLatin1String("name")) {
+   *     reader.readNext();
+   *     names << reader.stringValue();
+   *   }
+   * }
+   * if (reader.hasError())
+   *   qDebug() << reader.errorString() << reader.errorLine();
+   * @endcode
+   *
+   * Numbers are typed exactly like Parser types them.
+   */
+  class QJSON_EXPORT StreamReader
+  {
+    public:
+      enum TokenType {
+        NoToken,
+        Invalid,
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndDocument,
+        Incomplete
+      };
+
+      StreamReader();
+
+      /**
+       * Creates a reader pulling its data from @a device. The device is
+       * opened read only if it is not open yet.
+       */
+      explicit StreamReader(QIODevice* device);
+
+      /**
+       * Creates a reader for the complete document @a data.
+       */
+      explicit StreamReader(const QByteArray& data);
+
+      ~StreamReader();
+
+      /**
+       * Sets the device to read from and resets the reader.
+       * @sa device
+       */
+      void setDevice(QIODevice* device);
+
+      /**
+       * @returns the device the reader reads from, or 0
+       */
+      QIODevice* device() const;
+
+      /**
+       * Appends @a data to the data not read yet. Used to feed the reader
+       * in chunks when no device is set. A number at the very end of the
+       * data is only reported once it is followed by a delimiter or
+       * finishData() has been called.
+       * @sa finishData
+       */
+      void addData(const QByteArray& data);
+
+      /**
+       * Tells the reader that no more data will be added with addData().
+       */
+      void finishData();
+
+      /**
+       * Resets the reader to its initial state and drops all buffered data.
+       */
+      void clear();
+
+      /**
+       * Reads the next token.
+       * @returns the type of the token read
+       */
+      TokenType readNext();
+
+      /**
+       * @returns the type of the token read last
+       */
+      TokenType tokenType() const;
+
+      /**
+       * @returns true once the end of the document is reached or an error occurred
+       */
+      bool atEnd() const;
+
+      /**
+       * @returns true if the data is not well formed JSON
+       * @sa errorString
+       * @sa errorLine
+       */
+      bool hasError() const;
+
+      /**
+       * @returns the error message of the last error
+       */
+      QString errorString() const;
+
+      /**
+       * @returns the line number where the last error occurred
+       */
+      int errorLine() const;
+
+      /**
+       * @returns the name of a Key token or the text of a String token
+       */
+      QString stringValue() const;
+
+      /**
+       * @returns the value of a String, Number, Bool or Null token as a
+       * QVariant, using the same types Parser uses
+       */
+      QVariant value() const;
+
+      /**
+       * @returns the number of objects and arrays that are currently open
+       */
+      int depth() const;
+
+      /**
+       * Skips the value the current token starts. When the current token is
+       * StartObject or StartArray, everything up to the matching end token
+       * is skipped; for scalar tokens nothing is done.
+       * @returns false if the end of the value could not be reached
+       */
+      bool skipCurrentValue();
+
+      /**
+       * Converts the value the current token starts to a QVariant, exactly
+       * like Parser would convert it. Reading continues after the value.
+       * @param ok if the end of the value could not be reached, *ok is set to false; otherwise *ok is set to true.
+       */
+      QVariant readValue(bool* ok = 0);
+
+      /**
+       * Sets whether special numbers (Infinity, -Infinity, NaN) are allowed as an extension to
+       * the standard
+       * @param  allowSpecialNumbers new value of whether special numbers are allowed
+       * @sa specialNumbersAllowed
+       */
+      void allowSpecialNumbers(bool allowSpecialNumbers);
+
+      /**
+       * @returns whether special numbers (Infinity, -Infinity, NaN) are allowed
+       * @sa allowSpecialNumbers
+       */
+      bool specialNumbersAllowed() const;
+
+    private:
+      Q_DISABLE_COPY(StreamReader)
+      StreamReaderPrivate* const d;
+  };
+}
+
+#endif // QJSON_STREAMREADER_H
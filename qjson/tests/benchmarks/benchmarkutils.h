@@ -0,0 +1,51 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2014 Sune Vuorela <sune@ange.dk>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef BENCHMARKUTILS_H
+#define BENCHMARKUTILS_H
+
+#include <QtTest/QTest>
+#include <QFile>
+
+/*
+ * Set QJSON_BENCHMARK_FILE to run the benchmarks on another file, e.g. a
+ * large _info.json written by the OpenModelica compiler.
+ */
+static inline QString benchmarkFile() {
+    QString path = QString::fromLocal8Bit(qgetenv("QJSON_BENCHMARK_FILE"));
+    if (path.isEmpty())
+        path = QFINDTESTDATA("largefile.json");
+    return path;
+}
+
+/*
+ * Resident set size of the process in bytes, -1 where it is not available.
+ */
+static inline qint64 residentMemory() {
+    QFile statm(QLatin1String("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * 4096;
+}
+
+#endif // BENCHMARKUTILS_H
@@ -18,19 +18,25 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#include <QJson/Document>
 #include <QJson/Parser>
 #include <QJson/Serializer>
 #include <QtTest/QTest>
 #include <QFile>
 
+#include "benchmarkutils.h"
+
 class ParsingBenchmark: public QObject {
     Q_OBJECT
     private Q_SLOTS:
         void benchmark();
+        void benchmarkDocument();
+        void benchmarkDocumentFromFile();
+        void memoryUsage();
 };
 
 void ParsingBenchmark::benchmark() {
-    QString path = QFINDTESTDATA("largefile.json");
+    QString path = benchmarkFile();
 
     QVERIFY(QFile::exists(path));
 
@@ -49,6 +55,70 @@ void ParsingBenchmark::benchmark() {
     Q_UNUSED(result);
 }
 
+void ParsingBenchmark::benchmarkDocument() {
+    QString path = benchmarkFile();
+
+    QVERIFY(QFile::exists(path));
+
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+
+    QByteArray data = f.readAll();
+
+    QJson::Document result;
+
+    QBENCHMARK {
+        result = QJson::Document::fromJson(data);
+    }
+
+    QVERIFY(result.isValid());
+}
+
+void ParsingBenchmark::benchmarkDocumentFromFile() {
+    QString path = benchmarkFile();
+
+    QVERIFY(QFile::exists(path));
+
+    QJson::Document result;
+
+    QBENCHMARK {
+        result = QJson::Document::fromFile(path);
+    }
+
+    QVERIFY(result.isValid());
+}
+
+void ParsingBenchmark::memoryUsage() {
+    QString path = benchmarkFile();
+
+    QVERIFY(QFile::exists(path));
+
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+
+    QByteArray data = f.readAll();
+
+    if (residentMemory() < 0)
+        QSKIP("The resident memory can not be read on this platform", SkipAll);
+
+    // the document is measured first, so freed memory reused by the QVariant tree only favours the latter
+    qint64 before = residentMemory();
+    {
+        QJson::Document result = QJson::Document::fromJson(data);
+        QVERIFY(result.isValid());
+        qDebug() << "Document:" << (residentMemory() - before) / 1024 << "KiB," << result.memoryUsage() / 1024 << "KiB allocated";
+    }
+
+    before = residentMemory();
+    {
+        QJson::Parser parser;
+        QVariant result = parser.parse(data);
+        qDebug() << "QVariant tree:" << (residentMemory() - before) / 1024 << "KiB";
+    }
+
+    qDebug() << "Input:" << data.size() / 1024 << "KiB";
+}
+
 
 QTEST_MAIN(ParsingBenchmark)
 
@@ -0,0 +1,139 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2014 Sune Vuorela <sune@ange.dk>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QJson/Parser>
+#include <QJson/StreamReader>
+#include <QtTest/QTest>
+#include <QBuffer>
+#include <QFile>
+
+#include "benchmarkutils.h"
+
+class StreamReaderBenchmark: public QObject {
+    Q_OBJECT
+    private Q_SLOTS:
+        void initTestCase();
+        void domParser();
+        void streamReader();
+        void streamReaderFromDevice();
+        void streamReaderReadValue();
+        void memoryUsage();
+    private:
+        QByteArray m_data;
+};
+
+void StreamReaderBenchmark::initTestCase() {
+    QString path = benchmarkFile();
+
+    QVERIFY(QFile::exists(path));
+
+    QFile f(path);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+
+    m_data = f.readAll();
+}
+
+void StreamReaderBenchmark::domParser() {
+    QVariant result;
+
+    QJson::Parser parser;
+    QBENCHMARK {
+        result = parser.parse(m_data);
+    }
+
+    Q_UNUSED(result);
+}
+
+void StreamReaderBenchmark::streamReader() {
+    int tokens = 0;
+
+    QBENCHMARK {
+        QJson::StreamReader reader(m_data);
+        while (!reader.atEnd()) {
+            reader.readNext();
+            ++tokens;
+        }
+        QVERIFY(!reader.hasError());
+    }
+
+    Q_UNUSED(tokens);
+}
+
+void StreamReaderBenchmark::streamReaderFromDevice() {
+    int tokens = 0;
+
+    QBENCHMARK {
+        QBuffer buffer(&m_data);
+        QJson::StreamReader reader(&buffer);
+        while (!reader.atEnd()) {
+            reader.readNext();
+            ++tokens;
+        }
+        QVERIFY(!reader.hasError());
+    }
+
+    Q_UNUSED(tokens);
+}
+
+void StreamReaderBenchmark::streamReaderReadValue() {
+    QVariant result;
+
+    QBENCHMARK {
+        QJson::StreamReader reader(m_data);
+        reader.readNext();
+        result = reader.readValue();
+    }
+
+    Q_UNUSED(result);
+}
+
+void StreamReaderBenchmark::memoryUsage() {
+    if (residentMemory() < 0)
+        QSKIP("The resident memory can not be read on this platform", SkipAll);
+
+    // the stream reader is measured first, so freed memory reused by the QVariant tree only favours the latter
+    qint64 before = residentMemory();
+    qint64 peak = before;
+    {
+        QBuffer buffer(&m_data);
+        QJson::StreamReader reader(&buffer);
+        for (int tokens = 0; !reader.atEnd(); ++tokens) {
+            reader.readNext();
+            if (tokens % 10000 == 0)
+                peak = qMax(peak, residentMemory());
+        }
+        QVERIFY(!reader.hasError());
+        peak = qMax(peak, residentMemory());
+    }
+    qDebug() << "StreamReader:" << (peak - before) / 1024 << "KiB";
+
+    before = residentMemory();
+    {
+        QJson::Parser parser;
+        QVariant result = parser.parse(m_data);
+        qDebug() << "QVariant tree:" << (residentMemory() - before) / 1024 << "KiB";
+    }
+
+    qDebug() << "Input:" << m_data.size() / 1024 << "KiB";
+}
+
+QTEST_MAIN(StreamReaderBenchmark)
+
+#include "streamreaderbenchmark.moc"
@@ -0,0 +1,227 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVariant>
+
+#include <QtTest/QtTest>
+
+#include <QJson/Document>
+#include <QJson/Parser>
+#include <QJson/ParserRunnable>
+
+class TestDocument: public QObject
+{
+  Q_OBJECT
+  private slots:
+    void parseInvalidJson();
+    void parseInvalidJson_data();
+    void accessValues();
+    void lookupMembers();
+    void zeroCopyStrings();
+    void numbers();
+    void sameAsParser();
+    void sameAsParser_data();
+    void fromFile();
+    void parserRunnable();
+};
+
+using namespace QJson;
+
+void TestDocument::parseInvalidJson()
+{
+  QFETCH(QByteArray, json);
+  QFETCH(int, line);
+
+  bool ok;
+  Document document = Document::fromJson(json, &ok);
+  QVERIFY(!ok);
+  QVERIFY(!document.isValid());
+  QVERIFY(document.root().isUndefined());
+  QVERIFY(!document.errorString().isEmpty());
+  QCOMPARE(document.errorLine(), line);
+}
+
+void TestDocument::parseInvalidJson_data()
+{
+  QTest::addColumn<QByteArray>("json");
+  QTest::addColumn<int>("line");
+
+  QTest::newRow("empty") << QByteArray("") << 1;
+  QTest::newRow("missing colon") << QByteArray("{\"foo\" \"bar\"}") << 1;
+  QTest::newRow("missing comma") << QByteArray("[1\n2]") << 2;
+  QTest::newRow("trailing comma") << QByteArray("[1,\n]") << 2;
+  QTest::newRow("unterminated string") << QByteArray("\"foo") << 1;
+  QTest::newRow("unterminated object") << QByteArray("{\"foo\": 1") << 1;
+  QTest::newRow("invalid literal") << QByteArray("[nul]") << 1;
+  QTest::newRow("invalid number") << QByteArray("[-]") << 1;
+  QTest::newRow("out of range") << QByteArray("18446744073709551616") << 1;
+  QTest::newRow("trailing data") << QByteArray("{}\n{}") << 2;
+}
+
+void TestDocument::accessValues()
+{
+  bool ok;
+  Document document = Document::fromJson("{\"list\": [10, \"a\", true, null, {}], \"name\": \"model\"}", &ok);
+  QVERIFY(ok);
+  Value root = document.root();
+  QVERIFY(root.isObject());
+  QCOMPARE(root.size(), 2);
+
+  Value list = root.value("list");
+  QVERIFY(list.isArray());
+  QCOMPARE(list.size(), 5);
+  QCOMPARE(list.at(0).toInt(), 10);
+  QCOMPARE(list[1].toString(), QString(QLatin1String("a")));
+  QCOMPARE(list[2].toBool(), true);
+  QVERIFY(list[3].isNull());
+  QVERIFY(list[4].isObject());
+  QCOMPARE(list[4].size(), 0);
+  QVERIFY(list[5].isUndefined());
+  QVERIFY(list[-1].isUndefined());
+
+  // values of another type return the default
+  QCOMPARE(list[1].toInt(-1), -1);
+  QVERIFY(list[0].toString().isEmpty());
+  QCOMPARE(root.value("name").toUtf8(), QByteArray("model"));
+
+  // copies share the nodes
+  Document copy = document;
+  QCOMPARE(copy.root()["name"].stringData(), root["name"].stringData());
+}
+
+void TestDocument::lookupMembers()
+{
+  Document document = Document::fromJson("{\"c\": 3, \"a\": 1, \"b\": 2, \"a\": 4, \"\xc3\xa9\": 5}");
+  Value root = document.root();
+  // members are sorted by key and duplicate keys keep the last value
+  QCOMPARE(root.size(), 4);
+  QCOMPARE(root.keyAt(0), QString(QLatin1String("a")));
+  QCOMPARE(root.keyAt(1), QString(QLatin1String("b")));
+  QCOMPARE(root.keyAt(2), QString(QLatin1String("c")));
+  QCOMPARE(root.at(0).toInt(), 4);
+  QCOMPARE(root["a"].toInt(), 4);
+  QCOMPARE(root["b"].toInt(), 2);
+  QCOMPARE(root[QString(QLatin1String("c"))].toInt(), 3);
+  QCOMPARE(root[QString::fromUtf8("\xc3\xa9")].toInt(), 5);
+  QVERIFY(root["d"].isUndefined());
+  QVERIFY(root[""].isUndefined());
+  QVERIFY(root["a"]["b"].isUndefined());
+}
+
+void TestDocument::zeroCopyStrings()
+{
+  const QByteArray json("[\"plain\", \"esc\\\"aped\", \"\\u00e9\\ud83d\\ude00\"]");
+  Document document = Document::fromJson(json);
+  Value root = document.root();
+
+  // strings without escape sequences point into the input
+  QVERIFY(root[0].stringData() >= json.constData());
+  QVERIFY(root[0].stringData() < json.constData() + json.size());
+  QCOMPARE(root[0].stringSize(), 5);
+
+  QVERIFY(root[1].stringData() < json.constData() || root[1].stringData() >= json.constData() + json.size());
+  QCOMPARE(root[1].toString(), QString(QLatin1String("esc\"aped")));
+  QCOMPARE(root[2].toString(), QString::fromUtf8("\xc3\xa9\xf0\x9f\x98\x80"));
+}
+
+void TestDocument::numbers()
+{
+  Document document = Document::fromJson("[0, 18446744073709551615, -9223372036854775808, 2.5e-1, -0.5]");
+  Value root = document.root();
+  QVERIFY(root[0].isInteger());
+  QCOMPARE(root[1].toULongLong(), Q_UINT64_C(18446744073709551615));
+  QCOMPARE(root[2].toLongLong(), Q_INT64_C(-9223372036854775807) - 1);
+  QVERIFY(!root[3].isInteger());
+  QCOMPARE(root[3].toDouble(), 0.25);
+  QCOMPARE(root[4].toDouble(), -0.5);
+}
+
+void TestDocument::sameAsParser()
+{
+  QFETCH(QByteArray, json);
+
+  Parser parser;
+  bool ok;
+  QVariant expected = parser.parse(json, &ok);
+  QVERIFY(ok);
+
+  Document document = Document::fromJson(json, &ok);
+  QVERIFY(ok);
+  QVariant result = document.root().toVariant();
+  QCOMPARE(result, expected);
+  QCOMPARE(result.type(), expected.type());
+}
+
+void TestDocument::sameAsParser_data()
+{
+  QTest::addColumn<QByteArray>("json");
+
+  QTest::newRow("object") << QByteArray("{\"foo\": \"bar\", \"number\": -1, \"list\": [1, 2.5, true, null]}");
+  QTest::newRow("nested") << QByteArray("[[], {}, [[{\"a\": [1]}]]]");
+  QTest::newRow("escapes") << QByteArray("\"\\\\\\\"\\/\\b\\f\\n\\r\\t\\u0041\"");
+  QTest::newRow("unsigned") << QByteArray("1234");
+  QTest::newRow("negative") << QByteArray("-1234");
+  QTest::newRow("double") << QByteArray("1e3");
+}
+
+void TestDocument::fromFile()
+{
+  QTemporaryFile file;
+  QVERIFY(file.open());
+  file.write("{\"equations\": [{\"id\": 1}, {\"id\": 2}]}");
+  file.close();
+
+  bool ok;
+  Document document = Document::fromFile(file.fileName(), &ok);
+  QVERIFY(ok);
+  QCOMPARE(document.root()["equations"][1]["id"].toInt(), 2);
+  QVERIFY(document.memoryUsage() > 0);
+
+  Document missing = Document::fromFile(QLatin1String("does-not-exist.json"), &ok);
+  QVERIFY(!ok);
+  QVERIFY(!missing.isValid());
+}
+
+void TestDocument::parserRunnable()
+{
+  ParserRunnable runnable;
+  runnable.setAutoDelete(false);
+  runnable.setData("{\"a\": [1, 2, 3]}");
+  runnable.setDocumentOutput(true);
+  QSignalSpy spy(&runnable, SIGNAL(documentParsingFinished(QJson::Document,bool,QString)));
+  QThreadPool::globalInstance()->start(&runnable);
+  QThreadPool::globalInstance()->waitForDone();
+
+  QCOMPARE(spy.count(), 1);
+  QVERIFY(spy.at(0).at(1).toBool());
+  Document document = spy.at(0).at(0).value<Document>();
+  QCOMPARE(document.root()["a"].size(), 3);
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(5,0,0)
+// using Qt4 rather then Qt5
+QTEST_MAIN(TestDocument)
+#include "moc_testdocument.cxx"
+#else
+QTEST_GUILESS_MAIN(TestDocument)
+#include "testdocument.moc"
+#endif
@@ -54,6 +54,7 @@ class TestSerializer: public QObject
     void testIndentation();
     void testIndentation_data();
     void testSerializetoQIODevice();
+    void testSerializeLargeDocumentToQIODevice();
     void testSerializeWithoutOkParam();
     void testEscapeChars();
     void testEscapeChars_data();
@@ -557,6 +558,36 @@ void TestSerializer::testSerializetoQIODevice() {
   QVERIFY(ok);
 }
 
+void TestSerializer::testSerializeLargeDocumentToQIODevice() {
+  // large enough to be written to the device in several chunks
+  QVariantList list;
+  QByteArray expected = "[";
+  for (int i = 0; i < 20000; ++i) {
+    QVariantMap map;
+    map.insert(QLatin1String("id"), i);
+    map.insert(QLatin1String("name"), QString(QLatin1String("equation \"%1\"")).arg(i));
+    list << QVariant(map);
+    if (i > 0) {
+      expected += ",";
+    }
+    expected += "{\"id\":" + QByteArray::number(i) + ",\"name\":\"equation \\\"" + QByteArray::number(i) + "\\\"\"}";
+  }
+  expected += "]";
+
+  Serializer serializer;
+  serializer.setIndentMode(IndentCompact);
+  bool ok;
+  QBuffer buffer;
+  serializer.serialize(list, &buffer, &ok);
+  QVERIFY(ok);
+  QCOMPARE(buffer.data(), expected);
+
+  // the serializer can be reused after writing to a device
+  QCOMPARE(serializer.serialize(list, &ok), expected);
+  QVERIFY(ok);
+  QCOMPARE(serializer.serialize(list), expected);
+}
+
 void TestSerializer::testSerializeWithoutOkParam() {
   QBuffer buffer;
   QVariantList variant;
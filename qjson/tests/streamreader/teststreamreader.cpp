@@ -0,0 +1,306 @@
+/* This file is part of QJson
+ *
+ * Copyright (C) 2008 Flavio Castelli <flavio.castelli@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software Foundation.
+ *
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <cmath>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QVariant>
+
+#include <QtTest/QtTest>
+
+#include <QJson/Parser>
+#include <QJson/StreamReader>
+
+class TestStreamReader: public QObject
+{
+  Q_OBJECT
+  private slots:
+    void readTokens();
+    void readInvalidJson();
+    void readInvalidJson_data();
+    void readInChunks();
+    void readFromDevice();
+    void readNumbers();
+    void readNumbers_data();
+    void readSpecialNumbers();
+    void readEscapeChars();
+    void readValueLikeParser();
+    void readValueLikeParser_data();
+    void skipCurrentValue();
+};
+
+Q_DECLARE_METATYPE(QVariant)
+Q_DECLARE_METATYPE(QVariant::Type)
+
+using namespace QJson;
+
+static const char* document = "{\n"
+                              "  \"name\": \"model\",\n"
+                              "  \"values\": [1, -2, 0.5, true, false, null],\n"
+                              "  \"empty\": {}\n"
+                              "}\n";
+
+void TestStreamReader::readTokens()
+{
+  StreamReader reader((QByteArray(document)));
+  QCOMPARE(reader.readNext(), StreamReader::StartObject);
+  QCOMPARE(reader.depth(), 1);
+  QCOMPARE(reader.readNext(), StreamReader::Key);
+  QCOMPARE(reader.stringValue(), QString(QLatin1String("name")));
+  QCOMPARE(reader.readNext(), StreamReader::String);
+  QCOMPARE(reader.value(), QVariant(QLatin1String("model")));
+  QCOMPARE(reader.readNext(), StreamReader::Key);
+  QCOMPARE(reader.readNext(), StreamReader::StartArray);
+  QCOMPARE(reader.depth(), 2);
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QCOMPARE(reader.value(), QVariant(qulonglong(1)));
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QCOMPARE(reader.value(), QVariant(qlonglong(-2)));
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QCOMPARE(reader.value(), QVariant(0.5));
+  QCOMPARE(reader.readNext(), StreamReader::Bool);
+  QCOMPARE(reader.value(), QVariant(true));
+  QCOMPARE(reader.readNext(), StreamReader::Bool);
+  QCOMPARE(reader.value(), QVariant(false));
+  QCOMPARE(reader.readNext(), StreamReader::Null);
+  QVERIFY(!reader.value().isValid());
+  QCOMPARE(reader.readNext(), StreamReader::EndArray);
+  QCOMPARE(reader.readNext(), StreamReader::Key);
+  QCOMPARE(reader.readNext(), StreamReader::StartObject);
+  QCOMPARE(reader.readNext(), StreamReader::EndObject);
+  QCOMPARE(reader.readNext(), StreamReader::EndObject);
+  QCOMPARE(reader.depth(), 0);
+  QVERIFY(!reader.atEnd());
+  QCOMPARE(reader.readNext(), StreamReader::EndDocument);
+  QVERIFY(reader.atEnd());
+  QVERIFY(!reader.hasError());
+}
+
+void TestStreamReader::readInvalidJson()
+{
+  QFETCH(QByteArray, json);
+  QFETCH(int, line);
+
+  StreamReader reader(json);
+  while (!reader.atEnd())
+    reader.readNext();
+  QVERIFY(reader.hasError());
+  QCOMPARE(reader.tokenType(), StreamReader::Invalid);
+  QVERIFY(!reader.errorString().isEmpty());
+  QCOMPARE(reader.errorLine(), line);
+}
+
+void TestStreamReader::readInvalidJson_data()
+{
+  QTest::addColumn<QByteArray>("json");
+  QTest::addColumn<int>("line");
+
+  QTest::newRow("empty") << QByteArray("") << 1;
+  QTest::newRow("whitespace only") << QByteArray(" \n ") << 2;
+  QTest::newRow("missing colon") << QByteArray("{\"foo\" \"bar\"}") << 1;
+  QTest::newRow("missing comma") << QByteArray("[1 2]") << 1;
+  QTest::newRow("trailing comma") << QByteArray("[1,\n2,\n]") << 3;
+  QTest::newRow("wrong bracket") << QByteArray("{\"foo\": 1]") << 1;
+  QTest::newRow("unquoted key") << QByteArray("{foo: 1}") << 1;
+  QTest::newRow("unterminated string") << QByteArray("\"foo") << 1;
+  QTest::newRow("unterminated array") << QByteArray("[1, 2") << 1;
+  QTest::newRow("invalid literal") << QByteArray("[tru]") << 1;
+  QTest::newRow("invalid number") << QByteArray("[1.]") << 1;
+  QTest::newRow("invalid hex") << QByteArray("\"\\u12g4\"") << 1;
+  QTest::newRow("trailing data") << QByteArray("[1]\n[2]") << 2;
+  QTest::newRow("special number") << QByteArray("[NaN]") << 1;
+}
+
+void TestStreamReader::readInChunks()
+{
+  const QByteArray json(document);
+  StreamReader reader;
+  QList<StreamReader::TokenType> tokens;
+
+  for (int i = 0; i < json.size(); ++i) {
+    reader.addData(json.mid(i, 1));
+    while (reader.readNext() != StreamReader::Incomplete) {
+      QVERIFY(!reader.hasError());
+      tokens << reader.tokenType();
+    }
+  }
+  reader.finishData();
+  QCOMPARE(reader.readNext(), StreamReader::EndDocument);
+
+  StreamReader complete(json);
+  QList<StreamReader::TokenType> expected;
+  while (complete.readNext() != StreamReader::EndDocument)
+    expected << complete.tokenType();
+  QCOMPARE(tokens, expected);
+
+  // a number at the very end is only complete once the data is finished
+  StreamReader number;
+  number.addData("12");
+  QCOMPARE(number.readNext(), StreamReader::Incomplete);
+  QVERIFY(number.atEnd());
+  number.addData("3");
+  number.finishData();
+  QCOMPARE(number.readNext(), StreamReader::Number);
+  QCOMPARE(number.value(), QVariant(qulonglong(123)));
+  QCOMPARE(number.readNext(), StreamReader::EndDocument);
+}
+
+void TestStreamReader::readFromDevice()
+{
+  QByteArray json("[");
+  for (int i = 0; i < 50000; ++i)
+    json += "{\"index\": " + QByteArray::number(i) + ", \"name\": \"variable" + QByteArray::number(i) + "\"},";
+  json += "{}]";
+
+  QBuffer buffer(&json);
+  StreamReader reader(&buffer);
+  int names = 0;
+  qulonglong sum = 0;
+  while (!reader.atEnd()) {
+    if (reader.readNext() == StreamReader::Key && reader.stringValue() == QLatin1String("index")) {
+      QCOMPARE(reader.readNext(), StreamReader::Number);
+      sum += reader.value().toULongLong();
+      ++names;
+    }
+  }
+  QVERIFY(!reader.hasError());
+  QCOMPARE(reader.tokenType(), StreamReader::EndDocument);
+  QCOMPARE(names, 50000);
+  QCOMPARE(sum, qulonglong(49999) * 50000 / 2);
+}
+
+void TestStreamReader::readNumbers()
+{
+  QFETCH(QByteArray, number);
+  QFETCH(QVariant, expected);
+  QFETCH(QVariant::Type, type);
+
+  StreamReader reader(number);
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QCOMPARE(reader.value().type(), type);
+  QCOMPARE(reader.value(), expected);
+  QCOMPARE(reader.readNext(), StreamReader::EndDocument);
+
+  // the stream reader types numbers exactly like the parser
+  Parser parser;
+  bool ok;
+  QVariant result = parser.parse(number, &ok);
+  QVERIFY(ok);
+  QCOMPARE(result.type(), type);
+}
+
+void TestStreamReader::readNumbers_data()
+{
+  QTest::addColumn<QByteArray>("number");
+  QTest::addColumn<QVariant>("expected");
+  QTest::addColumn<QVariant::Type>("type");
+
+  QTest::newRow("zero") << QByteArray("0") << QVariant(qulonglong(0)) << QVariant::ULongLong;
+  QTest::newRow("positive") << QByteArray("1234") << QVariant(qulonglong(1234)) << QVariant::ULongLong;
+  QTest::newRow("negative") << QByteArray("-1234") << QVariant(qlonglong(-1234)) << QVariant::LongLong;
+  QTest::newRow("big") << QByteArray("18446744073709551615") << QVariant(Q_UINT64_C(18446744073709551615)) << QVariant::ULongLong;
+  QTest::newRow("fraction") << QByteArray("-12.25") << QVariant(-12.25) << QVariant::Double;
+  QTest::newRow("exponent") << QByteArray("1e3") << QVariant(1000.0) << QVariant::Double;
+  QTest::newRow("fraction and exponent") << QByteArray("2.5E-2") << QVariant(0.025) << QVariant::Double;
+}
+
+void TestStreamReader::readSpecialNumbers()
+{
+  StreamReader reader(QByteArray("[NaN, Infinity, -Infinity, null]"));
+  reader.allowSpecialNumbers(true);
+  QVERIFY(reader.specialNumbersAllowed());
+  QCOMPARE(reader.readNext(), StreamReader::StartArray);
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QVERIFY(std::isnan(reader.value().toDouble()));
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QVERIFY(std::isinf(reader.value().toDouble()) && reader.value().toDouble() > 0);
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QVERIFY(std::isinf(reader.value().toDouble()) && reader.value().toDouble() < 0);
+  QCOMPARE(reader.readNext(), StreamReader::Null);
+  QCOMPARE(reader.readNext(), StreamReader::EndArray);
+}
+
+void TestStreamReader::readEscapeChars()
+{
+  StreamReader reader(QByteArray("[\"\\\\\\\"\\/\\b\\f\\n\\r\\t\", \"\\u00e9t\\u00E9\", \"\\ud83d\\ude00\", \"\xc3\xa9t\xc3\xa9\"]"));
+  QCOMPARE(reader.readNext(), StreamReader::StartArray);
+  QCOMPARE(reader.readNext(), StreamReader::String);
+  QCOMPARE(reader.stringValue(), QString(QLatin1String("\\\"/\b\f\n\r\t")));
+  QCOMPARE(reader.readNext(), StreamReader::String);
+  QCOMPARE(reader.stringValue(), QString::fromUtf8("\xc3\xa9t\xc3\xa9"));
+  QCOMPARE(reader.readNext(), StreamReader::String);
+  QCOMPARE(reader.stringValue(), QString::fromUtf8("\xf0\x9f\x98\x80"));
+  QCOMPARE(reader.readNext(), StreamReader::String);
+  QCOMPARE(reader.stringValue(), QString::fromUtf8("\xc3\xa9t\xc3\xa9"));
+  QCOMPARE(reader.readNext(), StreamReader::EndArray);
+}
+
+void TestStreamReader::readValueLikeParser()
+{
+  QFETCH(QByteArray, json);
+
+  Parser parser;
+  bool ok;
+  QVariant expected = parser.parse(json, &ok);
+  QVERIFY(ok);
+
+  StreamReader reader(json);
+  reader.readNext();
+  QVariant result = reader.readValue(&ok);
+  QVERIFY(ok);
+  QCOMPARE(result, expected);
+  QCOMPARE(reader.readNext(), StreamReader::EndDocument);
+}
+
+void TestStreamReader::readValueLikeParser_data()
+{
+  QTest::addColumn<QByteArray>("json");
+
+  QTest::newRow("object") << QByteArray(document);
+  QTest::newRow("array") << QByteArray("[1, [2, [3, {\"a\": []}]], \"b\"]");
+  QTest::newRow("string") << QByteArray("\"foo\"");
+  QTest::newRow("number") << QByteArray("-3.5");
+  QTest::newRow("duplicate keys") << QByteArray("{\"a\": 1, \"a\": 2}");
+}
+
+void TestStreamReader::skipCurrentValue()
+{
+  StreamReader reader(QByteArray("{\"skip\": {\"a\": [1, {\"b\": 2}]}, \"keep\": 3}"));
+  QCOMPARE(reader.readNext(), StreamReader::StartObject);
+  QCOMPARE(reader.readNext(), StreamReader::Key);
+  QCOMPARE(reader.readNext(), StreamReader::StartObject);
+  QVERIFY(reader.skipCurrentValue());
+  QCOMPARE(reader.tokenType(), StreamReader::EndObject);
+  QCOMPARE(reader.depth(), 1);
+  QCOMPARE(reader.readNext(), StreamReader::Key);
+  QCOMPARE(reader.stringValue(), QString(QLatin1String("keep")));
+  QCOMPARE(reader.readNext(), StreamReader::Number);
+  QVERIFY(reader.skipCurrentValue());
+  QCOMPARE(reader.readNext(), StreamReader::EndObject);
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(5,0,0)
+// using Qt4 rather then Qt5
+QTEST_MAIN(TestStreamReader)
+#include "moc_teststreamreader.cxx"
+#else
+QTEST_GUILESS_MAIN(TestStreamReader)
+#include "teststreamreader.moc"
+#endif